@@ -24,9 +24,12 @@ option(DAWN_ASSERTS "Enable asserts" ${BUILD_IS_NOT_RELEASE})
 option(DAWN_USE_CCACHE "Use compile cache (ccache)" ON)
 option(DAWN_PYTHON "Build and install the Python module interface to HIR" ON)
 option(DAWN_JAVA "Build and install the java interface to HIR" ON)
+option(DAWN_PROFILE_ALLOCATIONS
+       "Count heap allocations to report them in the optimizer pass profile (replaces the global operator new)" OFF)
 
 # Testing
 option(DAWN_TESTING "Enable testing" ON)
+option(DAWN_BENCHMARKS "Build the compiler throughput benchmarks" OFF)
 
 # Documentation
 option(DAWN_DOCUMENTATION "Enable documentation" OFF)
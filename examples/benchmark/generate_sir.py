@@ -0,0 +1,126 @@
+#!/usr/bin/python3
+# -*- coding: utf-8 -*-
+# ===-----------------------------------------------------------------------------*- Python -*-===##
+#                          _
+#                         | |
+#                       __| | __ ___      ___ ___
+#                      / _` |/ _` \ \ /\ / / '_  |
+#                     | (_| | (_| |\ V  V /| | | |
+#                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+#
+#
+#  This file is distributed under the MIT License (MIT).
+#  See LICENSE.txt for details.
+#
+# ===------------------------------------------------------------------------------------------===##
+"""SIR generator of the CPU backend benchmarks
+
+This program writes the SIR of the copy_stencil, hori_diff and tridiagonal_solve examples (see
+examples/python) in the JSON format of the SIR serializer. In contrast to the examples, it does not
+need the python module of protobuf and can therefore be used to regenerate the benchmark inputs on
+any machine.
+"""
+
+import json
+import os.path
+
+NO_LOC = {"Line": -1, "Column": -1}
+
+
+def field(name, offset=(0, 0, 0)):
+    return {"field_access_expr": {"name": name, "offset": list(offset),
+                                  "argument_map": [-1, -1, -1], "argument_offset": [0, 0, 0],
+                                  "negate_offset": False, "loc": NO_LOC}}
+
+
+def var(name):
+    return {"var_access_expr": {"name": name, "is_external": False, "loc": NO_LOC}}
+
+
+def literal(value):
+    return {"literal_access_expr": {"value": value, "type": {"type_id": "Float"}, "loc": NO_LOC}}
+
+
+def binop(left, op, right):
+    return {"binary_operator": {"left": left, "op": op, "right": right, "loc": NO_LOC}}
+
+
+def assign(left, right, op="="):
+    return {"expr_stmt": {"expr": {"assignment_expr": {"left": left, "op": op, "right": right,
+                                                       "loc": NO_LOC}},
+                          "loc": NO_LOC}}
+
+
+def var_decl(name, init):
+    return {"var_decl_stmt": {"type": {"builtin_type": {"type_id": "Float"}, "is_const": False,
+                                       "is_volatile": False},
+                              "name": name, "dimension": 0, "op": "=", "init_list": [init],
+                              "loc": NO_LOC}}
+
+
+def block(statements):
+    return {"root": {"block_stmt": {"statements": statements, "loc": NO_LOC}}}
+
+
+def vertical_region(statements, lower_offset, upper_offset, upper_level, loop_order):
+    return {"vertical_region_decl_stmt": {"vertical_region": {
+        "loc": NO_LOC, "ast": block(statements),
+        "interval": {"lower_offset": lower_offset, "upper_offset": upper_offset,
+                     "special_lower_level": "Start", "special_upper_level": upper_level},
+        "loop_order": loop_order}, "loc": NO_LOC}}
+
+
+def sir(name, regions, fields, temporaries=()):
+    return {"filename": name + ".cpp", "stencils": [{
+        "name": name, "loc": NO_LOC, "ast": block(regions),
+        "fields": [{"name": f, "loc": NO_LOC, "is_temporary": f in temporaries,
+                    "field_dimensions": [1, 1, 1]} for f in fields]}],
+        "stencil_functions": [], "global_variables": {"map": {}}}
+
+
+def laplacian(out, arg):
+    neighbours = binop(field(arg, (1, 0, 0)), "+",
+                       binop(field(arg, (-1, 0, 0)), "+",
+                             binop(field(arg, (0, 1, 0)), "+", field(arg, (0, -1, 0)))))
+    return assign(field(out), binop(binop(literal("-4.0"), "*", field(arg)), "+",
+                                    binop(field("coeff"), "*", neighbours)))
+
+
+def copy_stencil():
+    return sir("copy_stencil",
+               [vertical_region([assign(field("out"), field("in", (1, 0, 0)))], 0, 0, "End",
+                                "Forward")],
+               ["in", "out"])
+
+
+def hori_diff():
+    return sir("hori_diff",
+               [vertical_region([laplacian("lap", "in"), laplacian("out", "lap")], 0, 0, "End",
+                                "Forward")],
+               ["in", "out", "coeff", "lap"], temporaries=("lap",))
+
+
+def tridiagonal_solve():
+    m = binop(literal("1.0"), "/",
+              binop(field("b"), "-", binop(field("a"), "*", field("c", (0, 0, -1)))))
+    return sir("tridiagonal_solve", [
+        vertical_region([assign(field("c"), binop(field("c"), "/", field("b")))], 0, 0, "Start",
+                        "Forward"),
+        vertical_region([
+            var_decl("m", m),
+            assign(field("c"), binop(field("c"), "*", var("m"))),
+            assign(field("d"), binop(binop(field("d"), "-",
+                                           binop(field("a"), "*", field("d", (0, 0, -1)))),
+                                     "*", var("m")))], 1, 0, "End", "Forward"),
+        vertical_region([assign(field("d"), binop(field("c"), "*", field("d", (0, 0, 1))), "-=")],
+                        0, -1, "End", "Backward")],
+        ["a", "b", "c", "d"])
+
+
+if __name__ == "__main__":
+    directory = os.path.dirname(os.path.realpath(__file__))
+    for stencil in [copy_stencil(), hori_diff(), tridiagonal_solve()]:
+        name = stencil["stencils"][0]["name"]
+        with open(os.path.join(directory, name + ".sir"), "w") as f:
+            json.dump(stencil, f, indent=1)
+            f.write("\n")
@@ -0,0 +1,68 @@
+#!/usr/bin/env bash
+##===-------------------------------------------------------------------------------*- bash -*-===##
+##                          _
+##                         | |
+##                       __| | __ ___      ___ ___
+##                      / _` |/ _` \ \ /\ / / '_  |
+##                     | (_| | (_| |\ V  V /| | | |
+##                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+##
+##
+##  This file is distributed under the MIT License (MIT).
+##  See LICENSE.txt for details.
+##
+##===------------------------------------------------------------------------------------------===##
+
+# Compare the naive and the OpenMP C++ backends on the copy_stencil, hori_diff and
+# tridiagonal_solve examples. By default only the default optimizer configuration is benchmarked
+# (an exhaustive search with a budget of one configuration); a larger BUDGET lets the search of
+# the OpenMP backend cover its block sizes and SIMD widths. The memory bandwidth of the best
+# configuration is reported next to the bandwidth of a STREAM-like copy on the same machine,
+# followed by the speedup of the OpenMP backend.
+#
+# usage: run_benchmark.sh DAWN_TUNE INCLUDE_DIR...
+#
+#   DAWN_TUNE     Path to the dawn-tune executable
+#   INCLUDE_DIR   Include directories of gridtools, gtclang and boost
+#
+# The environment variables BUDGET (default 1), DOMAIN (default 128,128,80), REPETITIONS
+# (default 20), CXX and CXXFLAGS are forwarded to dawn-tune. The number of threads of the OpenMP
+# backend is set with OMP_NUM_THREADS.
+
+this_script_dir="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+
+if [ $# -lt 1 ]; then
+  echo "usage: $0 DAWN_TUNE INCLUDE_DIR..."
+  exit 1
+fi
+
+dawn_tune=$1
+shift
+
+include_args=""
+for include_dir in "$@"; do
+  include_args="$include_args --include=$include_dir"
+done
+
+work_dir=$(mktemp -d)
+trap "rm -rf $work_dir" EXIT
+
+for stencil in copy_stencil hori_diff tridiagonal_solve; do
+  declare -A times=()
+  for backend in c++-naive c++-opt; do
+    result=$($dawn_tune --sir="$this_script_dir/$stencil.sir" \
+                        --db="$work_dir/$stencil-$backend.json" \
+                        --backend=$backend --search=exhaustive --budget=${BUDGET:-1} \
+                        --domain=${DOMAIN:-128,128,80} --repetitions=${REPETITIONS:-20} \
+                        --cxx="${CXX:-c++}" \
+                        --cxxflags="${CXXFLAGS:--O3 -march=native -std=c++14 -DNDEBUG}" \
+                        --workdir="$work_dir" $include_args | grep "configurations evaluated")
+    echo "$backend: $result"
+    # The median run time in seconds of the best configuration, e.g `(0.0123 s, ...`
+    times[$backend]=$(echo "$result" | sed -n 's/.*(\([0-9.e+-]*\) s,.*/\1/p')
+  done
+  if [ -n "${times[c++-naive]}" ] && [ -n "${times[c++-opt]}" ]; then
+    awk -v stencil=$stencil -v naive=${times[c++-naive]} -v opt=${times[c++-opt]} \
+      'BEGIN { printf "%s: c++-opt is %.2fx faster than c++-naive\n", stencil, naive / opt }'
+  fi
+done
@@ -0,0 +1,44 @@
+#include <chrono>
+#include <cstdio>
+#include <gridtools/clang_dsl.hpp>
+#include <string>
+
+#include "generated.hpp"
+
+// Runs the diffusion example on a w x w periodic mesh, compile with -DPOINTER_MESH to compare the
+// flat neighbour tables against the pointer based mesh
+int main(int argc, char** argv) {
+  int w = argc > 1 ? std::stoi(argv[1]) : 512;
+  int steps = argc > 2 ? std::stoi(argv[2]) : 100;
+
+  Grid grid{w, w, true};
+#ifdef POINTER_MESH
+  const char* name = "pointer";
+  Mesh const& m = grid;
+#else
+  const char* name = "csr";
+  Mesh m{grid};
+#endif
+  Field<double> in(m), out(m);
+
+  for(auto& f : grid.faces()) {
+    auto center_x = w / 2.f - (1.f / 3) * (f.vertex(0).x() + f.vertex(1).x() + f.vertex(2).x());
+    auto center_y = w / 2.f - (1.f / 3) * (f.vertex(0).y() + f.vertex(1).y() + f.vertex(2).y());
+    in[f] = (center_x * center_x + center_y * center_y > w / 3.) ? 1 : 0;
+  }
+
+  dawn_generated::cxxnaiveico::generated forward(m, in, out), backward(m, out, in);
+  forward.run();
+
+  auto start = std::chrono::steady_clock::now();
+  for(int i = 0; i < steps; ++i)
+    (i % 2 == 0 ? backward : forward).run();
+  std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+
+  double checksum = 0;
+  for(auto& f : grid.faces())
+    checksum += in[f] + out[f];
+
+  std::printf("%s mesh: %zu faces, %d steps, %.3f ms per step, checksum %.17g\n", name,
+              grid.faces().size(), steps, time.count() / steps, checksum);
+}
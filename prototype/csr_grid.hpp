@@ -0,0 +1,188 @@
+#pragma once
+
+#include "grid.hpp"
+
+#include <vector>
+
+namespace lib_lukas {
+namespace csr {
+
+// The locations of a mesh are identified by their IDs, [0, size)
+class LocationRange {
+public:
+  class iterator {
+  public:
+    explicit iterator(int id) : id_(id) {}
+
+    int operator*() const { return id_; }
+    iterator& operator++() {
+      ++id_;
+      return *this;
+    }
+    bool operator!=(iterator const& other) const { return id_ != other.id_; }
+
+  private:
+    int id_;
+  };
+
+  explicit LocationRange(int size) : size_(size) {}
+
+  iterator begin() const { return iterator(0); }
+  iterator end() const { return iterator(size_); }
+  int size() const { return size_; }
+
+private:
+  int size_;
+};
+
+// IDs of the neighbours of one location, a view into a NeighbourTable
+class NeighbourRange {
+public:
+  NeighbourRange(int const* begin, int const* end) : begin_(begin), end_(end) {}
+
+  int const* begin() const { return begin_; }
+  int const* end() const { return end_; }
+  int size() const { return end_ - begin_; }
+  int operator[](size_t i) const { return begin_[i]; }
+
+private:
+  int const* begin_;
+  int const* end_;
+};
+
+// Neighbours of all the locations of one kind in compressed sparse row format: the IDs of the
+// neighbours of location `id` are stored contiguously in indices_[offsets_[id], offsets_[id + 1])
+class NeighbourTable {
+public:
+  NeighbourTable() = default;
+
+  // `neighbours(location)` returns the pointers to the neighbours of a location of the pointer
+  // based grid
+  template <class Location, class Neighbours>
+  NeighbourTable(std::vector<Location> const& locations, Neighbours const& neighbours)
+      : offsets_(1, 0) {
+    offsets_.reserve(locations.size() + 1);
+    for(auto const& location : locations) {
+      for(auto const* neighbour : neighbours(location))
+        indices_.push_back(neighbour->id());
+      offsets_.push_back(indices_.size());
+    }
+  }
+
+  NeighbourRange operator()(int id) const {
+    return {indices_.data() + offsets_[id], indices_.data() + offsets_[id + 1]};
+  }
+  int size() const { return offsets_.size() - 1; }
+
+private:
+  std::vector<int> offsets_;
+  std::vector<int> indices_;
+};
+
+// Flat representation of a lib_lukas::Grid: the connectivity is stored in neighbour tables
+// instead of pointers inside every location, the neighbours are enumerated in the same order
+class Grid {
+public:
+  explicit Grid(lib_lukas::Grid const& grid)
+      : numFaces_(grid.faces().size()), numEdges_(grid.edges().size()),
+        numVertices_(grid.vertices().size()), nx_(grid.nx()), ny_(grid.ny()),
+        faceFaces_(grid.faces(), &faceNeighboursOfFace),
+        faceEdges_(grid.faces(), [](Face const& f) { return f.edges(); }),
+        faceVertices_(grid.faces(), [](Face const& f) { return f.vertices(); }),
+        edgeFaces_(grid.edges(), [](Edge const& e) { return e.faces(); }),
+        edgeVertices_(grid.edges(), [](Edge const& e) { return e.vertices(); }),
+        vertexFaces_(grid.vertices(), [](Vertex const& v) { return v.faces(); }),
+        vertexEdges_(grid.vertices(), [](Vertex const& v) { return v.edges(); }),
+        vertexVertices_(grid.vertices(), [](Vertex const& v) { return v.vertices(); }) {}
+
+  Grid(int nx, int ny, bool periodic = false) : Grid(lib_lukas::Grid(nx, ny, periodic)) {}
+
+  LocationRange faces() const { return LocationRange(numFaces_); }
+  LocationRange edges() const { return LocationRange(numEdges_); }
+  LocationRange vertices() const { return LocationRange(numVertices_); }
+
+  NeighbourTable const& faceFaces() const { return faceFaces_; }
+  NeighbourTable const& faceEdges() const { return faceEdges_; }
+  NeighbourTable const& faceVertices() const { return faceVertices_; }
+  NeighbourTable const& edgeFaces() const { return edgeFaces_; }
+  NeighbourTable const& edgeVertices() const { return edgeVertices_; }
+  NeighbourTable const& vertexFaces() const { return vertexFaces_; }
+  NeighbourTable const& vertexEdges() const { return vertexEdges_; }
+  NeighbourTable const& vertexVertices() const { return vertexVertices_; }
+
+  auto nx() const { return nx_; }
+  auto ny() const { return ny_; }
+
+private:
+  // Same as Face::faces(), but boundary edges of non-periodic grids are skipped instead of
+  // accessing their missing second face
+  static std::vector<const Face*> faceNeighboursOfFace(Face const& f) {
+    std::vector<const Face*> ret;
+    for(auto e : f.edges())
+      if(e->faces().size() == 2)
+        ret.push_back(e->face(0).id() == f.id() ? &e->face(1) : &e->face(0));
+    return ret;
+  }
+
+  int numFaces_;
+  int numEdges_;
+  int numVertices_;
+
+  int nx_;
+  int ny_;
+
+  NeighbourTable faceFaces_;
+  NeighbourTable faceEdges_;
+  NeighbourTable faceVertices_;
+  NeighbourTable edgeFaces_;
+  NeighbourTable edgeVertices_;
+  NeighbourTable vertexFaces_;
+  NeighbourTable vertexEdges_;
+  NeighbourTable vertexVertices_;
+};
+
+// Values of a field on all the locations of one kind, stored contiguously by location ID
+template <typename T>
+class Data {
+public:
+  explicit Data(size_t size) : data_(size) {}
+  T& operator[](int id) { return data_[id]; }
+  T const& operator[](int id) const { return data_[id]; }
+
+  // Access by the location of the lib_lukas::Grid the mesh was built from
+  template <class Location>
+  T& operator[](Location const& location) {
+    return data_[location.id()];
+  }
+  template <class Location>
+  T const& operator[](Location const& location) const {
+    return data_[location.id()];
+  }
+
+  T* data() { return data_.data(); }
+  T const* data() const { return data_.data(); }
+  auto begin() { return data_.begin(); }
+  auto end() { return data_.end(); }
+  auto size() const { return data_.size(); }
+
+private:
+  std::vector<T> data_;
+};
+template <typename T>
+class FaceData : public Data<T> {
+public:
+  explicit FaceData(Grid const& grid) : Data<T>(grid.faces().size()) {}
+};
+template <typename T>
+class VertexData : public Data<T> {
+public:
+  explicit VertexData(Grid const& grid) : Data<T>(grid.vertices().size()) {}
+};
+template <typename T>
+class EdgeData : public Data<T> {
+public:
+  explicit EdgeData(Grid const& grid) : Data<T>(grid.edges().size()) {}
+};
+
+} // namespace csr
+} // namespace lib_lukas
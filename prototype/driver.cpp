@@ -5,19 +5,28 @@
 
 int main() {
   int w = 20;
-  Mesh m{w, w, true};
+  Grid grid{w, w, true};
+#ifdef POINTER_MESH
+  Mesh const& m = grid;
+#else
+  Mesh m{grid};
+#endif
   Field<double> in(m), out(m);
 
-  for(auto& f : m.faces()) {
+  for(auto& f : grid.faces()) {
     auto center_x = w / 2.f - (1.f / 3) * (f.vertex(0).x() + f.vertex(1).x() + f.vertex(2).x());
     auto center_y = w / 2.f - (1.f / 3) * (f.vertex(0).y() + f.vertex(1).y() + f.vertex(2).y());
     in[f] = (center_x * center_x + center_y * center_y > w / 3.) ? 1 : 0;
   }
 
+  FaceData<double> temperature(grid);
   for(int i = 0; i < 1000; ++i) {
+    for(auto& f : grid.faces())
+      temperature[f] = in[f];
+
     std::ofstream of("of_" + std::to_string(i) + ".vtk");
-    toVtk(m, of);
-    toVtk("temperature", in, m, of);
+    toVtk(grid, of);
+    toVtk("temperature", temperature, grid, of);
 
     dawn_generated::cxxnaiveico::generated(m, in, out).run();
 
@@ -1,9 +1,15 @@
 #pragma once
 
+#include "csr_grid.hpp"
 #include "grid.hpp"
 
+// The interface targeted by the code of the c++-naive-ico backend. The locations are the IDs of
+// the flat lib_lukas::csr::Grid, define POINTER_MESH to run the generated code on the pointer based
+// lib_lukas::Grid instead.
 namespace MyInterface {
 
+#ifdef POINTER_MESH
+
 using Mesh = lib_lukas::Grid;
 using Face = lib_lukas::Face;
 template <typename T>
@@ -20,4 +26,23 @@ auto reduce(Objs&& objs, Init init, Op&& op) {
   return init;
 }
 
+#else
+
+using Mesh = lib_lukas::csr::Grid;
+template <typename T>
+using Field = lib_lukas::csr::FaceData<T>;
+
+inline auto getTriangles(Mesh const& m) { return m.faces(); }
+
+inline auto cellNeighboursOfCell(Mesh const& m, int n) { return m.faceFaces()(n); }
+
+template <typename Objs, typename Init, typename Op>
+auto reduce(Objs&& objs, Init init, Op&& op) {
+  for(int obj : objs)
+    op(init, obj);
+  return init;
+}
+
+#endif
+
 } // namespace MyInterface
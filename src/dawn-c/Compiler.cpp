@@ -16,12 +16,22 @@
 #include "dawn-c/ErrorHandling.h"
 #include "dawn-c/util/Allocate.h"
 #include "dawn-c/util/CompilerWrapper.h"
+#include "dawn-c/TranslationUnit.h"
 #include "dawn-c/util/OptionsWrapper.h"
+#include "dawn/Compiler/CompileServer.h"
 #include "dawn/Serialization/SIRSerializer.h"
+#include "dawn/Support/IndexGenerator.h"
+#include "dawn/Support/Logging.h"
+#include "dawn/Support/Parallel.h"
 #include "dawn/Support/STLExtras.h"
+#include "dawn/Support/UIDGenerator.h"
 #include "dawn/Support/Unreachable.h"
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
+#include <mutex>
+#include <vector>
 using namespace dawn::util;
 
 static DawnDiagnosticsKind getDawnDiagnosticsKind(dawn::DiagnosticsKind diag) {
@@ -67,9 +77,70 @@ void dawnInstallDiagnosticsHandler(dawnDiagnosticsHandler_t handler) {
   DiagnosticsHandler = handler ? handler : dawnDefaultDiagnosticsHandler;
 }
 
+static std::mutex CompileServerMutex;
+static std::string CompileServerSocket =
+    std::getenv("DAWN_COMPILE_SERVER") ? std::getenv("DAWN_COMPILE_SERVER") : "";
+
+void dawnSetCompileServer(const char* socketPath) {
+  std::lock_guard<std::mutex> lock(CompileServerMutex);
+  CompileServerSocket = socketPath ? socketPath : "";
+}
+
+char* dawnCompileServerGetStatistics(const char* socketPath) {
+  try {
+    return allocateAndCopyString(dawn::server::getStatistics(socketPath).dump());
+  } catch(std::exception& e) {
+    DAWN_LOG(WARNING) << e.what();
+    return nullptr;
+  }
+}
+
+/// @brief Compile the SIR on the compile server
+///
+/// @return `false` if the server cannot be reached, in which case the SIR is compiled in-process
+static bool compileOnServer(const std::string& socketPath, const char* SIR, size_t size,
+                            const dawn::Options& options, dawnTranslationUnit_t** translationUnit) {
+  dawn::server::CompileResult result;
+  try {
+    result = dawn::server::compile(socketPath, std::string(SIR, size), options);
+  } catch(std::exception& e) {
+    DAWN_LOG(WARNING) << e.what() << ", compiling in-process";
+    return false;
+  }
+
+  for(const auto& diag : result.Diagnostics)
+    dawnReportDiagnostic(getDawnDiagnosticsKind(diag.getDiagKind()), diag.getSourceLocation().Line,
+                         diag.getSourceLocation().Column, diag.getFilename().c_str(),
+                         diag.getMessage().c_str());
+
+  if(!result.TranslationUnit) {
+    dawnFatalError(result.Error.c_str());
+    return true;
+  }
+
+  *translationUnit = allocate<dawnTranslationUnit_t>();
+  (*translationUnit)->Impl = result.TranslationUnit.release();
+  (*translationUnit)->OwnsData = 1;
+  return true;
+}
+
 dawnTranslationUnit_t* dawnCompile(const char* SIR, size_t size, const dawnOptions_t* options) {
   dawnTranslationUnit_t* translationUnit = nullptr;
 
+  std::string socketPath;
+  {
+    std::lock_guard<std::mutex> lock(CompileServerMutex);
+    socketPath = CompileServerSocket;
+  }
+
+  if(!socketPath.empty()) {
+    dawn::Options compileOptions;
+    if(options)
+      toConstOptionsWrapper(options)->setDawnOptions(&compileOptions);
+    if(compileOnServer(socketPath, SIR, size, compileOptions, &translationUnit))
+      return translationUnit;
+  }
+
   // Deserialize the SIR
   try {
     std::string sirStr(SIR, size);
@@ -106,3 +177,101 @@ dawnTranslationUnit_t* dawnCompile(const char* SIR, size_t size, const dawnOptio
 
   return translationUnit;
 }
+
+/// @brief Compile a single SIR of a batch and store the generated code and the diagnostics in
+/// `result`
+static void compileBatchEntry(const char* SIR, size_t size, const dawn::Options& options,
+                              dawnCompileResult_t* result) {
+  try {
+    std::string sirStr(SIR, size);
+    auto inMemorySIR =
+        dawn::SIRSerializer::deserializeFromString(sirStr, dawn::SIRSerializer::SK_Byte);
+
+    dawn::DawnCompiler compiler(&options);
+    auto TU = compiler.compile(inMemorySIR);
+
+    const auto& queue = compiler.getDiagnostics().getQueue().queue();
+    if(!queue.empty()) {
+      result->Diagnostics = allocate<dawnDiagnostic_t>(queue.size());
+      for(const auto& diag : queue) {
+        dawnDiagnostic_t& diagnostic = result->Diagnostics[result->NumDiagnostics++];
+        diagnostic.Kind = getDawnDiagnosticsKind(diag->getDiagKind());
+        diagnostic.Line = diag->getSourceLocation().Line;
+        diagnostic.Column = diag->getSourceLocation().Column;
+        diagnostic.Filename = allocateAndCopyString(diag->getFilename());
+        diagnostic.Message = allocateAndCopyString(diag->getMessage());
+      }
+    }
+
+    if(!TU || compiler.getDiagnostics().hasErrors())
+      throw std::runtime_error("compilation failed");
+
+    result->TranslationUnit = allocate<dawnTranslationUnit_t>();
+    result->TranslationUnit->Impl = new dawn::codegen::TranslationUnit(std::move(*TU.get()));
+    result->TranslationUnit->OwnsData = 1;
+
+  } catch(std::exception& e) {
+    result->ErrorMessage = allocateAndCopyString(std::string(e.what()));
+  }
+}
+
+dawnCompileResult_t* dawnCompileBatch(const char* const* SIRs, const size_t* sizes, int numSIRs,
+                                      const dawnOptions_t* options, int numThreads) {
+  if(numSIRs <= 0)
+    return nullptr;
+
+  dawnCompileResult_t* results = allocate<dawnCompileResult_t>(numSIRs);
+
+  // Prepare options (shared by all compilations)
+  dawn::Options compileOptions;
+  if(options)
+    toConstOptionsWrapper(options)->setDawnOptions(&compileOptions);
+
+  // Each SIR draws its identifiers from a private range, like the stencil instantiations in the
+  // optimizer. This makes the generated code independent of the number of threads. The ranges are
+  // capped (like in the optimizer) so that a batch does not use up the identifiers of the
+  // following compilations.
+  dawn::UIDGenerator* uidGenerator = dawn::UIDGenerator::getInstance();
+  dawn::IndexGenerator& indexGenerator = dawn::IndexGenerator::Instance();
+  const int uidBase = uidGenerator->peek();
+  const int uidRange = std::min(1 << 24, uidGenerator->getNumAvailable() / numSIRs);
+  const long unsigned int indexBase = indexGenerator.peek();
+  const long unsigned int indexRange =
+      std::min(1ul << 24, indexGenerator.getNumAvailable() / numSIRs);
+
+  std::vector<int> uidNext(numSIRs, uidBase);
+  std::vector<long unsigned int> indexNext(numSIRs, indexBase);
+
+  dawn::parallelFor(numSIRs, numThreads, [&](std::size_t idx) {
+    dawn::UIDGenerator::Scope uidScope(uidBase + static_cast<int>(idx) * uidRange, uidRange);
+    dawn::IndexGenerator::Scope indexScope(indexBase + idx * indexRange, indexRange);
+
+    compileBatchEntry(SIRs[idx], sizes[idx], compileOptions, &results[idx]);
+
+    uidNext[idx] = uidScope.getNext();
+    indexNext[idx] = indexScope.getNext();
+  });
+
+  // Continue numbering after the identifiers of the last SIR
+  uidGenerator->set(uidNext.back());
+  indexGenerator.set(indexNext.back());
+
+  return results;
+}
+
+void dawnCompileResultsDestroy(dawnCompileResult_t* results, int numResults) {
+  if(!results)
+    return;
+
+  for(int i = 0; i < numResults; ++i) {
+    dawnCompileResult_t& result = results[i];
+    dawnTranslationUnitDestroy(result.TranslationUnit);
+    for(int j = 0; j < result.NumDiagnostics; ++j) {
+      std::free(result.Diagnostics[j].Filename);
+      std::free(result.Diagnostics[j].Message);
+    }
+    std::free(result.Diagnostics);
+    std::free(result.ErrorMessage);
+  }
+  std::free(results);
+}
@@ -52,6 +52,28 @@ typedef void (*dawnDiagnosticsHandler_t)(DawnDiagnosticsKind diag, int line, int
  */
 extern void dawnInstallDiagnosticsHandler(dawnDiagnosticsHandler_t handler);
 
+/**
+ * @brief Set the socket of the compile server used by @ref dawnCompile
+ *
+ * If a compile server is set, @ref dawnCompile sends the SIR to the server (see `dawn-server`)
+ * instead of compiling it in-process. If the server cannot be reached, a warning is logged and the
+ * SIR is compiled in-process. Initially, the socket is taken from the environment variable
+ * `DAWN_COMPILE_SERVER` (if set).
+ *
+ * @param socketPath  Path of the socket of the server (or if `NULL` is passed the SIRs are always
+ *                    compiled in-process)
+ */
+extern void dawnSetCompileServer(const char* socketPath);
+
+/**
+ * @brief Get the statistics of the compile server listening at `socketPath` as JSON string
+ *
+ * @param socketPath  Path of the socket of the server
+ * @return Newly allocated string which has to be freed by the user or `NULL` if the server cannot
+ *         be reached
+ */
+extern char* dawnCompileServerGetStatistics(const char* socketPath);
+
 /**
  * @brief Run the compiler on the byte-string serialized SIR and return the generated code
  *
@@ -64,6 +86,37 @@ extern void dawnInstallDiagnosticsHandler(dawnDiagnosticsHandler_t handler);
 extern dawnTranslationUnit_t* dawnCompile(const char* SIR, size_t size,
                                           const dawnOptions_t* options);
 
+/**
+ * @brief Run the compiler on a batch of byte-string serialized SIRs sharing the same options
+ *
+ * The options are converted once for the whole batch and the SIRs are compiled independently of
+ * each other using up to `numThreads` threads. The generated code does not depend on the number of
+ * threads.
+ *
+ * In contrast to @ref dawnCompile, the diagnostics are not passed to the installed diagnostics
+ * handler and a failed compilation does not invoke the fatal error handler. Instead, both are
+ * returned in the result of the respective SIR.
+ *
+ * @param SIRs        Array of byte string serialized SIRs
+ * @param sizes       Sizes of the serialized SIRs
+ * @param numSIRs     Number of SIRs
+ * @param options     Options of the compilations (if `NULL` is passed the default options are used)
+ * @param numThreads  Maximum number of threads (`<= 0` uses one thread per hardware thread)
+ * @return Newly allocated array of `numSIRs` results (in the order of `SIRs`) which has to be freed
+ *         with @ref dawnCompileResultsDestroy, or `NULL` if `numSIRs <= 0`
+ */
+extern dawnCompileResult_t* dawnCompileBatch(const char* const* SIRs, const size_t* sizes,
+                                             int numSIRs, const dawnOptions_t* options,
+                                             int numThreads);
+
+/**
+ * @brief Destroy the results of @ref dawnCompileBatch (including the translation units)
+ *
+ * @param results     Results returned by @ref dawnCompileBatch
+ * @param numResults  Number of results (i.e the number of compiled SIRs)
+ */
+extern void dawnCompileResultsDestroy(dawnCompileResult_t* results, int numResults);
+
 /** @} */
 
 #ifdef __cplusplus
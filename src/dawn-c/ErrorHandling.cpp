@@ -13,11 +13,13 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn-c/ErrorHandling.h"
+#include <atomic>
 #include <cassert>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
+#include <mutex>
 #include <string>
 
 static void dawnDefaultFatalErrorHandler(const char* reason) {
@@ -26,30 +28,37 @@ static void dawnDefaultFatalErrorHandler(const char* reason) {
   std::exit(1);
 }
 
-static dawnFatalErrorHandler_t FatalErrorHandler = dawnDefaultFatalErrorHandler;
+static std::atomic<dawnFatalErrorHandler_t> FatalErrorHandler(dawnDefaultFatalErrorHandler);
 
 void dawnInstallFatalErrorHandler(dawnFatalErrorHandler_t handler) {
   FatalErrorHandler = handler ? handler : dawnDefaultFatalErrorHandler;
 }
 
 void dawnFatalError(const char* reason) {
-  assert(FatalErrorHandler);
-  (*FatalErrorHandler)(reason);
+  dawnFatalErrorHandler_t handler = FatalErrorHandler;
+  assert(handler);
+  (*handler)(reason);
 }
 
 static struct ErrorState {
   bool HasError = false;
   std::string ErrorMsg = "";
+  std::mutex Mutex;
 } errorState;
 
 void dawnStateErrorHandler(const char* reason) {
+  std::lock_guard<std::mutex> lock(errorState.Mutex);
   errorState.HasError = true;
   errorState.ErrorMsg = reason;
 }
 
-int dawnStateErrorHandlerHasError(void) { return errorState.HasError; }
+int dawnStateErrorHandlerHasError(void) {
+  std::lock_guard<std::mutex> lock(errorState.Mutex);
+  return errorState.HasError;
+}
 
 char* dawnStateErrorHandlerGetErrorMessage(void) {
+  std::lock_guard<std::mutex> lock(errorState.Mutex);
   std::size_t size = errorState.ErrorMsg.size() + 1;
   char* errorMessage = (char*)std::malloc(size * sizeof(char));
   std::memcpy(errorMessage, errorState.ErrorMsg.c_str(), size);
@@ -57,6 +66,7 @@ char* dawnStateErrorHandlerGetErrorMessage(void) {
 }
 
 void dawnStateErrorHandlerResetState(void) {
+  std::lock_guard<std::mutex> lock(errorState.Mutex);
   errorState.HasError = false;
   errorState.ErrorMsg.clear();
 }
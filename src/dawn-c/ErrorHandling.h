@@ -56,7 +56,7 @@ extern void dawnInstallFatalErrorHandler(dawnFatalErrorHandler_t handler);
  * @brief Store the the current state of the error which can be queried via
  * @ref dawnStateErrorHandlerHasError as well as @ref dawnStateErrorHandlerGetErrorMessage
  *
- * This error handler is **not** thread-safe.
+ * The error state is shared by all threads, i.e only the last error is kept.
  */
 extern void dawnStateErrorHandler(const char* reason);
 
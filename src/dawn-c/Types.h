@@ -75,6 +75,27 @@ typedef struct {
   int OwnsData; /**< Ownership flag */
 } dawnTranslationUnit_t;
 
+/**
+ * @brief Diagnostic emitted during the compilation of a SIR
+ */
+typedef struct {
+  DawnDiagnosticsKind Kind; /**< Kind of the diagnostic */
+  int Line;                 /**< Line of the source location */
+  int Column;               /**< Column of the source location */
+  char* Filename;           /**< Filename of the source location */
+  char* Message;            /**< Message of the diagnostic */
+} dawnDiagnostic_t;
+
+/**
+ * @brief Result of the compilation of a single SIR of a batch
+ */
+typedef struct {
+  dawnTranslationUnit_t* TranslationUnit; /**< Generated code or `NULL` on failure */
+  dawnDiagnostic_t* Diagnostics;          /**< Diagnostics emitted during the compilation */
+  int NumDiagnostics;                     /**< Number of diagnostics */
+  char* ErrorMessage;                     /**< Reason of the failure or `NULL` on success */
+} dawnCompileResult_t;
+
 /** @} */
 
 #ifdef __cplusplus
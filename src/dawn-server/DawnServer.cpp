@@ -0,0 +1,99 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+
+#include "dawn/Compiler/CompileServer.h"
+#include <csignal>
+#include <iostream>
+#include <memory>
+#include <string>
+
+namespace {
+
+std::unique_ptr<dawn::CompileServer> Server;
+
+void handleSignal(int) {
+  if(Server)
+    Server->shutdown();
+}
+
+void printUsage(const char* program) {
+  std::cout << "usage: " << program << " --socket=PATH [options]\n\n"
+            << "Compile server which compiles the SIRs sent to the Unix socket PATH. Set the\n"
+            << "environment variable DAWN_COMPILE_SERVER=PATH to compile with the server via\n"
+            << "dawnCompile.\n\n"
+            << "Options:\n"
+            << "  --workers=N   Number of concurrent compilations (default: hardware threads)\n"
+            << "  --queue=N     Number of connections waiting for a worker (default: "
+            << dawn::CompileServer::DefaultQueueCapacity << ")\n"
+            << "  --stats       Print the statistics of the running server and exit\n"
+            << "  --stop        Shut down the running server and exit\n";
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  std::string socketPath;
+  int numWorkers = 0;
+  std::size_t queueCapacity = dawn::CompileServer::DefaultQueueCapacity;
+  bool printStatistics = false, stop = false;
+
+  try {
+    for(int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      if(arg.compare(0, 9, "--socket=") == 0)
+        socketPath = arg.substr(9);
+      else if(arg.compare(0, 10, "--workers=") == 0)
+        numWorkers = std::stoi(arg.substr(10));
+      else if(arg.compare(0, 8, "--queue=") == 0)
+        queueCapacity = std::stoul(arg.substr(8));
+      else if(arg == "--stats")
+        printStatistics = true;
+      else if(arg == "--stop")
+        stop = true;
+      else
+        throw std::invalid_argument(arg);
+    }
+  } catch(std::exception&) {
+    socketPath.clear();
+  }
+
+  if(socketPath.empty()) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  try {
+    if(printStatistics || stop) {
+      if(printStatistics)
+        std::cout << dawn::server::getStatistics(socketPath).dump(2) << std::endl;
+      if(stop)
+        dawn::server::shutdown(socketPath);
+      return 0;
+    }
+
+    Server = std::make_unique<dawn::CompileServer>(socketPath, numWorkers, queueCapacity);
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    Server->run();
+
+    std::cout << Server->getStatistics().jsonDump().dump(2) << std::endl;
+    Server.reset();
+
+  } catch(std::exception& e) {
+    std::cerr << "dawn-server: error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,156 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/Autotuner.h"
+#include "dawn/Compiler/BenchmarkHarness.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/Compiler/TuningDatabase.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/SIRSerializer.h"
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace {
+
+void printUsage(const char* program) {
+  std::cout << "usage: " << program << " --sir=FILE --db=FILE [options]\n\n"
+            << "Search the optimizer options of each stencil of the SIR FILE by compiling and\n"
+            << "running a benchmark of each configuration. The fastest configuration is stored in\n"
+            << "the tuning database which is used by compilations with -tuning-db=FILE.\n\n"
+            << "Options:\n"
+            << "  --stencil=NAME     Only tune the stencil NAME\n"
+            << "  --backend=NAME     Backend to tune for (default: c++-naive)\n"
+            << "  --search=KIND      exhaustive, random or greedy (default: greedy)\n"
+            << "  --budget=N         Maximum number of configurations per stencil (default: 32)\n"
+            << "  --seed=N           Seed of the random search (default: 0)\n"
+            << "  --domain=I,J,K     Size of the benchmark domain (default: 64,64,80)\n"
+            << "  --repetitions=N    Number of timed runs of each configuration (default: 10)\n"
+            << "  --cxx=CMD          C++ compiler (default: c++)\n"
+            << "  --cxxflags=FLAGS   Flags of the C++ compiler (default: -O3 -std=c++14 -DNDEBUG)\n"
+            << "  --include=DIR      Include directory of gridtools and gtclang (repeatable)\n"
+            << "  --workdir=DIR      Directory of the generated benchmarks\n";
+}
+
+bool startsWith(const std::string& arg, const std::string& prefix, std::string& value) {
+  if(arg.compare(0, prefix.size(), prefix) != 0)
+    return false;
+  value = arg.substr(prefix.size());
+  return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  std::string sirFile, dbFile, stencilName, searchName = "greedy";
+  std::size_t budget = 32;
+  unsigned seed = 0;
+  dawn::Options options;
+  options.Backend = "c++-naive";
+  dawn::BenchmarkHarness::Settings settings;
+  dawn::Autotuner::SearchKind searchKind;
+
+  try {
+    for(int i = 1; i < argc; ++i) {
+      std::string arg = argv[i], value;
+      if(startsWith(arg, "--sir=", value))
+        sirFile = value;
+      else if(startsWith(arg, "--db=", value))
+        dbFile = value;
+      else if(startsWith(arg, "--stencil=", value))
+        stencilName = value;
+      else if(startsWith(arg, "--backend=", value))
+        options.Backend = value;
+      else if(startsWith(arg, "--search=", value))
+        searchName = value;
+      else if(startsWith(arg, "--budget=", value))
+        budget = std::stoul(value);
+      else if(startsWith(arg, "--seed=", value))
+        seed = std::stoul(value);
+      else if(startsWith(arg, "--domain=", value)) {
+        std::istringstream ss(value);
+        std::string size;
+        for(int dim = 0; dim < 3; ++dim) {
+          if(!std::getline(ss, size, ','))
+            throw std::invalid_argument(arg);
+          settings.Domain[dim] = std::stoi(size);
+        }
+      } else if(startsWith(arg, "--repetitions=", value))
+        settings.Repetitions = std::stoi(value);
+      else if(startsWith(arg, "--cxx=", value))
+        settings.Compiler = value;
+      else if(startsWith(arg, "--cxxflags=", value))
+        settings.Flags = value;
+      else if(startsWith(arg, "--include=", value))
+        settings.IncludeDirs.push_back(value);
+      else if(startsWith(arg, "--workdir=", value))
+        settings.WorkDir = value;
+      else
+        throw std::invalid_argument(arg);
+    }
+  } catch(std::exception&) {
+    sirFile.clear();
+  }
+
+  if(sirFile.empty() || dbFile.empty() ||
+     !dawn::Autotuner::parseSearchKind(searchName, searchKind)) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  try {
+    auto sir = dawn::SIRSerializer::deserialize(sirFile);
+    dawn::TuningDatabase database(dbFile);
+
+    for(const auto& stencil : sir->Stencils) {
+      if(!stencilName.empty() && stencil->Name != stencilName)
+        continue;
+
+      dawn::BenchmarkHarness harness(sir, stencil->Name, options, settings);
+      dawn::Autotuner tuner(dawn::Autotuner::getDefaultSpace(options.Backend),
+                            [&](const dawn::TuningConfiguration& configuration) {
+                              return harness.evaluate(configuration);
+                            });
+
+      std::cout << stencil->Name << ": searching " << tuner.getNumConfigurations()
+                << " configurations" << std::endl;
+      auto result = tuner.run(searchKind, budget, seed);
+      if(result.BestTime < 0.0) {
+        std::cerr << "dawn-tune: warning: no configuration of `" << stencil->Name
+                  << "` could be benchmarked" << std::endl;
+        continue;
+      }
+
+      std::cout << stencil->Name << ": " << result.Best.toString() << " (" << result.BestTime
+                << " s, ";
+      if(const auto* bandwidth = harness.getBandwidth(result.Best))
+        std::cout << bandwidth->Stencil << " GB/s of " << bandwidth->Stream
+                  << " GB/s STREAM copy, ";
+      std::cout << result.History.size() << " configurations evaluated)" << std::endl;
+      database.insert(dawn::TuningDatabase::computeKey(*sir, stencil->Name, options),
+                      {stencil->Name, result.Best, result.BestTime});
+    }
+
+    if(!database.save()) {
+      std::cerr << "dawn-tune: error: failed to write `" << dbFile << "`" << std::endl;
+      return 1;
+    }
+
+  } catch(std::exception& e) {
+    std::cerr << "dawn-tune: error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
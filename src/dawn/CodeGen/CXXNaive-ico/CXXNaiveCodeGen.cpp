@@ -467,12 +467,11 @@ std::unique_ptr<TranslationUnit> CXXNaiveIcoCodeGen::generateCode() {
 
   // Generate code for StencilInstantiations
   std::map<std::string, std::string> stencils;
-  for(const auto& nameStencilCtxPair : context_) {
-    std::string code = generateStencilInstantiation(nameStencilCtxPair.second);
-    if(code.empty())
-      return nullptr;
-    stencils.emplace(nameStencilCtxPair.first, std::move(code));
-  }
+  if(!generateStencilInstantiations(
+         stencils, [&](const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
+           return generateStencilInstantiation(stencilInstantiation);
+         }))
+    return nullptr;
 
   std::string globals = generateGlobals(context_, "dawn_generated", "cxxnaiveico");
 
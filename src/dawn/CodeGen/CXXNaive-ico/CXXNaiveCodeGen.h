@@ -33,6 +33,13 @@ namespace codegen {
 namespace cxxnaiveico {
 
 /// @brief GridTools C++ code generation for the gridtools_clang DSL
+///
+/// The generated code runs on unstructured (icosahedral) meshes through the interface of
+/// `prototype/my_interface.hpp`: `Mesh`, `Field<T>`, `getTriangles(mesh)`,
+/// `cellNeighboursOfCell(mesh, t)` and `reduce(neighbours, init, op)`. The locations are opaque
+/// to the generated code, the default interface passes them as IDs into the flat neighbour tables
+/// and contiguous fields of `lib_lukas::csr::Grid`.
+///
 /// @ingroup cxxnaiveico
 class CXXNaiveIcoCodeGen : public CodeGen {
 public:
@@ -75,7 +75,8 @@ std::string CXXNaiveCodeGen::generateStencilInstantiation(
   std::stringstream ssSW;
 
   Namespace dawnNamespace("dawn_generated", ssSW);
-  Namespace cxxnaiveNamespace("cxxnaive", ssSW);
+  const std::string backendNamespace = getBackendNamespace();
+  Namespace cxxnaiveNamespace(backendNamespace, ssSW);
 
   const auto& globalsMap = stencilInstantiation->getIIR()->getGlobalVariableMap();
 
@@ -518,14 +519,13 @@ std::unique_ptr<TranslationUnit> CXXNaiveCodeGen::generateCode() {
 
   // Generate code for StencilInstantiations
   std::map<std::string, std::string> stencils;
-  for(const auto& nameStencilCtxPair : context_) {
-    std::string code = generateStencilInstantiation(nameStencilCtxPair.second);
-    if(code.empty())
-      return nullptr;
-    stencils.emplace(nameStencilCtxPair.first, std::move(code));
-  }
+  if(!generateStencilInstantiations(
+         stencils, [&](const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
+           return generateStencilInstantiation(stencilInstantiation);
+         }))
+    return nullptr;
 
-  std::string globals = generateGlobals(context_, "dawn_generated", "cxxnaive");
+  std::string globals = generateGlobals(context_, "dawn_generated", getBackendNamespace());
 
   std::vector<std::string> ppDefines;
   auto makeDefine = [](std::string define, int value) {
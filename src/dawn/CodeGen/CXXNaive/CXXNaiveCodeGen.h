@@ -41,7 +41,10 @@ public:
   virtual ~CXXNaiveCodeGen();
   virtual std::unique_ptr<TranslationUnit> generateCode() override;
 
-private:
+protected:
+  /// @brief Namespace of the generated code inside `dawn_generated`
+  virtual std::string getBackendNamespace() const { return "cxxnaive"; }
+
   std::string generateStencilInstantiation(
       const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation);
 
@@ -50,9 +53,10 @@ private:
                            const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
                            const CodeGenProperties& codeGenProperties) const;
 
-  void generateStencilClasses(const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
-                              Class& stencilWrapperClass,
-                              const CodeGenProperties& codeGenProperties) const;
+  virtual void
+  generateStencilClasses(const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+                         Class& stencilWrapperClass,
+                         const CodeGenProperties& codeGenProperties) const;
   void generateStencilWrapperMembers(
       Class& stencilWrapperClass,
       const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
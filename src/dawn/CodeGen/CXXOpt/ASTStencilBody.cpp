@@ -0,0 +1,47 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/CXXOpt/ASTStencilBody.h"
+#include "dawn/IIR/StencilMetaInformation.h"
+
+namespace dawn {
+namespace codegen {
+namespace cxxopt {
+
+ASTStencilBody::ASTStencilBody(const iir::StencilMetaInformation& metadata,
+                               StencilContext stencilContext,
+                               const std::set<int>& blockTemporaries,
+                               const std::set<int>& ijCachedTemporaries)
+    : Base(metadata, stencilContext), blockTemporaries_(blockTemporaries),
+      ijCachedTemporaries_(ijCachedTemporaries) {}
+
+void ASTStencilBody::visit(const std::shared_ptr<iir::FieldAccessExpr>& expr) {
+  if(currentFunction_ || !blockTemporaries_.count(getAccessID(expr))) {
+    Base::visit(expr);
+    return;
+  }
+
+  const std::string accessName = getName(expr);
+  const Array3i& offset = expr->getOffset();
+  const int numDims = ijCachedTemporaries_.count(getAccessID(expr)) ? 2 : 3;
+  ss_ << accessName << "(";
+  for(int dim = 0; dim < numDims; ++dim)
+    ss_ << (dim == 0 ? "" : ",") << "ijk"[dim] << "+" << offset[dim] << "+" << accessName
+        << "_offsets[" << dim << "]";
+  ss_ << (numDims == 2 ? ",0" : "") << ")";
+}
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
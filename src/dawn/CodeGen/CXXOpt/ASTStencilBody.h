@@ -0,0 +1,52 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_CODEGEN_CXXOPT_ASTSTENCILBODY_H
+#define DAWN_CODEGEN_CXXOPT_ASTSTENCILBODY_H
+
+#include "dawn/CodeGen/CXXNaive/ASTStencilBody.h"
+#include <set>
+
+namespace dawn {
+namespace codegen {
+namespace cxxopt {
+
+/// @brief ASTVisitor to generate the optimized C++ code for the stencil bodies
+///
+/// Identical to the naive code except for the temporaries which are allocated per block: their
+/// accesses are shifted by `<name>_offsets` to the origin of the block of the executing thread. The
+/// IJ-cached temporaries only store the level which is currently computed, they are accessed at
+/// level 0.
+///
+/// @ingroup cxxopt
+class ASTStencilBody : public cxxnaive::ASTStencilBody {
+protected:
+  std::set<int> blockTemporaries_;
+  std::set<int> ijCachedTemporaries_;
+
+public:
+  using Base = cxxnaive::ASTStencilBody;
+
+  ASTStencilBody(const iir::StencilMetaInformation& metadata, StencilContext stencilContext,
+                 const std::set<int>& blockTemporaries, const std::set<int>& ijCachedTemporaries);
+
+  virtual void visit(const std::shared_ptr<iir::FieldAccessExpr>& expr) override;
+  using Base::visit;
+};
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
+
+#endif
@@ -0,0 +1,150 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/CXXOpt/ASTStencilBodySIMD.h"
+#include "dawn/IIR/StencilMetaInformation.h"
+#include "dawn/Support/Assert.h"
+#include "dawn/Support/Casting.h"
+#include <sstream>
+
+namespace dawn {
+namespace codegen {
+namespace cxxopt {
+
+ASTStencilBodySIMD::ASTStencilBodySIMD(const iir::StencilMetaInformation& metadata,
+                                       const std::set<int>& blockTemporaries,
+                                       const std::set<int>& ijCachedTemporaries)
+    : Base(metadata, StencilContext::SC_Stencil, blockTemporaries, ijCachedTemporaries),
+      unitStrideI_(true), numMasks_(0) {}
+
+bool ASTStencilBodySIMD::isMaskable(const std::shared_ptr<iir::Stmt>& stmt) {
+  if(const auto* blockStmt = dyn_cast<iir::BlockStmt>(stmt.get())) {
+    for(const auto& s : blockStmt->getStatements())
+      if(!isMaskable(s))
+        return false;
+    return true;
+  }
+  if(const auto* exprStmt = dyn_cast<iir::ExprStmt>(stmt.get()))
+    return isa<iir::AssignmentExpr>(exprStmt->getExpr().get());
+  if(isa<iir::VarDeclStmt>(stmt.get()))
+    return true;
+  if(const auto* ifStmt = dyn_cast<iir::IfStmt>(stmt.get()))
+    return isMaskable(ifStmt->getThenStmt()) &&
+           (!ifStmt->hasElse() || isMaskable(ifStmt->getElseStmt()));
+  return false;
+}
+
+void ASTStencilBodySIMD::visit(const std::shared_ptr<iir::ExprStmt>& stmt) {
+  const auto* assignment = dyn_cast<iir::AssignmentExpr>(stmt->getExpr().get());
+  if(masks_.empty() || !assignment) {
+    Base::visit(stmt);
+    return;
+  }
+
+  if(scopeDepth_ == 0)
+    ss_ << std::string(indent_, ' ');
+
+  // `x op= y` becomes `x = simd_select(mask, x op y, x)`
+  const std::string op = assignment->getOp();
+  assignment->getLeft()->accept(*this);
+  ss_ << " = simd_select(" << masks_.back() << ", ";
+  if(op == "=") {
+    assignment->getRight()->accept(*this);
+  } else {
+    ss_ << "(";
+    assignment->getLeft()->accept(*this);
+    ss_ << " " << op.substr(0, op.size() - 1) << " ";
+    assignment->getRight()->accept(*this);
+    ss_ << ")";
+  }
+  ss_ << ", ";
+  assignment->getLeft()->accept(*this);
+  ss_ << ");\n";
+}
+
+void ASTStencilBodySIMD::visit(const std::shared_ptr<iir::IfStmt>& stmt) {
+  if(!isMaskable(stmt)) {
+    Base::visit(stmt);
+    return;
+  }
+
+  if(scopeDepth_ == 0)
+    ss_ << std::string(indent_, ' ');
+
+  // Both branches are executed, their assignments only take effect where the mask is set
+  const std::string cond = "__mask_" + std::to_string(numMasks_++);
+  ss_ << "const bool " << cond << " = ";
+  stmt->getCondExpr()->accept(*this);
+  ss_ << ";\n";
+
+  const std::string parent = masks_.empty() ? "" : masks_.back() + " && ";
+  masks_.push_back("(" + parent + cond + ")");
+  stmt->getThenStmt()->accept(*this);
+  masks_.pop_back();
+
+  if(stmt->hasElse()) {
+    masks_.push_back("(" + parent + "!" + cond + ")");
+    stmt->getElseStmt()->accept(*this);
+    masks_.pop_back();
+  }
+}
+
+void ASTStencilBodySIMD::visit(const std::shared_ptr<iir::TernaryOperator>& expr) {
+  ss_ << "simd_select(";
+  expr->getCondition()->accept(*this);
+  ss_ << ", ";
+  expr->getLeft()->accept(*this);
+  ss_ << ", ";
+  expr->getRight()->accept(*this);
+  ss_ << ")";
+}
+
+void ASTStencilBodySIMD::visit(const std::shared_ptr<iir::StencilFunCallExpr>& expr) {
+  DAWN_ASSERT_MSG(0, "StencilFunCallExpr not allowed in vectorized stencil bodies");
+}
+
+std::string ASTStencilBodySIMD::getFieldAccess(int accessID, const Array3i& offset) const {
+  const std::string accessName = metadata_.getFieldNameFromAccessID(accessID);
+  std::stringstream ss;
+  ss << accessName << "_ptr[";
+  if(blockTemporaries_.count(accessID)) {
+    ss << "(i+" << offset[0] << "-blockOriginI) + (j+" << offset[1] << "-blockOriginJ)*blockStrideJ";
+    if(!ijCachedTemporaries_.count(accessID))
+      ss << " + (k+" << offset[2] << ")*blockStrideK";
+  } else {
+    ss << "(i+" << offset[0] << ")" << (unitStrideI_ ? "" : "*" + accessName + "_si") << " + (j+"
+       << offset[1] << ")*" << accessName << "_sj + (k+" << offset[2] << ")*" << accessName
+       << "_sk";
+  }
+  ss << "]";
+  return ss.str();
+}
+
+void ASTStencilBodySIMD::visit(const std::shared_ptr<iir::FieldAccessExpr>& expr) {
+  const int accessID = getAccessID(expr);
+  const Array3i& offset = expr->getOffset();
+
+  auto kCacheIt = kCacheCenterOffsets_.find(accessID);
+  if(kCacheIt == kCacheCenterOffsets_.end()) {
+    ss_ << getFieldAccess(accessID, offset);
+    return;
+  }
+
+  DAWN_ASSERT_MSG(offset[0] == 0 && offset[1] == 0, "horizontal offset of a k-cached field");
+  ss_ << getName(expr) << "_kcache[" << (kCacheIt->second + offset[2]) << "][i - iVec]";
+}
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
@@ -0,0 +1,90 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_CODEGEN_CXXOPT_ASTSTENCILBODYSIMD_H
+#define DAWN_CODEGEN_CXXOPT_ASTSTENCILBODYSIMD_H
+
+#include "dawn/CodeGen/CXXOpt/ASTStencilBody.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dawn {
+namespace codegen {
+namespace cxxopt {
+
+/// @brief ASTVisitor to generate the explicitly vectorized C++ code for the stencil bodies
+///
+/// The fields are accessed through raw pointers instead of data views:
+///
+///   - `<name>_ptr[(i+o0)*<name>_si + (j+o1)*<name>_sj + (k+o2)*<name>_sk]` for the storages, the
+///     i-stride is omitted if the loop is generated for unit strides in i (see `setUnitStrideI`)
+///   - `<name>_ptr[(i+o0-blockOriginI) + (j+o1-blockOriginJ)*blockStrideJ + (k+o2)*blockStrideK]`
+///     for the temporaries which are allocated per block, the k-term is omitted for the IJ-cached
+///     temporaries which only store the level currently computed
+///   - `<name>_kcache[level][i - iVec]` for the k-cached fields (see `setKCaches` and
+///     `KCacheCodeGen`)
+///
+/// Conditionals are lowered to selects so that they do not prevent the vectorization: ternary
+/// operators become calls to `simd_select` and if-statements which only contain assignments (and
+/// declarations) are converted to masked assignments `x = simd_select(mask, value, x)`. Stencil
+/// functions are not supported.
+///
+/// @ingroup cxxopt
+class ASTStencilBodySIMD : public ASTStencilBody {
+  bool unitStrideI_;
+  int numMasks_;
+
+  /// Mask of the enclosing (converted) if-statements
+  std::vector<std::string> masks_;
+
+  /// Index of the center level in the ring buffer of the k-cached fields
+  std::unordered_map<int, int> kCacheCenterOffsets_;
+
+  /// @brief Can `stmt` be converted to masked assignments?
+  static bool isMaskable(const std::shared_ptr<iir::Stmt>& stmt);
+
+public:
+  using Base = ASTStencilBody;
+
+  ASTStencilBodySIMD(const iir::StencilMetaInformation& metadata,
+                     const std::set<int>& blockTemporaries,
+                     const std::set<int>& ijCachedTemporaries);
+
+  /// @brief Generate the accesses for a unit stride in i (i.e without `<name>_si`)
+  void setUnitStrideI(bool unitStrideI) { unitStrideI_ = unitStrideI; }
+
+  /// @brief Access the fields with the given access IDs through their k-caches
+  ///
+  /// @param kCacheCenterOffsets  Index of the center level in the ring buffer of each cached field
+  void setKCaches(const std::unordered_map<int, int>& kCacheCenterOffsets) {
+    kCacheCenterOffsets_ = kCacheCenterOffsets;
+  }
+
+  /// @brief Access of the field `accessID` at `offset` in memory (the k-caches are ignored)
+  std::string getFieldAccess(int accessID, const Array3i& offset) const;
+
+  virtual void visit(const std::shared_ptr<iir::ExprStmt>& stmt) override;
+  virtual void visit(const std::shared_ptr<iir::IfStmt>& stmt) override;
+  virtual void visit(const std::shared_ptr<iir::TernaryOperator>& expr) override;
+  virtual void visit(const std::shared_ptr<iir::StencilFunCallExpr>& expr) override;
+  virtual void visit(const std::shared_ptr<iir::FieldAccessExpr>& expr) override;
+  using Base::visit;
+};
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
+
+#endif
@@ -0,0 +1,630 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/CXXOpt/CXXOptCodeGen.h"
+#include "dawn/CodeGen/CXXOpt/ASTStencilBody.h"
+#include "dawn/CodeGen/CXXOpt/ASTStencilBodySIMD.h"
+#include "dawn/CodeGen/CXXOpt/KCacheCodeGen.h"
+#include "dawn/CodeGen/CXXUtil.h"
+#include "dawn/CodeGen/CodeGenProperties.h"
+#include "dawn/IIR/ASTVisitor.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Support/Assert.h"
+#include "dawn/Support/StringUtil.h"
+#include <algorithm>
+#include <set>
+#include <vector>
+
+namespace dawn {
+namespace codegen {
+namespace cxxopt {
+
+namespace {
+
+/// @brief Check if an AST calls a stencil function
+class StencilFunCallFinder : public iir::ASTVisitorForwarding {
+  bool found_ = false;
+
+public:
+  virtual void visit(const std::shared_ptr<iir::StencilFunCallExpr>& expr) override {
+    found_ = true;
+  }
+
+  bool hasFound() const { return found_; }
+};
+
+bool hasStencilFunCalls(const iir::MultiStage& multiStage) {
+  StencilFunCallFinder finder;
+  for(const auto& stagePtr : multiStage.getChildren())
+    for(const auto& doMethodPtr : stagePtr->getChildren())
+      for(const auto& statementAccessesPair : doMethodPtr->getChildren())
+        statementAccessesPair->getStatement()->accept(finder);
+  return finder.hasFound();
+}
+
+} // anonymous namespace
+
+static std::string makeLoopImpl(const iir::Extent extent, const std::string& dim,
+                                const std::string& lower, const std::string& upper,
+                                const std::string& comparison, const std::string& increment) {
+  return Twine("for(int " + dim + " = " + lower + "+" + std::to_string(extent.Minus) + "; " + dim +
+               " " + comparison + " " + upper + "+" + std::to_string(extent.Plus) + "; " +
+               increment + dim + ")")
+      .str();
+}
+
+static std::string makeIntervalBound(const std::string dom, iir::Interval const& interval,
+                                     iir::Interval::Bound bound) {
+  return interval.levelIsEnd(bound)
+             ? "( " + dom + ".ksize() == 0 ? 0 : (" + dom + ".ksize() - " + dom +
+                   ".kplus() - 1)) + " + std::to_string(interval.offset(bound))
+             : std::to_string(interval.bound(bound));
+}
+
+static std::string makeKLoop(const std::string dom, iir::LoopOrderKind loopOrder,
+                             iir::Interval const& interval, int kBlockSize) {
+  std::string lower = makeIntervalBound(dom, interval, iir::Interval::Bound::lower);
+  std::string upper = makeIntervalBound(dom, interval, iir::Interval::Bound::upper);
+
+  if(loopOrder == iir::LoopOrderKind::LK_Backward)
+    return makeLoopImpl(iir::Extent{}, "k", upper, lower, ">=", "--");
+
+  // Parallel multi-stages only compute the levels of the interval within the current k-block
+  if(loopOrder == iir::LoopOrderKind::LK_Parallel) {
+    const std::string size = std::to_string(kBlockSize);
+    lower = "std::max(" + lower + ", kBlock * " + size + ")";
+    upper = "std::min(" + upper + ", kBlock * " + size + " + " + size + " - 1)";
+  }
+  return makeLoopImpl(iir::Extent{}, "k", lower, upper, "<=", "++");
+}
+
+CXXOptCodeGen::CXXOptCodeGen(stencilInstantiationContext& ctx, DiagnosticsEngine& engine,
+                             int maxHaloPoint, int simdWidth)
+    : CXXNaiveCodeGen(ctx, engine, maxHaloPoint), simdWidth_(simdWidth) {}
+
+CXXOptCodeGen::~CXXOptCodeGen() {}
+
+void CXXOptCodeGen::generateStencilClasses(
+    const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+    Class& stencilWrapperClass, const CodeGenProperties& codeGenProperties) const {
+
+  const auto& stencils = stencilInstantiation->getStencils();
+  const auto& globalsMap = stencilInstantiation->getIIR()->getGlobalVariableMap();
+
+  // Size of the blocks distributed over the threads, at least one point in each dimension
+  std::array<int, 3> blockSize;
+  for(int dim = 0; dim < 3; ++dim)
+    blockSize[dim] =
+        std::max(1, static_cast<int>(stencilInstantiation->getIIR()->getBlockSize()[dim]));
+  const std::string blockSizeI = std::to_string(blockSize[0]);
+  const std::string blockSizeJ = std::to_string(blockSize[1]);
+  const std::string blockSizeK = std::to_string(blockSize[2]);
+
+  for(std::size_t stencilIdx = 0; stencilIdx < stencils.size(); ++stencilIdx) {
+    const auto& stencil = *stencils[stencilIdx];
+
+    std::string stencilName =
+        codeGenProperties.getStencilName(StencilContext::SC_Stencil, stencil.getStencilID());
+
+    auto stencilProperties =
+        codeGenProperties.getStencilProperties(StencilContext::SC_Stencil, stencilName);
+
+    if(stencil.isEmpty())
+      continue;
+
+    // fields used in the stencil
+    const auto stencilFields = stencil.getOrderedFields();
+
+    // Temporaries which are only accessed by a single multi-stage live in per-thread block
+    // storages, the others are allocated for the full domain
+    std::set<int> blockTemporaries;
+    for(const auto& fieldPair : stencilFields) {
+      if(!fieldPair.second.IsTemporary)
+        continue;
+      int numMultiStages = 0;
+      for(const auto& multiStagePtr : stencil.getChildren())
+        numMultiStages += multiStagePtr->getFields().count(fieldPair.first);
+      if(numMultiStages == 1)
+        blockTemporaries.insert(fieldPair.first);
+    }
+
+    // IJ-cached block temporaries are only accessed at the level which is computed, their block
+    // storages hold a single level which stays in the L1 cache
+    std::set<int> ijCachedTemporaries;
+    for(const auto& multiStagePtr : stencil.getChildren())
+      for(const auto& cachePair : multiStagePtr->getCaches())
+        if(blockTemporaries.count(cachePair.first) &&
+           cachePair.second.getCacheType() == iir::Cache::IJ)
+          ijCachedTemporaries.insert(cachePair.first);
+
+    auto nonTempFields = makeRange(
+        stencilFields, std::function<bool(std::pair<int, iir::Stencil::FieldInfo> const&)>(
+                           [](std::pair<int, iir::Stencil::FieldInfo> const& p) {
+                             return !p.second.IsTemporary;
+                           }));
+    auto tempFields = makeRange(
+        stencilFields, std::function<bool(std::pair<int, iir::Stencil::FieldInfo> const&)>(
+                           [&](std::pair<int, iir::Stencil::FieldInfo> const& p) {
+                             return p.second.IsTemporary && !blockTemporaries.count(p.first);
+                           }));
+
+    Structure stencilClass = stencilWrapperClass.addStruct(stencilName);
+
+    ASTStencilBody stencilBodyCXXVisitor(stencilInstantiation->getMetaData(),
+                                         StencilContext::SC_Stencil, blockTemporaries,
+                                         ijCachedTemporaries);
+    ASTStencilBodySIMD stencilBodySIMDVisitor(stencilInstantiation->getMetaData(),
+                                              blockTemporaries, ijCachedTemporaries);
+
+    // Stencil functions take data views as arguments, multi-stages calling them are not vectorized
+    auto isVectorized = [&](const iir::MultiStage& multiStage) {
+      return simdWidth_ > 0 && !hasStencilFunCalls(multiStage);
+    };
+
+    stencilClass.addComment("Members");
+    stencilClass.addComment("Temporary storages");
+    addTempStorageTypedef(stencilClass, stencil);
+
+    stencilClass.addMember("const " + c_gtc() + "domain&", "m_dom");
+
+    if(!globalsMap.empty()) {
+      stencilClass.addMember("const globals&", "m_globals");
+    }
+
+    stencilClass.addComment("Input/Output storages");
+    for(auto it = nonTempFields.begin(); it != nonTempFields.end(); ++it) {
+      std::string type = stencilProperties->paramNameToType_.at((*it).second.Name);
+      stencilClass.addMember(type + "&", "m_" + (*it).second.Name);
+    }
+
+    addTmpStorageDeclaration(stencilClass, tempFields);
+
+    stencilClass.changeAccessibility("public");
+
+    auto stencilClassCtr = stencilClass.addConstructor();
+
+    stencilClassCtr.addArg("const " + c_gtc() + "domain& dom_");
+    if(!globalsMap.empty()) {
+      stencilClassCtr.addArg("const globals& globals_");
+    }
+    for(auto it = nonTempFields.begin(); it != nonTempFields.end(); ++it) {
+      std::string type = stencilProperties->paramNameToType_.at((*it).second.Name);
+      stencilClassCtr.addArg(type + "& " + (*it).second.Name + "_");
+    }
+
+    stencilClassCtr.addInit("m_dom(dom_)");
+    if(!globalsMap.empty()) {
+      stencilClassCtr.addInit("m_globals(globals_)");
+    }
+
+    for(const auto& fieldPair : nonTempFields) {
+      stencilClassCtr.addInit("m_" + fieldPair.second.Name + "(" + fieldPair.second.Name + "_)");
+    }
+
+    addTmpStorageInit(stencilClassCtr, stencil, tempFields);
+    stencilClassCtr.commit();
+
+    // virtual dtor
+    MemberFunction stencilClassDtr = stencilClass.addDestructor(true);
+    stencilClassDtr.startBody();
+    stencilClassDtr.commit();
+
+    // synchronize storages method
+    MemberFunction syncStoragesMethod = stencilClass.addMemberFunction("void", "sync_storages", "");
+    syncStoragesMethod.startBody();
+
+    for(const auto& fieldPair : nonTempFields) {
+      syncStoragesMethod.addStatement("m_" + fieldPair.second.Name + ".sync()");
+    }
+
+    syncStoragesMethod.commit();
+
+    if(std::any_of(stencil.getChildren().begin(), stencil.getChildren().end(),
+                   [&](const auto& multiStagePtr) { return isVectorized(*multiStagePtr); })) {
+      // Select without branches, both values are evaluated
+      MemberFunction selectMethod = stencilClass.addMemberFunction(
+          "static typename std::common_type<T, U>::type", "simd_select", "typename T, typename U");
+      selectMethod.addArg("bool mask");
+      selectMethod.addArg("T trueValue");
+      selectMethod.addArg("U falseValue");
+      selectMethod.startBody();
+      selectMethod.addStatement("return mask ? trueValue : falseValue");
+      selectMethod.commit();
+
+      // Align a pointer to the next cache line
+      MemberFunction alignMethod =
+          stencilClass.addMemberFunction("static " + c_gtc() + "float_type*", "simd_align");
+      alignMethod.addArg(c_gtc() + "float_type* ptr");
+      alignMethod.startBody();
+      alignMethod.addStatement("return reinterpret_cast<" + c_gtc() +
+                               "float_type*>((reinterpret_cast<std::uintptr_t>(ptr) + 63) & "
+                               "~std::uintptr_t(63))");
+      alignMethod.commit();
+    }
+
+    //
+    // Run-Method
+    //
+    MemberFunction stencilRunMethod = stencilClass.addMemberFunction("virtual void", "run", "");
+    for(auto it = nonTempFields.begin(); it != nonTempFields.end(); ++it) {
+      std::string type = stencilProperties->paramNameToType_.at((*it).second.Name);
+      stencilRunMethod.addArg(type + "& " + (*it).second.Name + "_");
+    }
+
+    stencilRunMethod.startBody();
+
+    stencilRunMethod.addStatement("sync_storages()");
+    for(const auto& multiStagePtr : stencil.getChildren()) {
+
+      stencilRunMethod.ss() << "{";
+
+      const iir::MultiStage& multiStage = *multiStagePtr;
+      const iir::LoopOrderKind loopOrder = multiStage.getLoopOrder();
+
+      // create the data views of the storages shared by all threads
+      for(auto it = nonTempFields.begin(); it != nonTempFields.end(); ++it) {
+        const auto fieldName = (*it).second.Name;
+        std::string type = stencilProperties->paramNameToType_.at(fieldName);
+        stencilRunMethod.addStatement(c_gt() + "data_view<" + type + "> " + fieldName + "= " +
+                                      c_gt() + "make_host_view(m_" + fieldName + ")");
+        stencilRunMethod.addStatement("std::array<int,3> " + fieldName + "_offsets{0,0,0}");
+      }
+      for(const auto& fieldPair : tempFields) {
+        const auto fieldName = fieldPair.second.Name;
+        stencilRunMethod.addStatement(c_gt() + "data_view<tmp_storage_t> " + fieldName + "= " +
+                                      c_gt() + "make_host_view(m_" + fieldName + ")");
+        stencilRunMethod.addStatement("std::array<int,3> " + fieldName + "_offsets{0,0,0}");
+      }
+
+      // The block storages cover the union of the extents of the stages
+      iir::Extents extents(0, 0, 0, 0, 0, 0);
+      for(const auto& stagePtr : multiStage.getChildren())
+        extents.merge(stagePtr->getExtents());
+
+      std::vector<std::string> multiStageBlockTemporaries;
+      std::set<std::string> multiStageIJCachedTemporaries;
+      for(const auto& fieldPair : stencilFields) {
+        if(blockTemporaries.count(fieldPair.first) &&
+           multiStage.getFields().count(fieldPair.first)) {
+          multiStageBlockTemporaries.push_back(fieldPair.second.Name);
+          if(ijCachedTemporaries.count(fieldPair.first))
+            multiStageIJCachedTemporaries.insert(fieldPair.second.Name);
+        }
+      }
+
+      // Raw pointers to the origin of the storages and their strides
+      const bool vectorize = isVectorized(multiStage);
+      if(vectorize) {
+        std::vector<std::string> unitStrideConditions;
+        for(const auto& fieldPair : stencilFields) {
+          if(blockTemporaries.count(fieldPair.first) ||
+             !multiStage.getFields().count(fieldPair.first))
+            continue;
+          const std::string fieldName = fieldPair.second.Name;
+          stencilRunMethod.addStatement(c_gtc() + "float_type* const __restrict__ " + fieldName +
+                                        "_ptr = " + fieldName + ".data() + m_" + fieldName +
+                                        ".get_storage_info_ptr()->index(0, 0, 0)");
+          for(int dim = 0; dim < 3; ++dim)
+            stencilRunMethod.addStatement("const int " + fieldName + "_s" + "ijk"[dim] + " = m_" +
+                                          fieldName + ".get_storage_info_ptr()->template stride<" +
+                                          std::to_string(dim) + ">()");
+          unitStrideConditions.push_back(fieldName + "_si == 1");
+        }
+        stencilRunMethod.addStatement(
+            "const bool unitStrideI = " +
+            (unitStrideConditions.empty() ? std::string("true")
+                                          : RangeToString(" && ", "", "")(unitStrideConditions)));
+      }
+
+      stencilRunMethod.addStatement("const int iMin = m_dom.iminus()");
+      stencilRunMethod.addStatement("const int iMax = m_dom.isize() - m_dom.iplus() - 1");
+      stencilRunMethod.addStatement("const int jMin = m_dom.jminus()");
+      stencilRunMethod.addStatement("const int jMax = m_dom.jsize() - m_dom.jplus() - 1");
+      stencilRunMethod.addStatement("const int numBlocksI = (iMax - iMin + " + blockSizeI + ") / " +
+                                    blockSizeI);
+      stencilRunMethod.addStatement("const int numBlocksJ = (jMax - jMin + " + blockSizeJ + ") / " +
+                                    blockSizeJ);
+      if(loopOrder == iir::LoopOrderKind::LK_Parallel) {
+        stencilRunMethod.addStatement(
+            "const int numBlocksK = (" +
+            makeIntervalBound("m_dom", iir::Interval(0, sir::Interval::End),
+                              iir::Interval::Bound::upper) +
+            " + " + blockSizeK + ") / " + blockSizeK);
+      }
+
+      auto intervals_set = multiStage.getIntervals();
+      std::vector<iir::Interval> intervals_v;
+      std::copy(intervals_set.begin(), intervals_set.end(), std::back_inserter(intervals_v));
+
+      // compute the partition of the intervals
+      auto partitionIntervals = iir::Interval::computePartition(intervals_v);
+      if(loopOrder == iir::LoopOrderKind::LK_Backward)
+        std::reverse(partitionIntervals.begin(), partitionIntervals.end());
+
+      // Generate the loops over the points of a stage in the block at level k: the i-loops of
+      // unit stride storages are vectorized, the points which do not fill a whole vector are
+      // computed by a scalar remainder loop
+      auto generateVectorizedStage = [&](const iir::Stage& stage, const iir::Interval& interval) {
+        const iir::Extents& stageExtents = stage.getExtents();
+        const std::string width = std::to_string(simdWidth_);
+        const std::string jLoop =
+            makeLoopImpl(stageExtents[1], "j", "jStart", "jEnd", "<=", "++");
+
+        auto generateStatements = [&]() {
+          for(const auto& doMethodPtr : stage.getChildren()) {
+            if(!doMethodPtr->getInterval().overlaps(interval))
+              continue;
+            for(const auto& statementAccessesPair : doMethodPtr->getChildren()) {
+              statementAccessesPair->getStatement()->accept(stencilBodySIMDVisitor);
+              stencilRunMethod << stencilBodySIMDVisitor.getCodeAndResetStream();
+            }
+          }
+        };
+
+        stencilRunMethod.addBlockStatement("if(unitStrideI)", [&]() {
+          stencilBodySIMDVisitor.setUnitStrideI(true);
+          stencilRunMethod.addBlockStatement(jLoop, [&]() {
+            stencilRunMethod.addStatement("const int iFirst = iStart + " +
+                                          std::to_string(stageExtents[0].Minus));
+            stencilRunMethod.addStatement("const int iLast = iEnd + " +
+                                          std::to_string(stageExtents[0].Plus));
+            stencilRunMethod.addStatement("const int iPeel = iFirst + (iLast - iFirst + 1) / " +
+                                          width + " * " + width);
+            stencilRunMethod.addBlockStatement(
+                "for(int iVec = iFirst; iVec < iPeel; iVec += " + width + ")", [&]() {
+                  stencilRunMethod.addPreprocessorDirective("pragma omp simd");
+                  stencilRunMethod.addBlockStatement(
+                      "for(int i = iVec; i < iVec + " + width + "; ++i)", generateStatements);
+                });
+            stencilRunMethod.addBlockStatement("for(int i = iPeel; i <= iLast; ++i)",
+                                               generateStatements);
+          });
+        });
+        stencilRunMethod.addBlockStatement("else", [&]() {
+          stencilBodySIMDVisitor.setUnitStrideI(false);
+          stencilRunMethod.addBlockStatement(jLoop, [&]() {
+            stencilRunMethod.addBlockStatement(
+                makeLoopImpl(stageExtents[0], "i", "iStart", "iEnd", "<=", "++"),
+                generateStatements);
+          });
+        });
+      };
+
+      // Generate the sweep of a forward or backward multi-stage over the columns of the block in
+      // batches of `simdWidth` columns, the levels accessed through the k-caches are kept in local
+      // ring buffers of the batch
+      KCacheCodeGen kCacheCodeGen(multiStage, stencilInstantiation->getMetaData(),
+                                  stencilBodySIMDVisitor, simdWidth_);
+      const bool useKCaches = vectorize && KCacheCodeGen::isApplicable(multiStage);
+
+      auto generateKCachedColumns = [&]() {
+        const std::string width = std::to_string(simdWidth_);
+        stencilRunMethod.addBlockStatement("for(int j = jStart; j <= jEnd; ++j)", [&]() {
+          stencilRunMethod.addBlockStatement(
+              "for(int iVec = iStart; iVec <= iEnd; iVec += " + width + ")", [&]() {
+                stencilRunMethod.addStatement("const int numLanes = std::min(" + width +
+                                              ", iEnd - iVec + 1)");
+                kCacheCodeGen.generateKCacheDecl(stencilRunMethod);
+
+                for(auto interval : partitionIntervals) {
+                  kCacheCodeGen.generatePreFillKCaches(stencilRunMethod, interval);
+
+                  stencilRunMethod.addBlockStatement(
+                      makeKLoop("m_dom", loopOrder, interval, blockSize[2]), [&]() {
+                        kCacheCodeGen.generateFillKCaches(stencilRunMethod, interval);
+
+                        for(const auto& stagePtr : multiStage.getChildren()) {
+                          const iir::Stage& stage = *stagePtr;
+                          if(std::none_of(stage.getChildren().begin(), stage.getChildren().end(),
+                                          [&](const auto& doMethodPtr) {
+                                            return doMethodPtr->getInterval().overlaps(interval);
+                                          }))
+                            continue;
+
+                          kCacheCodeGen.generateLaneLoop(stencilRunMethod, [&]() {
+                            for(const auto& doMethodPtr : stage.getChildren()) {
+                              if(!doMethodPtr->getInterval().overlaps(interval))
+                                continue;
+                              for(const auto& statementAccessesPair : doMethodPtr->getChildren()) {
+                                statementAccessesPair->getStatement()->accept(
+                                    stencilBodySIMDVisitor);
+                                stencilRunMethod << stencilBodySIMDVisitor.getCodeAndResetStream();
+                              }
+                            }
+                          });
+                        }
+
+                        kCacheCodeGen.generateFlushKCaches(stencilRunMethod, interval,
+                                                           iir::Cache::CacheIOPolicy::flush);
+                        kCacheCodeGen.generateFlushKCaches(
+                            stencilRunMethod, interval, iir::Cache::CacheIOPolicy::fill_and_flush);
+                        kCacheCodeGen.generateKCacheSlide(stencilRunMethod, interval);
+                      });
+
+                  kCacheCodeGen.generateFinalFlushKCaches(
+                      stencilRunMethod, interval, iir::Cache::CacheIOPolicy::fill_and_flush);
+                  kCacheCodeGen.generateFinalFlushKCaches(stencilRunMethod, interval,
+                                                          iir::Cache::CacheIOPolicy::flush);
+                  kCacheCodeGen.generateFinalFlushKCaches(stencilRunMethod, interval,
+                                                          iir::Cache::CacheIOPolicy::epflush);
+                }
+              });
+        });
+      };
+
+      // Generate the loops over the levels and stages of one block
+      auto generateBlock = [&]() {
+        stencilRunMethod.addStatement("const int iStart = iMin + iBlock * " + blockSizeI);
+        stencilRunMethod.addStatement("const int iEnd = std::min(iStart + " + blockSizeI +
+                                      " - 1, iMax)");
+        stencilRunMethod.addStatement("const int jStart = jMin + jBlock * " + blockSizeJ);
+        stencilRunMethod.addStatement("const int jEnd = std::min(jStart + " + blockSizeJ +
+                                      " - 1, jMax)");
+        if(vectorize && !multiStageBlockTemporaries.empty()) {
+          stencilRunMethod.addStatement("const int blockOriginI = iStart + " +
+                                        std::to_string(extents[0].Minus));
+          stencilRunMethod.addStatement("const int blockOriginJ = jStart + " +
+                                        std::to_string(extents[1].Minus));
+        }
+        for(const auto& fieldName : multiStageBlockTemporaries) {
+          if(vectorize)
+            continue;
+          stencilRunMethod.addStatement(fieldName + "_offsets[0] = " +
+                                        std::to_string(-extents[0].Minus) + " - iStart");
+          stencilRunMethod.addStatement(fieldName + "_offsets[1] = " +
+                                        std::to_string(-extents[1].Minus) + " - jStart");
+        }
+
+        if(useKCaches) {
+          stencilBodySIMDVisitor.setKCaches(kCacheCodeGen.getKCacheCenterOffsets());
+          stencilRunMethod.addBlockStatement("if(unitStrideI)", [&]() {
+            stencilBodySIMDVisitor.setUnitStrideI(true);
+            generateKCachedColumns();
+          });
+          stencilRunMethod.addBlockStatement("else", [&]() {
+            stencilBodySIMDVisitor.setUnitStrideI(false);
+            generateKCachedColumns();
+          });
+          stencilBodySIMDVisitor.setKCaches({});
+          return;
+        }
+
+        for(auto interval : partitionIntervals) {
+          stencilRunMethod.addBlockStatement(
+              makeKLoop("m_dom", loopOrder, interval, blockSize[2]), [&]() {
+                for(const auto& stagePtr : multiStage.getChildren()) {
+                  const iir::Stage& stage = *stagePtr;
+                  if(std::none_of(stage.getChildren().begin(), stage.getChildren().end(),
+                                  [&](const auto& doMethodPtr) {
+                                    return doMethodPtr->getInterval().overlaps(interval);
+                                  }))
+                    continue;
+
+                  if(vectorize) {
+                    generateVectorizedStage(stage, interval);
+                    continue;
+                  }
+
+                  stencilRunMethod.addBlockStatement(
+                      makeLoopImpl(stage.getExtents()[0], "i", "iStart", "iEnd", "<=", "++"),
+                      [&]() {
+                        stencilRunMethod.addBlockStatement(
+                            makeLoopImpl(stage.getExtents()[1], "j", "jStart", "jEnd", "<=", "++"),
+                            [&]() {
+                              // Generate Do-Method
+                              for(const auto& doMethodPtr : stage.getChildren()) {
+                                const iir::DoMethod& doMethod = *doMethodPtr;
+                                if(!doMethod.getInterval().overlaps(interval))
+                                  continue;
+                                for(const auto& statementAccessesPair : doMethod.getChildren()) {
+                                  statementAccessesPair->getStatement()->accept(
+                                      stencilBodyCXXVisitor);
+                                  stencilRunMethod << stencilBodyCXXVisitor.getCodeAndResetStream();
+                                }
+                              }
+                            });
+                      });
+                }
+              });
+        }
+      };
+
+      stencilRunMethod.addPreprocessorDirective("pragma omp parallel");
+      stencilRunMethod.addBlockStatement("", [&]() {
+        // Storages of the temporaries of the block computed by this thread
+        if(vectorize && !multiStageBlockTemporaries.empty()) {
+          // The rows are padded to a multiple of the vector width and start at cache line
+          // boundaries
+          const int rowSize = blockSize[0] + extents[0].Plus - extents[0].Minus;
+          const int vhalo = getVerticalTmpHaloSize(stencil);
+          stencilRunMethod.addStatement(
+              "constexpr int blockStrideJ = " +
+              std::to_string((rowSize + simdWidth_ - 1) / simdWidth_ * simdWidth_));
+          stencilRunMethod.addStatement(
+              "constexpr int blockStrideK = blockStrideJ * " +
+              std::to_string(blockSize[1] + extents[1].Plus - extents[1].Minus));
+          for(const auto& fieldName : multiStageBlockTemporaries) {
+            if(multiStageIJCachedTemporaries.count(fieldName)) {
+              stencilRunMethod.addStatement("std::vector<" + c_gtc() + "float_type> block_" +
+                                            fieldName + "(blockStrideK + 64 / sizeof(" + c_gtc() +
+                                            "float_type))");
+              stencilRunMethod.addStatement(c_gtc() + "float_type* const __restrict__ " +
+                                            fieldName + "_ptr = simd_align(block_" + fieldName +
+                                            ".data())");
+              continue;
+            }
+            stencilRunMethod.addStatement(
+                "std::vector<" + c_gtc() + "float_type> block_" + fieldName +
+                "(blockStrideK * (m_dom.ksize() + 2*" + std::to_string(vhalo) + ") + 64 / sizeof(" +
+                c_gtc() + "float_type))");
+            stencilRunMethod.addStatement(c_gtc() + "float_type* const __restrict__ " + fieldName +
+                                          "_ptr = simd_align(block_" + fieldName + ".data()) + " +
+                                          std::to_string(vhalo) + " * blockStrideK");
+          }
+        } else if(!multiStageBlockTemporaries.empty()) {
+          const std::string blockSizeIJ =
+              blockSizeI + " + " + std::to_string(extents[0].Plus - extents[0].Minus) + ", " +
+              blockSizeJ + " + " + std::to_string(extents[1].Plus - extents[1].Minus);
+          if(multiStageIJCachedTemporaries.size() != multiStageBlockTemporaries.size())
+            stencilRunMethod.addStatement(tmpMetadataTypename_ + " block_meta_data(" + blockSizeIJ +
+                                          ", m_dom.ksize() + 2*" +
+                                          std::to_string(getVerticalTmpHaloSize(stencil)) + ")");
+          if(!multiStageIJCachedTemporaries.empty())
+            stencilRunMethod.addStatement(tmpMetadataTypename_ + " block_ij_meta_data(" +
+                                          blockSizeIJ + ", 1)");
+          for(const auto& fieldName : multiStageBlockTemporaries) {
+            stencilRunMethod.addStatement(
+                tmpStorageTypename_ + " block_" + fieldName + "(" +
+                (multiStageIJCachedTemporaries.count(fieldName) ? "block_ij_meta_data"
+                                                                : "block_meta_data") +
+                ")");
+            stencilRunMethod.addStatement(c_gt() + "data_view<tmp_storage_t> " + fieldName +
+                                          "= " + c_gt() + "make_host_view(block_" + fieldName +
+                                          ")");
+            stencilRunMethod.addStatement("std::array<int,3> " + fieldName + "_offsets{0,0,0}");
+          }
+        }
+
+        if(loopOrder == iir::LoopOrderKind::LK_Parallel) {
+          stencilRunMethod.addPreprocessorDirective("pragma omp for collapse(3) schedule(static)");
+          stencilRunMethod.addBlockStatement(
+              "for(int kBlock = 0; kBlock < numBlocksK; ++kBlock)", [&]() {
+                stencilRunMethod.addBlockStatement(
+                    "for(int jBlock = 0; jBlock < numBlocksJ; ++jBlock)", [&]() {
+                      stencilRunMethod.addBlockStatement(
+                          "for(int iBlock = 0; iBlock < numBlocksI; ++iBlock)", generateBlock);
+                    });
+              });
+        } else {
+          // The levels of forward and backward multi-stages depend on each other, the blocks
+          // only run in parallel in the horizontal
+          stencilRunMethod.addPreprocessorDirective("pragma omp for collapse(2) schedule(static)");
+          stencilRunMethod.addBlockStatement(
+              "for(int jBlock = 0; jBlock < numBlocksJ; ++jBlock)", [&]() {
+                stencilRunMethod.addBlockStatement(
+                    "for(int iBlock = 0; iBlock < numBlocksI; ++iBlock)", generateBlock);
+              });
+        }
+      });
+      stencilRunMethod.ss() << "}";
+    }
+    stencilRunMethod.addStatement("sync_storages()");
+    stencilRunMethod.commit();
+  }
+}
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
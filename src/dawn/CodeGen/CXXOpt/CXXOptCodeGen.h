@@ -0,0 +1,70 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_CODEGEN_CXXOPT_CXXOPTCODEGEN_H
+#define DAWN_CODEGEN_CXXOPT_CXXOPTCODEGEN_H
+
+#include "dawn/CodeGen/CXXNaive/CXXNaiveCodeGen.h"
+
+namespace dawn {
+namespace codegen {
+namespace cxxopt {
+
+/// @brief Optimized, OpenMP parallel C++ code generation for the gridtools_clang DSL
+///
+/// The stencil wrappers, stencil functions and storages are the ones of the naive C++ backend. The
+/// multi-stages are executed differently:
+///
+///   - The compute domain is split into blocks in i and j (of the size set by `PassSetBlockSize`)
+///     which are distributed over the threads of an OpenMP parallel region. Each block computes its
+///     stages on the block extended by the extents of the stage (see `PassComputeStageExtents`),
+///     i.e the halo of a block is computed redundantly instead of synchronizing the threads.
+///   - Parallel multi-stages are additionally split into blocks in k, forward and backward
+///     multi-stages sweep over all the levels of a block.
+///   - Temporaries which are only accessed within a single multi-stage are allocated per thread
+///     with the size of a block instead of the full domain.
+///   - The IJ-cached temporaries among them (see `PassSetCaches`) only hold the level which is
+///     computed, i.e the stages exchange them through a single plane of the block which stays in the
+///     L1 cache for the block sizes chosen by `PassSetBlockSize` for CPUs.
+///   - If `simdWidth` is positive, the multi-stages which do not call stencil functions access the
+///     fields through raw pointers and their innermost i-loops are vectorized with
+///     `#pragma omp simd` in chunks of `simdWidth` points (see `ASTStencilBodySIMD`). The block
+///     temporaries are then allocated with padded, cache line aligned rows.
+///   - If additionally a forward or backward multi-stage has k-caches, it sweeps over batches of
+///     `simdWidth` columns and keeps the cached levels in local ring buffers (see `KCacheCodeGen`).
+///
+/// @ingroup cxxopt
+class CXXOptCodeGen : public cxxnaive::CXXNaiveCodeGen {
+public:
+  CXXOptCodeGen(stencilInstantiationContext& ctx, DiagnosticsEngine& engine, int maxHaloPoint,
+                int simdWidth);
+  virtual ~CXXOptCodeGen();
+
+protected:
+  virtual std::string getBackendNamespace() const override { return "cxxopt"; }
+
+  virtual void
+  generateStencilClasses(const std::shared_ptr<iir::StencilInstantiation> stencilInstantiation,
+                         Class& stencilWrapperClass,
+                         const CodeGenProperties& codeGenProperties) const override;
+
+private:
+  int simdWidth_;
+};
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
+
+#endif
@@ -0,0 +1,528 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/CXXOpt/KCacheCodeGen.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/LoopOrder.h"
+#include "dawn/IIR/StencilMetaInformation.h"
+#include "dawn/Support/Assert.h"
+#include "dawn/Support/Unreachable.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+
+namespace dawn {
+namespace codegen {
+namespace cxxopt {
+
+KCacheCodeGen::KCacheCodeGen(const iir::MultiStage& ms, const iir::StencilMetaInformation& metadata,
+                             const ASTStencilBodySIMD& stencilBodyVisitor, int simdWidth)
+    : ms_(ms), metadata_(metadata), stencilBodyVisitor_(stencilBodyVisitor),
+      simdWidth_(simdWidth) {}
+
+bool KCacheCodeGen::isApplicable(const iir::MultiStage& ms) {
+  if(ms.getLoopOrder() == iir::LoopOrderKind::LK_Parallel)
+    return false;
+
+  if(std::none_of(ms.getCaches().begin(), ms.getCaches().end(), [](const auto& cachePair) {
+       return cachePair.second.getCacheType() == iir::Cache::CacheTypeKind::K;
+     }))
+    return false;
+
+  // The ring buffers of a batch of columns can not provide the neighbouring columns
+  for(const auto& stagePtr : ms.getChildren()) {
+    const iir::Extents& extents = stagePtr->getExtents();
+    if(extents[0].Minus != 0 || extents[0].Plus != 0 || extents[1].Minus != 0 ||
+       extents[1].Plus != 0)
+      return false;
+  }
+  return true;
+}
+
+std::unordered_map<int, int> KCacheCodeGen::getKCacheCenterOffsets() const {
+  std::unordered_map<int, int> centerOffsets;
+  for(const auto& cachePair : ms_.getCaches()) {
+    const iir::Cache& cache = cachePair.second;
+    if(cache.getCacheType() != iir::Cache::CacheTypeKind::K)
+      continue;
+    const int accessID = cache.getCachedFieldAccessID();
+    centerOffsets.emplace(accessID, getKCacheIndex(accessID, 0));
+  }
+  return centerOffsets;
+}
+
+void KCacheCodeGen::generateLaneLoop(MemberFunction& function,
+                                     const std::function<void()>& body) const {
+  function.addPreprocessorDirective("pragma omp simd");
+  function.addBlockStatement("for(int i = iVec; i < iVec + numLanes; ++i)", body);
+}
+
+void KCacheCodeGen::generateKCacheDecl(MemberFunction& function) const {
+  for(const auto& cachePair : ms_.getOrderedCaches()) {
+    const iir::Cache& cache = cachePair.second;
+    if(cache.getCacheType() != iir::Cache::CacheTypeKind::K)
+      continue;
+
+    const int accessID = cache.getCachedFieldAccessID();
+    auto vertExtent = ms_.getKCacheVertExtent(accessID);
+
+    function.addStatement(c_gtc() + "float_type " + metadata_.getFieldNameFromAccessID(accessID) +
+                          "_kcache[" + std::to_string(-vertExtent.Minus + vertExtent.Plus + 1) +
+                          "][" + std::to_string(simdWidth_) + "]");
+  }
+}
+
+std::string
+KCacheCodeGen::makeIntervalLevelBound(const std::string dom,
+                                      iir::Interval::IntervalLevel const& intervalLevel) {
+  return intervalLevel.isEnd() ? "( " + dom + ".ksize() == 0 ? 0 : (" + dom + ".ksize() - " + dom +
+                                     ".kplus() - 1)) + " + std::to_string(intervalLevel.offset_)
+                               : std::to_string(intervalLevel.bound());
+}
+
+std::string KCacheCodeGen::kBegin(const std::string dom, iir::Interval const& interval) const {
+  return (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+             ? makeIntervalLevelBound(dom, interval.upperIntervalLevel())
+             : makeIntervalLevelBound(dom, interval.lowerIntervalLevel());
+}
+
+std::string KCacheCodeGen::kEnd(const std::string dom, iir::Interval const& interval) const {
+  return (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+             ? "(" + makeIntervalLevelBound(dom, interval.lowerIntervalLevel()) + ") - 1"
+             : "(" + makeIntervalLevelBound(dom, interval.upperIntervalLevel()) + ") + 1";
+}
+
+bool KCacheCodeGen::requiresFill(const iir::Cache& cache) {
+  return ((cache.getCacheIOPolicy() == iir::Cache::CacheIOPolicy::fill) ||
+          (cache.getCacheIOPolicy() == iir::Cache::CacheIOPolicy::bpfill) ||
+          (cache.getCacheIOPolicy() == iir::Cache::CacheIOPolicy::fill_and_flush));
+}
+
+int KCacheCodeGen::getKCacheIndex(const int accessID, const int offset) const {
+  return -ms_.getKCacheVertExtent(accessID).Minus + offset;
+}
+
+void KCacheCodeGen::generateKCacheFillStatement(MemberFunction& function,
+                                                const KCacheProperties& kcacheProp,
+                                                int klev) const {
+  function.addStatement(kcacheProp.name_ + "[" +
+                        std::to_string(getKCacheIndex(kcacheProp.accessID_, klev)) +
+                        "][i - iVec] = " +
+                        stencilBodyVisitor_.getFieldAccess(kcacheProp.accessID_, {0, 0, klev}));
+}
+
+iir::MultiInterval
+KCacheCodeGen::intervalNotPreviouslyAccessed(const int accessID,
+                                             const iir::Interval& targetInterval,
+                                             const iir::Interval& queryInterval) const {
+  iir::MultiInterval res{targetInterval};
+
+  auto intervals_set = ms_.getIntervals();
+  std::vector<iir::Interval> intervals_v;
+  std::copy(intervals_set.begin(), intervals_set.end(), std::back_inserter(intervals_v));
+  auto partitionIntervals = iir::Interval::computePartition(intervals_v);
+  if(ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+    std::reverse(partitionIntervals.begin(), partitionIntervals.end());
+
+  for(const auto& aInterval : partitionIntervals) {
+    // we only need to check intervals that were computed before the current interval of execution
+    if(aInterval.overlaps(queryInterval)) {
+      break;
+    }
+    for(auto const& doMethod : iterateIIROver<iir::DoMethod>(ms_)) {
+      if(!doMethod->getInterval().overlaps(aInterval)) {
+        continue;
+      }
+      if(!doMethod->hasField(accessID)) {
+        continue;
+      }
+      auto doMethodInterval = doMethod->getInterval().intersect(aInterval);
+      const auto& field = doMethod->getField(accessID);
+      auto accessedInterval = doMethodInterval.extendInterval(field.getExtents()[2]);
+
+      if(accessedInterval.overlaps(targetInterval)) {
+        res.substract(accessedInterval);
+      }
+    }
+  }
+  return res;
+}
+
+void KCacheCodeGen::generatePreFillKCaches(MemberFunction& function,
+                                           const iir::Interval& interval) const {
+  // the algorithm consists of two parts:
+  // 1) identify all the caches that require a prefill for each of the intervals of the partition.
+  //    Insert into kCacheProperty
+  // 2) generation of the prefill code for all cache/intervals in KCacheProperty
+  std::vector<KCacheProperties> kCacheProperty;
+
+  for(const auto& cachePair : ms_.getOrderedCaches()) {
+    const int accessID = cachePair.first;
+    const auto& cache = cachePair.second;
+    if(cache.getCacheType() != iir::Cache::CacheTypeKind::K || !requiresFill(cache))
+      continue;
+
+    // for a pre-fill operation, we dont take into account the extent over the whole ms (i.e. all
+    // intervals) but rather the current interval, which is the first in full vertical iteration.
+    // This is because extents in the inner part of the vertical iteration can be larger, and if
+    // applied at the intervals on the bounds of the iteration, they can generate out of bound
+    // accesses
+    auto extents = ms_.computeExtents(accessID, interval);
+    if(!extents.is_initialized()) {
+      continue;
+    }
+    auto intervalVertExtent = (*extents)[2];
+
+    DAWN_ASSERT(cache.getInterval().is_initialized());
+
+    // if only one level is accessed (the head of the cache) this level will be provided by the fill
+    // operation
+    if(intervalVertExtent.Minus == intervalVertExtent.Plus)
+      continue;
+
+    // check the interval of levels accessed beyond the iteration interval. This will mark all the
+    // levels of the kcache that will be accessed but are not filled (they will have to be
+    // prefilled) at the beginning of the processing of the interval
+    auto outOfRangeAccessedInterval =
+        (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+            ? interval.crop(iir::Interval::Bound::upper,
+                            // the last level of Minus if not required since will be filled by the
+                            // head fill method
+                            {intervalVertExtent.Minus + 1, intervalVertExtent.Plus})
+            : interval.crop(iir::Interval::Bound::lower,
+                            // the last level of Plus if not required since will be filled by the
+                            // head fill method
+                            {intervalVertExtent.Minus, intervalVertExtent.Plus - 1});
+
+    /// we check if the levels beyond the iteration interval are filled already by the processing of
+    /// previous intervals
+    auto notYetAccessedInterval =
+        intervalNotPreviouslyAccessed(accessID, outOfRangeAccessedInterval, interval);
+    if(!notYetAccessedInterval.empty()) {
+      // if the outOfRangeAccessInterval has not been accessed (and therefore filled in the cache)
+      // by the processing of a previous interval we need to add a prefill action
+      auto firstInterval = notYetAccessedInterval.getIntervals()[0];
+      auto lastInterval =
+          notYetAccessedInterval.getIntervals()[notYetAccessedInterval.numPartitions() - 1];
+
+      iir::Interval preFillInterval(firstInterval.lowerLevel(), lastInterval.upperLevel(),
+                                    firstInterval.lowerOffset(), lastInterval.upperOffset());
+
+      auto preFillMarkLevel = (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+                                  ? interval.upperIntervalLevel()
+                                  : interval.lowerIntervalLevel();
+
+      iir::Extent preFillExtent{
+          iir::distance(preFillMarkLevel, preFillInterval.lowerIntervalLevel()).value,
+          iir::distance(preFillMarkLevel, preFillInterval.upperIntervalLevel()).value};
+
+      kCacheProperty.emplace_back(metadata_.getFieldNameFromAccessID(accessID) + "_kcache",
+                                  accessID, preFillExtent);
+    }
+  }
+
+  if(kCacheProperty.empty())
+    return;
+
+  function.addComment("Pre-fill of kcaches");
+  function.addBlockStatement("", [&]() {
+    function.addStatement("const int k = " + kBegin("m_dom", interval));
+    generateLaneLoop(function, [&]() {
+      for(const auto& kcacheProp : kCacheProperty) {
+        if(ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward) {
+          for(int klev = kcacheProp.intervalVertExtent_.Minus;
+              klev <= kcacheProp.intervalVertExtent_.Plus; ++klev) {
+            generateKCacheFillStatement(function, kcacheProp, klev);
+          }
+        } else {
+          for(int klev = kcacheProp.intervalVertExtent_.Plus;
+              klev >= kcacheProp.intervalVertExtent_.Minus; --klev) {
+            generateKCacheFillStatement(function, kcacheProp, klev);
+          }
+        }
+      }
+    });
+  });
+}
+
+void KCacheCodeGen::generateFillKCaches(MemberFunction& function,
+                                        const iir::Interval& interval) const {
+  std::vector<KCacheProperties> kCacheProperty;
+
+  for(const auto& cachePair : ms_.getOrderedCaches()) {
+    const int accessID = cachePair.first;
+    const auto& cache = cachePair.second;
+    if(cache.getCacheType() != iir::Cache::CacheTypeKind::K || !requiresFill(cache))
+      continue;
+
+    DAWN_ASSERT(cache.getInterval().is_initialized());
+    const auto cacheInterval = *(cache.getInterval());
+    auto extents = ms_.computeExtents(accessID, interval);
+    if(!extents.is_initialized()) {
+      continue;
+    }
+
+    auto intervalVertExtent = (*extents)[2];
+
+    iir::Interval::Bound intervalBound = (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+                                             ? iir::Interval::Bound::lower
+                                             : iir::Interval::Bound::upper;
+
+    const bool cacheEndWithinInterval =
+        (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+            ? interval.bound(intervalBound) >= cacheInterval.bound(intervalBound)
+            : interval.bound(intervalBound) <= cacheInterval.bound(intervalBound);
+
+    if(cacheInterval.overlaps(interval) && cacheEndWithinInterval) {
+      kCacheProperty.emplace_back(metadata_.getFieldNameFromAccessID(accessID) + "_kcache",
+                                  accessID, intervalVertExtent);
+    }
+  }
+
+  if(kCacheProperty.empty())
+    return;
+
+  function.addComment("Head fill of kcaches");
+  generateLaneLoop(function, [&]() {
+    for(const auto& kcacheProp : kCacheProperty) {
+      int offset = (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+                       ? kcacheProp.intervalVertExtent_.Minus
+                       : kcacheProp.intervalVertExtent_.Plus;
+      generateKCacheFillStatement(function, kcacheProp, offset);
+    }
+  });
+}
+
+bool KCacheCodeGen::checkIfCacheNeedsToFlush(const iir::Cache& cache,
+                                             iir::Interval interval) const {
+  DAWN_ASSERT(cache.getInterval().is_initialized());
+
+  const iir::Interval& cacheInterval = *(cache.getInterval());
+  if(cache.getCacheIOPolicy() == iir::Cache::CacheIOPolicy::epflush) {
+    auto epflushWindowInterval = cache.getWindowInterval(
+        (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Forward) ? iir::Interval::Bound::upper
+                                                               : iir::Interval::Bound::lower);
+    return epflushWindowInterval.overlaps(interval);
+  } else {
+    return cacheInterval.contains(interval);
+  }
+}
+
+std::vector<KCacheCodeGen::KCacheProperties>
+KCacheCodeGen::buildKCacheProperties(const iir::Interval& interval,
+                                     const iir::Cache::CacheIOPolicy policy) const {
+  std::vector<KCacheProperties> kCacheProperty;
+
+  for(const auto& IDCachePair : ms_.getOrderedCaches()) {
+    const int accessID = IDCachePair.first;
+    const auto& cache = IDCachePair.second;
+
+    if(cache.getCacheType() != iir::Cache::CacheTypeKind::K ||
+       policy != cache.getCacheIOPolicy()) {
+      continue;
+    }
+    DAWN_ASSERT(policy != iir::Cache::CacheIOPolicy::local);
+    DAWN_ASSERT(cache.getInterval().is_initialized());
+    auto extents = ms_.computeExtents(accessID, interval);
+    if(!extents.is_initialized()) {
+      continue;
+    }
+
+    if(checkIfCacheNeedsToFlush(cache, interval)) {
+      kCacheProperty.emplace_back(metadata_.getFieldNameFromAccessID(accessID) + "_kcache",
+                                  accessID, (*extents)[2]);
+    }
+  }
+  return kCacheProperty;
+}
+
+void KCacheCodeGen::generateKCacheFlushStatement(MemberFunction& function, const int accessID,
+                                                 std::string cacheName, const int offset) const {
+  function.addStatement(stencilBodyVisitor_.getFieldAccess(accessID, {0, 0, offset}) + " = " +
+                        cacheName + "[" + std::to_string(getKCacheIndex(accessID, offset)) +
+                        "][i - iVec]");
+}
+
+void KCacheCodeGen::generateKCacheFlushBlockStatement(MemberFunction& function,
+                                                      const iir::Interval& interval,
+                                                      const KCacheProperties& kcacheProp,
+                                                      const int klev,
+                                                      std::string currentKLevel) const {
+  const int accessID = kcacheProp.accessID_;
+  const auto& cache = ms_.getCache(accessID);
+  const auto& cacheInterval = *(cache.getInterval());
+
+  int kcacheTailExtent = (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+                             ? kcacheProp.intervalVertExtent_.Plus
+                             : kcacheProp.intervalVertExtent_.Minus;
+
+  // we can not flush the cache beyond the interval where the field is accessed, since that would
+  // write un-initialized data back into main memory of the field. If the distance of the
+  // computation interval to the interval limits of the cache is larger than the tail of the
+  // kcache being flushed, we need to insert a conditional guard
+  auto dist = distance(cacheInterval, interval, ms_.getLoopOrder());
+  if(dist.rangeType_ != iir::IntervalDiff::RangeType::literal ||
+     std::abs(dist.value) >= std::abs(kcacheTailExtent)) {
+    generateKCacheFlushStatement(function, kcacheProp.accessID_, kcacheProp.name_, klev);
+  } else {
+    std::string intervalKBegin = kBegin("m_dom", cacheInterval);
+    std::string pred =
+        (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+            ? "if(" + intervalKBegin + " - (" + currentKLevel +
+                  ") >= " + std::to_string(std::abs(kcacheTailExtent)) + ")"
+            : "if(" + currentKLevel + " - (" + intervalKBegin +
+                  ") >= " + std::to_string(std::abs(kcacheTailExtent)) + ")";
+    function.addBlockStatement(pred, [&]() {
+      generateKCacheFlushStatement(function, kcacheProp.accessID_, kcacheProp.name_, klev);
+    });
+  }
+}
+
+void KCacheCodeGen::generateFlushKCaches(MemberFunction& function, const iir::Interval& interval,
+                                         iir::Cache::CacheIOPolicy policy) const {
+  auto kCacheProperty = buildKCacheProperties(interval, policy);
+  if(kCacheProperty.empty())
+    return;
+
+  function.addComment("Flush of kcaches");
+  generateLaneLoop(function, [&]() {
+    for(const auto& kcacheProp : kCacheProperty) {
+      // we flush the last level of the cache, that is determined by its size
+      int kcacheTailExtent = (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+                                 ? kcacheProp.intervalVertExtent_.Plus
+                                 : kcacheProp.intervalVertExtent_.Minus;
+
+      generateKCacheFlushBlockStatement(function, interval, kcacheProp, kcacheTailExtent, "k");
+    }
+  });
+}
+
+void KCacheCodeGen::generateKCacheSlide(MemberFunction& function,
+                                        const iir::Interval& interval) const {
+  std::vector<std::string> slides;
+  for(const auto& cachePair : ms_.getOrderedCaches()) {
+    const auto& cache = cachePair.second;
+    if(cache.getCacheType() != iir::Cache::CacheTypeKind::K)
+      continue;
+    auto cacheInterval = cache.getInterval();
+    DAWN_ASSERT(cacheInterval.is_initialized());
+    if(!(*cacheInterval).overlaps(interval)) {
+      continue;
+    }
+
+    const int accessID = cache.getCachedFieldAccessID();
+    auto vertExtent = ms_.getKCacheVertExtent(accessID);
+    auto cacheName = metadata_.getFieldNameFromAccessID(accessID) + "_kcache";
+
+    for(int i = 0; i < -vertExtent.Minus + vertExtent.Plus; ++i) {
+      if(ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward) {
+        int maxCacheIdx = -vertExtent.Minus + vertExtent.Plus;
+        slides.push_back(cacheName + "[" + std::to_string(maxCacheIdx - i) + "][i - iVec] = " +
+                         cacheName + "[" + std::to_string(maxCacheIdx - i - 1) + "][i - iVec]");
+      } else {
+        slides.push_back(cacheName + "[" + std::to_string(i) + "][i - iVec] = " + cacheName + "[" +
+                         std::to_string(i + 1) + "][i - iVec]");
+      }
+    }
+  }
+
+  if(slides.empty())
+    return;
+
+  function.addComment("Slide kcaches");
+  generateLaneLoop(function, [&]() {
+    for(const auto& slide : slides)
+      function.addStatement(slide);
+  });
+}
+
+void KCacheCodeGen::generateFinalFlushKCaches(MemberFunction& function,
+                                              const iir::Interval& interval,
+                                              const iir::Cache::CacheIOPolicy policy) const {
+  DAWN_ASSERT((policy == iir::Cache::CacheIOPolicy::epflush) ||
+              (policy == iir::Cache::CacheIOPolicy::flush) ||
+              (policy == iir::Cache::CacheIOPolicy::fill_and_flush));
+  // levels to flush of each cache, relative to the iterator after the k-loop
+  std::vector<std::pair<KCacheProperties, std::vector<int>>> flushLevels;
+  for(const auto& kcacheProp : buildKCacheProperties(interval, policy)) {
+    const int accessID = kcacheProp.accessID_;
+    const auto& cache = ms_.getCache(accessID);
+    DAWN_ASSERT((cache.getInterval().is_initialized()));
+
+    int kcacheTailExtent;
+    if((policy == iir::Cache::CacheIOPolicy::flush) ||
+       (policy == iir::Cache::CacheIOPolicy::fill_and_flush)) {
+      kcacheTailExtent = (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+                             ? kcacheProp.intervalVertExtent_.Plus
+                             : kcacheProp.intervalVertExtent_.Minus;
+    } else if(policy == iir::Cache::CacheIOPolicy::epflush) {
+      DAWN_ASSERT(cache.getWindow().is_initialized());
+      auto intervalToFlush =
+          cache
+              .getWindowInterval((ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+                                     ? iir::Interval::Bound::lower
+                                     : iir::Interval::Bound::upper)
+              .intersect(interval);
+      auto distance_ = iir::distance(intervalToFlush.lowerIntervalLevel(),
+                                     intervalToFlush.upperIntervalLevel()) +
+                       1;
+      DAWN_ASSERT(distance_.rangeType_ == iir::IntervalDiff::RangeType::literal);
+
+      kcacheTailExtent = (ms_.getLoopOrder() == iir::LoopOrderKind::LK_Backward)
+                             ? distance_.value
+                             : -distance_.value;
+    } else {
+      dawn_unreachable("Not valid policy for final flush");
+    }
+
+    int firstFlushLevel = kcacheTailExtent;
+    iir::increment(firstFlushLevel, ms_.getLoopOrder());
+
+    std::vector<int> levels;
+    for(int klev = firstFlushLevel; iir::isLevelExecBeforeEqThan(klev, 0, ms_.getLoopOrder());
+        iir::increment(klev, ms_.getLoopOrder())) {
+      // for the final flush, we need to do an extra decrement the levels we are flushing since the
+      // final flush happens after a last iterator increment beyond the interval bounds
+      int klevFlushed = klev;
+      iir::increment(klevFlushed, ms_.getLoopOrder(), -1);
+      levels.push_back(klevFlushed);
+    }
+    if(!levels.empty())
+      flushLevels.emplace_back(kcacheProp, std::move(levels));
+  }
+
+  if(flushLevels.empty())
+    return;
+
+  function.addComment("Final flush of kcaches");
+  function.addBlockStatement("", [&]() {
+    function.addStatement("const int k = " + kEnd("m_dom", interval));
+    generateLaneLoop(function, [&]() {
+      for(const auto& kcachePropLevelsPair : flushLevels) {
+        const KCacheProperties& kcacheProp = kcachePropLevelsPair.first;
+
+        auto lastLevelComputed = ms_.lastLevelComputed(kcacheProp.accessID_);
+        iir::increment(lastLevelComputed.offset_, ms_.getLoopOrder());
+        auto lastKLevelStr = makeIntervalLevelBound("m_dom", lastLevelComputed);
+
+        for(int klev : kcachePropLevelsPair.second)
+          generateKCacheFlushBlockStatement(function, interval, kcacheProp, klev, lastKLevelStr);
+      }
+    });
+  });
+}
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
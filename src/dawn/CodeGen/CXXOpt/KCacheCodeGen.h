@@ -0,0 +1,152 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_CODEGEN_CXXOPT_KCACHECODEGEN_H
+#define DAWN_CODEGEN_CXXOPT_KCACHECODEGEN_H
+
+#include "dawn/CodeGen/CXXOpt/ASTStencilBodySIMD.h"
+#include "dawn/CodeGen/CXXUtil.h"
+#include "dawn/IIR/MultiStage.h"
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dawn {
+namespace iir {
+class StencilMetaInformation;
+}
+
+namespace codegen {
+namespace cxxopt {
+
+/// @brief Code generation of the k-caches (see `PassSetCaches`) of a forward or backward
+/// multi-stage for the CPU
+///
+/// This is the k-cache machinery of the CUDA backend (see `cuda::MSCodeGen`) where a thread
+/// computes a batch of columns instead of a single one: the multi-stage sweeps over the levels of
+/// the columns `[iVec, iVec + numLanes)` of row `j` and the cached levels of a field are kept in a
+/// ring buffer of local arrays `<name>_kcache[level][lane]`, one lane per column. The head of the
+/// ring buffer is filled from memory before the stages of a level are computed, the tail is flushed
+/// to memory afterwards and the ring buffer slides by one level, as required by the IO policy of
+/// the cache.
+///
+/// @ingroup cxxopt
+class KCacheCodeGen {
+  struct KCacheProperties {
+    inline KCacheProperties(std::string name, int accessID, iir::Extent intervalVertExtent)
+        : name_(name), accessID_(accessID), intervalVertExtent_(intervalVertExtent) {}
+    std::string name_;
+    int accessID_;
+    iir::Extent intervalVertExtent_; // extent of the cache used within the interval, this
+                                     // information is used for IO policies, to know which portion
+                                     // of the interval needs to be sync with mem
+  };
+
+  const iir::MultiStage& ms_;
+  const iir::StencilMetaInformation& metadata_;
+  const ASTStencilBodySIMD& stencilBodyVisitor_;
+  const int simdWidth_;
+
+public:
+  /// @brief Generate the k-caches of `ms`, the memory accesses are printed by `stencilBodyVisitor`
+  KCacheCodeGen(const iir::MultiStage& ms, const iir::StencilMetaInformation& metadata,
+                const ASTStencilBodySIMD& stencilBodyVisitor, int simdWidth);
+
+  /// @brief Can the k-caches of the multi-stage be generated?
+  ///
+  /// The multi-stage needs to be solved sequentially in k, to have k-caches and to compute all its
+  /// stages on the same columns (i.e without horizontal extents).
+  static bool isApplicable(const iir::MultiStage& ms);
+
+  /// @brief Index of the center level in the ring buffer of each k-cached field
+  std::unordered_map<int, int> getKCacheCenterOffsets() const;
+
+  /// @brief Generate a vectorized loop over the lanes of the current batch of columns
+  void generateLaneLoop(MemberFunction& function, const std::function<void()>& body) const;
+
+  /// @brief code generate all kcache declarations
+  void generateKCacheDecl(MemberFunction& function) const;
+
+  /// @brief generate a pre-fill of the kcaches, i.e. it fills all the klevels of the kcache that
+  /// need to be filled before we start the k looping
+  void generatePreFillKCaches(MemberFunction& function, const iir::Interval& interval) const;
+
+  /// @brief generate a fill of the top level of the kcache, at every k iteration
+  void generateFillKCaches(MemberFunction& function, const iir::Interval& interval) const;
+
+  /// @brief generate a flush of the tail level of the kcaches with the IO policy `policy`, at
+  /// every k iteration
+  void generateFlushKCaches(MemberFunction& function, const iir::Interval& interval,
+                            iir::Cache::CacheIOPolicy policy) const;
+
+  /// @brief code generate slides of the values of a kcache in a ring-buffer manner
+  void generateKCacheSlide(MemberFunction& function, const iir::Interval& interval) const;
+
+  /// @brief generates a final kcache flush statement, i.e. it flushes all the levels at the end of
+  /// an interval iteration
+  void generateFinalFlushKCaches(MemberFunction& function, const iir::Interval& interval,
+                                 const iir::Cache::CacheIOPolicy policy) const;
+
+  /// @brief returns the first level of the interval in the loop order of the multi-stage
+  std::string kBegin(const std::string dom, iir::Interval const& interval) const;
+
+  /// @brief returns the level after the last level of the interval in the loop order of the
+  /// multi-stage, i.e the value of the iterator after the k-loop
+  std::string kEnd(const std::string dom, iir::Interval const& interval) const;
+
+private:
+  static std::string makeIntervalLevelBound(const std::string dom,
+                                            iir::Interval::IntervalLevel const& intervalLevel);
+
+  /// @brief true if the cache requires a fill
+  static bool requiresFill(const iir::Cache& cache);
+
+  /// @brief returns the index (of the ring buffer) for a stencil access with a vertical offset
+  int getKCacheIndex(const int accessID, const int offset) const;
+
+  void generateKCacheFillStatement(MemberFunction& function, const KCacheProperties& kcacheProp,
+                                   int klev) const;
+
+  /// @brief determines the multi interval of an interval (targetInterval) has not been accessed
+  /// before the execution of the queryInterval by a given accessID
+  iir::MultiInterval intervalNotPreviouslyAccessed(const int accessID,
+                                                   const iir::Interval& targetInterval,
+                                                   iir::Interval const& queryInterval) const;
+
+  /// @brief determines if a cache needs to flush for a given interval
+  bool checkIfCacheNeedsToFlush(const iir::Cache& cache, iir::Interval interval) const;
+
+  /// @brief computes additional information of kcaches for those kache with IO synchronization
+  /// policy
+  std::vector<KCacheProperties> buildKCacheProperties(const iir::Interval& interval,
+                                                      const iir::Cache::CacheIOPolicy policy) const;
+
+  /// @brief generates the kcache flush statement, that can be guarded by a conitional to protect
+  /// for out-of-bounds or not, depending on the distance from the interval being executed to the
+  /// interval range where cache is declared
+  void generateKCacheFlushBlockStatement(MemberFunction& function, const iir::Interval& interval,
+                                         const KCacheProperties& kcacheProp, const int klev,
+                                         std::string currentKLevel) const;
+
+  /// @brief generates the kcache flush statement
+  void generateKCacheFlushStatement(MemberFunction& function, const int accessID,
+                                    std::string cacheName, const int offset) const;
+};
+
+} // namespace cxxopt
+} // namespace codegen
+} // namespace dawn
+
+#endif
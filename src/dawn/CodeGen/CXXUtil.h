@@ -376,6 +376,15 @@ struct MemberFunction : public NewLine {
     return *this;
   }
 
+  /// @brief Add a preprocessor directive (e.g `#pragma omp parallel`) on a line of its own
+  ///
+  /// This function can only be called *after* the body was added.
+  MemberFunction& addPreprocessorDirective(const Twine& directive) {
+    startBody();
+    ss() << "\n#" << directive.str() << "\n";
+    return *this;
+  }
+
   /// @brief Add a statement block to the function body (a statement block is sourrounded by
   /// '{ ... }'
   ///
@@ -1,5 +1,7 @@
 #include "dawn/CodeGen/CodeGen.h"
 #include "dawn/CodeGen/StencilFunctionAsBCGenerator.h"
+#include "dawn/Support/Parallel.h"
+#include <vector>
 
 namespace dawn {
 namespace codegen {
@@ -208,7 +210,7 @@ CodeGen::computeCodeGenProperties(const iir::StencilInstantiation* stencilInstan
     auto& paramNameToType = stencilProperties->paramNameToType_;
 
     // fields used in the stencil
-    const auto& StencilFields = stencil->getFields();
+    const auto StencilFields = stencil->getOrderedFields();
 
     auto nonTempFields = makeRange(
         StencilFields, std::function<bool(std::pair<int, iir::Stencil::FieldInfo> const&)>(
@@ -362,6 +364,27 @@ void CodeGen::addMplIfdefs(std::vector<std::string>& ppDefines, int mplContainer
       makeIfNotDefinedString("BOOST_MPL_LIMIT_VECTOR_SIZE", "GT_VECTOR_LIMIT_SIZE"));
 }
 
+bool CodeGen::generateStencilInstantiations(
+    std::map<std::string, std::string>& stencils,
+    const std::function<std::string(const std::shared_ptr<iir::StencilInstantiation>&)>& generate)
+    const {
+  std::vector<const stencilInstantiationContext::value_type*> instantiations;
+  for(const auto& nameStencilCtxPair : context_)
+    instantiations.push_back(&nameStencilCtxPair);
+
+  std::vector<std::string> codes(instantiations.size());
+  parallelFor(instantiations.size(), codeGenOptions.NumThreads,
+              [&](std::size_t i) { codes[i] = generate(instantiations[i]->second); });
+
+  // Assemble in the order of the context
+  for(std::size_t i = 0; i < instantiations.size(); ++i) {
+    if(codes[i].empty())
+      return false;
+    stencils.emplace(instantiations[i]->first, std::move(codes[i]));
+  }
+  return true;
+}
+
 std::string CodeGen::generateFileName(const stencilInstantiationContext& context) const {
   if(context.size() > 0) {
     return context_.begin()->second->getMetaData().getFileName();
@@ -21,6 +21,7 @@
 #include "dawn/IIR/StencilInstantiation.h"
 #include "dawn/Support/DiagnosticsEngine.h"
 #include "dawn/Support/IndexRange.h"
+#include <functional>
 #include <memory>
 
 namespace dawn {
@@ -37,6 +38,7 @@ protected:
   DiagnosticsEngine& diagEngine;
   struct codeGenOption {
     int MaxHaloPoints;
+    int NumThreads = 1;
   } codeGenOptions;
 
   static size_t getVerticalTmpHaloSize(iir::Stencil const& stencil);
@@ -58,6 +60,16 @@ protected:
 
   void addMplIfdefs(std::vector<std::string>& ppDefines, int mplContainerMaxSize) const;
 
+  /// @brief Generate the code of each stencil instantiation of the context with `generate`
+  ///
+  /// The instantiations are distributed among `NumThreads` threads, hence `generate` must only
+  /// modify state owned by the instantiation. The result does not depend on the number of threads.
+  /// @returns `false` if the generation of any instantiation failed (i.e returned empty code)
+  bool generateStencilInstantiations(
+      std::map<std::string, std::string>& stencils,
+      const std::function<std::string(const std::shared_ptr<iir::StencilInstantiation>&)>&
+          generate) const;
+
   const std::string tmpStorageTypename_ = "tmp_storage_t";
   const std::string tmpMetadataTypename_ = "tmp_meta_data_t";
   const std::string tmpMetadataName_ = "m_tmp_meta_data";
@@ -72,6 +84,10 @@ public:
   /// @brief Generate code
   virtual std::unique_ptr<TranslationUnit> generateCode() = 0;
 
+  /// @brief Set the number of threads used to generate the stencil instantiations (0 = number of
+  /// hardware threads)
+  void setNumThreads(int numThreads) { codeGenOptions.NumThreads = numThreads; }
+
   static std::string getStorageType(const sir::Field& field);
   static std::string getStorageType(const iir::Stencil::FieldInfo& field);
   static std::string getStorageType(Array3i dimensions);
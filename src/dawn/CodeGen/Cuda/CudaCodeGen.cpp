@@ -43,11 +43,12 @@ CudaCodeGen::~CudaCodeGen() {}
 
 void CudaCodeGen::generateAllCudaKernels(
     std::stringstream& ssSW,
-    const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
+    const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation,
+    const std::unordered_map<int, CacheProperties>& cachePropertyMap) {
   for(const auto& ms : iterateIIROver<iir::MultiStage>(*(stencilInstantiation->getIIR()))) {
-    DAWN_ASSERT(cachePropertyMap_.count(ms->getID()));
+    DAWN_ASSERT(cachePropertyMap.count(ms->getID()));
 
-    MSCodeGen msCodeGen(ssSW, ms, stencilInstantiation, cachePropertyMap_.at(ms->getID()),
+    MSCodeGen msCodeGen(ssSW, ms, stencilInstantiation, cachePropertyMap.at(ms->getID()),
                         codeGenOptions);
     msCodeGen.generateCudaKernelCode();
   }
@@ -63,11 +64,12 @@ std::string CudaCodeGen::generateStencilInstantiation(
   Namespace cudaNamespace("cuda", ssSW);
 
   // map from MS ID to cacheProperty
+  std::unordered_map<int, CacheProperties> cachePropertyMap;
   for(const auto& ms : iterateIIROver<iir::MultiStage>(*(stencilInstantiation->getIIR()))) {
-    cachePropertyMap_.emplace(ms->getID(), makeCacheProperties(ms, stencilInstantiation, 2));
+    cachePropertyMap.emplace(ms->getID(), makeCacheProperties(ms, stencilInstantiation, 2));
   }
 
-  generateAllCudaKernels(ssSW, stencilInstantiation);
+  generateAllCudaKernels(ssSW, stencilInstantiation, cachePropertyMap);
 
   Class stencilWrapperClass(stencilInstantiation->getName(), ssSW);
   stencilWrapperClass.changeAccessibility("public");
@@ -633,18 +635,13 @@ std::unique_ptr<TranslationUnit> CudaCodeGen::generateCode() {
   DAWN_LOG(INFO) << "Starting code generation for GTClang ...";
 
   // Generate code for StencilInstantiations
+  // TODO the clone seems to be broken, otherwise each instantiation should be cloned first
   std::map<std::string, std::string> stencils;
-  for(const auto& nameStencilCtxPair : context_) {
-    std::shared_ptr<iir::StencilInstantiation> origSI = nameStencilCtxPair.second;
-    // TODO the clone seems to be broken
-    //    std::shared_ptr<iir::StencilInstantiation> stencilInstantiation = origSI->clone();
-    std::shared_ptr<iir::StencilInstantiation> stencilInstantiation = origSI;
-
-    std::string code = generateStencilInstantiation(stencilInstantiation);
-    if(code.empty())
-      return nullptr;
-    stencils.emplace(nameStencilCtxPair.first, std::move(code));
-  }
+  if(!generateStencilInstantiations(
+         stencils, [&](const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
+           return generateStencilInstantiation(stencilInstantiation);
+         }))
+    return nullptr;
 
   std::string globals = generateGlobals(context_, "dawn_generated", "cuda");
 
@@ -36,9 +36,6 @@ namespace cuda {
 /// @brief GridTools C++ code generation for the gridtools_clang DSL
 /// @ingroup cxxnaive
 class CudaCodeGen : public CodeGen {
-
-  std::unordered_map<int, CacheProperties> cachePropertyMap_;
-
 public:
   ///@brief constructor
   CudaCodeGen(stencilInstantiationContext& ctx, DiagnosticsEngine& engine, int maxHaloPoints,
@@ -70,7 +67,8 @@ private:
                          const CacheProperties& cacheProperties);
   void
   generateAllCudaKernels(std::stringstream& ssSW,
-                         const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation);
+                         const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation,
+                         const std::unordered_map<int, CacheProperties>& cachePropertyMap);
 
   void
   generateStencilRunMethod(Structure& stencilClass, const iir::Stencil& stencil,
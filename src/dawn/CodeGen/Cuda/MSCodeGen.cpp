@@ -40,7 +40,7 @@ MSCodeGen::MSCodeGen(std::stringstream& ss, const std::unique_ptr<iir::MultiStag
       solveKLoopInParallel_(CodeGeneratorHelper::solveKLoopInParallel(ms_)), options_(options) {}
 
 void MSCodeGen::generateIJCacheDecl(MemberFunction& kernel) const {
-  for(const auto& cacheP : ms_->getCaches()) {
+  for(const auto& cacheP : ms_->getOrderedCaches()) {
     const iir::Cache& cache = cacheP.second;
     if(cache.getCacheType() != iir::Cache::CacheTypeKind::IJ)
       continue;
@@ -57,7 +57,7 @@ void MSCodeGen::generateIJCacheDecl(MemberFunction& kernel) const {
 }
 
 void MSCodeGen::generateKCacheDecl(MemberFunction& kernel) const {
-  for(const auto& cacheP : ms_->getCaches()) {
+  for(const auto& cacheP : ms_->getOrderedCaches()) {
     const iir::Cache& cache = cacheP.second;
 
     if(cache.getCacheType() != iir::Cache::CacheTypeKind::K)
@@ -186,7 +186,7 @@ void MSCodeGen::generatePreFillKCaches(
   auto intervalFields = ms_->computeFieldsAtInterval(interval);
   std::unordered_map<iir::Extents, std::vector<KCacheProperties>> kCacheProperty;
 
-  for(const auto& cachePair : ms_->getCaches()) {
+  for(const auto& cachePair : ms_->getOrderedCaches()) {
     const int accessID = cachePair.first;
     const auto& cache = cachePair.second;
     if(!CacheProperties::requiresFill(cache))
@@ -297,7 +297,7 @@ void MSCodeGen::generateFillKCaches(MemberFunction& cudaKernel, const iir::Inter
   auto intervalFields = ms_->computeFieldsAtInterval(interval);
   std::unordered_map<iir::Extents, std::vector<KCacheProperties>> kCacheProperty;
 
-  for(const auto& cachePair : ms_->getCaches()) {
+  for(const auto& cachePair : ms_->getOrderedCaches()) {
     const int accessID = cachePair.first;
     const auto& cache = cachePair.second;
     if(!CacheProperties::requiresFill(cache))
@@ -442,7 +442,7 @@ MSCodeGen::buildKCacheProperties(const iir::Interval& interval,
   std::unordered_map<iir::Extents, std::vector<KCacheProperties>> kCacheProperty;
   auto intervalFields = ms_->computeFieldsAtInterval(interval);
 
-  for(const auto& IDCachePair : ms_->getCaches()) {
+  for(const auto& IDCachePair : ms_->getOrderedCaches()) {
     const int accessID = IDCachePair.first;
     const auto& cache = IDCachePair.second;
 
@@ -564,7 +564,7 @@ void MSCodeGen::generateFlushKCaches(MemberFunction& cudaKernel, const iir::Inte
 void MSCodeGen::generateKCacheSlide(MemberFunction& cudaKernel,
                                     const iir::Interval& interval) const {
   cudaKernel.addComment("Slide kcaches");
-  for(const auto& cachePair : ms_->getCaches()) {
+  for(const auto& cachePair : ms_->getOrderedCaches()) {
     const auto& cache = cachePair.second;
     if(!cacheProperties_.isKCached(cache))
       continue;
@@ -66,7 +66,7 @@ GTCodeGen::IntervalDefinitions::IntervalDefinitions(const iir::Stencil& stencil)
 
   // inserting the intervals of the caches
   for(const auto& mss : stencil.getChildren()) {
-    for(const auto& cachePair : mss->getCaches()) {
+    for(const auto& cachePair : mss->getOrderedCaches()) {
       auto const& cache = cachePair.second;
       boost::optional<iir::Interval> interval;
       if(cache.getCacheIOPolicy() == iir::Cache::CacheIOPolicy::fill) {
@@ -153,7 +153,7 @@ void GTCodeGen::generatePlaceholderDefinitions(
     Structure& stencilClass, const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation,
     const sir::GlobalVariableMap& globalsMap, const CodeGenProperties& codeGenProperties) const {
 
-  const auto& stencilFields = stencilInstantiation->getIIR()->getFields();
+  const auto stencilFields = stencilInstantiation->getIIR()->getOrderedFields();
 
   int accessorIdx = 0;
   for(const auto& fieldInfoPair : stencilFields) {
@@ -611,7 +611,7 @@ void GTCodeGen::generateStencilClasses(
         StencilFunStruct.addTypeDef("param_list")
             .addType(c_gt() + "make_param_list")
             .addTemplates(arglist);
-        mplContainerMaxSize_ = std::max(mplContainerMaxSize_, arglist.size());
+        requireMplContainerSize(arglist.size());
 
         // Generate Do-Method
         auto doMethod = StencilFunStruct.addMemberFunction("GT_FUNCTION static void", "apply",
@@ -666,7 +666,7 @@ void GTCodeGen::generateStencilClasses(
       if(!multiStage.getCaches().empty()) {
 
         std::vector<iir::Cache> ioCaches;
-        for(const auto& cacheP : multiStage.getCaches()) {
+        for(const auto& cacheP : multiStage.getOrderedCaches()) {
           if((cacheP.second.getCacheIOPolicy() == iir::Cache::CacheIOPolicy::bpfill) ||
              (cacheP.second.getCacheIOPolicy() == iir::Cache::CacheIOPolicy::epflush)) {
             continue;
@@ -774,7 +774,7 @@ void GTCodeGen::generateStencilClasses(
         StageStruct.addTypeDef("param_list")
             .addType(c_gt() + "make_param_list")
             .addTemplates(arglist);
-        mplContainerMaxSize_ = std::max(mplContainerMaxSize_, arglist.size());
+        requireMplContainerSize(arglist.size());
 
         // Generate Do-Method
         for(const auto& doMethodPtr : stage.getChildren()) {
@@ -818,7 +818,7 @@ void GTCodeGen::generateStencilClasses(
     //
     std::size_t numFields = stencilFields.size();
 
-    mplContainerMaxSize_ = std::max(mplContainerMaxSize_, numFields);
+    requireMplContainerSize(numFields);
 
     // Generate constructor
     auto StencilConstructor = stencilClass.addConstructor();
@@ -933,13 +933,11 @@ std::unique_ptr<TranslationUnit> GTCodeGen::generateCode() {
 
   // Generate StencilInstantiations
   std::map<std::string, std::string> stencils;
-  for(const auto& nameStencilCtxPair : context_) {
-    std::string code = generateStencilInstantiation(nameStencilCtxPair.second);
-
-    if(code.empty())
-      return nullptr;
-    stencils.emplace(nameStencilCtxPair.first, std::move(code));
-  }
+  if(!generateStencilInstantiations(
+         stencils, [&](const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
+           return generateStencilInstantiation(stencilInstantiation);
+         }))
+    return nullptr;
 
   // Generate globals
   std::string globals = generateGlobals(context_, "dawn_generated", "gt");
@@ -974,6 +972,11 @@ std::unique_ptr<TranslationUnit> GTCodeGen::generateCode() {
                                       std::move(globals));
 }
 
+void GTCodeGen::requireMplContainerSize(std::size_t size) {
+  std::lock_guard<std::mutex> lock(mplContainerMaxSizeMutex_);
+  mplContainerMaxSize_ = std::max(mplContainerMaxSize_, size);
+}
+
 std::vector<std::string> GTCodeGen::buildFieldTemplateNames(
     IndexRange<std::vector<iir::Stencil::FieldInfo>> const& stencilFields) const {
   std::vector<std::string> templates;
@@ -18,6 +18,7 @@
 #include "dawn/CodeGen/CodeGen.h"
 #include "dawn/CodeGen/CodeGenProperties.h"
 #include "dawn/IIR/Interval.h"
+#include <mutex>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
@@ -118,8 +119,14 @@ private:
   std::vector<std::string> buildFieldTemplateNames(
       IndexRange<std::vector<iir::Stencil::FieldInfo>> const& stencilFields) const;
 
+  /// @brief Increase the maximum needed vector size of boost::fusion containers to `size`
+  ///
+  /// Thread-safe, the stencil instantiations may be generated concurrently.
+  void requireMplContainerSize(std::size_t size);
+
   /// Maximum needed vector size of boost::fusion containers
   std::size_t mplContainerMaxSize_;
+  std::mutex mplContainerMaxSizeMutex_;
 
   /// Use the parallel keyword for mulistages
   struct GTCodeGenOptions {
@@ -0,0 +1,165 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/Autotuner.h"
+#include "dawn/Support/Logging.h"
+#include <algorithm>
+#include <random>
+
+namespace dawn {
+
+Autotuner::Autotuner(std::vector<TuningParameter> space, Evaluator evaluator)
+    : space_(std::move(space)), evaluator_(std::move(evaluator)) {}
+
+std::vector<TuningParameter> Autotuner::getDefaultSpace(const std::string& backend) {
+  std::vector<TuningParameter> space{{"ReorderStrategy", {"greedy", "none", "scut"}},
+                                     {"MergeStages", {"false", "true"}},
+                                     {"MergeTemporaries", {"false", "true"}},
+                                     {"PassTmpToFunction", {"false", "true"}},
+                                     {"UseNonTempCaches", {"false", "true"}},
+                                     {"MaxFieldsPerStencil", {"40", "20", "80"}}};
+  if(backend == "c++-opt") {
+    space.push_back({"block_size", {"", "32,8,8", "64,8,8", "128,16,16"}});
+    space.push_back({"SIMDWidth", {"0", "4", "8"}});
+  }
+  return space;
+}
+
+bool Autotuner::parseSearchKind(const std::string& name, SearchKind& kind) {
+  if(name == "exhaustive")
+    kind = SK_Exhaustive;
+  else if(name == "random")
+    kind = SK_Random;
+  else if(name == "greedy")
+    kind = SK_Greedy;
+  else
+    return false;
+  return true;
+}
+
+std::size_t Autotuner::getNumConfigurations() const {
+  std::size_t numConfigurations = 1;
+  for(const auto& parameter : space_)
+    numConfigurations *= parameter.Values.size();
+  return numConfigurations;
+}
+
+TuningConfiguration Autotuner::toConfiguration(const Point& point) const {
+  TuningConfiguration configuration;
+  for(std::size_t i = 0; i < space_.size(); ++i)
+    configuration.set(space_[i].Name, space_[i].Values[point[i]]);
+  return configuration;
+}
+
+bool Autotuner::evaluate(const Point& point, Result& result, double& time) {
+  TuningConfiguration configuration = toConfiguration(point);
+  for(const auto& evaluated : result.History)
+    if(evaluated.first == configuration) {
+      time = evaluated.second;
+      return true;
+    }
+
+  if(maxEvaluations_ != 0 && result.History.size() >= maxEvaluations_)
+    return false;
+
+  time = evaluator_(configuration);
+  DAWN_LOG(INFO) << "Autotuner: " << configuration.toString() << ": " << time << " s";
+
+  result.History.emplace_back(configuration, time);
+  if(time >= 0.0 && (result.BestTime < 0.0 || time < result.BestTime)) {
+    result.Best = configuration;
+    result.BestTime = time;
+  }
+  return true;
+}
+
+Autotuner::Result Autotuner::run(SearchKind kind, std::size_t maxEvaluations, unsigned seed) {
+  maxEvaluations_ = maxEvaluations;
+  Result result;
+
+  const std::size_t numConfigurations = getNumConfigurations();
+  if(numConfigurations == 0)
+    return result;
+
+  // Decode the i-th configuration in lexicographic order
+  auto getPoint = [&](std::size_t index) {
+    Point point(space_.size());
+    for(std::size_t i = space_.size(); i-- > 0;) {
+      point[i] = index % space_[i].Values.size();
+      index /= space_[i].Values.size();
+    }
+    return point;
+  };
+
+  double time;
+  switch(kind) {
+  case SK_Exhaustive:
+    for(std::size_t index = 0; index < numConfigurations; ++index)
+      if(!evaluate(getPoint(index), result, time))
+        break;
+    break;
+
+  case SK_Random: {
+    const std::size_t numSamples =
+        maxEvaluations == 0 ? numConfigurations : std::min(maxEvaluations, numConfigurations);
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<std::size_t> distribution(0, numConfigurations - 1);
+
+    // Duplicates are not evaluated again, bound the number of draws in case the space is almost
+    // exhausted
+    for(std::size_t draws = 0; result.History.size() < numSamples && draws < 16 * numSamples + 64;
+        ++draws)
+      evaluate(getPoint(distribution(generator)), result, time);
+    break;
+  }
+
+  case SK_Greedy: {
+    Point current(space_.size(), 0);
+    double currentTime;
+    if(!evaluate(current, result, currentTime))
+      break;
+
+    bool improved = true, exhausted = false;
+    while(improved && !exhausted) {
+      improved = false;
+      for(std::size_t i = 0; i < space_.size() && !exhausted; ++i) {
+        Point best = current;
+        for(std::size_t value = 0; value < space_[i].Values.size(); ++value) {
+          Point candidate = current;
+          candidate[i] = value;
+          if(candidate == current)
+            continue;
+          if(!evaluate(candidate, result, time)) {
+            exhausted = true;
+            break;
+          }
+          if(time >= 0.0 && (currentTime < 0.0 || time < currentTime)) {
+            best = candidate;
+            currentTime = time;
+          }
+        }
+        if(best != current) {
+          current = best;
+          improved = true;
+        }
+      }
+    }
+    break;
+  }
+  }
+
+  return result;
+}
+
+} // namespace dawn
@@ -0,0 +1,93 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_COMPILER_AUTOTUNER_H
+#define DAWN_COMPILER_AUTOTUNER_H
+
+#include "dawn/Compiler/TuningDatabase.h"
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace dawn {
+
+/// @brief Option searched by the autotuner and the values it may take
+/// @ingroup compiler
+struct TuningParameter {
+  std::string Name;                ///< Name of the option (e.g `ReorderStrategy`)
+  std::vector<std::string> Values; ///< Candidate values, the first value is the starting point
+};
+
+/// @brief Empirical search over the options of the compiler
+///
+/// The autotuner calls the evaluator for each configuration it visits and keeps the fastest one.
+/// The evaluator returns the measured run time in seconds or a negative value if the configuration
+/// could not be compiled or run. Configurations are evaluated at most once per run.
+///
+/// Supported searches:
+///   - Exhaustive: all configurations in lexicographic order (until the budget is exhausted)
+///   - Random: uniformly sampled configurations
+///   - Greedy: coordinate descent starting at the first value of each parameter, each parameter is
+///     varied in turn while the others are fixed until no parameter improves the run time
+///
+/// @ingroup compiler
+class Autotuner {
+public:
+  enum SearchKind { SK_Exhaustive, SK_Random, SK_Greedy };
+
+  using Evaluator = std::function<double(const TuningConfiguration&)>;
+
+  struct Result {
+    TuningConfiguration Best;
+    double BestTime = -1.0; ///< Negative if no configuration could be evaluated
+    std::vector<std::pair<TuningConfiguration, double>> History;
+  };
+
+  Autotuner(std::vector<TuningParameter> space, Evaluator evaluator);
+
+  /// @brief Default search space for `backend`
+  ///
+  /// The search space only covers the backends which can be benchmarked (see `BenchmarkHarness`).
+  /// The block size and the vector width are only searched for `c++-opt`, the naive backend
+  /// ignores them.
+  static std::vector<TuningParameter> getDefaultSpace(const std::string& backend);
+
+  /// @brief Parse `exhaustive`, `random` or `greedy`
+  /// @returns `false` if the name is unknown
+  static bool parseSearchKind(const std::string& name, SearchKind& kind);
+
+  /// @brief Number of configurations of the search space
+  std::size_t getNumConfigurations() const;
+
+  /// @brief Run the search with at most `maxEvaluations` evaluations (0 = unlimited)
+  Result run(SearchKind kind, std::size_t maxEvaluations, unsigned seed = 0);
+
+private:
+  using Point = std::vector<std::size_t>;
+
+  TuningConfiguration toConfiguration(const Point& point) const;
+
+  /// @brief Evaluate `point` unless it has been evaluated already or the budget is exhausted
+  /// @returns `false` if the budget is exhausted
+  bool evaluate(const Point& point, Result& result, double& time);
+
+  std::vector<TuningParameter> space_;
+  Evaluator evaluator_;
+  std::size_t maxEvaluations_ = 0;
+};
+
+} // namespace dawn
+
+#endif
@@ -0,0 +1,279 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/BenchmarkHarness.h"
+#include "dawn/CodeGen/CodeGen.h"
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/SIR/ASTExpr.h"
+#include "dawn/SIR/ASTVisitor.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/SIRSerializer.h"
+#include "dawn/Support/Logging.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+
+namespace fs = std::filesystem;
+
+namespace dawn {
+
+namespace {
+
+/// @brief Namespace of the generated stencil wrappers of `backend` (empty if not supported)
+std::string getBackendNamespace(const std::string& backend) {
+  if(backend == "c++-naive")
+    return "cxxnaive";
+  if(backend == "c++-opt")
+    return "cxxopt";
+  return "";
+}
+
+/// @brief Storage meta data type of `storageType` (e.g `meta_data_ij_t` of `storage_ij_t`)
+std::string getMetaDataType(const std::string& storageType) {
+  std::string dimensions = storageType.substr(8, storageType.size() - 10);
+  return dimensions == "ijk" ? "meta_data_t" : "meta_data_" + dimensions + "_t";
+}
+
+/// @brief Collect the names of the fields which are assigned to
+class WrittenFieldsCollector : public sir::ASTVisitorForwarding {
+  std::set<std::string> names_;
+
+public:
+  virtual void visit(const std::shared_ptr<sir::AssignmentExpr>& expr) override {
+    if(auto field = std::dynamic_pointer_cast<sir::FieldAccessExpr>(expr->getLeft()))
+      names_.insert(field->getName());
+    sir::ASTVisitorForwarding::visit(expr);
+  }
+
+  const std::set<std::string>& getNames() const { return names_; }
+};
+
+} // anonymous namespace
+
+BenchmarkHarness::BenchmarkHarness(const std::shared_ptr<SIR>& sir, const std::string& stencilName,
+                                   const Options& baseOptions, const Settings& settings)
+    : sir_(sir), stencilName_(stencilName), baseOptions_(baseOptions), settings_(settings) {}
+
+std::string
+BenchmarkHarness::generateSource(const codegen::TranslationUnit& translationUnit) const {
+  const std::string backendNamespace = getBackendNamespace(baseOptions_.Backend);
+  if(backendNamespace.empty())
+    return "";
+
+  const sir::Stencil* stencil = nullptr;
+  for(const auto& s : sir_->Stencils)
+    if(s->Name == stencilName_)
+      stencil = s.get();
+  if(!stencil)
+    return "";
+
+  std::ostringstream ss;
+  for(const auto& define : translationUnit.getPPDefines())
+    ss << define << "\n";
+  ss << "#include \"gridtools/clang_dsl.hpp\"\n"
+     << "#include \"gridtools/clang/verify.hpp\"\n"
+     << "#include <algorithm>\n"
+     << "#include <chrono>\n"
+     << "#include <iostream>\n"
+     << "#include <vector>\n\n"
+     << "using namespace gridtools::clang;\n\n"
+     << translationUnit.getGlobals() << "\n";
+  for(const auto& code : translationUnit.getStencils())
+    ss << code.second << "\n";
+
+  // STREAM copy of `size` elements, in a function of its own as its variables could clash with
+  // the names of the fields
+  ss << "double dawn_benchmark_stream(std::size_t size) {\n"
+     << "  std::vector<float_type> a(size, 1.0), b(size, 0.0);\n"
+     << "  std::vector<double> times;\n"
+     << "  for(int i = 0; i < " << settings_.Repetitions << "; ++i) {\n"
+     << "    auto start = std::chrono::steady_clock::now();\n"
+     << "#pragma omp parallel for\n"
+     << "    for(std::size_t n = 0; n < size; ++n)\n"
+     << "      b[n] = a[n];\n"
+     << "    auto stop = std::chrono::steady_clock::now();\n"
+     << "    times.push_back(std::chrono::duration<double>(stop - start).count());\n"
+     << "  }\n"
+     << "  std::sort(times.begin(), times.end());\n"
+     << "  const double time = times[times.size() / 2];\n"
+     << "  std::cout << \"dawn-benchmark-checksum \" << b[size / 2] << std::endl;\n"
+     << "  return 2 * size * sizeof(float_type) / time * 1e-9;\n"
+     << "}\n\n";
+
+  // Allocate the fields of the stencil (in the order of the SIR) and fill them with synthetic data.
+  // The variables of the benchmark are prefixed to not clash with the names of the fields.
+  std::vector<std::string> fieldNames;
+  ss << "int main() {\n"
+     << "  domain dawn_benchmark_dom(" << settings_.Domain[0] << ", " << settings_.Domain[1] << ", "
+     << settings_.Domain[2] << ");\n"
+     << "  dawn_benchmark_dom.set_halos(" << settings_.Halo << ", " << settings_.Halo << ", "
+     << settings_.Halo << ", " << settings_.Halo << ", 0, 0);\n"
+     << "  verifier dawn_benchmark_verif(dawn_benchmark_dom);\n";
+  for(const auto& field : stencil->Fields) {
+    if(field->IsTemporary)
+      continue;
+    const std::string storageType = codegen::CodeGen::getStorageType(*field);
+    const std::string metaData = "dawn_benchmark_meta_" + field->Name;
+    ss << "  " << getMetaDataType(storageType) << " " << metaData << "("
+       << (field->fieldDimensions[0] ? "dawn_benchmark_dom.isize()" : "1") << ", "
+       << (field->fieldDimensions[1] ? "dawn_benchmark_dom.jsize()" : "1") << ", "
+       << (field->fieldDimensions[2] ? "dawn_benchmark_dom.ksize() + 1" : "1") << ");\n"
+       << "  " << storageType << " " << field->Name << "(" << metaData << ", \"" << field->Name
+       << "\");\n"
+       << "  dawn_benchmark_verif.fillMath(8.0, 2.0, 1.5, 1.5, 2.0, 4.0, " << field->Name << ");\n";
+    fieldNames.push_back(field->Name);
+  }
+
+  std::string fieldList;
+  for(const auto& name : fieldNames)
+    fieldList += (fieldList.empty() ? "" : ", ") + name;
+
+  // Every field is read once and every output field is written once
+  WrittenFieldsCollector writtenFields;
+  stencil->StencilDescAst->accept(writtenFields);
+  std::size_t numTransfers = fieldNames.size();
+  for(const auto& name : fieldNames)
+    numTransfers += writtenFields.getNames().count(name);
+
+  ss << "\n  dawn_generated::" << backendNamespace << "::" << stencilName_
+     << " dawn_benchmark_stencil(dawn_benchmark_dom" << (fieldList.empty() ? "" : ", ")
+     << fieldList << ");\n"
+     << "  dawn_benchmark_stencil.run(" << fieldList << ");\n\n"
+     << "  std::vector<double> dawn_benchmark_times;\n"
+     << "  for(int dawn_benchmark_i = 0; dawn_benchmark_i < " << settings_.Repetitions
+     << "; ++dawn_benchmark_i) {\n"
+     << "    auto dawn_benchmark_start = std::chrono::steady_clock::now();\n"
+     << "    dawn_benchmark_stencil.run(" << fieldList << ");\n"
+     << "    auto dawn_benchmark_stop = std::chrono::steady_clock::now();\n"
+     << "    dawn_benchmark_times.push_back(\n"
+     << "        std::chrono::duration<double>(dawn_benchmark_stop - dawn_benchmark_start)\n"
+     << "            .count());\n"
+     << "  }\n"
+     << "  std::sort(dawn_benchmark_times.begin(), dawn_benchmark_times.end());\n"
+     << "  const double dawn_benchmark_time =\n"
+     << "      dawn_benchmark_times[dawn_benchmark_times.size() / 2];\n"
+     << "  std::cout << \"dawn-benchmark-time \" << dawn_benchmark_time << std::endl;\n\n"
+     << "  const std::size_t dawn_benchmark_points =\n"
+     << "      std::size_t(dawn_benchmark_dom.isize() - dawn_benchmark_dom.iminus() -\n"
+     << "                  dawn_benchmark_dom.iplus()) *\n"
+     << "      (dawn_benchmark_dom.jsize() - dawn_benchmark_dom.jminus() -\n"
+     << "       dawn_benchmark_dom.jplus()) *\n"
+     << "      dawn_benchmark_dom.ksize();\n"
+     << "  const std::size_t dawn_benchmark_transfers = " << numTransfers << ";\n"
+     << "  std::cout << \"dawn-benchmark-bandwidth \"\n"
+     << "            << dawn_benchmark_transfers * dawn_benchmark_points * sizeof(float_type) /\n"
+     << "                   dawn_benchmark_time * 1e-9\n"
+     << "            << std::endl;\n\n"
+     << "  // STREAM copy of the same amount of data\n"
+     << "  const double dawn_benchmark_stream_bandwidth = dawn_benchmark_stream(\n"
+     << "      std::max<std::size_t>(dawn_benchmark_transfers / 2, 1) * dawn_benchmark_points);\n"
+     << "  std::cout << \"dawn-benchmark-stream \" << dawn_benchmark_stream_bandwidth\n"
+     << "            << std::endl;\n"
+     << "  return 0;\n"
+     << "}\n";
+  return ss.str();
+}
+
+bool BenchmarkHarness::runCommand(const std::string& command, const std::string& logFile) const {
+  DAWN_LOG(INFO) << "BenchmarkHarness: " << command;
+  return std::system((command + " > \"" + logFile + "\" 2>&1").c_str()) == 0;
+}
+
+double BenchmarkHarness::evaluate(const TuningConfiguration& configuration) {
+  Options options = baseOptions_;
+  if(!configuration.apply(options)) {
+    DAWN_LOG(WARNING) << "invalid configuration: " << configuration.toString();
+    return -1.0;
+  }
+
+  // The optimizer modifies the SIR it compiles, every configuration starts from a pristine copy
+  DawnCompiler compiler(&options);
+  auto translationUnit = compiler.compile(SIRSerializer::copy(sir_.get()));
+  if(!translationUnit || compiler.getDiagnostics().hasErrors())
+    return -1.0;
+
+  std::string source = generateSource(*translationUnit);
+  if(source.empty()) {
+    DAWN_LOG(WARNING) << "backend `" << options.Backend << "` is not supported by the benchmark";
+    return -1.0;
+  }
+
+  // Without a given working directory, every harness gets its own temporary directory such that
+  // concurrent runs do not overwrite each other's programs
+  if(settings_.WorkDir.empty()) {
+    std::string dir =
+        (fs::temp_directory_path() / ("dawn-tune-" + stencilName_ + "-XXXXXX")).string();
+    if(!mkdtemp(&dir[0])) {
+      DAWN_LOG(WARNING) << "failed to create a temporary directory: " << std::strerror(errno);
+      return -1.0;
+    }
+    settings_.WorkDir = dir;
+  }
+
+  std::error_code ec;
+  fs::create_directories(settings_.WorkDir, ec);
+  const std::string base =
+      (fs::path(settings_.WorkDir) / (stencilName_ + "_" + std::to_string(numEvaluations_++)))
+          .string();
+  {
+    std::ofstream ofs(base + ".cpp");
+    ofs << source;
+    if(!ofs.good())
+      return -1.0;
+  }
+
+  std::ostringstream compileCommand;
+  compileCommand << settings_.Compiler << " " << settings_.Flags;
+  if(baseOptions_.Backend == "c++-opt")
+    compileCommand << " -fopenmp";
+  for(const auto& includeDir : settings_.IncludeDirs)
+    compileCommand << " -I\"" << includeDir << "\"";
+  compileCommand << " \"" << base << ".cpp\" -o \"" << base << "\"";
+  if(!runCommand(compileCommand.str(), base + ".compile.log")) {
+    DAWN_LOG(WARNING) << "failed to compile the benchmark, see `" << base << ".compile.log`";
+    return -1.0;
+  }
+
+  if(!runCommand("\"" + base + "\"", base + ".log"))
+    return -1.0;
+
+  double time = -1.0;
+  Bandwidth bandwidth{0.0, 0.0};
+  std::ifstream log(base + ".log");
+  std::string token;
+  while(log >> token) {
+    if(token == "dawn-benchmark-time")
+      log >> time;
+    else if(token == "dawn-benchmark-bandwidth")
+      log >> bandwidth.Stencil;
+    else if(token == "dawn-benchmark-stream")
+      log >> bandwidth.Stream;
+  }
+  if(time >= 0.0)
+    bandwidths_[configuration] = bandwidth;
+  return time;
+}
+
+const BenchmarkHarness::Bandwidth*
+BenchmarkHarness::getBandwidth(const TuningConfiguration& configuration) const {
+  auto it = bandwidths_.find(configuration);
+  return it != bandwidths_.end() ? &it->second : nullptr;
+}
+
+} // namespace dawn
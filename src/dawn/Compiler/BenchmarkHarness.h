@@ -0,0 +1,92 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_COMPILER_BENCHMARKHARNESS_H
+#define DAWN_COMPILER_BENCHMARKHARNESS_H
+
+#include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/Compiler/TuningDatabase.h"
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace dawn {
+
+struct SIR;
+
+/// @brief Measure the run time of a stencil compiled with a given configuration
+///
+/// The stencil is compiled by Dawn with the configuration applied to the base options. The
+/// generated code is embedded into a benchmark program which allocates the fields of the stencil,
+/// fills them with synthetic data and reports the median run time of several repetitions. The
+/// program is compiled with the host C++ compiler (which needs the gridtools and gtclang headers
+/// in its include path) and run in a working directory.
+///
+/// Besides the run time, the program reports the memory bandwidth achieved by the stencil (the
+/// compulsory traffic of reading every field and writing every output field once) and, as a
+/// baseline, the bandwidth of a STREAM copy kernel on arrays of the same total size.
+///
+/// Only the CPU backends are supported.
+///
+/// @ingroup compiler
+class BenchmarkHarness {
+public:
+  struct Settings {
+    std::string Compiler = "c++";                  ///< C++ compiler command
+    std::string Flags = "-O3 -std=c++14 -DNDEBUG"; ///< Flags passed to the compiler
+    std::vector<std::string> IncludeDirs;          ///< Include directories of gridtools and gtclang
+    std::string WorkDir;                           ///< Working directory (empty = unique temp dir)
+    std::array<int, 3> Domain{{64, 64, 80}};       ///< Size of the compute domain
+    int Halo = 3;                                  ///< Number of halo points of the fields
+    int Repetitions = 10;                          ///< Number of timed runs
+  };
+
+  /// @brief Memory bandwidths in GB/s measured by an evaluation
+  struct Bandwidth {
+    double Stencil; ///< Compulsory traffic of the stencil divided by its run time
+    double Stream;  ///< STREAM copy baseline
+  };
+
+  BenchmarkHarness(const std::shared_ptr<SIR>& sir, const std::string& stencilName,
+                   const Options& baseOptions, const Settings& settings);
+
+  /// @brief Generate the source code of the benchmark program of `translationUnit`
+  /// @returns an empty string if the backend is not supported
+  std::string generateSource(const codegen::TranslationUnit& translationUnit) const;
+
+  /// @brief Compile and run the stencil with `configuration`
+  /// @returns median run time in seconds or a negative value on failure
+  double evaluate(const TuningConfiguration& configuration);
+
+  /// @brief Bandwidths measured by the evaluation of `configuration`
+  /// @returns `NULL` if the configuration was not evaluated successfully
+  const Bandwidth* getBandwidth(const TuningConfiguration& configuration) const;
+
+private:
+  bool runCommand(const std::string& command, const std::string& logFile) const;
+
+  std::shared_ptr<SIR> sir_;
+  std::string stencilName_;
+  Options baseOptions_;
+  Settings settings_;
+  unsigned numEvaluations_ = 0;
+  std::map<TuningConfiguration, Bandwidth> bandwidths_;
+};
+
+} // namespace dawn
+
+#endif
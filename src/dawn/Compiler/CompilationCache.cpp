@@ -0,0 +1,209 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/CompilationCache.h"
+#include "dawn/Compiler/Fingerprint.h"
+#include "dawn/Support/Json.h"
+#include "dawn/Support/Logging.h"
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace dawn {
+
+CompilationCache::CompilationCache(const std::string& directory, std::uintmax_t maxSize)
+    : directory_(directory), maxSize_(maxSize) {
+  std::error_code ec;
+  fs::create_directories(directory_, ec);
+  if(ec)
+    DAWN_LOG(WARNING) << "failed to create cache directory `" << directory_
+                      << "`: " << ec.message();
+}
+
+std::string CompilationCache::computeKey(const SIR& sir, const Options& options) {
+  return computeSIRFingerprint(sir, options);
+}
+
+std::string CompilationCache::getEntryPath(const std::string& key) const {
+  return (fs::path(directory_) / (key + ".tu")).string();
+}
+
+std::unique_ptr<codegen::TranslationUnit>
+CompilationCache::lookup(const std::string& key, std::vector<DiagnosticsMessage>* diagnostics) {
+  const std::string path = getEntryPath(key);
+  std::unique_ptr<codegen::TranslationUnit> translationUnit;
+  std::vector<DiagnosticsMessage> entryDiagnostics;
+
+  std::ifstream ifs(path);
+  if(ifs.is_open()) {
+    try {
+      json::json node = json::json::parse(ifs);
+
+      // Guard against truncated or foreign files
+      if(node.at("key").get<std::string>() == key) {
+        for(const auto& diagNode : node.at("diagnostics"))
+          entryDiagnostics.emplace_back(
+              static_cast<DiagnosticsKind>(diagNode.at("kind").get<int>()),
+              SourceLocation(diagNode.at("line").get<int>(), diagNode.at("column").get<int>()),
+              diagNode.at("filename").get<std::string>(),
+              diagNode.at("message").get<std::string>());
+
+        translationUnit = std::make_unique<codegen::TranslationUnit>(
+            node.at("filename").get<std::string>(),
+            node.at("pp_defines").get<std::vector<std::string>>(),
+            node.at("stencils").get<std::map<std::string, std::string>>(),
+            node.at("globals").get<std::string>());
+      }
+    } catch(std::exception& e) {
+      DAWN_LOG(WARNING) << "ignoring invalid cache entry `" << path << "`: " << e.what();
+    }
+  }
+
+  if(translationUnit) {
+    if(diagnostics)
+      diagnostics->insert(diagnostics->end(), entryDiagnostics.begin(), entryDiagnostics.end());
+
+    // Mark the entry as recently used
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if(translationUnit)
+    statistics_.Hits++;
+  else
+    statistics_.Misses++;
+  return translationUnit;
+}
+
+bool CompilationCache::store(const std::string& key,
+                             const codegen::TranslationUnit& translationUnit,
+                             const std::vector<DiagnosticsMessage>& diagnostics) {
+  json::json node;
+  node["key"] = key;
+  node["filename"] = translationUnit.getFilename();
+  node["pp_defines"] = translationUnit.getPPDefines();
+  node["globals"] = translationUnit.getGlobals();
+  node["stencils"] = translationUnit.getStencils();
+
+  node["diagnostics"] = json::json::array();
+  for(const auto& diag : diagnostics) {
+    json::json diagNode;
+    diagNode["kind"] = static_cast<int>(diag.getDiagKind());
+    diagNode["line"] = diag.getSourceLocation().Line;
+    diagNode["column"] = diag.getSourceLocation().Column;
+    diagNode["filename"] = diag.getFilename();
+    diagNode["message"] = diag.getMessage();
+    node["diagnostics"].push_back(diagNode);
+  }
+
+  // Write to a temporary file unique to this process and move it into place, renaming is atomic
+  static std::atomic<unsigned> counter(0);
+  std::ostringstream tmpName;
+  tmpName << key << ".tmp." << ::getpid() << "." << counter++;
+  const fs::path tmpPath = fs::path(directory_) / tmpName.str();
+  bool written;
+  {
+    std::ofstream ofs(tmpPath);
+    ofs << node.dump();
+    written = ofs.good();
+  }
+
+  std::error_code ec;
+  if(!written) {
+    DAWN_LOG(WARNING) << "failed to write cache entry `" << tmpPath.string() << "`";
+    fs::remove(tmpPath, ec);
+    return false;
+  }
+
+  fs::rename(tmpPath, getEntryPath(key), ec);
+  if(ec) {
+    DAWN_LOG(WARNING) << "failed to store cache entry `" << getEntryPath(key)
+                      << "`: " << ec.message();
+    fs::remove(tmpPath, ec);
+    return false;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_.Stores++;
+  }
+
+  evict();
+  return true;
+}
+
+void CompilationCache::evict() {
+  if(maxSize_ == 0)
+    return;
+
+  struct Entry {
+    fs::path Path;
+    std::uintmax_t Size;
+    fs::file_time_type LastUsed;
+  };
+
+  std::vector<Entry> entries;
+  std::uintmax_t totalSize = 0;
+
+  std::error_code ec;
+  for(fs::directory_iterator it(directory_, ec), end; !ec && it != end; it.increment(ec)) {
+    if(it->path().extension() != ".tu")
+      continue;
+
+    std::error_code entryEc;
+    Entry entry{it->path(), fs::file_size(it->path(), entryEc), {}};
+    if(entryEc)
+      continue;
+    entry.LastUsed = fs::last_write_time(it->path(), entryEc);
+    if(entryEc)
+      continue;
+
+    totalSize += entry.Size;
+    entries.push_back(std::move(entry));
+  }
+
+  if(totalSize <= maxSize_)
+    return;
+
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry& a, const Entry& b) { return a.LastUsed < b.LastUsed; });
+
+  std::size_t numEvictions = 0;
+  for(const Entry& entry : entries) {
+    if(totalSize <= maxSize_)
+      break;
+
+    // Another process may have removed the entry already
+    if(fs::remove(entry.Path, ec))
+      numEvictions++;
+    totalSize -= entry.Size;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_.Evictions += numEvictions;
+}
+
+CompilationCache::Statistics CompilationCache::getStatistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+} // namespace dawn
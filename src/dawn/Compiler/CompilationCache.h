@@ -0,0 +1,91 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_COMPILER_COMPILATIONCACHE_H
+#define DAWN_COMPILER_COMPILATIONCACHE_H
+
+#include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Support/DiagnosticsMessage.h"
+#include "dawn/Support/NonCopyable.h"
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace dawn {
+
+struct Options;
+struct SIR;
+
+/// @brief Content-addressed, on-disk cache of generated translation units
+///
+/// Each entry is stored as `<directory>/<key>.tu` where the key is the SHA-256 digest of the
+/// canonicalized SIR, all options besides the locations of the caches and the version of Dawn
+/// (see `computeKey`). Each entry also holds the diagnostics (i.e warnings and notes) of the
+/// compilation, which are reported again when the entry is used. Entries are written to a
+/// temporary file first and then renamed, hence concurrent compilers may safely share one cache
+/// directory. Once the total size of the entries exceeds the given limit, the least recently used
+/// entries are removed.
+///
+/// @ingroup compiler
+class CompilationCache : NonCopyable {
+public:
+  struct Statistics {
+    std::size_t Hits = 0;
+    std::size_t Misses = 0;
+    std::size_t Stores = 0;
+    std::size_t Evictions = 0;
+  };
+
+  /// @brief Open (and create if necessary) the cache in `directory`
+  ///
+  /// A `maxSize` of 0 disables eviction.
+  CompilationCache(const std::string& directory, std::uintmax_t maxSize);
+
+  /// @brief Compute the cache key of compiling `sir` with `options`
+  /// @see computeSIRFingerprint
+  static std::string computeKey(const SIR& sir, const Options& options);
+
+  /// @brief Get the translation unit of `key` and append the diagnostics stored with it to
+  /// `diagnostics` (if given)
+  /// @returns `nullptr` if there is no (valid) entry
+  std::unique_ptr<codegen::TranslationUnit>
+  lookup(const std::string& key, std::vector<DiagnosticsMessage>* diagnostics = nullptr);
+
+  /// @brief Store the translation unit and the `diagnostics` of its compilation under `key` and
+  /// evict old entries if necessary
+  /// @returns `true` on success
+  bool store(const std::string& key, const codegen::TranslationUnit& translationUnit,
+             const std::vector<DiagnosticsMessage>& diagnostics = {});
+
+  /// @brief Get the directory of the cache
+  const std::string& getDirectory() const { return directory_; }
+
+  /// @brief Get the statistics of this cache object (not persisted)
+  Statistics getStatistics() const;
+
+private:
+  std::string getEntryPath(const std::string& key) const;
+  void evict();
+
+  std::string directory_;
+  std::uintmax_t maxSize_;
+  Statistics statistics_;
+  mutable std::mutex mutex_;
+};
+
+} // namespace dawn
+
+#endif
@@ -0,0 +1,422 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/CompileServer.h"
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/SIRSerializer.h"
+#include "dawn/Support/Format.h"
+#include "dawn/Support/IndexGenerator.h"
+#include "dawn/Support/Logging.h"
+#include "dawn/Support/Parallel.h"
+#include "dawn/Support/StringRef.h"
+#include "dawn/Support/UIDGenerator.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace dawn {
+
+namespace server {
+
+namespace {
+
+struct MessageHeader {
+  std::uint32_t Kind;
+  std::uint64_t Size;
+};
+
+/// @brief Send `request` to the server at `socketPath` and receive its response
+Message request(const std::string& socketPath, const Message& request,
+                MessageKind expectedResponse) {
+  UnixSocket socket = UnixSocket::connect(socketPath);
+  Message response;
+  if(!sendMessage(socket, request) || receiveMessage(socket, response) != RS_Received)
+    throw std::runtime_error("lost connection to the compile server '" + socketPath + "'");
+  if(response.Kind == MK_Error)
+    throw std::runtime_error("compile server '" + socketPath +
+                             "' rejected the request: " + response.Payload);
+  if(response.Kind != expectedResponse)
+    throw std::runtime_error("invalid response of the compile server '" + socketPath + "'");
+  return response;
+}
+
+} // anonymous namespace
+
+bool sendMessage(const UnixSocket& socket, const Message& message) {
+  MessageHeader header{message.Kind, message.Payload.size()};
+  return socket.sendAll(&header.Kind, sizeof(header.Kind)) &&
+         socket.sendAll(&header.Size, sizeof(header.Size)) &&
+         socket.sendAll(message.Payload.data(), message.Payload.size());
+}
+
+ReceiveStatus receiveMessage(const UnixSocket& socket, Message& message) {
+  MessageHeader header;
+  if(!socket.receiveAll(&header.Kind, sizeof(header.Kind)) ||
+     !socket.receiveAll(&header.Size, sizeof(header.Size)))
+    return RS_ConnectionLost;
+
+  // The size comes from the peer, don't let it make us allocate arbitrary amounts of memory
+  message.Kind = static_cast<MessageKind>(header.Kind);
+  message.Payload.clear();
+  if(header.Size > MaxPayloadSize)
+    return RS_PayloadTooLarge;
+
+  message.Payload.resize(header.Size);
+  return socket.receiveAll(&message.Payload[0], header.Size) ? RS_Received : RS_ConnectionLost;
+}
+
+json::json optionsToJson(const Options& options) {
+  const Options defaults;
+  json::json node = json::json::object();
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(options.NAME != defaults.NAME)                                                                \
+    node[#NAME] = options.NAME;
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+  return node;
+}
+
+Options optionsFromJson(const json::json& node) {
+  Options options;
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(node.count(#NAME))                                                                            \
+    options.NAME = node.at(#NAME).get<TYPE>();
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+  return options;
+}
+
+std::string encodeCompileRequest(const std::string& SIR, const Options& options) {
+  std::string payload = optionsToJson(options).dump();
+  payload.push_back('\0');
+  payload += SIR;
+  return payload;
+}
+
+void decodeCompileRequest(const std::string& payload, std::string& SIR, Options& options) {
+  std::size_t pos = payload.find('\0');
+  if(pos == std::string::npos)
+    throw std::runtime_error("invalid compile request");
+  options = optionsFromJson(json::json::parse(payload.substr(0, pos)));
+  SIR = payload.substr(pos + 1);
+}
+
+std::string encodeCompileResult(const CompileResult& result) {
+  json::json node;
+  if(result.TranslationUnit) {
+    const codegen::TranslationUnit& TU = *result.TranslationUnit;
+    node["translation_unit"]["filename"] = TU.getFilename();
+    node["translation_unit"]["pp_defines"] = TU.getPPDefines();
+    node["translation_unit"]["globals"] = TU.getGlobals();
+    node["translation_unit"]["stencils"] = TU.getStencils();
+  }
+
+  node["diagnostics"] = json::json::array();
+  for(const auto& diag : result.Diagnostics) {
+    json::json diagNode;
+    diagNode["kind"] = static_cast<int>(diag.getDiagKind());
+    diagNode["line"] = diag.getSourceLocation().Line;
+    diagNode["column"] = diag.getSourceLocation().Column;
+    diagNode["filename"] = diag.getFilename();
+    diagNode["message"] = diag.getMessage();
+    node["diagnostics"].push_back(diagNode);
+  }
+
+  node["error"] = result.Error;
+  return node.dump();
+}
+
+CompileResult decodeCompileResult(const std::string& payload) {
+  json::json node = json::json::parse(payload);
+  CompileResult result;
+
+  if(node.count("translation_unit")) {
+    const json::json& TU = node.at("translation_unit");
+    result.TranslationUnit = std::make_unique<codegen::TranslationUnit>(
+        TU.at("filename").get<std::string>(), TU.at("pp_defines").get<std::vector<std::string>>(),
+        TU.at("stencils").get<std::map<std::string, std::string>>(),
+        TU.at("globals").get<std::string>());
+  }
+
+  for(const auto& diagNode : node.at("diagnostics"))
+    result.Diagnostics.emplace_back(
+        static_cast<DiagnosticsKind>(diagNode.at("kind").get<int>()),
+        SourceLocation(diagNode.at("line").get<int>(), diagNode.at("column").get<int>()),
+        diagNode.at("filename").get<std::string>(), diagNode.at("message").get<std::string>());
+
+  result.Error = node.at("error").get<std::string>();
+  return result;
+}
+
+CompileResult compile(const std::string& socketPath, const std::string& SIR,
+                      const Options& options) {
+  Message response =
+      request(socketPath, Message{MK_Compile, encodeCompileRequest(SIR, options)}, MK_CompileResult);
+  return decodeCompileResult(response.Payload);
+}
+
+json::json getStatistics(const std::string& socketPath) {
+  return json::json::parse(
+      request(socketPath, Message{MK_Statistics, ""}, MK_StatisticsResult).Payload);
+}
+
+void shutdown(const std::string& socketPath) {
+  request(socketPath, Message{MK_Shutdown, ""}, MK_ShutdownResult);
+}
+
+} // namespace server
+
+namespace {
+
+/// @brief Check if the option `name` makes the compiler read or write files besides its caches
+bool isLocalFileOption(StringRef name) {
+  return name == "OutputFile" || name == "SerializeIIR" || name == "DeserializeIIR" ||
+         name == "PassProfile" || name == "PassVerbose" || name.startswith("Report") ||
+         name.startswith("Dump");
+}
+
+/// @brief Reset the options which would make the server read or write files on behalf of the
+/// client, returns the command-line names of the reset options
+///
+/// `OutputFile` is reset silently: it only names the serialized IIR and clients commonly set it.
+std::vector<std::string> resetLocalFileOptions(Options& options) {
+  const Options defaults;
+  std::vector<std::string> reset;
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(isLocalFileOption(#NAME) && options.NAME != defaults.NAME) {                                  \
+    options.NAME = defaults.NAME;                                                                  \
+    if(StringRef(#NAME) != "OutputFile")                                                           \
+      reset.push_back(OPTION);                                                                     \
+  }
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+  return reset;
+}
+
+/// @brief Check if `accept` failed because the server ran out of resources, which may become
+/// available again once connections are closed
+bool isTransientAcceptError(int error) {
+  return error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM;
+}
+
+} // anonymous namespace
+
+json::json CompileServer::Statistics::jsonDump() const {
+  json::json node;
+  node["workers"] = Workers;
+  node["uptime"] = Uptime;
+  node["requests"] = Requests;
+  node["failed_compilations"] = FailedCompilations;
+  node["average_latency"] = Requests != 0 ? TotalLatency / Requests : 0.0;
+  node["max_latency"] = MaxLatency;
+  node["queue_depth"] = QueueDepth;
+  node["max_queue_depth"] = MaxQueueDepth;
+  return node;
+}
+
+CompileServer::CompileServer(const std::string& socketPath, int numWorkers,
+                             std::size_t queueCapacity)
+    : socketPath_(socketPath), numWorkers_(getNumWorkerThreads(numWorkers)),
+      queueCapacity_(std::max<std::size_t>(queueCapacity, 1)),
+      listenSocket_(UnixSocket::listen(socketPath)), shutdown_(false), start_(Clock::now()) {}
+
+CompileServer::~CompileServer() {
+  listenSocket_.close();
+  std::remove(socketPath_.c_str());
+}
+
+void CompileServer::run() {
+  DAWN_LOG(INFO) << "Compile server listening at `" << socketPath_ << "` with " << numWorkers_
+                 << " workers";
+
+  std::vector<std::thread> workers;
+  for(int i = 0; i < numWorkers_; ++i)
+    workers.emplace_back([this] { work(); });
+
+  const auto minBackoff = std::chrono::milliseconds(10);
+  const auto maxBackoff = std::chrono::milliseconds(1000);
+  auto backoff = minBackoff;
+
+  while(waitForQueueSpace()) {
+    UnixSocket connection = listenSocket_.accept();
+    if(!connection.isValid()) {
+      const int error = errno;
+      if(shutdown_)
+        break;
+
+      // The client went away before we accepted it
+      if(error == ECONNABORTED || error == EPROTO)
+        continue;
+
+      if(isTransientAcceptError(error)) {
+        DAWN_LOG(WARNING) << "Compile server: cannot accept connection: " << std::strerror(error)
+                          << ", retrying in " << backoff.count() << " ms";
+        std::this_thread::sleep_for(backoff);
+        backoff = std::min(2 * backoff, maxBackoff);
+        continue;
+      }
+
+      DAWN_LOG(ERROR) << "Compile server: cannot accept connections: " << std::strerror(error);
+      shutdown_ = true;
+      break;
+    }
+    backoff = minBackoff;
+
+    // Don't let a stalled client block a worker forever
+    connection.setTimeout(60);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.emplace_back(std::move(connection), Clock::now());
+    statistics_.QueueDepth = queue_.size();
+    statistics_.MaxQueueDepth = std::max(statistics_.MaxQueueDepth, queue_.size());
+    queueCondition_.notify_one();
+  }
+
+  queueCondition_.notify_all();
+  for(auto& worker : workers)
+    worker.join();
+
+  DAWN_LOG(INFO) << "Compile server shut down";
+}
+
+void CompileServer::shutdown() {
+  shutdown_ = true;
+  listenSocket_.shutdown();
+}
+
+bool CompileServer::waitForQueueSpace() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  // `shutdown` may be called from a signal handler and thus cannot notify us, poll the flag instead
+  while(!shutdown_ && queue_.size() >= queueCapacity_)
+    queueSpaceCondition_.wait_for(lock, std::chrono::milliseconds(100));
+  return !shutdown_;
+}
+
+CompileServer::Statistics CompileServer::getStatistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  Statistics statistics = statistics_;
+  statistics.Workers = numWorkers_;
+  statistics.Uptime = std::chrono::duration<double>(Clock::now() - start_).count();
+  return statistics;
+}
+
+void CompileServer::work() {
+  DawnCompiler compiler;
+
+  while(true) {
+    std::pair<UnixSocket, Clock::time_point> entry;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      queueCondition_.wait(lock, [this] { return shutdown_ || !queue_.empty(); });
+      if(queue_.empty())
+        return;
+      entry = std::move(queue_.front());
+      queue_.pop_front();
+      statistics_.QueueDepth = queue_.size();
+    }
+    queueSpaceCondition_.notify_one();
+
+    // A misbehaving client must only lose its own connection, not take down the server
+    try {
+      serve(entry.first, entry.second, compiler);
+    } catch(std::exception& e) {
+      DAWN_LOG(WARNING) << "Compile server: dropping connection: " << e.what();
+    }
+  }
+}
+
+void CompileServer::serve(UnixSocket& connection, Clock::time_point accepted,
+                          DawnCompiler& compiler) {
+  using namespace server;
+
+  Message request;
+  switch(receiveMessage(connection, request)) {
+  case RS_Received:
+    break;
+  case RS_ConnectionLost:
+    return;
+  case RS_PayloadTooLarge:
+    DAWN_LOG(WARNING) << "Compile server: rejecting message larger than " << MaxPayloadSize
+                      << " bytes";
+    sendMessage(connection, Message{MK_Error, dawn::format("payload exceeds the limit of %i bytes",
+                                                           MaxPayloadSize)});
+    return;
+  }
+
+  Message response;
+  switch(request.Kind) {
+  case MK_Compile: {
+    CompileResult result;
+    try {
+      std::string SIR;
+      decodeCompileRequest(request.Payload, SIR, compiler.getOptions());
+
+      // The client has no access to files written by the server (and must not read its files)
+      for(const auto& option : resetLocalFileOptions(compiler.getOptions()))
+        result.Diagnostics.emplace_back(
+            DiagnosticsKind::Warning, SourceLocation(), "",
+            dawn::format("option '-%s' is ignored by the compile server", option));
+
+      // Number the identifiers as a freshly started compiler would
+      UIDGenerator::Scope uidScope(1, INT_MAX - 1);
+      IndexGenerator::Scope indexScope(0, ULONG_MAX);
+
+      compiler.getDiagnostics().clear();
+      result.TranslationUnit =
+          compiler.compile(SIRSerializer::deserializeFromString(SIR, SIRSerializer::SK_Byte));
+
+      for(const auto& diag : compiler.getDiagnostics().getQueue().queue())
+        result.Diagnostics.push_back(*diag);
+      if(!result.TranslationUnit || compiler.getDiagnostics().hasErrors()) {
+        result.TranslationUnit = nullptr;
+        result.Error = "compilation failed";
+      }
+    } catch(std::exception& e) {
+      result.TranslationUnit = nullptr;
+      result.Error = e.what();
+    }
+    response = Message{MK_CompileResult, encodeCompileResult(result)};
+
+    // Update the statistics before responding, the client may query them right away
+    const double latency =
+        std::chrono::duration<double, std::milli>(Clock::now() - accepted).count();
+    std::lock_guard<std::mutex> lock(mutex_);
+    statistics_.Requests++;
+    statistics_.FailedCompilations += !result.Error.empty();
+    statistics_.TotalLatency += latency;
+    statistics_.MaxLatency = std::max(statistics_.MaxLatency, latency);
+    break;
+  }
+  case MK_Statistics:
+    response = Message{MK_StatisticsResult, getStatistics().jsonDump().dump()};
+    break;
+  case MK_Shutdown:
+    response = Message{MK_ShutdownResult, ""};
+    shutdown();
+    break;
+  default:
+    DAWN_LOG(WARNING) << "Compile server: rejecting message of unknown kind " << request.Kind;
+    response = Message{MK_Error, dawn::format("unknown message kind %i", request.Kind)};
+    break;
+  }
+
+  sendMessage(connection, response);
+}
+
+} // namespace dawn
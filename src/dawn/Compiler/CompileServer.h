@@ -0,0 +1,207 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_COMPILER_COMPILESERVER_H
+#define DAWN_COMPILER_COMPILESERVER_H
+
+#include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/Support/DiagnosticsMessage.h"
+#include "dawn/Support/Json.h"
+#include "dawn/Support/NonCopyable.h"
+#include "dawn/Support/UnixSocket.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dawn {
+
+class DawnCompiler;
+
+/// @brief Protocol between the compile server and its clients
+///
+/// A client connects to the socket of the server, sends a single request message and receives a
+/// single response message. Each message consists of a header (the `MessageKind` as 32-bit and the
+/// size of the payload as 64-bit integer in native byte order) followed by the payload:
+///
+///   - `MK_Compile`: the options as JSON object, a zero byte and the byte serialized SIR
+///   - `MK_CompileResult`: JSON object with the translation unit, the diagnostics and the error
+///   - `MK_Statistics`, `MK_Shutdown`: empty
+///   - `MK_StatisticsResult`: JSON object with the statistics of the server
+///   - `MK_Error`: the reason why the server rejected the request (e.g a payload larger than
+///     `MaxPayloadSize`), the server closes the connection afterwards
+///
+/// @ingroup compiler
+namespace server {
+
+enum MessageKind : std::uint32_t {
+  MK_Compile = 1,
+  MK_CompileResult,
+  MK_Statistics,
+  MK_StatisticsResult,
+  MK_Shutdown,
+  MK_ShutdownResult,
+  MK_Error
+};
+
+/// @brief Largest payload accepted by `receiveMessage` (1 GiB)
+constexpr std::uint64_t MaxPayloadSize = std::uint64_t(1) << 30;
+
+struct Message {
+  MessageKind Kind;
+  std::string Payload;
+};
+
+/// @brief Send `message` over `socket`
+bool sendMessage(const UnixSocket& socket, const Message& message);
+
+enum ReceiveStatus { RS_Received, RS_ConnectionLost, RS_PayloadTooLarge };
+
+/// @brief Receive a message from `socket`
+///
+/// The payload of a message larger than `MaxPayloadSize` is not received (only `Kind` is set).
+ReceiveStatus receiveMessage(const UnixSocket& socket, Message& message);
+
+/// @brief Outcome of the compilation of a SIR
+struct CompileResult {
+  std::unique_ptr<codegen::TranslationUnit> TranslationUnit; ///< `nullptr` on failure
+  std::vector<DiagnosticsMessage> Diagnostics;
+  std::string Error; ///< Empty on success
+};
+
+/// @brief Convert the options to JSON (options with their default value are omitted)
+json::json optionsToJson(const Options& options);
+
+/// @brief Convert the JSON object to options (missing options have their default value)
+Options optionsFromJson(const json::json& node);
+
+std::string encodeCompileRequest(const std::string& SIR, const Options& options);
+void decodeCompileRequest(const std::string& payload, std::string& SIR, Options& options);
+
+std::string encodeCompileResult(const CompileResult& result);
+CompileResult decodeCompileResult(const std::string& payload);
+
+/// @brief Compile the byte serialized `SIR` on the server listening at `socketPath`
+/// @throws std::runtime_error  The server cannot be reached, rejects the request or the response
+///                             is invalid
+CompileResult compile(const std::string& socketPath, const std::string& SIR,
+                      const Options& options);
+
+/// @brief Get the statistics of the server listening at `socketPath`
+/// @throws std::runtime_error  The server cannot be reached, rejects the request or the response
+///                             is invalid
+json::json getStatistics(const std::string& socketPath);
+
+/// @brief Ask the server listening at `socketPath` to shut down
+/// @throws std::runtime_error  The server cannot be reached
+void shutdown(const std::string& socketPath);
+
+} // namespace server
+
+/// @brief Server which compiles SIRs sent over a Unix domain socket
+///
+/// Avoids the start-up cost of the compiler (loading the library, initializing protobuf, ...) for
+/// every compilation. Incoming connections are queued and served by a fixed number of workers,
+/// each of which keeps its own `DawnCompiler` (and thus its compilation cache) alive.
+///
+/// Every request is compiled as if by a freshly started compiler, i.e the generated code does not
+/// depend on the previous requests. Relative paths in the options (e.g `CacheDir`) are relative to
+/// the working directory of the server. The server only returns the translation unit: options which
+/// make the compiler read or write other files (e.g `OutputFile`, `SerializeIIR`, `PassProfile` or
+/// the reports and dumps) are reset and the client is warned about each ignored option.
+///
+/// At most `queueCapacity` connections wait for a worker, further clients are left in the backlog
+/// of the socket until a worker becomes available.
+///
+/// @ingroup compiler
+class CompileServer : NonCopyable {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief Default maximal number of connections waiting for a worker
+  static constexpr std::size_t DefaultQueueCapacity = 64;
+
+  struct Statistics {
+    int Workers = 0;                      ///< Number of workers
+    double Uptime = 0.0;                  ///< Time since the server was started (in s)
+    std::uint64_t Requests = 0;           ///< Number of compile requests
+    std::uint64_t FailedCompilations = 0; ///< Number of compile requests which failed
+    double TotalLatency = 0.0;            ///< Sum of the latencies of the compilations (in ms)
+    double MaxLatency = 0.0;              ///< Maximal latency of a compilation (in ms)
+    std::size_t QueueDepth = 0;           ///< Number of connections waiting for a worker
+    std::size_t MaxQueueDepth = 0;        ///< Maximal number of connections waiting for a worker
+
+    json::json jsonDump() const;
+  };
+
+private:
+  std::string socketPath_;
+  int numWorkers_;
+  std::size_t queueCapacity_;
+  UnixSocket listenSocket_;
+  std::atomic<bool> shutdown_;
+
+  /// Accepted connections together with the time they were accepted
+  std::deque<std::pair<UnixSocket, Clock::time_point>> queue_;
+  std::condition_variable queueCondition_;
+  std::condition_variable queueSpaceCondition_;
+  mutable std::mutex mutex_;
+  Statistics statistics_;
+  Clock::time_point start_;
+
+  void serve(UnixSocket& connection, Clock::time_point accepted, DawnCompiler& compiler);
+  void work();
+
+  /// @brief Wait until the queue can take another connection, returns `false` on shutdown
+  bool waitForQueueSpace();
+
+public:
+  /// @brief Create a server listening at `socketPath` with `numWorkers` workers (`<= 0` uses one
+  /// worker per hardware thread) and at most `queueCapacity` connections waiting for a worker
+  /// @throws std::runtime_error  The socket cannot be created
+  CompileServer(const std::string& socketPath, int numWorkers,
+                std::size_t queueCapacity = DefaultQueueCapacity);
+  ~CompileServer();
+
+  /// @brief Serve requests until the server is shut down
+  void run();
+
+  /// @brief Stop accepting requests, `run` returns once the pending requests are handled
+  ///
+  /// This function is async-signal-safe.
+  void shutdown();
+
+  /// @brief Get the path of the socket
+  const std::string& getSocketPath() const { return socketPath_; }
+
+  /// @brief Get the number of workers
+  int getNumWorkers() const { return numWorkers_; }
+
+  /// @brief Get the maximal number of connections waiting for a worker
+  std::size_t getQueueCapacity() const { return queueCapacity_; }
+
+  /// @brief Get the statistics of the compile requests handled so far
+  Statistics getStatistics() const;
+};
+
+} // namespace dawn
+
+#endif
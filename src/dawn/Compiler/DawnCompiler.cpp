@@ -15,9 +15,12 @@
 #include "dawn/Compiler/DawnCompiler.h"
 #include "dawn/CodeGen/CXXNaive-ico/CXXNaiveCodeGen.h"
 #include "dawn/CodeGen/CXXNaive/CXXNaiveCodeGen.h"
+#include "dawn/CodeGen/CXXOpt/CXXOptCodeGen.h"
 #include "dawn/CodeGen/CodeGen.h"
 #include "dawn/CodeGen/Cuda/CudaCodeGen.h"
 #include "dawn/CodeGen/GridTools/GTCodeGen.h"
+#include "dawn/Compiler/Fingerprint.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/Optimizer/PassComputeStageExtents.h"
 #include "dawn/Optimizer/PassDataLocalityMetric.h"
@@ -44,11 +47,20 @@
 #include "dawn/Optimizer/PassTemporaryType.h"
 #include "dawn/SIR/SIR.h"
 #include "dawn/Serialization/IIRSerializer.h"
+#include "dawn/Serialization/SIRSerializer.h"
 #include "dawn/Support/EditDistance.h"
+#include "dawn/Support/IndexGenerator.h"
 #include "dawn/Support/Logging.h"
+#include "dawn/Support/Parallel.h"
+#include "dawn/Support/StringRef.h"
 #include "dawn/Support/StringSwitch.h"
 #include "dawn/Support/StringUtil.h"
+#include "dawn/Support/UIDGenerator.h"
 #include "dawn/Support/Unreachable.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <map>
 
 namespace dawn {
 
@@ -117,6 +129,25 @@ static std::string remove_fileextension(std::string fullName, std::string extens
   return truncation;
 }
 
+static bool isOptionSet(bool value) { return value; }
+static bool isOptionSet(int value) { return value != 0; }
+static bool isOptionSet(const std::string& value) { return !value.empty(); }
+
+/// @brief Check if the options request any output besides the generated code (reports, dumps,
+/// serialized IIR, ...)
+static bool hasSideEffects(const Options& options) {
+  if(options.SerializeIIR || !options.DeserializeIIR.empty() || !options.PassProfile.empty() ||
+     options.PassVerbose)
+    return true;
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if((StringRef(#NAME).startswith("Report") || StringRef(#NAME).startswith("Dump")) &&            \
+     isOptionSet(options.NAME))                                                                    \
+    return true;
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+  return false;
+}
+
 static OptimizerContext::OptimizerContextOptions
 createOptimizerOptionsFromAllOptions(const Options& options) {
   OptimizerContext::OptimizerContextOptions retval;
@@ -127,7 +158,8 @@ createOptimizerOptionsFromAllOptions(const Options& options) {
   return retval;
 }
 
-DawnCompiler::DawnCompiler(Options* options) : diagnostics_(std::make_unique<DiagnosticsEngine>()) {
+DawnCompiler::DawnCompiler(const Options* options)
+    : diagnostics_(std::make_unique<DiagnosticsEngine>()) {
   options_ = options ? std::make_unique<Options>(*options) : std::make_unique<Options>();
 }
 
@@ -157,6 +189,19 @@ std::unique_ptr<OptimizerContext> DawnCompiler::runOptimizer(std::shared_ptr<SIR
   // -max-fields
   int maxFields = options_->MaxFieldsPerStencil;
 
+  // -block-size
+  std::array<unsigned int, 3> blockSize;
+  if(!options_->block_size.empty() &&
+     !PassSetBlockSize::parseBlockSize(options_->block_size, blockSize)) {
+    diagnostics_->report(buildDiag("-block-size", options_->block_size,
+                                   "expected three positive integers '<i>,<j>,<k>'"));
+    return nullptr;
+  }
+
+  // The block size is chosen for the CPU tiles of the c++-opt backend, for GPU blocks otherwise
+  const PassSetBlockSize::TargetKind blockSizeTarget =
+      options_->Backend == "c++-opt" ? PassSetBlockSize::TK_CPU : PassSetBlockSize::TK_GPU;
+
   IIRSerializer::SerializationKind serializationKind = IIRSerializer::SK_Json;
   if(options_->SerializeIIR || (options_->DeserializeIIR != "")) {
     if(options_->IIRFormat == "json") {
@@ -177,6 +222,29 @@ std::unique_ptr<OptimizerContext> DawnCompiler::runOptimizer(std::shared_ptr<SIR
 
   if(options_->DeserializeIIR == "") {
     optimizer = std::make_unique<OptimizerContext>(getDiagnostics(), optimizerOptions, SIR);
+
+    if(!options_->IncrementalDir.empty() &&
+       (!incremental_ || incremental_->getDirectory() != options_->IncrementalDir))
+      incremental_ = std::make_unique<IncrementalCompilation>(options_->IncrementalDir);
+
+    // In incremental mode, the stencils which did not change since the last compilation reuse their
+    // optimized IIR. Only the remaining ones are built from the SIR and optimized.
+    std::map<std::string, std::string> stencilFingerprints;
+    if(!options_->IncrementalDir.empty()) {
+      for(const auto& stencil : SIR->Stencils) {
+        if(stencil->Attributes.has(sir::Attr::AK_NoCodeGen))
+          continue;
+
+        std::string fingerprint = computeStencilFingerprint(*SIR, stencil->Name, *options_);
+        auto restored = incremental_->load(stencil->Name, fingerprint, *optimizer);
+        if(restored && optimizer->restoreOptimizedIIR(restored)) {
+          DAWN_LOG(INFO) << "Reusing optimized IIR of `" << stencil->Name << "`";
+          continue;
+        }
+        stencilFingerprints.emplace(stencil->Name, std::move(fingerprint));
+      }
+    }
+
     optimizer->fillIIR();
 
     // Setup pass interface
@@ -192,7 +260,7 @@ std::unique_ptr<OptimizerContext> DawnCompiler::runOptimizer(std::shared_ptr<SIR
     optimizer->checkAndPushBack<PassSetStageName>();
     optimizer->checkAndPushBack<PassSetStageGraph>();
     optimizer->checkAndPushBack<PassStageReordering>(reorderStrategy);
-    optimizer->checkAndPushBack<PassStageMerger>();
+    optimizer->checkAndPushBack<PassStageMerger>(blockSizeTarget);
     optimizer->checkAndPushBack<PassStencilSplitter>(maxFields);
     optimizer->checkAndPushBack<PassTemporaryType>();
     optimizer->checkAndPushBack<PassTemporaryMerger>();
@@ -205,7 +273,7 @@ std::unique_ptr<OptimizerContext> DawnCompiler::runOptimizer(std::shared_ptr<SIR
     optimizer->checkAndPushBack<PassSetCaches>();
     optimizer->checkAndPushBack<PassComputeStageExtents>();
     optimizer->checkAndPushBack<PassSetBoundaryCondition>();
-    optimizer->checkAndPushBack<PassSetBlockSize>();
+    optimizer->checkAndPushBack<PassSetBlockSize>(blockSizeTarget);
     optimizer->checkAndPushBack<PassDataLocalityMetric>();
     optimizer->checkAndPushBack<PassSetSyncStage>();
     // Since both cuda code generation as well as serialization do not support stencil-functions, we
@@ -219,19 +287,115 @@ std::unique_ptr<OptimizerContext> DawnCompiler::runOptimizer(std::shared_ptr<SIR
       DAWN_LOG(INFO) << a->getName();
     }
 
-    int i = 0;
-    for(auto& stencil : optimizer->getStencilInstantiationMap()) {
+    std::vector<std::shared_ptr<iir::StencilInstantiation>> instantiations;
+    for(auto& stencil : optimizer->getStencilInstantiationMap())
+      if(options_->IncrementalDir.empty() || stencilFingerprints.count(stencil.first))
+        instantiations.push_back(stencil.second);
+    const std::size_t numInstantiations = instantiations.size();
+
+    // With more than one job, each instantiation draws its identifiers from a private range which
+    // is reserved up-front, so that the identifiers do not depend on the thread scheduling. The
+    // ranges are carved out of the active scope of the generators, if any (see
+    // `dawnCompileBatch`). Once all instantiations are optimized, their identifiers are renumbered
+    // to the ones a single job, which draws them one instantiation after the other, would have
+    // given. The output (e.g. `__tmp_<name>_<AccessID>` or `__code_gen_<StencilID>`) is hence the
+    // same for any number of jobs.
+    const bool reserveRanges = options_->OptimizerJobs != 1 && numInstantiations > 1;
+    const int uidBase = UIDGenerator::getInstance()->peek();
+    const int uidRange = !reserveRanges
+                             ? 0
+                             : std::min(1 << 24, UIDGenerator::getInstance()->getNumAvailable() /
+                                                     static_cast<int>(numInstantiations));
+    const long unsigned int indexBase = IndexGenerator::Instance().peek();
+    const long unsigned int indexRange =
+        !reserveRanges
+            ? 0
+            : std::min(1ul << 24, IndexGenerator::Instance().getNumAvailable() / numInstantiations);
+
+    std::vector<int> uidNext(numInstantiations, uidBase);
+    std::vector<long unsigned int> indexNext(numInstantiations, indexBase);
+    std::atomic<bool> failed(false);
+
+    parallelFor(numInstantiations, options_->OptimizerJobs, [&](std::size_t idx) {
+      // Like in a serial run, stop processing as soon as one of the instantiations failed
+      if(failed)
+        return;
+
+      std::unique_ptr<UIDGenerator::Scope> uidScope;
+      std::unique_ptr<IndexGenerator::Scope> indexScope;
+      if(reserveRanges) {
+        uidScope = std::make_unique<UIDGenerator::Scope>(
+            uidBase + static_cast<int>(idx) * uidRange, uidRange);
+        indexScope =
+            std::make_unique<IndexGenerator::Scope>(indexBase + idx * indexRange, indexRange);
+      }
+
       // Run optimization passes
-      std::shared_ptr<iir::StencilInstantiation> instantiation = stencil.second;
+      const std::shared_ptr<iir::StencilInstantiation>& instantiation = instantiations[idx];
 
       DAWN_LOG(INFO) << "Starting Optimization and Analysis passes for `"
                      << instantiation->getName() << "` ...";
-      if(!optimizer->getPassManager().runAllPassesOnStecilInstantiation(*optimizer, instantiation))
-        return nullptr;
+      if(!optimizer->getPassManager().runAllPassesOnStecilInstantiation(*optimizer,
+                                                                         instantiation)) {
+        failed = true;
+        return;
+      }
 
       DAWN_LOG(INFO) << "Done with Optimization and Analysis passes for `"
                      << instantiation->getName() << "`";
 
+      if(reserveRanges) {
+        uidNext[idx] = uidScope->getNext();
+        indexNext[idx] = indexScope->getNext();
+      }
+    });
+
+    if(!options_->PassProfile.empty()) {
+      const PassProfiler& profiler = optimizer->getPassManager().getProfiler();
+      profiler.writeReport(options_->PassProfile);
+      profiler.writeChromeTrace(options_->PassProfile + ".trace.json");
+    }
+
+    if(failed)
+      return nullptr;
+
+    // Move the identifiers of each instantiation right after the ones of its predecessor and
+    // continue numbering after the identifiers of the last instantiation
+    if(reserveRanges) {
+      int uidStart = uidBase;
+      long unsigned int indexStart = indexBase;
+      for(std::size_t idx = 0; idx < numInstantiations; ++idx) {
+        const int uidFrom = uidBase + static_cast<int>(idx) * uidRange;
+        const long unsigned int indexFrom = indexBase + idx * indexRange;
+        const int uidCount = uidNext[idx] - uidFrom;
+        const long unsigned int indexCount = indexNext[idx] - indexFrom;
+        if(uidFrom != uidStart || indexFrom != indexStart)
+          instantiations[idx]->renumberIDs(
+              iir::IDRenumbering(uidFrom, uidStart, uidCount, indexFrom, indexStart, indexCount));
+        uidStart += uidCount;
+        indexStart += indexCount;
+      }
+      UIDGenerator::getInstance()->set(uidStart);
+      IndexGenerator::Instance().set(indexStart);
+    }
+
+    // The IIR serializer does not support stencil functions, instantiations which still call
+    // stencil functions are optimized again by the next compilation
+    if(!options_->IncrementalDir.empty())
+      for(const auto& instantiation : instantiations) {
+        if(!instantiation->getMetaData().getStencilFunctionInstantiations().empty()) {
+          DAWN_LOG(INFO) << "Not storing optimized IIR of `" << instantiation->getName()
+                         << "` as it calls stencil functions";
+          continue;
+        }
+        incremental_->store(instantiation->getName(),
+                            stencilFingerprints.at(instantiation->getName()), instantiation);
+      }
+
+    std::size_t i = 0;
+    for(const auto& stencil : optimizer->getStencilInstantiationMap()) {
+      const std::shared_ptr<iir::StencilInstantiation>& instantiation = stencil.second;
+
       if(options_->SerializeIIR) {
         const std::string originalFileName = remove_fileextension(
             options_->OutputFile.empty() ? instantiation->getMetaData().getFileName()
@@ -239,11 +403,11 @@ std::unique_ptr<OptimizerContext> DawnCompiler::runOptimizer(std::shared_ptr<SIR
             ".cpp");
         IIRSerializer::serialize(originalFileName + "." + std::to_string(i) + ".iir", instantiation,
                                  serializationKind);
-        i++;
       }
       if(options_->DumpStencilInstantiation) {
         instantiation->dump();
       }
+      ++i;
     }
   } else {
     optimizer = std::make_unique<OptimizerContext>(getDiagnostics(), optimizerOptions, nullptr);
@@ -268,6 +432,34 @@ std::unique_ptr<codegen::TranslationUnit> DawnCompiler::compile(const std::share
     return nullptr;
   }
 
+  // -cache-max-size
+  if(options_->CacheMaxSize < 0) {
+    diagnostics_->report(
+        buildDiag("-cache-max-size", options_->CacheMaxSize, "cache size must be >= 0"));
+    return nullptr;
+  }
+
+  if(!options_->TuningDB.empty())
+    return compileTuned(SIR);
+
+  // Look up the generated code in the compilation cache. Options which produce side-effects besides
+  // the generated code bypass the cache.
+  std::string cacheKey;
+  if(!options_->CacheDir.empty() && !hasSideEffects(*options_)) {
+    if(!cache_ || cache_->getDirectory() != options_->CacheDir)
+      cache_ = std::make_unique<CompilationCache>(
+          options_->CacheDir, static_cast<std::uintmax_t>(options_->CacheMaxSize) << 20);
+
+    cacheKey = CompilationCache::computeKey(*SIR, *options_);
+    std::vector<DiagnosticsMessage> diagnostics;
+    if(auto translationUnit = cache_->lookup(cacheKey, &diagnostics)) {
+      DAWN_LOG(INFO) << "Found `" << SIR->Filename << "` in compilation cache (" << cacheKey << ")";
+      for(const auto& diag : diagnostics)
+        diagnostics_->report(diag);
+      return translationUnit;
+    }
+  }
+
   // Initialize optimizer
   auto optimizer = runOptimizer(SIR);
 
@@ -294,7 +486,9 @@ std::unique_ptr<codegen::TranslationUnit> DawnCompiler::compile(const std::share
         optimizer->getStencilInstantiationMap(), *diagnostics_, options_->MaxHaloPoints,
         options_->nsms, options_->maxBlocksPerSM, options_->domain_size);
   } else if(options_->Backend == "c++-opt") {
-    dawn_unreachable("GTClangOptCXX not supported yet");
+    CG = std::make_unique<codegen::cxxopt::CXXOptCodeGen>(optimizer->getStencilInstantiationMap(),
+                                                          *diagnostics_, options_->MaxHaloPoints,
+                                                          options_->SIMDWidth);
   } else {
     diagnostics_->report(buildDiag("-backend", options_->Backend,
                                    "backend options must be : " +
@@ -303,7 +497,107 @@ std::unique_ptr<codegen::TranslationUnit> DawnCompiler::compile(const std::share
     return nullptr;
   }
 
-  return CG->generateCode();
+  CG->setNumThreads(options_->CodeGenJobs);
+  auto translationUnit = CG->generateCode();
+
+  if(translationUnit && !cacheKey.empty() && !diagnostics_->hasErrors()) {
+    std::vector<DiagnosticsMessage> diagnostics;
+    for(const auto& diag : diagnostics_->getQueue().queue())
+      diagnostics.push_back(*diag);
+    cache_->store(cacheKey, *translationUnit, diagnostics);
+  }
+
+  return translationUnit;
+}
+
+std::unique_ptr<codegen::TranslationUnit>
+DawnCompiler::compileTuned(const std::shared_ptr<SIR>& SIR) {
+  if(!tuningDB_ || tuningDB_->getFilename() != options_->TuningDB)
+    tuningDB_ = std::make_unique<TuningDatabase>(options_->TuningDB);
+
+  // Group the stencils by their tuned configuration, stencils without an entry use the given
+  // options
+  std::map<TuningConfiguration, std::vector<std::string>> groups;
+  for(const auto& stencil : SIR->Stencils) {
+    const auto* entry =
+        tuningDB_->lookup(TuningDatabase::computeKey(*SIR, stencil->Name, *options_));
+    groups[entry ? entry->Configuration : TuningConfiguration()].push_back(stencil->Name);
+  }
+
+  // Compile the stencils of each configuration once: every group compiles a copy of the SIR (the
+  // optimizer modifies the SIR it compiles) in which the stencils of the other groups are marked as
+  // `AK_NoCodeGen`. `compile` starts with a clean diagnostics engine, hence the diagnostics of all
+  // the groups are collected (duplicates, e.g of the stencil functions, are dropped).
+  const Options options = *options_;
+  std::vector<DiagnosticsMessage> diagnostics;
+  auto collectDiagnostics = [&]() {
+    for(const auto& diag : diagnostics_->getQueue().queue())
+      if(std::none_of(diagnostics.begin(), diagnostics.end(), [&](const DiagnosticsMessage& d) {
+           return d.getDiagKind() == diag->getDiagKind() &&
+                  d.getSourceLocation() == diag->getSourceLocation() &&
+                  d.getMessage() == diag->getMessage();
+         }))
+        diagnostics.push_back(*diag);
+    diagnostics_->clear();
+    for(const auto& diag : diagnostics)
+      diagnostics_->report(diag);
+  };
+
+  std::unique_ptr<codegen::TranslationUnit> translationUnit;
+  std::vector<std::string> ppDefines;
+  std::string globals;
+  std::map<std::string, std::string> stencils;
+  bool isFirstGroup = true;
+  for(const auto& group : groups) {
+    *options_ = options;
+    options_->TuningDB.clear();
+    if(!group.first.apply(*options_)) {
+      *options_ = options;
+      diagnostics_->report(buildDiag("-tuning-db", options_->TuningDB,
+                                     "invalid configuration `" + group.first.toString() + "`"));
+      return nullptr;
+    }
+
+    DAWN_LOG(INFO) << "Compiling " << RangeToString(", ", "", "")(group.second)
+                   << " with the tuned configuration `" << group.first.toString() << "`";
+    auto groupSIR = SIRSerializer::copy(SIR.get());
+    for(const auto& stencil : groupSIR->Stencils)
+      if(std::find(group.second.begin(), group.second.end(), stencil->Name) == group.second.end())
+        stencil->Attributes.set(sir::Attr::AK_NoCodeGen);
+
+    translationUnit = compile(groupSIR);
+    collectDiagnostics();
+    if(!translationUnit || groups.size() == 1) {
+      *options_ = options;
+      return translationUnit;
+    }
+
+    // The stencils of all the groups end up in one translation unit, which has to provide the
+    // preprocessor defines of every group and can only have one definition of the globals
+    for(const auto& define : translationUnit->getPPDefines())
+      if(std::find(ppDefines.begin(), ppDefines.end(), define) == ppDefines.end())
+        ppDefines.push_back(define);
+    if(isFirstGroup) {
+      globals = translationUnit->getGlobals();
+      isFirstGroup = false;
+    } else if(translationUnit->getGlobals() != globals) {
+      *options_ = options;
+      diagnostics_->report(buildDiag("-tuning-db", options_->TuningDB,
+                                     "the tuned configurations generate different globals"));
+      return nullptr;
+    }
+
+    for(const auto& name : group.second) {
+      auto it = translationUnit->getStencils().find(name);
+      if(it != translationUnit->getStencils().end())
+        stencils.insert(*it);
+    }
+  }
+  *options_ = options;
+
+  return std::make_unique<codegen::TranslationUnit>(translationUnit->getFilename(),
+                                                    std::move(ppDefines), std::move(stencils),
+                                                    std::move(globals));
 }
 
 const DiagnosticsEngine& DawnCompiler::getDiagnostics() const { return *diagnostics_.get(); }
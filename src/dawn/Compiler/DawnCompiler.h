@@ -16,7 +16,10 @@
 #define DAWN_COMPILER_DAWNCOMPILER_H
 
 #include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Compiler/CompilationCache.h"
+#include "dawn/Compiler/IncrementalCompilation.h"
 #include "dawn/Compiler/Options.h"
+#include "dawn/Compiler/TuningDatabase.h"
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/Support/DiagnosticsEngine.h"
 #include "dawn/Support/NonCopyable.h"
@@ -32,10 +35,13 @@ class DawnCompiler : NonCopyable {
   std::unique_ptr<DiagnosticsEngine> diagnostics_;
   std::unique_ptr<Options> options_;
   std::string filename_;
+  std::unique_ptr<CompilationCache> cache_;
+  std::unique_ptr<IncrementalCompilation> incremental_;
+  std::unique_ptr<TuningDatabase> tuningDB_;
 
 public:
   /// @brief Initialize the compiler by setting up diagnostics
-  DawnCompiler(Options* options = nullptr);
+  DawnCompiler(const Options* options = nullptr);
 
   /// @brief Compile the SIR using the provided code generation routine
   /// @returns compiled TranslationUnit on success, `nullptr` otherwise
@@ -47,9 +53,22 @@ public:
   const Options& getOptions() const;
   Options& getOptions();
 
+  /// @brief Get the compilation cache (`nullptr` if `-cache-dir` was never set)
+  const CompilationCache* getCompilationCache() const { return cache_.get(); }
+
+  /// @brief Get the storage of the optimized IIR (`nullptr` if `-incremental-dir` was never set)
+  const IncrementalCompilation* getIncrementalCompilation() const { return incremental_.get(); }
+
+  /// @brief Get the tuning database (`nullptr` if `-tuning-db` was never set)
+  const TuningDatabase* getTuningDatabase() const { return tuningDB_.get(); }
+
   /// @brief Get the diagnostics engine
   const DiagnosticsEngine& getDiagnostics() const;
   DiagnosticsEngine& getDiagnostics();
+
+private:
+  /// @brief Compile each stencil with the configuration stored in the tuning database
+  std::unique_ptr<codegen::TranslationUnit> compileTuned(std::shared_ptr<SIR> const& SIR);
 };
 
 } // namespace dawn
@@ -0,0 +1,194 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/Fingerprint.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/SIR/AST.h"
+#include "dawn/SIR/ASTVisitor.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/SIRSerializer.h"
+#include "dawn/Support/Config.h"
+#include "dawn/Support/Json.h"
+#include "dawn/Support/SHA256.h"
+#include <algorithm>
+#include <set>
+#include <sstream>
+#include <vector>
+
+namespace dawn {
+
+namespace {
+
+void collectIDs(const json::json& node, std::vector<int>& IDs) {
+  if(node.is_object()) {
+    for(auto it = node.begin(); it != node.end(); ++it) {
+      if(it.key() == "ID" && it.value().is_number_integer())
+        IDs.push_back(it.value().get<int>());
+      else
+        collectIDs(it.value(), IDs);
+    }
+  } else if(node.is_array()) {
+    for(const auto& child : node)
+      collectIDs(child, IDs);
+  }
+}
+
+void replaceIDs(json::json& node, const std::vector<int>& sortedIDs) {
+  if(node.is_object()) {
+    for(auto it = node.begin(); it != node.end(); ++it) {
+      if(it.key() == "ID" && it.value().is_number_integer())
+        it.value() = std::lower_bound(sortedIDs.begin(), sortedIDs.end(), it.value().get<int>()) -
+                     sortedIDs.begin();
+      else
+        replaceIDs(it.value(), sortedIDs);
+    }
+  } else if(node.is_array()) {
+    for(auto& child : node)
+      replaceIDs(child, sortedIDs);
+  }
+}
+
+/// @brief Serialize the SIR in a form which does not depend on the absolute values of the IDs nor on
+/// the (unspecified) order of the protobuf maps
+std::string canonicalizeSIR(const SIR& sir) {
+  json::json node =
+      json::json::parse(SIRSerializer::serializeToString(&sir, SIRSerializer::SK_Json));
+
+  std::vector<int> IDs;
+  collectIDs(node, IDs);
+  std::sort(IDs.begin(), IDs.end());
+  IDs.erase(std::unique(IDs.begin(), IDs.end()), IDs.end());
+  replaceIDs(node, IDs);
+
+  // The stencil attributes are not serialized (`AK_NoCodeGen` decides which stencils are compiled)
+  for(const auto& stencil : sir.Stencils)
+    node["attributes"][stencil->Name] = stencil->Attributes.getBits();
+
+  // Objects are ordered by key
+  return node.dump();
+}
+
+/// @brief Options which only locate the caches and databases of the compiler
+///
+/// All the other options are hashed, even those which are not expected to influence the generated
+/// code (e.g the number of jobs). The tuned options a tuning database applies are hashed as they
+/// are set in the options when compiling (see `DawnCompiler::compileTuned`).
+bool isIgnoredOption(const std::string& name) {
+  return name == "CacheDir" || name == "CacheMaxSize" || name == "TuningDB";
+}
+
+void hashOptions(SHA256& sha, const Options& options) {
+  sha.update(std::string("dawn " DAWN_FULL_VERSION_STR "\n"));
+
+  std::ostringstream ss;
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(!isIgnoredOption(#NAME))                                                                      \
+    ss << #NAME << "=" << options.NAME << "\n";
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+  sha.update(ss.str());
+}
+
+/// @brief Collect the names of the stencils, stencil functions and variables referenced in an AST
+class ReferenceCollector : public sir::ASTVisitorForwarding {
+public:
+  std::set<std::string> Stencils;
+  std::set<std::string> StencilFunctions;
+  std::set<std::string> Variables;
+
+  void visit(const std::shared_ptr<sir::StencilCallDeclStmt>& stmt) override {
+    Stencils.insert(stmt->getStencilCall()->Callee);
+    sir::ASTVisitorForwarding::visit(stmt);
+  }
+
+  void visit(const std::shared_ptr<sir::BoundaryConditionDeclStmt>& stmt) override {
+    StencilFunctions.insert(stmt->getFunctor());
+    sir::ASTVisitorForwarding::visit(stmt);
+  }
+
+  void visit(const std::shared_ptr<sir::StencilFunCallExpr>& expr) override {
+    StencilFunctions.insert(expr->getCallee());
+    sir::ASTVisitorForwarding::visit(expr);
+  }
+
+  void visit(const std::shared_ptr<sir::VarAccessExpr>& expr) override {
+    Variables.insert(expr->getName());
+    sir::ASTVisitorForwarding::visit(expr);
+  }
+};
+
+} // anonymous namespace
+
+std::string computeSIRFingerprint(const SIR& sir, const Options& options) {
+  SHA256 sha;
+  hashOptions(sha, options);
+  sha.update(canonicalizeSIR(sir));
+  return sha.hexDigest();
+}
+
+std::string computeStencilFingerprint(const SIR& sir, const std::string& stencilName,
+                                      const Options& options) {
+  // Build the SIR containing only the stencil and everything it depends on. The filename is left
+  // out as it is not stored in the optimized IIR.
+  SIR reduced;
+
+  ReferenceCollector collector;
+  std::set<std::string> visitedStencils, visitedStencilFunctions;
+  std::vector<std::string> worklist{stencilName};
+
+  while(!worklist.empty()) {
+    std::string name = worklist.back();
+    worklist.pop_back();
+    if(!visitedStencils.insert(name).second)
+      continue;
+
+    for(const auto& stencil : sir.Stencils)
+      if(stencil->Name == name) {
+        reduced.Stencils.push_back(stencil);
+        stencil->StencilDescAst->accept(collector);
+      }
+
+    for(const auto& callee : collector.Stencils)
+      if(!visitedStencils.count(callee))
+        worklist.push_back(callee);
+  }
+
+  // Stencil functions may call other stencil functions
+  bool changed = true;
+  while(changed) {
+    changed = false;
+    for(const auto& stencilFunction : sir.StencilFunctions) {
+      if(!collector.StencilFunctions.count(stencilFunction->Name) ||
+         visitedStencilFunctions.count(stencilFunction->Name))
+        continue;
+
+      visitedStencilFunctions.insert(stencilFunction->Name);
+      reduced.StencilFunctions.push_back(stencilFunction);
+      for(const auto& ast : stencilFunction->Asts)
+        ast->accept(collector);
+      changed = true;
+    }
+  }
+
+  for(const auto& variable : *sir.GlobalVariableMap)
+    if(collector.Variables.count(variable.first))
+      reduced.GlobalVariableMap->insert(variable);
+
+  SHA256 sha;
+  hashOptions(sha, options);
+  sha.update(canonicalizeSIR(reduced));
+  return sha.hexDigest();
+}
+
+} // namespace dawn
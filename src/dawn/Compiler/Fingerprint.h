@@ -0,0 +1,46 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_COMPILER_FINGERPRINT_H
+#define DAWN_COMPILER_FINGERPRINT_H
+
+#include <string>
+
+namespace dawn {
+
+struct Options;
+struct SIR;
+
+/// @brief Compute the fingerprint of compiling `sir` with `options`
+///
+/// The fingerprint is the SHA-256 digest of the canonicalized SIR, all options besides the locations
+/// of the caches and the version of Dawn. Statement and expression IDs of the SIR are replaced by
+/// their rank, i.e two SIRs which only differ by the offset of their IDs have the same fingerprint.
+///
+/// @ingroup compiler
+std::string computeSIRFingerprint(const SIR& sir, const Options& options);
+
+/// @brief Compute the fingerprint of the stencil `stencilName` of `sir`
+///
+/// Only the stencil itself and the stencils, stencil functions and global variables it
+/// (transitively) refers to are taken into account. Changing any other part of the SIR does not
+/// alter the fingerprint.
+///
+/// @ingroup compiler
+std::string computeStencilFingerprint(const SIR& sir, const std::string& stencilName,
+                                      const Options& options);
+
+} // namespace dawn
+
+#endif
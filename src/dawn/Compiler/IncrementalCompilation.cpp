@@ -0,0 +1,118 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/IncrementalCompilation.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Serialization/IIRSerializer.h"
+#include "dawn/Support/Logging.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace dawn {
+
+namespace {
+
+fs::path getEntryPath(const std::string& directory, const std::string& fingerprint) {
+  return fs::path(directory) / (fingerprint + ".iir");
+}
+
+} // anonymous namespace
+
+IncrementalCompilation::IncrementalCompilation(const std::string& directory)
+    : directory_(directory) {
+  std::error_code ec;
+  fs::create_directories(directory_, ec);
+  if(ec)
+    DAWN_LOG(WARNING) << "failed to create directory `" << directory_ << "`: " << ec.message();
+}
+
+std::shared_ptr<iir::StencilInstantiation>
+IncrementalCompilation::load(const std::string& stencilName, const std::string& fingerprint,
+                             OptimizerContext& context) {
+  std::ifstream ifs(getEntryPath(directory_, fingerprint), std::ios::binary);
+  if(!ifs.is_open())
+    return nullptr;
+  std::string content((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+
+  // Guard against truncated or foreign files
+  const std::string header = fingerprint + '\n';
+  if(content.compare(0, header.size(), header) != 0)
+    return nullptr;
+
+  std::shared_ptr<iir::StencilInstantiation> instantiation;
+  try {
+    instantiation = IIRSerializer::deserializeFromString(content.substr(header.size()), &context,
+                                                         IIRSerializer::SK_Byte);
+  } catch(std::exception& e) {
+    DAWN_LOG(WARNING) << "ignoring optimized IIR of `" << stencilName << "`: " << e.what();
+    return nullptr;
+  }
+
+  if(!instantiation || instantiation->getName() != stencilName)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_.Reused++;
+  return instantiation;
+}
+
+bool IncrementalCompilation::store(
+    const std::string& stencilName, const std::string& fingerprint,
+    const std::shared_ptr<iir::StencilInstantiation>& instantiation) {
+  const fs::path path = getEntryPath(directory_, fingerprint);
+
+  // Write to a temporary file unique to this process and thread and move it into place, renaming
+  // is atomic. Concurrent compilers storing the same entry write the same content.
+  static std::atomic<unsigned> counter(0);
+  std::ostringstream tmpName;
+  tmpName << fingerprint << ".tmp." << ::getpid() << "." << counter++;
+  const fs::path tmpPath = fs::path(directory_) / tmpName.str();
+
+  bool success;
+  {
+    std::ofstream ofs(tmpPath, std::ios::binary);
+    ofs << fingerprint << '\n'
+        << IIRSerializer::serializeToString(instantiation, IIRSerializer::SK_Byte);
+    success = ofs.good();
+  }
+
+  std::error_code ec;
+  if(success) {
+    fs::rename(tmpPath, path, ec);
+    success = !ec;
+  }
+  if(!success) {
+    DAWN_LOG(WARNING) << "failed to store optimized IIR of `" << stencilName << "` in `"
+                      << directory_ << "`";
+    fs::remove(tmpPath, ec);
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  statistics_.Stored++;
+  return true;
+}
+
+IncrementalCompilation::Statistics IncrementalCompilation::getStatistics() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return statistics_;
+}
+
+} // namespace dawn
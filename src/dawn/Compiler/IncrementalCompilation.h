@@ -0,0 +1,79 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_COMPILER_INCREMENTALCOMPILATION_H
+#define DAWN_COMPILER_INCREMENTALCOMPILATION_H
+
+#include "dawn/Support/NonCopyable.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace dawn {
+
+class OptimizerContext;
+
+namespace iir {
+class StencilInstantiation;
+}
+
+/// @brief Storage of the optimized stencil instantiations of previous compilations
+///
+/// The optimized IIR of a stencil is kept in `<directory>/<fingerprint>.iir`, where the fingerprint
+/// identifies the stencil it was computed from (see `computeStencilFingerprint`). If a stencil with
+/// the same fingerprint is compiled again, the optimized IIR can be reused instead of running the
+/// passes again.
+///
+/// The entries are content-addressed and written atomically, hence several compilers (e.g of a
+/// parallel build) can share the directory. Entries are never removed, stale ones accumulate until
+/// the directory is cleared.
+///
+/// @ingroup compiler
+class IncrementalCompilation : NonCopyable {
+public:
+  struct Statistics {
+    std::size_t Reused = 0;
+    std::size_t Stored = 0;
+  };
+
+  /// @brief Open (and create if necessary) the storage in `directory`
+  IncrementalCompilation(const std::string& directory);
+
+  /// @brief Load the optimized instantiation of `stencilName` if it was computed from a stencil with
+  /// the same `fingerprint`
+  /// @returns `nullptr` if the stencil has to be optimized again
+  std::shared_ptr<iir::StencilInstantiation> load(const std::string& stencilName,
+                                                  const std::string& fingerprint,
+                                                  OptimizerContext& context);
+
+  /// @brief Store the optimized instantiation of `stencilName`
+  /// @returns `true` on success
+  bool store(const std::string& stencilName, const std::string& fingerprint,
+             const std::shared_ptr<iir::StencilInstantiation>& instantiation);
+
+  /// @brief Get the directory of the storage
+  const std::string& getDirectory() const { return directory_; }
+
+  /// @brief Get the statistics of this object (not persisted)
+  Statistics getStatistics() const;
+
+private:
+  std::string directory_;
+  Statistics statistics_;
+  mutable std::mutex mutex_;
+};
+
+} // namespace dawn
+
+#endif
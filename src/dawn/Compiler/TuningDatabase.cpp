@@ -0,0 +1,231 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/TuningDatabase.h"
+#include "dawn/Compiler/Fingerprint.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/Support/Logging.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+namespace fs = std::filesystem;
+
+namespace dawn {
+
+namespace {
+
+bool parseValue(const std::string& str, std::string& value) {
+  value = str;
+  return true;
+}
+
+bool parseValue(const std::string& str, bool& value) {
+  if(str == "true" || str == "1")
+    value = true;
+  else if(str == "false" || str == "0")
+    value = false;
+  else
+    return false;
+  return true;
+}
+
+bool parseValue(const std::string& str, int& value) {
+  try {
+    std::size_t pos = 0;
+    value = std::stoi(str, &pos);
+    return pos == str.size();
+  } catch(std::exception&) {
+    return false;
+  }
+}
+
+std::string formatValue(const std::string& value) { return value; }
+std::string formatValue(bool value) { return value ? "true" : "false"; }
+std::string formatValue(int value) { return std::to_string(value); }
+
+} // anonymous namespace
+
+//===------------------------------------------------------------------------------------------===//
+//     TuningConfiguration
+//===------------------------------------------------------------------------------------------===//
+
+TuningConfiguration TuningConfiguration::fromOptions(const Options& options,
+                                                     const std::vector<std::string>& names) {
+  TuningConfiguration configuration;
+  for(const auto& name : names) {
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(name == #NAME)                                                                                \
+    configuration.set(name, formatValue(options.NAME));
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+  }
+  return configuration;
+}
+
+const std::string* TuningConfiguration::get(const std::string& name) const {
+  auto it = values_.find(name);
+  return it != values_.end() ? &it->second : nullptr;
+}
+
+bool TuningConfiguration::apply(Options& options) const {
+  for(const auto& value : values_) {
+    bool valid = false;
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(value.first == #NAME)                                                                         \
+    valid = parseValue(value.second, options.NAME);
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+    if(!valid)
+      return false;
+  }
+  return true;
+}
+
+bool TuningConfiguration::isOption(const std::string& name) {
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(name == #NAME)                                                                                \
+    return true;
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+  return false;
+}
+
+std::string TuningConfiguration::toString() const {
+  std::ostringstream ss;
+  for(const auto& value : values_) {
+#define OPT(TYPE, NAME, DEFAULT_VALUE, OPTION, OPTION_SHORT, HELP, VALUE_NAME, HAS_VALUE, F_GROUP) \
+  if(value.first == #NAME)                                                                         \
+    ss << (ss.tellp() == 0 ? "" : " ") << "-" << OPTION << "=" << value.second;
+#include "dawn/Compiler/Options.inc"
+#undef OPT
+  }
+  return ss.str();
+}
+
+json::json TuningConfiguration::jsonDump() const {
+  json::json node = json::json::object();
+  for(const auto& value : values_)
+    node[value.first] = value.second;
+  return node;
+}
+
+TuningConfiguration TuningConfiguration::fromJson(const json::json& node) {
+  TuningConfiguration configuration;
+  for(auto it = node.begin(); it != node.end(); ++it)
+    configuration.set(it.key(), it.value().get<std::string>());
+  return configuration;
+}
+
+//===------------------------------------------------------------------------------------------===//
+//     TuningDatabase
+//===------------------------------------------------------------------------------------------===//
+
+TuningDatabase::TuningDatabase(const std::string& filename) : filename_(filename) {
+  std::ifstream ifs(filename_);
+  if(!ifs.is_open())
+    return;
+
+  try {
+    json::json node;
+    ifs >> node;
+    for(auto it = node["entries"].begin(); it != node["entries"].end(); ++it) {
+      Entry entry;
+      entry.Stencil = it.value()["stencil"].get<std::string>();
+      entry.Configuration = TuningConfiguration::fromJson(it.value()["options"]);
+      entry.Time = it.value()["time"].get<double>();
+      entries_.emplace(it.key(), entry);
+    }
+  } catch(std::exception& e) {
+    DAWN_LOG(WARNING) << "ignoring invalid tuning database `" << filename_ << "`: " << e.what();
+    entries_.clear();
+  }
+}
+
+const std::vector<std::string>& TuningDatabase::getTunableOptions() {
+  static const std::vector<std::string> names{"ReorderStrategy",     "MergeStages",
+                                              "MergeTemporaries",    "PassTmpToFunction",
+                                              "UseNonTempCaches",    "MaxFieldsPerStencil",
+                                              "block_size",          "SIMDWidth"};
+  return names;
+}
+
+std::string TuningDatabase::computeKey(const SIR& sir, const std::string& stencilName,
+                                       const Options& options) {
+  // The tuned options are reset to their defaults, the key has to be the same for all the
+  // configurations of the search
+  Options keyOptions = options;
+  TuningConfiguration::fromOptions(Options(), getTunableOptions()).apply(keyOptions);
+
+  // The configuration found for a stencil does not depend on how the compiler is run
+  keyOptions.OptimizerJobs = Options().OptimizerJobs;
+  keyOptions.CodeGenJobs = Options().CodeGenJobs;
+  keyOptions.IncrementalDir.clear();
+  return computeStencilFingerprint(sir, stencilName, keyOptions);
+}
+
+const TuningDatabase::Entry* TuningDatabase::lookup(const std::string& key) const {
+  auto it = entries_.find(key);
+  return it != entries_.end() ? &it->second : nullptr;
+}
+
+bool TuningDatabase::insert(const std::string& key, const Entry& entry) {
+  auto it = entries_.find(key);
+  if(it != entries_.end() && it->second.Time <= entry.Time)
+    return false;
+  entries_[key] = entry;
+  return true;
+}
+
+bool TuningDatabase::save() const {
+  json::json node;
+  node["entries"] = json::json::object();
+  for(const auto& entry : entries_) {
+    json::json entryNode;
+    entryNode["stencil"] = entry.second.Stencil;
+    entryNode["options"] = entry.second.Configuration.jsonDump();
+    entryNode["time"] = entry.second.Time;
+    node["entries"][entry.first] = entryNode;
+  }
+
+  // Write to a temporary file unique to this process and move it into place, renaming is atomic
+  static std::atomic<unsigned> counter(0);
+  std::ostringstream tmpName;
+  tmpName << filename_ << ".tmp." << ::getpid() << "." << counter++;
+  bool written;
+  {
+    std::ofstream ofs(tmpName.str());
+    ofs << node.dump(2);
+    written = ofs.good();
+  }
+
+  std::error_code ec;
+  if(!written) {
+    DAWN_LOG(WARNING) << "failed to write tuning database `" << tmpName.str() << "`";
+    fs::remove(tmpName.str(), ec);
+    return false;
+  }
+
+  fs::rename(tmpName.str(), filename_, ec);
+  if(ec) {
+    DAWN_LOG(WARNING) << "failed to write tuning database `" << filename_ << "`: " << ec.message();
+    fs::remove(tmpName.str(), ec);
+    return false;
+  }
+  return true;
+}
+
+} // namespace dawn
@@ -0,0 +1,122 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_COMPILER_TUNINGDATABASE_H
+#define DAWN_COMPILER_TUNINGDATABASE_H
+
+#include "dawn/Support/Json.h"
+#include "dawn/Support/NonCopyable.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace dawn {
+
+struct Options;
+struct SIR;
+
+/// @brief Values of a subset of the options, keyed by the option name (e.g `ReorderStrategy`)
+///
+/// Values are stored as strings, boolean options use `true` and `false`.
+///
+/// @ingroup compiler
+class TuningConfiguration {
+  std::map<std::string, std::string> values_;
+
+public:
+  using const_iterator = std::map<std::string, std::string>::const_iterator;
+
+  TuningConfiguration() = default;
+
+  /// @brief Read the values of the options `names` from `options`
+  static TuningConfiguration fromOptions(const Options& options,
+                                         const std::vector<std::string>& names);
+
+  /// @brief Set the value of the option `name`
+  void set(const std::string& name, const std::string& value) { values_[name] = value; }
+
+  /// @brief Get the value of the option `name` (`nullptr` if not part of the configuration)
+  const std::string* get(const std::string& name) const;
+
+  /// @brief Overwrite the options of this configuration in `options`
+  /// @returns `false` if an option does not exist or its value is invalid
+  bool apply(Options& options) const;
+
+  /// @brief Check whether `name` is an option of the compiler
+  static bool isOption(const std::string& name);
+
+  /// @brief Convert to the equivalent command-line flags (e.g `-reorder=scut -merge-stages=true`)
+  std::string toString() const;
+
+  json::json jsonDump() const;
+  static TuningConfiguration fromJson(const json::json& node);
+
+  const_iterator begin() const { return values_.begin(); }
+  const_iterator end() const { return values_.end(); }
+  std::size_t size() const { return values_.size(); }
+
+  bool operator==(const TuningConfiguration& other) const { return values_ == other.values_; }
+  bool operator!=(const TuningConfiguration& other) const { return !(*this == other); }
+  bool operator<(const TuningConfiguration& other) const { return values_ < other.values_; }
+};
+
+/// @brief Persistent mapping from stencils to the fastest configuration measured by the autotuner
+///
+/// The database is a single JSON file. Entries are keyed by the fingerprint of the stencil and of
+/// all options which are not tuned, except for the number of jobs and the incremental compilation
+/// directory (see `computeKey`). The tuned configuration of a stencil is hence only reused as long
+/// as neither the stencil nor e.g the backend change. Saving writes a temporary
+/// file first and then renames it.
+///
+/// @ingroup compiler
+class TuningDatabase : NonCopyable {
+public:
+  struct Entry {
+    std::string Stencil;               ///< Name of the stencil (informative only)
+    TuningConfiguration Configuration; ///< Fastest configuration
+    double Time = 0.0;                 ///< Measured run time of the configuration in seconds
+  };
+
+  /// @brief Load the database from `filename` (starts empty if the file does not exist)
+  explicit TuningDatabase(const std::string& filename);
+
+  /// @brief Names of the options searched by the autotuner, they are excluded from the key
+  static const std::vector<std::string>& getTunableOptions();
+
+  /// @brief Compute the key of the stencil `stencilName` of `sir` compiled with `options`
+  static std::string computeKey(const SIR& sir, const std::string& stencilName,
+                                const Options& options);
+
+  /// @brief Get the entry of `key` (`nullptr` if there is none)
+  const Entry* lookup(const std::string& key) const;
+
+  /// @brief Insert the entry unless there is a faster entry for `key` already
+  /// @returns `true` if the entry was inserted
+  bool insert(const std::string& key, const Entry& entry);
+
+  /// @brief Write the database back to its file
+  /// @returns `true` on success
+  bool save() const;
+
+  const std::string& getFilename() const { return filename_; }
+  std::size_t size() const { return entries_.size(); }
+
+private:
+  std::string filename_;
+  std::map<std::string, Entry> entries_;
+};
+
+} // namespace dawn
+
+#endif
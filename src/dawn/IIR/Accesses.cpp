@@ -13,6 +13,7 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/IIR/Accesses.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/IIR/StencilFunctionInstantiation.h"
 #include "dawn/IIR/StencilMetaInformation.h"
 #include "dawn/Support/Format.h"
@@ -128,6 +129,11 @@ bool Accesses::hasAccess(int accessID) const {
   return hasReadAccess(accessID) || hasWriteAccess(accessID);
 }
 
+void Accesses::renumberIDs(const IDRenumbering& renumbering) {
+  writeAccesses_ = renumbering.mapKeys(writeAccesses_);
+  readAccesses_ = renumbering.mapKeys(readAccesses_);
+}
+
 Extents const& Accesses::getReadAccess(int AccessID) const {
   DAWN_ASSERT(readAccesses_.count(AccessID));
   return readAccesses_.at(AccessID);
@@ -16,21 +16,25 @@
 #define DAWN_IIR_ACCESSES_H
 
 #include "dawn/IIR/Extents.h"
-#include <unordered_map>
+#include "dawn/Support/FlatMap.h"
 
 namespace dawn {
 namespace iir {
 
+class IDRenumbering;
 class StencilFunctionInstantiation;
 class StencilMetaInformation;
 
+/// @brief Map of AccessIDs to the extents of the accesses (sorted by AccessID)
+using AccessMap = FlatMap<int, Extents>;
+
 /// @brief Read and write accesses of a statement
 ///
 /// Accesses are either part of a `StencilInstantiation` or `StencilFunctionInstantiation`.
 /// @ingroup optimizer
 class Accesses {
-  std::unordered_map<int, Extents> writeAccesses_;
-  std::unordered_map<int, Extents> readAccesses_;
+  AccessMap writeAccesses_;
+  AccessMap readAccesses_;
 
 public:
   Accesses() = default;
@@ -73,11 +77,14 @@ public:
   const Extents& getWriteAccess(int AccessID) const;
 
   /// @brief Get the accesses maps
-  std::unordered_map<int, Extents>& getReadAccesses() { return readAccesses_; }
-  const std::unordered_map<int, Extents>& getReadAccesses() const { return readAccesses_; }
+  AccessMap& getReadAccesses() { return readAccesses_; }
+  const AccessMap& getReadAccesses() const { return readAccesses_; }
+
+  AccessMap& getWriteAccesses() { return writeAccesses_; }
+  const AccessMap& getWriteAccesses() const { return writeAccesses_; }
 
-  std::unordered_map<int, Extents>& getWriteAccesses() { return writeAccesses_; }
-  const std::unordered_map<int, Extents>& getWriteAccesses() const { return writeAccesses_; }
+  /// @brief Renumber the AccessIDs (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
 
   /// @brief Convert the accesses of a stencil or stencil-function instantiation to string
   /// @{
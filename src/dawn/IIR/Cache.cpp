@@ -13,6 +13,7 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/IIR/Cache.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/Support/Unreachable.h"
 
 namespace dawn {
@@ -62,6 +63,10 @@ Cache::Cache(CacheTypeKind type, CacheIOPolicy policy, int fieldAccessID,
 
 int Cache::getCachedFieldAccessID() const { return AccessID_; }
 
+void Cache::renumberIDs(const IDRenumbering& renumbering) {
+  AccessID_ = renumbering.mapUID(AccessID_);
+}
+
 Interval Cache::getWindowInterval(Interval::Bound bound) const {
   DAWN_ASSERT(interval_.is_initialized() && window_.is_initialized());
   return interval_->crop(bound, {window_->m_m, window_->m_p});
@@ -23,6 +23,8 @@
 namespace dawn {
 namespace iir {
 
+class IDRenumbering;
+
 /// @brief Cache specification of gridtools
 /// @ingroup optimizer
 class Cache {
@@ -66,6 +68,9 @@ public:
   /// @brief Get the AccessID of the field
   int getCachedFieldAccessID() const;
 
+  /// @brief Renumber the AccessID of the field (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
+
   json::json jsonDump() const;
 
   /// @brief Get the type of cache
@@ -0,0 +1,119 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/IIR/DeferredUpdate.h"
+#include "dawn/Support/Assert.h"
+
+namespace dawn {
+namespace iir {
+
+namespace {
+
+struct DeferredUpdateState {
+  /// Number of open scopes
+  int Depth = 0;
+
+  /// Set while the pending updates are applied (updates requested meanwhile are applied eagerly)
+  bool Flushing = false;
+
+  /// Dirty nodes in the order they were marked (destroyed nodes leave a `nullptr` behind)
+  std::vector<impl::DeferredUpdateNode*> Queue;
+
+  std::uint64_t NumDeferredUpdates = 0;
+  std::uint64_t NumAppliedUpdates = 0;
+};
+
+thread_local DeferredUpdateState state;
+
+} // anonymous namespace
+
+namespace impl {
+
+DeferredUpdateNode::~DeferredUpdateNode() {
+  if(isDirty())
+    DeferredUpdateScope::dequeue(this);
+}
+
+bool DeferredUpdateNode::deferUpdate(unsigned kinds) {
+  if(!DeferredUpdateScope::isActive())
+    return false;
+
+  if(!isDirty())
+    DeferredUpdateScope::enqueue(this);
+  pendingKinds_ |= kinds;
+  state.NumDeferredUpdates++;
+  return true;
+}
+
+void DeferredUpdateNode::applyPendingUpdate() {
+  if(!isDirty())
+    return;
+
+  unsigned kinds = pendingKinds_;
+  DeferredUpdateScope::dequeue(this);
+  state.NumAppliedUpdates++;
+  applyUpdate(kinds);
+}
+
+void DeferredUpdateNode::flushIfDirty() const {
+  if(isDirty())
+    DeferredUpdateScope::flush();
+}
+
+} // namespace impl
+
+DeferredUpdateScope::DeferredUpdateScope() { state.Depth++; }
+
+DeferredUpdateScope::~DeferredUpdateScope() {
+  DAWN_ASSERT(state.Depth > 0);
+  if(--state.Depth == 0)
+    flush();
+}
+
+bool DeferredUpdateScope::isActive() { return state.Depth > 0 && !state.Flushing; }
+
+void DeferredUpdateScope::flush() {
+  if(state.Flushing)
+    return;
+
+  state.Flushing = true;
+  // Applying the update of a node applies the pending updates of its children first, hence the
+  // order of the queue does not matter
+  for(std::size_t i = 0; i < state.Queue.size(); ++i) {
+    if(state.Queue[i])
+      state.Queue[i]->applyPendingUpdate();
+  }
+  state.Queue.clear();
+  state.Flushing = false;
+}
+
+std::uint64_t DeferredUpdateScope::getNumDeferredUpdates() { return state.NumDeferredUpdates; }
+
+std::uint64_t DeferredUpdateScope::getNumAppliedUpdates() { return state.NumAppliedUpdates; }
+
+void DeferredUpdateScope::enqueue(impl::DeferredUpdateNode* node) {
+  DAWN_ASSERT(!node->isDirty());
+  node->dirtySlot_ = static_cast<std::int32_t>(state.Queue.size());
+  state.Queue.push_back(node);
+}
+
+void DeferredUpdateScope::dequeue(impl::DeferredUpdateNode* node) {
+  DAWN_ASSERT(node->isDirty() && state.Queue[node->dirtySlot_] == node);
+  state.Queue[node->dirtySlot_] = nullptr;
+  node->dirtySlot_ = -1;
+  node->pendingKinds_ = 0;
+}
+
+} // namespace iir
+} // namespace dawn
@@ -0,0 +1,123 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_IIR_DEFERREDUPDATE_H
+#define DAWN_IIR_DEFERREDUPDATE_H
+
+#include "dawn/Support/NonCopyable.h"
+#include <cstdint>
+#include <vector>
+
+namespace dawn {
+namespace iir {
+
+class DeferredUpdateScope;
+
+namespace impl {
+
+/// @brief Bookkeeping of the lazy update of the derived info of an IIR node
+///
+/// While a `DeferredUpdateScope` is open on the current thread, the mutators of `IIRNode` only
+/// record *which* part of the derived info of a node became stale. The recorded updates are
+/// applied (children before parents) when the outermost scope closes or when the derived info of a
+/// dirty node is read.
+class DeferredUpdateNode {
+public:
+  /// @brief Parts of the derived info which need to be recomputed
+  enum UpdateKind : unsigned {
+    UK_Children = 1 << 0, ///< `updateFromChildren`
+    UK_Level = 1 << 1,    ///< `updateLevel`
+    UK_Clear = 1 << 2     ///< `clearDerivedInfo` (applied before the other two)
+  };
+
+  /// @brief Check if the node has pending updates
+  bool isDirty() const { return dirtySlot_ >= 0; }
+
+  /// @brief Record the updates `kinds` if a `DeferredUpdateScope` is open
+  /// @returns `false` if the update has to be applied eagerly by the caller
+  bool deferUpdate(unsigned kinds);
+
+  /// @brief Apply the pending updates of this node (if any) and remove it from the scope
+  void applyPendingUpdate();
+
+protected:
+  DeferredUpdateNode() = default;
+
+  /// @brief Pending updates belong to the node object and are never copied
+  /// @{
+  DeferredUpdateNode(const DeferredUpdateNode&) {}
+  DeferredUpdateNode& operator=(const DeferredUpdateNode&) { return *this; }
+  /// @}
+
+  virtual ~DeferredUpdateNode();
+
+  /// @brief Apply all the pending updates of the thread if this node is dirty
+  ///
+  /// Called by the getters of derived info, which is thereby recomputed on first read.
+  void flushIfDirty() const;
+
+  /// @brief Apply the updates `kinds` to this node
+  ///
+  /// Implementations have to apply the pending updates of their children first.
+  virtual void applyUpdate(unsigned kinds) = 0;
+
+private:
+  friend class dawn::iir::DeferredUpdateScope;
+
+  std::int32_t dirtySlot_ = -1;
+  unsigned pendingKinds_ = 0;
+};
+
+} // namespace impl
+
+/// @brief Batch-edit scope of the IIR tree
+///
+/// Inserting, erasing or replacing children of an `IIRNode` (as well as `IIRNode::update`)
+/// recomputes the derived info of the node and of all its ancestors. When many children are
+/// modified in a row this is quadratic in the number of edits. Within a `DeferredUpdateScope` the
+/// nodes are only marked dirty and the derived info is recomputed once, when the outermost scope of
+/// the thread closes. Reading the derived info of a dirty node (e.g `Stage::getFields`) inside the
+/// scope applies the pending updates first.
+///
+/// Scopes are nestable and thread-local.
+///
+/// @ingroup iir
+class DeferredUpdateScope : NonCopyable {
+public:
+  DeferredUpdateScope();
+  ~DeferredUpdateScope();
+
+  /// @brief Check if updates are currently deferred on this thread
+  static bool isActive();
+
+  /// @brief Apply all pending updates of this thread
+  static void flush();
+
+  /// @brief Number of updates which were deferred (and later applied) on this thread
+  static std::uint64_t getNumDeferredUpdates();
+
+  /// @brief Number of nodes which were recomputed when flushing the pending updates on this thread
+  static std::uint64_t getNumAppliedUpdates();
+
+private:
+  friend class impl::DeferredUpdateNode;
+
+  static void enqueue(impl::DeferredUpdateNode* node);
+  static void dequeue(impl::DeferredUpdateNode* node);
+};
+
+} // namespace iir
+} // namespace dawn
+
+#endif
@@ -15,13 +15,14 @@
 #ifndef DAWN_IIR_DEPENDENCYGRAPH_H
 #define DAWN_IIR_DEPENDENCYGRAPH_H
 
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/Support/Assert.h"
 #include "dawn/Support/Unreachable.h"
 #include <algorithm>
+#include <cstdint>
 #include <fstream>
 #include <iosfwd>
 #include <iterator>
-#include <list>
 #include <memory>
 #include <set>
 #include <sstream>
@@ -34,6 +35,14 @@ namespace dawn {
 namespace iir {
 
 /// @brief CRTP base class of all dependency graphs
+///
+/// The vertices are numbered consecutively by their insertion order (the VertexID) and the edges
+/// are stored in a flat edge list per vertex. Reachability queries (`isReachable`,
+/// `hasCycleDependency`) are answered from the transitive closure of the graph, which is computed
+/// on a compressed (CSR) copy of the adjacency list upon the first query and cached as one bitset
+/// per vertex until the graph is modified. As the cache is filled by const member functions, a
+/// graph must not be queried concurrently from multiple threads.
+///
 /// @ingroup optimizer
 template <class Derived, class EdgeData>
 class DependencyGraph {
@@ -57,7 +66,7 @@ public:
     bool operator!=(const Edge& other) const { return !(*this == other); }
   };
 
-  using EdgeList = std::list<Edge>;
+  using EdgeList = std::vector<Edge>;
 
   struct Vertex {
     std::size_t VertexID; ///< Unqiue ID of the Vertex
@@ -66,13 +75,22 @@ public:
 
 protected:
   std::unordered_map<int, Vertex> vertices_;
-  std::vector<std::shared_ptr<EdgeList>> adjacencyList_;
+  std::vector<int> vertexValues_;
+  std::vector<EdgeList> adjacencyList_;
+
+  /// Transitive closure: bit `To` of the row `From` is set if there is a path from `From` to `To`
+  mutable std::vector<std::uint64_t> closure_;
+  mutable std::size_t closureWords_ = 0;
+  mutable bool closureValid_ = false;
 
 public:
-  /// @brief Get the adjacency list
+  /// @brief Get the adjacency list (indexed by VertexID)
   /// @{
-  std::vector<std::shared_ptr<EdgeList>>& getAdjacencyList() { return adjacencyList_; }
-  const std::vector<std::shared_ptr<EdgeList>>& getAdjacencyList() const { return adjacencyList_; }
+  std::vector<EdgeList>& getAdjacencyList() {
+    closureValid_ = false;
+    return adjacencyList_;
+  }
+  const std::vector<EdgeList>& getAdjacencyList() const { return adjacencyList_; }
   /// @}
 
   /// @brief Get the vertices
@@ -91,20 +109,33 @@ public:
   /// @brief Insert a new node
   Vertex& insertNode(int ID) {
     auto insertPair = vertices_.emplace(ID, Vertex{adjacencyList_.size(), ID});
-    if(insertPair.second)
-      adjacencyList_.push_back(std::make_shared<EdgeList>());
+    if(insertPair.second) {
+      vertexValues_.push_back(ID);
+      adjacencyList_.emplace_back();
+      closureValid_ = false;
+    }
     return insertPair.first->second;
   }
 
+  /// @brief Renumber the IDs of the vertices (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering) {
+    std::unordered_map<int, Vertex> vertices;
+    for(const auto& IDVertexPair : vertices_)
+      vertices.emplace(renumbering.mapUID(IDVertexPair.first),
+                       Vertex{IDVertexPair.second.VertexID,
+                              renumbering.mapUID(IDVertexPair.second.value)});
+    vertices_ = std::move(vertices);
+
+    for(int& value : vertexValues_)
+      value = renumbering.mapUID(value);
+  }
+
+  /// @brief Get the values of all vertices which are part of a cycle
   std::set<int> computeIDsWithCycles() const {
     std::set<int> ids;
-    for(const auto& vertexPair : vertices_) {
-      const auto& vertex = vertexPair.second;
-
-      if(hasCycleDependency(vertex.value)) {
-        ids.insert(vertex.value);
-      }
-    }
+    for(std::size_t VertexID = 0; VertexID < vertexValues_.size(); ++VertexID)
+      if(isReachableByVertexID(VertexID, VertexID))
+        ids.insert(vertexValues_[VertexID]);
     return ids;
   }
 
@@ -122,19 +153,8 @@ public:
     // if the node does already exist)
     static_cast<Derived*>(this)->insertNode(vertexValueTo);
 
-    // Traverse the edge-list of node `IDFrom` to check if we already have such an edge
-    auto& edgeList = adjacencyList_[getVertexIDFromValue(vertexValueFrom)];
-    const Edge edge{std::forward<TEdgeData>(data), getVertexIDFromValue(vertexValueFrom),
-                    getVertexIDFromValue(vertexValueTo)};
-
-    auto it = std::find_if(edgeList->begin(), edgeList->end(), [&edge](const Edge& e) {
-      return e.FromVertexID == edge.FromVertexID && e.ToVertexID == edge.ToVertexID;
-    });
-
-    if(it != edgeList->end())
-      static_cast<Derived*>(this)->edgeAlreadyExists(it->Data, edge.Data);
-    else
-      edgeList->push_back(edge);
+    insertEdgeByVertexID(getVertexIDFromValue(vertexValueFrom),
+                         getVertexIDFromValue(vertexValueTo), std::forward<TEdgeData>(data));
   }
 
   /// @brief Callback which will be invoked if an edge already exists
@@ -149,32 +169,44 @@ public:
     return it->second.VertexID;
   }
 
-  bool hasCycleDependency(const int value) const {
-    std::set<int> a{};
-    // TODO implement a perfect fwd
-    return hasCycleDependencyImpl(getVertexIDFromValue(value), getVertexIDFromValue(value), a);
+  /// @brief Check if the vertex given by `value` is part of a cycle
+  bool hasCycleDependency(const int value) const { return isReachable(value, value); }
+
+  /// @brief Check if there is a path (of at least one edge) from the vertex with value
+  /// `valueFrom` to the vertex with value `valueTo`
+  bool isReachable(int valueFrom, int valueTo) const {
+    return isReachableByVertexID(getVertexIDFromValue(valueFrom), getVertexIDFromValue(valueTo));
+  }
+
+  /// @brief Check if there is a path (of at least one edge) from `VertexIDFrom` to `VertexIDTo`
+  bool isReachableByVertexID(std::size_t VertexIDFrom, std::size_t VertexIDTo) const {
+    DAWN_ASSERT(VertexIDFrom < vertexValues_.size() && VertexIDTo < vertexValues_.size());
+    if(!closureValid_)
+      computeClosure();
+    return (closure_[VertexIDFrom * closureWords_ + VertexIDTo / 64] >> (VertexIDTo % 64)) & 1;
   }
 
   /// @brief Get the ID of the vertex given by ID
   int getValueFromVertexID(std::size_t VertexID) const {
-    for(const auto& vertexPair : vertices_)
-      if(vertexPair.second.VertexID == VertexID)
-        return vertexPair.first;
-    dawn_unreachable("invalid VertexID");
+    DAWN_ASSERT_MSG(VertexID < vertexValues_.size(), "invalid VertexID");
+    return vertexValues_[VertexID];
   }
 
   /// @brief Get the list of edges of node given by `ID`
   EdgeList& edgesOf(int vertexValue) {
-    return *(adjacencyList_[getVertexIDFromValue(vertexValue)]);
+    closureValid_ = false;
+    return adjacencyList_[getVertexIDFromValue(vertexValue)];
   }
   const EdgeList& edgesOf(int vertexValue) const {
-    return *(adjacencyList_[getVertexIDFromValue(vertexValue)]);
+    return adjacencyList_[getVertexIDFromValue(vertexValue)];
   }
 
   /// @brief Clear the graph
   void clear() {
     vertices_.clear();
+    vertexValues_.clear();
     adjacencyList_.clear();
+    closureValid_ = false;
   }
 
   /// @brief Check if graph is empty
@@ -204,7 +236,7 @@ public:
   std::string toString() const {
     std::stringstream ss;
     for(std::size_t VertexID = 0; VertexID < adjacencyList_.size(); ++VertexID) {
-      for(const Edge& edge : *(adjacencyList_[VertexID])) {
+      for(const Edge& edge : adjacencyList_[VertexID]) {
         ss << static_cast<const Derived*>(this)->getVertexNameByVertexID(edge.FromVertexID)
            << static_cast<const Derived*>(this)->edgeDataToString(edge.Data)
            << static_cast<const Derived*>(this)->getVertexNameByVertexID(edge.ToVertexID) << "\n";
@@ -220,23 +252,70 @@ public:
   }
 
 protected:
-  bool hasCycleDependencyImpl(const int targetVertexID, const int seedID,
-                              std::set<int>& visited) const {
-    // DFS search for cycles on access to ID
-    for(auto& edge : *(getAdjacencyList()[seedID])) {
-      if(edge.ToVertexID == targetVertexID) {
-        return true;
-      }
-      visited.insert(seedID);
+  /// @brief Insert a new edge between two existing vertices (or merge it into the existing edge)
+  template <typename TEdgeData>
+  void insertEdgeByVertexID(std::size_t VertexIDFrom, std::size_t VertexIDTo, TEdgeData&& data) {
+    // The out-degree is small, a linear scan of the contiguous edge list is the fastest way to
+    // check if we already have such an edge
+    EdgeList& edgeList = adjacencyList_[VertexIDFrom];
+    auto it = std::find_if(edgeList.begin(), edgeList.end(), [&](const Edge& e) {
+      return e.ToVertexID == VertexIDTo;
+    });
 
-      if(visited.count(edge.ToVertexID)) {
-        return true;
-      }
-      if(hasCycleDependencyImpl(targetVertexID, edge.ToVertexID, visited)) {
-        return true;
+    if(it != edgeList.end())
+      static_cast<Derived*>(this)->edgeAlreadyExists(it->Data, data);
+    else {
+      edgeList.push_back(Edge{std::forward<TEdgeData>(data), VertexIDFrom, VertexIDTo});
+      closureValid_ = false;
+    }
+  }
+
+  /// @brief Compute the transitive closure
+  ///
+  /// The adjacency list is first compressed into a CSR representation. The closure of each vertex
+  /// is then computed by a depth-first search which reuses the (complete) closure of the vertices
+  /// with a lower VertexID.
+  void computeClosure() const {
+    const std::size_t numVertices = adjacencyList_.size();
+
+    std::vector<std::size_t> offsets(numVertices + 1, 0);
+    for(std::size_t VertexID = 0; VertexID < numVertices; ++VertexID)
+      offsets[VertexID + 1] = offsets[VertexID] + adjacencyList_[VertexID].size();
+    std::vector<std::size_t> targets;
+    targets.reserve(offsets.back());
+    for(const EdgeList& edgeList : adjacencyList_)
+      for(const Edge& edge : edgeList)
+        targets.push_back(edge.ToVertexID);
+
+    closureWords_ = (numVertices + 63) / 64;
+    closure_.assign(numVertices * closureWords_, 0);
+
+    std::vector<std::size_t> nodesToVisit;
+    for(std::size_t source = 0; source < numVertices; ++source) {
+      std::uint64_t* row = closure_.data() + source * closureWords_;
+      nodesToVisit.assign(targets.begin() + offsets[source], targets.begin() + offsets[source + 1]);
+
+      while(!nodesToVisit.empty()) {
+        std::size_t curNode = nodesToVisit.back();
+        nodesToVisit.pop_back();
+
+        std::uint64_t mask = std::uint64_t(1) << (curNode % 64);
+        if(row[curNode / 64] & mask)
+          continue;
+        row[curNode / 64] |= mask;
+
+        if(curNode < source) {
+          // Everything reachable from `curNode` is reachable from `source`
+          const std::uint64_t* curRow = closure_.data() + curNode * closureWords_;
+          for(std::size_t word = 0; word < closureWords_; ++word)
+            row[word] |= curRow[word];
+        } else {
+          nodesToVisit.insert(nodesToVisit.end(), targets.begin() + offsets[curNode],
+                              targets.begin() + offsets[curNode + 1]);
+        }
       }
     }
-    return false;
+    closureValid_ = true;
   }
 
   template <class StreamType>
@@ -254,7 +333,7 @@ protected:
                        "\"");
 
       // Convert edge to dot
-      for(const Edge& edge : *(adjacencyList_[VertexID]))
+      for(const Edge& edge : adjacencyList_[VertexID])
         edgeStrs.emplace(
             "\"" + FromVertexName + "\" -> \"" +
             static_cast<const Derived*>(this)->getVertexNameByVertexID(edge.ToVertexID) + "\"" +
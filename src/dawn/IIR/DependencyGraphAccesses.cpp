@@ -40,24 +40,12 @@ void DependencyGraphAccesses::insertStatementAccessesPair(
   }
 }
 
-DependencyGraphAccesses::Vertex& DependencyGraphAccesses::insertNode(int ID) {
-  Vertex& vertex = Base::insertNode(ID);
-  VertexIDToAccessIDMap_.emplace(vertex.VertexID, vertex.value);
-  return vertex;
-}
-
 void DependencyGraphAccesses::edgeAlreadyExists(DependencyGraphAccesses::EdgeData& existingEdge,
                                                 const DependencyGraphAccesses::EdgeData& newEdge) {
   if(!newEdge.isPointwise())
     existingEdge.merge(newEdge);
 }
 
-int DependencyGraphAccesses::getIDFromVertexID(std::size_t VertexID) const {
-  auto it = VertexIDToAccessIDMap_.find(VertexID);
-  DAWN_ASSERT_MSG(it != VertexIDToAccessIDMap_.end(), "Node with given VertexID does not exist");
-  return it->second;
-}
-
 const char* DependencyGraphAccesses::edgeDataToString(const EdgeData& data) const {
   if(data.isHorizontalPointwise() && data.isVerticalPointwise())
     return " -------> ";
@@ -82,27 +70,25 @@ std::string DependencyGraphAccesses::getVertexNameByVertexID(std::size_t VertexI
 }
 
 void DependencyGraphAccesses::merge(const DependencyGraphAccesses* other) {
-  // Insert the nodes of `other`
+  // Insert the nodes of `other` and map its VertexIDs to ours
+  std::vector<std::size_t> otherToThisVertexID(other->getNumVertices());
   for(const auto& AccessIDVertexIDPair : other->getVertices()) {
-    int AccessID = AccessIDVertexIDPair.first;
-    insertNode(AccessID);
+    const Vertex& otherVertex = AccessIDVertexIDPair.second;
+    otherToThisVertexID[otherVertex.VertexID] = insertNode(otherVertex.value).VertexID;
   }
 
   // Insert the edges of `other`
-  for(std::size_t VertexID = 0; VertexID < other->getAdjacencyList().size(); ++VertexID) {
-    for(const Edge& edge : *(other->getAdjacencyList()[VertexID])) {
-      insertEdge(other->getIDFromVertexID(edge.FromVertexID),
-                 other->getIDFromVertexID(edge.ToVertexID), edge.Data);
-    }
-  }
+  for(const EdgeList& edgeList : other->getAdjacencyList())
+    for(const Edge& edge : edgeList)
+      insertEdgeByVertexID(otherToThisVertexID[edge.FromVertexID],
+                           otherToThisVertexID[edge.ToVertexID], edge.Data);
 }
 
 std::shared_ptr<DependencyGraphAccesses> DependencyGraphAccesses::clone() const {
   auto graph = std::make_shared<DependencyGraphAccesses>(metaData_);
   graph->vertices_ = vertices_;
-  graph->VertexIDToAccessIDMap_ = VertexIDToAccessIDMap_;
-  for(const auto& edgeListPtr : adjacencyList_)
-    graph->adjacencyList_.push_back(std::make_shared<EdgeList>(*edgeListPtr));
+  graph->vertexValues_ = vertexValues_;
+  graph->adjacencyList_ = adjacencyList_;
   return graph;
 }
 
@@ -154,7 +140,7 @@ std::vector<std::set<std::size_t>> DependencyGraphAccesses::partitionInSubGraphs
         partition[curNode] = currentPartitionIdx;
       }
 
-      for(const Edge& edge : *adjacencyList_[curNode])
+      for(const Edge& edge : adjacencyList_[curNode])
         nodesToVisit.push_back(edge.ToVertexID);
     }
   }
@@ -192,46 +178,48 @@ void getInputVertexIDsImpl(
   const auto& adjacencyList = graph.getAdjacencyList();
   for(const auto& vertex : vertexList) {
     std::size_t VertexID = getVertexIDFromVertexListElemenFunc(vertex);
-    if(adjacencyList[VertexID]->empty())
+    if(adjacencyList[VertexID].empty())
       inputVertexIDs.push_back(VertexID);
-    else if(adjacencyList[VertexID]->size() == 1) {
+    else if(adjacencyList[VertexID].size() == 1) {
       // We allow self-dependencies!
-      const auto& edge = adjacencyList[VertexID]->front();
+      const auto& edge = adjacencyList[VertexID].front();
       if(edge.FromVertexID == edge.ToVertexID)
         inputVertexIDs.push_back(VertexID);
     }
   }
 }
 
+/// @brief Compute the dependent vertices i.e vertices with edges from other vertices pointing to
+/// them (indexed by VertexID)
+static std::vector<bool> computeDependentVertices(const DependencyGraphAccesses& graph) {
+  std::vector<bool> dependentVertices(graph.getNumVertices(), false);
+  for(const auto& edgeList : graph.getAdjacencyList())
+    for(const auto& edge : edgeList)
+      // We allow self-dependencies!
+      if(edge.FromVertexID != edge.ToVertexID)
+        dependentVertices[edge.ToVertexID] = true;
+  return dependentVertices;
+}
+
 /// @brief Generic version of computing the Output-VertexIDs
 ///
 /// This function can operate on the vertex list of the graph as well as on a simple set of
 /// VertexIDs.
 template <class VertexListType, class GetVertexIDFromVertexListElemenFuncType>
 void getOutputVertexIDsImpl(
-    const DependencyGraphAccesses& graph, const VertexListType& vertexList,
+    const std::vector<bool>& dependentVertices, const VertexListType& vertexList,
     GetVertexIDFromVertexListElemenFuncType&& getVertexIDFromVertexListElemenFunc,
     std::vector<std::size_t>& outputVertexIDs) {
-
-  std::set<std::size_t> dependentNodes;
-  const auto& adjacencyList = graph.getAdjacencyList();
-
-  // Construct a set of dependent nodes i.e nodes with edges from other nodes pointing to them
-  for(const auto& edgeList : adjacencyList)
-    for(const auto& edge : *edgeList)
-      // We allow self-dependencies!
-      if(edge.FromVertexID != edge.ToVertexID)
-        dependentNodes.insert(edge.ToVertexID);
-
   for(const auto& vertex : vertexList) {
     std::size_t VertexID = getVertexIDFromVertexListElemenFunc(vertex);
-    if(!dependentNodes.count(VertexID))
+    if(!dependentVertices[VertexID])
       outputVertexIDs.push_back(VertexID);
   }
 }
 
 bool DependencyGraphAccesses::isDAG() const {
   auto partitions = partitionInSubGraphs();
+  std::vector<bool> dependentVertices = computeDependentVertices(*this);
   std::vector<std::size_t> vertices;
 
   for(std::set<std::size_t>& partition : partitions) {
@@ -242,8 +230,8 @@ bool DependencyGraphAccesses::isDAG() const {
       return false;
 
     vertices.clear();
-    getOutputVertexIDsImpl(*this, partition, [](std::size_t VertexID) { return VertexID; },
-                           vertices);
+    getOutputVertexIDsImpl(dependentVertices, partition,
+                           [](std::size_t VertexID) { return VertexID; }, vertices);
     if(vertices.empty())
       return false;
   }
@@ -253,7 +241,7 @@ bool DependencyGraphAccesses::isDAG() const {
 std::vector<std::size_t> DependencyGraphAccesses::getOutputVertexIDs() const {
   std::vector<std::size_t> outputVertexIDs;
   getOutputVertexIDsImpl(
-      *this, vertices_,
+      computeDependentVertices(*this), vertices_,
       [](const std::pair<int, Vertex>& IDVertexPair) { return IDVertexPair.second.VertexID; },
       outputVertexIDs);
   return outputVertexIDs;
@@ -327,7 +315,7 @@ computeBoundaryExtents(const iir::DependencyGraphAccesses* graph) {
         visitedNodes.insert(curNode);
 
       // Follow edges of the current node and update the node extents
-      for(const Edge& edge : *adjacencyList[curNode]) {
+      for(const Edge& edge : adjacencyList[curNode]) {
         nodeExtents.at(edge.ToVertexID).merge(iir::Extents::add(curExtent, edge.Data));
         nodesToVisit.push_back(edge.ToVertexID);
       }
@@ -366,7 +354,7 @@ class StronglyConnectedComponents {
     const VertexType* Vertex;
   };
 
-  std::unordered_map<std::size_t, VertexData> vertexData_;
+  std::vector<VertexData> vertexData_;
   std::stack<std::size_t> vertexStack_;
 
   int index_;
@@ -385,9 +373,10 @@ public:
       scc_->clear();
 
     // Initialize the vertex Data
+    vertexData_.resize(graph_->getNumVertices());
     for(const auto& AccessIDVertexPair : graph_->getVertices()) {
       const VertexType& vertex = AccessIDVertexPair.second;
-      vertexData_.emplace(vertex.VertexID, VertexData{-1, -1, false, &vertex});
+      vertexData_[vertex.VertexID] = VertexData{-1, -1, false, &vertex};
     }
     index_ = 0;
     hasMultiNodeSCC_ = false;
@@ -416,7 +405,7 @@ private:
     index_++;
 
     // Consider successors of the `FromVertex`
-    for(const EdgeType& edge : *graph_->getAdjacencyList()[FromVertexID]) {
+    for(const EdgeType& edge : graph_->getAdjacencyList()[FromVertexID]) {
 
       VertexData& ToVertexData = vertexData_[edge.ToVertexID];
 
@@ -488,7 +477,7 @@ public:
     // Compute the neighbor-list
     std::vector<std::set<std::size_t>> neighborList(numVertices);
     for(std::size_t FromVertexID = 0; FromVertexID < numVertices; ++FromVertexID) {
-      for(const Edge& edge : *adjacencyList[FromVertexID]) {
+      for(const Edge& edge : adjacencyList[FromVertexID]) {
         neighborList[edge.FromVertexID].insert(edge.ToVertexID);
         neighborList[edge.ToVertexID].insert(edge.FromVertexID);
       }
@@ -534,11 +523,6 @@ void DependencyGraphAccesses::greedyColoring(std::unordered_map<int, int>& color
   return GreedyColoring(this, coloring).compute();
 }
 
-void DependencyGraphAccesses::clear() {
-  Base::clear();
-  VertexIDToAccessIDMap_.clear();
-}
-
 void DependencyGraphAccesses::toJSON(const std::string& file, DiagnosticsEngine& diagEngine) const {
   std::unordered_map<std::size_t, Extents> extentMap = computeBoundaryExtents(this);
   json::json jgraph;
@@ -574,7 +558,7 @@ void DependencyGraphAccesses::toJSON(const std::string& file, DiagnosticsEngine&
 
     jgraph["vertices"][std::to_string(VertexID)] = jvertex;
 
-    for(const Edge& edge : *getAdjacencyList()[VertexID]) {
+    for(const Edge& edge : getAdjacencyList()[VertexID]) {
       json::json jedge;
 
       jedge["from"] = edge.FromVertexID;
@@ -60,7 +60,6 @@ class DependencyGraphAccesses
     : public DependencyGraph<DependencyGraphAccesses, DependencyGraphAccessesEdgeData> {
 
   const StencilMetaInformation& metaData_;
-  std::unordered_map<std::size_t, int> VertexIDToAccessIDMap_;
 
 public:
   using Base = DependencyGraph<DependencyGraphAccesses, DependencyGraphAccessesEdgeData>;
@@ -95,14 +94,11 @@ public:
   void
   insertStatementAccessesPair(const std::unique_ptr<iir::StatementAccessesPair>& stmtAccessPair);
 
-  /// @brief Insert a new node
-  Vertex& insertNode(int ID);
-
   /// @brief Merge extents if edge already exists
   void edgeAlreadyExists(EdgeData& existingEdge, const EdgeData& newEdge);
 
-  /// @brief Get the ID of the vertex given by ID
-  int getIDFromVertexID(std::size_t VertexID) const;
+  /// @brief Get the AccessID of the vertex given by `VertexID`
+  int getIDFromVertexID(std::size_t VertexID) const { return getValueFromVertexID(VertexID); }
 
   /// @brief EdgeData to string
   const char* edgeDataToString(const EdgeData& data) const;
@@ -168,9 +164,6 @@ public:
   /// @see https://en.wikipedia.org/wiki/Greedy_coloring
   void greedyColoring(std::unordered_map<int, int>& coloring) const;
 
-  /// @brief Clear the graph
-  void clear();
-
   /// @brief Serialize the graph to JSON
   void toJSON(const std::string& file, DiagnosticsEngine& diagEngine) const;
 
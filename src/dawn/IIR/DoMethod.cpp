@@ -16,6 +16,7 @@
 #include "dawn/IIR/AccessUtils.h"
 #include "dawn/IIR/Accesses.h"
 #include "dawn/IIR/DependencyGraphAccesses.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/IIR/IIR.h"
 #include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/MultiStage.h"
@@ -33,8 +34,10 @@ namespace iir {
 DoMethod::DoMethod(Interval interval, const StencilMetaInformation& metaData)
     : interval_(interval), id_(IndexGenerator::Instance().getIndex()), metaData_(metaData) {}
 
-std::unique_ptr<DoMethod> DoMethod::clone() const {
-  auto cloneMS = std::make_unique<DoMethod>(interval_, metaData_);
+std::unique_ptr<DoMethod> DoMethod::clone() const { return clone(metaData_); }
+
+std::unique_ptr<DoMethod> DoMethod::clone(const StencilMetaInformation& metadata) const {
+  auto cloneMS = std::make_unique<DoMethod>(interval_, metadata);
 
   cloneMS->setID(id_);
   cloneMS->setDependencyGraph(derivedInfo_.dependencyGraph_);
@@ -92,6 +95,19 @@ void DoMethod::DerivedInfo::clear() { fields_.clear(); }
 
 void DoMethod::clearDerivedInfo() { derivedInfo_.clear(); }
 
+void DoMethod::renumberIDs(const IDRenumbering& renumbering) {
+  id_ = renumbering.mapIndex(id_);
+
+  renumberFields(derivedInfo_.fields_, renumbering);
+
+  // The dependency graph may be shared with clones of this Do-Method
+  if(derivedInfo_.dependencyGraph_ && renumbering.visit(derivedInfo_.dependencyGraph_.get()))
+    derivedInfo_.dependencyGraph_->renumberIDs(renumbering);
+
+  for(const auto& stmtAccessesPair : children_)
+    stmtAccessesPair->renumberIDs(renumbering);
+}
+
 json::json DoMethod::jsonDump(const StencilMetaInformation& metaData) const {
   json::json node;
   node["ID"] = id_;
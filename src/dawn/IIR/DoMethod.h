@@ -27,6 +27,7 @@ namespace iir {
 
 class Stage;
 class DependencyGraphAccesses;
+class IDRenumbering;
 class StatementAccessesPair;
 class StencilMetaInformation;
 
@@ -71,6 +72,9 @@ public:
   /// @brief clone the object creating and returning a new unique_ptr
   std::unique_ptr<DoMethod> clone() const;
 
+  /// @brief clone the Do-Method, the clone refers to the meta information `metadata`
+  std::unique_ptr<DoMethod> clone(const StencilMetaInformation& metadata) const;
+
   /// @name Getters
   /// @{
   Interval& getInterval();
@@ -88,6 +92,9 @@ public:
 
   virtual void clearDerivedInfo() override;
 
+  /// @brief Renumber the ID, the derived info and the statements (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
+
   /// @brief computes the maximum extent among all the accesses of accessID
   boost::optional<Extents> computeMaximumExtents(const int accessID) const;
 
@@ -109,12 +116,16 @@ public:
   /// `Input`
   ///
   /// The fields are computed during `DoMethod::update`.
-  const std::unordered_map<int, Field>& getFields() const { return derivedInfo_.fields_; }
+  const std::unordered_map<int, Field>& getFields() const {
+    flushIfDirty();
+    return derivedInfo_.fields_;
+  }
 
-  bool hasField(int accessID) const { return derivedInfo_.fields_.count(accessID); }
+  bool hasField(int accessID) const { return getFields().count(accessID); }
 
   /// @brief field getter
   const Field& getField(const int accessID) const {
+    flushIfDirty();
     DAWN_ASSERT(derivedInfo_.fields_.count(accessID));
     return derivedInfo_.fields_.at(accessID);
   }
@@ -13,11 +13,16 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/IIR/Field.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/IIR/StencilMetaInformation.h"
 
 namespace dawn {
 namespace iir {
 
+void Field::renumberIDs(const IDRenumbering& renumbering) {
+  accessID_ = renumbering.mapUID(accessID_);
+}
+
 Interval Field::computeAccessedInterval() const {
   Interval accessedInterval = interval_;
   accessedInterval = accessedInterval.extendInterval(getExtents());
@@ -84,6 +89,12 @@ void mergeFields(std::unordered_map<int, Field> const& sourceFields,
   }
 }
 
+void renumberFields(std::unordered_map<int, Field>& fields, const IDRenumbering& renumbering) {
+  fields = renumbering.mapKeys(fields);
+  for(auto& fieldPair : fields)
+    fieldPair.second.renumberIDs(renumbering);
+}
+
 void Field::setReadExtentsRB(boost::optional<Extents> const& extents) {
   if(extents.is_initialized()) {
     extentsRB_.setReadExtents(*extents);
@@ -23,6 +23,7 @@
 
 namespace dawn {
 namespace iir {
+class IDRenumbering;
 class StencilInstantiation;
 
 /// @brief Information of a field
@@ -109,6 +110,9 @@ public:
   inline void setWriteExtentsRB(boost::optional<Extents> const& extents);
   /// @}
 
+  /// @brief Renumber the AccessID (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
+
   // Enclosing interval where accesses where recorded,
   /// i.e. interval_.extend(Extent)
   Interval computeAccessedInterval() const;
@@ -148,6 +152,9 @@ void mergeFields(std::unordered_map<int, Field> const& sourceFields,
 
 void mergeField(const Field& sField, Field& dField);
 
+/// @brief Renumber the fields and their keys in `fields` (see `IDRenumbering`)
+void renumberFields(std::unordered_map<int, Field>& fields, const IDRenumbering& renumbering);
+
 } // namespace iir
 } // namespace dawn
 
@@ -13,6 +13,7 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/IIR/FieldAccessMetadata.h"
+#include "dawn/IIR/IDRenumbering.h"
 
 namespace dawn {
 namespace iir {
@@ -37,6 +38,28 @@ std::string toString(FieldAccessType type) {
   return "Unkown";
 }
 
+VariableVersions::VariableVersions(const VariableVersions& other) { *this = other; }
+
+VariableVersions& VariableVersions::operator=(const VariableVersions& other) {
+  if(this == &other)
+    return *this;
+  variableVersionsMap_.clear();
+  for(const auto& pair : other.variableVersionsMap_)
+    variableVersionsMap_.emplace(pair.first, std::make_shared<std::vector<int>>(*pair.second));
+  derivedInfo_ = other.derivedInfo_;
+  return *this;
+}
+
+void VariableVersions::renumberIDs(const IDRenumbering& renumbering) {
+  variableVersionsMap_ = renumbering.mapKeys(variableVersionsMap_);
+  for(const auto& pair : variableVersionsMap_)
+    for(int& ID : *pair.second)
+      ID = renumbering.mapUID(ID);
+  derivedInfo_.versionToOriginalVersionMap_ =
+      renumbering.mapKeysAndValues(derivedInfo_.versionToOriginalVersionMap_);
+  derivedInfo_.versionIDs_ = renumbering.mapSet(derivedInfo_.versionIDs_);
+}
+
 json::json VariableVersions::jsonDump() const {
   json::json node;
 
@@ -57,20 +80,5 @@ json::json VariableVersions::jsonDump() const {
   return node;
 }
 
-void FieldAccessMetadata::clone(const FieldAccessMetadata& origin) {
-  LiteralAccessIDToNameMap_ = origin.LiteralAccessIDToNameMap_;
-  FieldAccessIDSet_ = origin.FieldAccessIDSet_;
-  apiFieldIDs_ = origin.apiFieldIDs_;
-  TemporaryFieldAccessIDSet_ = origin.TemporaryFieldAccessIDSet_;
-  AllocatedFieldAccessIDSet_ = origin.AllocatedFieldAccessIDSet_;
-  GlobalVariableAccessIDSet_ = origin.GlobalVariableAccessIDSet_;
-  for(auto idToVersionsPair : origin.variableVersions_.getvariableVersionsMap()) {
-    int originalID = idToVersionsPair.first;
-    for(auto versionID : *idToVersionsPair.second) {
-      variableVersions_.addIDPair(originalID, versionID);
-    }
-  }
-  accessIDType_ = origin.accessIDType_;
-}
 } // namespace iir
 } // namespace dawn
@@ -25,10 +25,19 @@
 namespace dawn {
 namespace iir {
 
+class IDRenumbering;
+
 class VariableVersions {
 public:
   VariableVersions() = default;
 
+  /// @brief Copies own the lists of versions, i.e. modifying the versions of a copy does not
+  /// affect the original
+  VariableVersions(const VariableVersions& other);
+  VariableVersions(VariableVersions&&) = default;
+  VariableVersions& operator=(const VariableVersions& other);
+  VariableVersions& operator=(VariableVersions&&) = default;
+
 private:
   /// This map links the original fieldID with a list of all it's versioned fields. The index of
   /// the field in the vector denotes the version of the field
@@ -126,6 +135,9 @@ public:
     return variableVersionsMap_;
   }
 
+  /// @brief Renumber the AccessIDs (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
+
   json::json jsonDump() const;
 };
 
@@ -255,8 +267,6 @@ struct FieldAccessMetadata {
   std::set<int> AllocatedFieldAccessIDSet_;
 
   std::unordered_map<int, FieldAccessType> accessIDType_;
-
-  void clone(const FieldAccessMetadata& origin);
 };
 } // namespace iir
 } // namespace dawn
@@ -0,0 +1,168 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/IIR/IDRenumbering.h"
+#include "dawn/IIR/ASTExpr.h"
+#include "dawn/IIR/ASTStmt.h"
+#include "dawn/IIR/ASTVisitor.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Support/StringRef.h"
+#include <algorithm>
+#include <cctype>
+
+namespace dawn {
+namespace iir {
+
+namespace {
+
+/// @brief Renumber the IDs and the generated names of the nodes of an AST
+class ASTRenumberer : public iir::ASTVisitorForwarding {
+  const IDRenumbering& renumbering_;
+
+  void renumberNode(Stmt& stmt) { stmt.setID(renumbering_.mapUID(stmt.getID())); }
+  void renumberNode(Expr& expr) { expr.setID(renumbering_.mapUID(expr.getID())); }
+
+  void renumberNode(VarDeclStmt& stmt) {
+    stmt.setID(renumbering_.mapUID(stmt.getID()));
+    stmt.getName() = renumbering_.mapName(stmt.getName());
+  }
+
+  void renumberNode(StencilCallDeclStmt& stmt) {
+    stmt.setID(renumbering_.mapUID(stmt.getID()));
+    ast::StencilCall& call = *stmt.getStencilCall();
+    call.Callee = renumbering_.mapName(call.Callee);
+    for(std::string& arg : call.Args)
+      arg = renumbering_.mapName(arg);
+  }
+
+  void renumberNode(StencilFunCallExpr& expr) {
+    expr.setID(renumbering_.mapUID(expr.getID()));
+    expr.setCallee(renumbering_.mapName(expr.getCallee()));
+  }
+
+  void renumberNode(VarAccessExpr& expr) {
+    expr.setID(renumbering_.mapUID(expr.getID()));
+    expr.setName(renumbering_.mapName(expr.getName()));
+  }
+
+  void renumberNode(FieldAccessExpr& expr) {
+    expr.setID(renumbering_.mapUID(expr.getID()));
+    expr.setName(renumbering_.mapName(expr.getName()));
+  }
+
+public:
+  ASTRenumberer(const IDRenumbering& renumbering) : renumbering_(renumbering) {}
+
+#define DAWN_RENUMBER_NODE(NodeType)                                                               \
+  void visit(const std::shared_ptr<NodeType>& node) override {                                     \
+    if(!renumbering_.visit(node.get()))                                                            \
+      return;                                                                                      \
+    renumberNode(*node);                                                                           \
+    iir::ASTVisitorForwarding::visit(node);                                                        \
+  }
+
+  DAWN_RENUMBER_NODE(BlockStmt)
+  DAWN_RENUMBER_NODE(ExprStmt)
+  DAWN_RENUMBER_NODE(ReturnStmt)
+  DAWN_RENUMBER_NODE(VarDeclStmt)
+  DAWN_RENUMBER_NODE(VerticalRegionDeclStmt)
+  DAWN_RENUMBER_NODE(StencilCallDeclStmt)
+  DAWN_RENUMBER_NODE(BoundaryConditionDeclStmt)
+  DAWN_RENUMBER_NODE(IfStmt)
+  DAWN_RENUMBER_NODE(ReductionOverNeighborExpr)
+  DAWN_RENUMBER_NODE(UnaryOperator)
+  DAWN_RENUMBER_NODE(BinaryOperator)
+  DAWN_RENUMBER_NODE(AssignmentExpr)
+  DAWN_RENUMBER_NODE(TernaryOperator)
+  DAWN_RENUMBER_NODE(FunCallExpr)
+  DAWN_RENUMBER_NODE(StencilFunCallExpr)
+  DAWN_RENUMBER_NODE(StencilFunArgExpr)
+  DAWN_RENUMBER_NODE(VarAccessExpr)
+  DAWN_RENUMBER_NODE(FieldAccessExpr)
+  DAWN_RENUMBER_NODE(LiteralAccessExpr)
+
+#undef DAWN_RENUMBER_NODE
+};
+
+} // anonymous namespace
+
+IDRenumbering::IDRenumbering(int uidFrom, int uidTo, int uidCount, long unsigned int indexFrom,
+                             long unsigned int indexTo, long unsigned int indexCount)
+    : uidFrom_(uidFrom), uidTo_(uidTo), uidCount_(uidCount), indexFrom_(indexFrom),
+      indexTo_(indexTo), indexCount_(indexCount) {}
+
+int IDRenumbering::mapUID(int ID) const {
+  // Literal AccessIDs are negated UIDs
+  if(ID < 0)
+    return -mapUID(-ID);
+  return ID >= uidFrom_ && ID - uidFrom_ < uidCount_ ? ID - uidFrom_ + uidTo_ : ID;
+}
+
+long unsigned int IDRenumbering::mapIndex(long unsigned int index) const {
+  return index >= indexFrom_ && index - indexFrom_ < indexCount_ ? index - indexFrom_ + indexTo_
+                                                                 : index;
+}
+
+std::string IDRenumbering::mapName(const std::string& name) const {
+  StringRef nameRef(name);
+  if(!nameRef.startswith("__tmp_") && !nameRef.startswith("__local_") &&
+     !nameRef.startswith("__code_gen_"))
+    return name;
+
+  // The IDs are the numbers delimited by underscores (a name may embed several of them, e.g the
+  // stencil functions computing a temporary on the fly are named `__tmp_<name>_<AccessID>_...`)
+  std::string result;
+  std::size_t pos = 0;
+  while(pos <= name.size()) {
+    std::size_t end = name.find('_', pos);
+    if(end == std::string::npos)
+      end = name.size();
+
+    std::string token = name.substr(pos, end - pos);
+    if(!token.empty() && token.size() < 10 &&
+       std::all_of(token.begin(), token.end(), [](unsigned char c) { return std::isdigit(c) != 0; }))
+      token = std::to_string(mapUID(std::stoi(token)));
+
+    result += token;
+    if(end != name.size())
+      result += '_';
+    pos = end + 1;
+  }
+  return result;
+}
+
+void IDRenumbering::renumberAST(const std::shared_ptr<Stmt>& stmt) const {
+  ASTRenumberer renumberer(*this);
+  stmt->accept(renumberer);
+}
+
+void IDRenumbering::renumberAST(const std::shared_ptr<Expr>& expr) const {
+  ASTRenumberer renumberer(*this);
+  expr->accept(renumberer);
+}
+
+void IDRenumbering::renumberStencilFunction(
+    const std::shared_ptr<sir::StencilFunction>& stencilFunction) const {
+  if(!visit(stencilFunction.get()))
+    return;
+  stencilFunction->Name = mapName(stencilFunction->Name);
+  for(const auto& arg : stencilFunction->Args)
+    if(visit(arg.get()))
+      arg->Name = mapName(arg->Name);
+  for(const auto& ast : stencilFunction->Asts)
+    renumberAST(ast->getRoot());
+}
+
+} // namespace iir
+} // namespace dawn
@@ -0,0 +1,106 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_IIR_IDRENUMBERING_H
+#define DAWN_IIR_IDRENUMBERING_H
+
+#include "dawn/IIR/ASTFwd.h"
+#include "dawn/Support/NonCopyable.h"
+#include <memory>
+#include <string>
+#include <unordered_set>
+
+namespace dawn {
+namespace sir {
+struct StencilFunction;
+}
+
+namespace iir {
+
+/// @brief Renumbering of the identifiers which were drawn from a range of the `UIDGenerator` and
+/// of the `IndexGenerator`
+///
+/// The UIDs `[uidFrom, uidFrom + uidCount)` are mapped to `[uidTo, uidTo + uidCount)` and the
+/// indices `[indexFrom, indexFrom + indexCount)` to `[indexTo, indexTo + indexCount)`, all other
+/// identifiers are kept. Literal AccessIDs, which are negated UIDs, are mapped accordingly. This is
+/// used to give the stencil instantiations optimized in parallel the identifiers they would have
+/// been given by the serial optimizer (see `StencilInstantiation::renumberIDs`).
+///
+/// Objects may be shared by several owners (e.g AST nodes or accesses shared with clones), `visit`
+/// makes sure each of them is only renumbered once.
+/// @ingroup optimizer
+class IDRenumbering : NonCopyable {
+  int uidFrom_, uidTo_, uidCount_;
+  long unsigned int indexFrom_, indexTo_, indexCount_;
+  mutable std::unordered_set<const void*> visited_;
+
+public:
+  IDRenumbering(int uidFrom, int uidTo, int uidCount, long unsigned int indexFrom,
+                long unsigned int indexTo, long unsigned int indexCount);
+
+  /// @brief Map a UID (e.g ID of an AST node, StencilID, StageID) or an AccessID
+  int mapUID(int ID) const;
+
+  /// @brief Map an index of the `IndexGenerator` (i.e the ID of a Do-Method)
+  long unsigned int mapIndex(long unsigned int index) const;
+
+  /// @brief Map the IDs embedded in a name generated by the `InstantiationHelper` (e.g
+  /// `__tmp_<name>_<AccessID>`), other names are returned unchanged
+  std::string mapName(const std::string& name) const;
+
+  /// @brief Copy of the set `set` with mapped IDs
+  template <class SetType>
+  SetType mapSet(const SetType& set) const {
+    SetType result;
+    for(int ID : set)
+      result.insert(mapUID(ID));
+    return result;
+  }
+
+  /// @brief Copy of the map `map` with mapped keys
+  template <class MapType>
+  MapType mapKeys(const MapType& map) const {
+    MapType result;
+    for(const auto& pair : map)
+      result.emplace(mapUID(pair.first), pair.second);
+    return result;
+  }
+
+  /// @brief Copy of the map `map` with mapped keys and values
+  template <class MapType>
+  MapType mapKeysAndValues(const MapType& map) const {
+    MapType result;
+    for(const auto& pair : map)
+      result.emplace(mapUID(pair.first), mapUID(pair.second));
+    return result;
+  }
+
+  /// @brief Returns `true` the first time it is called with `object`
+  bool visit(const void* object) const { return visited_.insert(object).second; }
+
+  /// @brief Renumber the AST nodes (IDs and generated names) of `stmt` and `expr`
+  /// @{
+  void renumberAST(const std::shared_ptr<Stmt>& stmt) const;
+  void renumberAST(const std::shared_ptr<Expr>& expr) const;
+  /// @}
+
+  /// @brief Renumber the name, the arguments and the ASTs of a stencil function (the stencil
+  /// functions computing a temporary on the fly are named after its AccessID)
+  void renumberStencilFunction(const std::shared_ptr<sir::StencilFunction>& stencilFunction) const;
+};
+
+} // namespace iir
+} // namespace dawn
+
+#endif
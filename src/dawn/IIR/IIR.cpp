@@ -15,6 +15,7 @@
 #include "dawn/IIR/IIR.h"
 #include "dawn/IIR/DependencyGraphStage.h"
 #include "dawn/IIR/Field.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/IIR/StatementAccessesPair.h"
 #include "dawn/IIR/Stencil.h"
 #include "dawn/SIR/SIR.h"
@@ -76,6 +77,22 @@ void IIR::updateFromChildren() {
 
 void IIR::DerivedInfo::clear() { fields_.clear(); }
 
+void IIR::renumberIDs(const IDRenumbering& renumbering) {
+  for(const auto& stmt : controlFlowDesc_.getStatements())
+    renumbering.renumberAST(stmt);
+
+  derivedInfo_.StageIDToNameMap_ = renumbering.mapKeys(derivedInfo_.StageIDToNameMap_);
+  derivedInfo_.fields_ = renumbering.mapKeys(derivedInfo_.fields_);
+  for(auto& fieldInfoPair : derivedInfo_.fields_)
+    fieldInfoPair.second.renumberIDs(renumbering);
+
+  for(const auto& stencilFunction : stencilFunctions_)
+    renumbering.renumberStencilFunction(stencilFunction);
+
+  for(const auto& stencil : children_)
+    stencil->renumberIDs(renumbering);
+}
+
 json::json IIR::jsonDump() const {
   json::json node;
 
@@ -106,9 +123,19 @@ IIR::IIR(const sir::GlobalVariableMap& sirGlobals,
 
 void IIR::clone(std::unique_ptr<IIR>& dest) const {
   dest->cloneChildrenFrom(*this, dest);
+  cloneAttributes(dest);
+}
+
+void IIR::clone(std::unique_ptr<IIR>& dest, StencilMetaInformation& metadata) const {
+  dest->cloneChildrenFrom(*this, dest, metadata);
+  cloneAttributes(dest);
+}
+
+void IIR::cloneAttributes(std::unique_ptr<IIR>& dest) const {
   dest->setBlockSize(blockSize_);
   dest->controlFlowDesc_ = controlFlowDesc_.clone();
   dest->globalVariableMap_ = globalVariableMap_;
+  dest->derivedInfo_.StageIDToNameMap_ = derivedInfo_.StageIDToNameMap_;
 }
 
 } // namespace iir
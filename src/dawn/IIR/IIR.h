@@ -23,6 +23,8 @@
 namespace dawn {
 namespace iir {
 
+class IDRenumbering;
+
 /// @brief A Stencil is represented by a collection of MultiStages
 /// @ingroup optimizer
 class IIR : public IIRNode<void, IIR, Stencil> {
@@ -43,6 +45,9 @@ class IIR : public IIRNode<void, IIR, Stencil> {
 
   DerivedInfo derivedInfo_;
 
+  /// @brief Copy everything but the children to `dest`
+  void cloneAttributes(std::unique_ptr<IIR>& dest) const;
+
 public:
   static constexpr const char* name = "IIR";
 
@@ -64,18 +69,29 @@ public:
   /// @brief clone the IIR
   void clone(std::unique_ptr<IIR>& dest) const;
 
+  /// @brief clone the IIR into `dest`, the cloned nodes refer to the meta information `metadata`
+  void clone(std::unique_ptr<IIR>& dest, StencilMetaInformation& metadata) const;
+
   json::json jsonDump() const;
 
   /// @brief update the derived info from children
   virtual void updateFromChildren() override;
 
+  /// @brief Renumber the control flow, the derived info, the stencil functions and the stencils
+  /// (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
+
   /// @brief returns true if the accessid is used within the stencil
-  bool hasFieldAccessID(const int accessID) const { return derivedInfo_.fields_.count(accessID); }
+  bool hasFieldAccessID(const int accessID) const { return getFields().count(accessID); }
 
   /// @brief Get the pair <AccessID, field> for the fields used within the multi-stage
   const std::unordered_map<int, Stencil::FieldInfo>& getFields() const {
+    flushIfDirty();
     return derivedInfo_.fields_;
   }
+  std::map<int, Stencil::FieldInfo> getOrderedFields() const {
+    return support::orderMap(getFields());
+  }
 
   const std::vector<std::shared_ptr<sir::StencilFunction>>& getStencilFunctions() {
     return stencilFunctions_;
@@ -15,11 +15,14 @@
 #ifndef DAWN_IIR_IIRNODE_H
 #define DAWN_IIR_IIRNODE_H
 
+#include "dawn/IIR/DeferredUpdate.h"
 #include "dawn/IIR/NodeUpdateType.h"
 #include "dawn/Support/Assert.h"
 #include "dawn/Support/RemoveIf.hpp"
 #include "dawn/Support/Unreachable.h"
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <iterator>
 #include <list>
@@ -37,9 +40,22 @@
 namespace dawn {
 namespace iir {
 
+class StencilMetaInformation;
+
 namespace impl {
 template <typename T>
 using StdVector = std::vector<T, std::allocator<T>>;
+
+/// @brief Epoch of the structure of all the subtrees which are not attached to an IIR tree
+///
+/// The parent pointers of the nodes of a detached subtree are not set, a modification of such a
+/// subtree thus cannot reach the structure epoch of its root (see `IIRNode::getStructureEpoch`)
+/// and increments this counter instead.
+extern std::atomic<std::uint64_t> DetachedStructureEpoch;
+
+inline std::uint64_t getDetachedStructureEpoch() {
+  return DetachedStructureEpoch.load(std::memory_order_relaxed);
+}
 }
 
 template <typename P>
@@ -52,9 +68,14 @@ bool ptrEqual(const std::weak_ptr<P>& f, const std::weak_ptr<P>& s) {
 /// @tparam NodeType the same class that inherits from this IIRNode, i.e. this node
 /// @tparam Child child class of the node
 /// @tparam Container stl containter that stores the children
+///
+/// Modifications of the children update the derived info of the node and its ancestors, unless a
+/// `DeferredUpdateScope` is open, in which case the nodes are only marked dirty (see
+/// `impl::DeferredUpdateNode`). Insertions, erasures and replacements of children also increment
+/// the structure epoch of the node and its ancestors (see `getStructureEpoch`).
 template <typename Parent, typename NodeType, typename Child,
           template <class> class Container = impl::StdVector>
-class IIRNode {
+class IIRNode : public impl::DeferredUpdateNode {
 
 protected:
   /// @brief constructors
@@ -70,6 +91,9 @@ protected:
 
   Container<SmartPtr<Child>> children_;
 
+  /// Number of structural modifications in the subtree of this node
+  std::uint64_t structureEpoch_ = 0;
+
 public:
   using ParentType = Parent;
   using ChildType = Child;
@@ -84,14 +108,31 @@ public:
   using child_reverse_iterator_t = typename Container<SmartPtr<Child>>::reverse_iterator;
 
   /// @brief clone the children of another node and store them as children of this object
+  ///
+  /// The derived info of this node is updated once after all the children are inserted.
   /// @param other node from where the children are cloned
   inline void cloneChildrenFrom(const IIRNode& other) { cloneChildrenImpl<Child>(other); }
   /// @brief clone the children of another node and store them as children of this object
   /// @param other node from where the children are cloned
+  /// @param metadata meta information the cloned children refer to (passed to their `clone`)
+  inline void cloneChildrenFrom(const IIRNode& other, StencilMetaInformation& metadata) {
+    cloneChildrenImpl<Child>(other, metadata);
+  }
+  /// @brief clone the children of another node and store them as children of this object
+  /// @param other node from where the children are cloned
   /// @param thisNode smart ptr of this object (specialization for nodes that have no parent)
   inline void cloneChildrenFrom(const IIRNode& other, const SmartPtr<NodeType>& thisNode) {
     DAWN_ASSERT(thisNode.get() == this);
-    cloneChildrenImpl<Child>(other, thisNode);
+    cloneRootChildrenImpl<Child>(other, thisNode);
+  }
+  /// @brief clone the children of another node and store them as children of this object
+  /// @param other node from where the children are cloned
+  /// @param thisNode smart ptr of this object (specialization for nodes that have no parent)
+  /// @param metadata meta information the cloned children refer to (passed to their `clone`)
+  inline void cloneChildrenFrom(const IIRNode& other, const SmartPtr<NodeType>& thisNode,
+                                StencilMetaInformation& metadata) {
+    DAWN_ASSERT(thisNode.get() == this);
+    cloneRootChildrenImpl<Child>(other, thisNode, metadata);
   }
 
   /// @brief getters and iterator getters
@@ -140,6 +181,7 @@ public:
   /// @return iterator to next element
   inline ChildIterator childrenErase(ChildIterator childIt) {
     auto it_ = children_.erase(childIt);
+    bumpStructureEpoch();
 
     fixAfterErase();
 
@@ -157,6 +199,7 @@ public:
     if(!res)
       return res;
 
+    bumpStructureEpoch();
     fixAfterErase();
     return res;
   }
@@ -176,6 +219,18 @@ public:
   /// @brief check if the pointer to parent is set
   inline bool parentIsSet() const { return static_cast<bool>(parent_); }
 
+  /// @brief Get the epoch of the structure of the subtree of this node
+  ///
+  /// Incremented by every insertion, erasure or replacement of children in the subtree, which
+  /// allows caches of the structure (e.g `StencilLeafIndex`) to be validated with a single
+  /// comparison. Modifications only reach the ancestors whose parent pointers are set, i.e the
+  /// epoch is only reliable for nodes attached to an IIR tree (see
+  /// `impl::DetachedStructureEpoch` for the others).
+  inline std::uint64_t getStructureEpoch() const { return structureEpoch_; }
+
+  /// @brief Increment the structure epoch of this node and its ancestors
+  inline void bumpStructureEpoch() { bumpStructureEpochImpl<Parent>(); }
+
   template <bool T>
   struct identity {
     using type = std::integral_constant<bool, T>;
@@ -326,7 +381,10 @@ public:
   bool childrenEmpty() const { return children_.empty(); }
 
   /// @brief clear the container of chilren
-  void clearChildren() { children_.clear(); }
+  void clearChildren() {
+    children_.clear();
+    bumpStructureEpoch();
+  }
 
   /// @brief get the smart pointer of a raw pointer child node
   inline const std::unique_ptr<Child>& getChildSmartPtr(Child* child) {
@@ -346,7 +404,8 @@ public:
   inline void updateFromChildrenRec(
       typename std::enable_if<std::is_void<typename TNodeType::ParentType>::value>::type* = 0) {
 
-    updateFromChildren();
+    if(!deferUpdate(UK_Children))
+      updateFromChildren();
   }
 
   /// @brief update recursively (propagating to the top of the tree) the derived info of this node
@@ -354,7 +413,8 @@ public:
   inline void updateFromChildrenRec(
       typename std::enable_if<!std::is_void<typename TNodeType::ParentType>::value>::type* = 0) {
 
-    updateFromChildren();
+    if(!deferUpdate(UK_Children))
+      updateFromChildren();
 
     auto parentPtr = getParentPtr();
     if(parentPtr) {
@@ -366,7 +426,8 @@ public:
   template <typename TNodeType>
   inline void clearDerivedInfoRec(
       typename std::enable_if<std::is_void<typename TNodeType::ParentType>::value>::type* = 0) {
-    clearDerivedInfo();
+    if(!deferUpdate(UK_Clear))
+      clearDerivedInfo();
   }
 
   /// @brief clear the derived info recursively (propagating to the top of the tree)
@@ -376,7 +437,8 @@ public:
 
     auto parentPtr = getParentPtr();
     if(parentPtr) {
-      (*parentPtr)->clearDerivedInfo();
+      if(!(*parentPtr)->deferUpdate(UK_Clear))
+        (*parentPtr)->clearDerivedInfo();
       (*parentPtr)->template clearDerivedInfoRec<typename TNodeType::ParentType>();
     }
   }
@@ -385,7 +447,7 @@ public:
   /// @param updateType determines if the update should be applied to this tree level (only) or
   /// propagate it to the top or bottom of the tree
   void update(NodeUpdateType updateType) {
-    if(impl::updateLevel(updateType)) {
+    if(impl::updateLevel(updateType) && !deferUpdate(UK_Clear | UK_Level | UK_Children)) {
       clearDerivedInfo();
       static_cast<NodeType*>(this)->updateLevel();
       if(!impl::updateTreeAbove(updateType)) {
@@ -404,7 +466,49 @@ public:
   virtual void updateLevel() {}
   virtual void clearDerivedInfo() {}
 
+protected:
+  /// @brief apply the deferred updates of the children and then the updates `kinds` of this node
+  void applyUpdate(unsigned kinds) override {
+    applyPendingUpdateOfChildren<Child>();
+
+    if(kinds & UK_Clear)
+      clearDerivedInfo();
+    if(kinds & UK_Level)
+      static_cast<NodeType*>(this)->updateLevel();
+    if(kinds & (UK_Level | UK_Children))
+      updateFromChildren();
+  }
+
 private:
+  template <typename TParent>
+  void bumpStructureEpochImpl(typename std::enable_if<std::is_void<TParent>::value>::type* = 0) {
+    ++structureEpoch_;
+  }
+
+  template <typename TParent>
+  void bumpStructureEpochImpl(typename std::enable_if<!std::is_void<TParent>::value>::type* = 0) {
+    PROTECT_TEMPLATE(TParent, Parent)
+    ++structureEpoch_;
+    if(parent_ && *parent_)
+      (*parent_)->bumpStructureEpoch();
+    else
+      impl::DetachedStructureEpoch.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  template <typename TChild>
+  void
+  applyPendingUpdateOfChildren(typename std::enable_if<std::is_void<TChild>::value>::type* = 0) {}
+
+  template <typename TChild>
+  void
+  applyPendingUpdateOfChildren(typename std::enable_if<!std::is_void<TChild>::value>::type* = 0) {
+    PROTECT_TEMPLATE(TChild, Child)
+
+    for(const auto& child : children_) {
+      child->applyPendingUpdate();
+    }
+  }
+
   /// @brief fix the tree structure after the erase of a child
   inline void fixAfterErase() {
     // since we have removed a child, the pointers of other siblings might have change,
@@ -436,31 +540,39 @@ private:
     return *it;
   }
 
-  template <typename TChild>
-  void cloneChildrenImpl(const IIRNode& other,
-                         typename std::enable_if<std::is_void<TChild>::value>::type* = 0) {}
+  template <typename TChild, typename... Args>
+  typename std::enable_if<std::is_void<TChild>::value>::type
+  cloneChildrenImpl(const IIRNode& other, Args&... args) {}
 
-  template <typename TChild>
-  void cloneChildrenImpl(const IIRNode& other,
-                         typename std::enable_if<!std::is_void<TChild>::value>::type* = 0) {
+  template <typename TChild, typename... Args>
+  typename std::enable_if<!std::is_void<TChild>::value>::type
+  cloneChildrenImpl(const IIRNode& other, Args&... args) {
     static_assert(std::is_same<TChild, Child>::value,
                   "The template TParent type of this function should be == Parent. The function is "
                   "templated only for syntax specialization using SFINAE");
 
-    for(const auto& child : other.getChildren()) {
-      insertChild(child->clone());
+    // The children are appended in bulk, as inserting them one by one repairs the parent pointers
+    // and updates the derived info of this node after every insertion
+    for(const auto& child : other.getChildren())
+      children_.push_back(child->clone(args...));
+    if(!children_.empty()) {
+      bumpStructureEpoch();
+      repairTreeOfChildren();
     }
   }
 
-  template <typename TChild>
-  void cloneChildrenImpl(const IIRNode& other, const SmartPtr<NodeType>& thisNode,
-                         typename std::enable_if<std::is_void<TChild>::value>::type* = 0) {}
+  template <typename TChild, typename... Args>
+  typename std::enable_if<std::is_void<TChild>::value>::type
+  cloneRootChildrenImpl(const IIRNode& other, const SmartPtr<NodeType>& thisNode, Args&... args) {}
 
-  template <typename TChild>
-  void cloneChildrenImpl(const IIRNode& other, const SmartPtr<NodeType>& thisNode,
-                         typename std::enable_if<!std::is_void<TChild>::value>::type* = 0) {
-    for(const auto& child : other.getChildren()) {
-      insertChild(child->clone(), thisNode);
+  template <typename TChild, typename... Args>
+  typename std::enable_if<!std::is_void<TChild>::value>::type
+  cloneRootChildrenImpl(const IIRNode& other, const SmartPtr<NodeType>& thisNode, Args&... args) {
+    for(const auto& child : other.getChildren())
+      children_.push_back(child->clone(args...));
+    if(!children_.empty()) {
+      bumpStructureEpoch();
+      repairTreeOfChildren(thisNode);
     }
   }
 
@@ -495,6 +607,7 @@ private:
                        typename std::enable_if<!std::is_void<TParent>::value>::type* = 0) {
     PROTECT_TEMPLATE(TParent, Parent)
     children_.push_back(std::move(child));
+    bumpStructureEpoch();
     repairTreeOfChildren();
   }
 
@@ -504,6 +617,7 @@ private:
 
     PROTECT_TEMPLATE(TParent, Parent)
     auto it = children_.insert(pos, std::move(child));
+    bumpStructureEpoch();
 
     repairTreeOfChildren();
     return it;
@@ -516,6 +630,7 @@ private:
     PROTECT_TEMPLATE(TParent, Parent)
 
     auto newfirst = children_.insert(pos, first, last);
+    bumpStructureEpoch();
 
     repairTreeOfChildren();
     return newfirst;
@@ -554,6 +669,7 @@ private:
     PROTECT_TEMPLATE(TChildParent, NodeType)
 
     auto newfirst = children_.insert(pos, first, last);
+    bumpStructureEpoch();
 
     repairTreeOfChildren(p);
 
@@ -568,6 +684,7 @@ private:
     DAWN_ASSERT(p.get() == this);
     PROTECT_TEMPLATE(TParent, Parent)
     children_.push_back(std::move(child));
+    bumpStructureEpoch();
 
     repairTreeOfChildren(p);
   }
@@ -580,6 +697,7 @@ private:
     const std::unique_ptr<NodeType>* ptr = &((*it)->getParent());
 
     (it)->swap(withNewChild);
+    bumpStructureEpoch();
     inputChild->setParent(*ptr);
     setChildParent<Parent, Child>(inputChild);
 
@@ -600,6 +718,7 @@ private:
     const std::unique_ptr<NodeType>* ptr = &((*it)->getParent());
 
     (it)->swap(withNewChild);
+    bumpStructureEpoch();
 
     inputChild->setParent(*ptr);
     inputChild
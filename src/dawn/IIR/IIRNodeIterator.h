@@ -35,7 +35,6 @@ class IIRNodeIterator {
 
   // the iterator is a void iterator if the node contains no children
   bool voidIter_ = false;
-  std::string name = RootIIRNode::name;
   const RootIIRNode* root_;
   bool isTop_ = false;
 
@@ -15,7 +15,6 @@
 #include "dawn/IIR/Interval.h"
 #include <algorithm>
 #include <iostream>
-#include <set>
 #include <sstream>
 #include <unordered_set>
 
@@ -91,11 +90,14 @@ std::string Interval::makeCodeGenName(const Interval& interval) {
 }
 
 std::vector<Interval> Interval::computeLevelUnion(const std::vector<Interval>& intervals) {
-  std::set<int> levels;
+  std::vector<int> levels;
+  levels.reserve(2 * intervals.size());
   for(const Interval& interval : intervals) {
-    levels.insert(interval.lowerLevel());
-    levels.insert(interval.upperLevel());
+    levels.push_back(interval.lowerLevel());
+    levels.push_back(interval.upperLevel());
   }
+  std::sort(levels.begin(), levels.end());
+  levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
 
   std::vector<Interval> newIntervals;
 
@@ -116,17 +118,16 @@ std::vector<Interval> Interval::computeLevelUnion(const std::vector<Interval>& i
 
 std::vector<Interval> Interval::computeGapIntervals(const Interval& axis,
                                                     const std::vector<Interval>& intervals) {
-  std::vector<Interval> newIntervals;
+  std::vector<Interval> newIntervals(intervals);
 
-  // Insert the intervals in sorted order
-  for(const Interval& interval : intervals) {
-    auto it = std::find_if(newIntervals.begin(), newIntervals.end(), [&](const Interval& I) {
-      DAWN_ASSERT_MSG(I.lowerBound() != interval.lowerBound(),
-                      "Intervals have to be non-overlapping");
-      return I.lowerBound() > interval.lowerBound();
-    });
-    newIntervals.insert(it, interval);
-  }
+  // Sort the intervals
+  std::sort(newIntervals.begin(), newIntervals.end(),
+            [](const Interval& a, const Interval& b) { return a.lowerBound() < b.lowerBound(); });
+  DAWN_ASSERT_MSG(std::adjacent_find(newIntervals.begin(), newIntervals.end(),
+                                     [](const Interval& a, const Interval& b) {
+                                       return a.lowerBound() == b.lowerBound();
+                                     }) == newIntervals.end(),
+                  "Intervals have to be non-overlapping");
 
   // Close the intermediate gaps
   if(newIntervals.size() > 1) {
@@ -180,154 +181,64 @@ void Interval::merge(const Interval& other) {
       ub > other.upperBound() ? ub - upper_.levelMark_ : other.upperBound() - upperLevel();
 }
 
-// TODO move this to IntervalAlgorithms and generate a MultiInterval
 std::vector<Interval> Interval::computePartition(std::vector<Interval> const& intervals) {
+  // Sweep-line over the bounds: the pieces of the partition are delimited by the lower bounds and
+  // the upper bounds (+1) of the intervals, and are kept if at least one interval covers them
+  struct Cut {
+    int Bound;
+    bool IsLower;
+    IntervalLevel Level;
+  };
 
-  std::vector<Interval> newIntervals(intervals);
-
-  // sort the intervals based on the lower bound
-  std::sort(newIntervals.begin(), newIntervals.end(),
-            [](Interval const& a, Interval const& b) { return a.lowerBound() < b.lowerBound(); });
-
-  // When we have more than one interval, we sort them based on their lower bounds and evaluate
-  // neighbouring pairs
-  if(newIntervals.size() > 1) {
-    int cnt = 0;
-    bool change = false;
-    // we start the loop from the interval with the smallest lower bound and iterate over them
-    for(auto curLowIt = newIntervals.begin(), curTopIt = std::next(newIntervals.begin());
-        curTopIt != newIntervals.end();) {
-      // get iterators of two contiguous intervals
-      const Interval& curLowInterval = *curLowIt;
-      const Interval& curTopInterval = *curTopIt;
+  std::vector<Cut> cuts;
+  cuts.reserve(2 * intervals.size());
+  for(const Interval& interval : intervals) {
+    DAWN_ASSERT(interval.lowerBound() <= interval.upperBound());
+    cuts.push_back(Cut{interval.lowerBound(), true, interval.lower_});
+    cuts.push_back(Cut{interval.upperBound() + 1, false, interval.upper_});
+  }
+  std::stable_sort(cuts.begin(), cuts.end(),
+                   [](const Cut& a, const Cut& b) { return a.Bound < b.Bound; });
 
-      // If they are the same, we simply eliminate one
-      if(curLowInterval == curTopInterval) {
-        curTopIt = newIntervals.erase(curTopIt);
-        continue;
-      }
-      // if one interval is contained in the other hand, we split them in two non overlapping
-      // intervals depending on how the contains are:
-      // [a---------b]
-      // [a--c]
-      // ====>>
-      // [a--c]
-      //      [c+1--b]
-      else if(curLowInterval.contains(curTopInterval) &&
-              (curLowInterval.lowerBound() == curTopInterval.lowerBound())) {
-        Interval splitHighInterval(curLowInterval.lowerLevel(), curTopInterval.upperLevel(),
-                                   curLowInterval.lowerOffset(), curTopInterval.upperOffset());
-        Interval splitLowInterval(curTopInterval.upperLevel(), curLowInterval.upperLevel(),
-                                  curTopInterval.upperOffset() + 1, curLowInterval.upperOffset());
-
-        *curLowIt = splitLowInterval;
-        *curTopIt = splitHighInterval;
-
-        change = true;
-      }
-      // [a----b]
-      // [a-----------c]
-      // ====>>
-      // [a----b]
-      //        [b+1--c]
-      else if(curTopInterval.contains(curLowInterval)) {
-        Interval splitLowInterval(curLowInterval.lowerLevel(), curLowInterval.upperLevel(),
-                                  curLowInterval.lowerOffset(), curLowInterval.upperOffset());
-        Interval splitHighInterval(curLowInterval.upperLevel(), curTopInterval.upperLevel(),
-                                   curLowInterval.upperOffset() + 1, curTopInterval.upperOffset());
-
-        *curLowIt = splitLowInterval;
-        *curTopIt = splitHighInterval;
-
-        change = true;
-      }
-      // [a------------b]
-      //         [c----b]
-      // ====>>
-      // [a--c-1]
-      //        [c-----b]
-      else if(curLowInterval.contains(curTopInterval) &&
-              (curLowInterval.upperBound() == curTopInterval.upperBound())) {
-        Interval splitLowInterval(curLowInterval.lowerLevel(), curTopInterval.lowerLevel(),
-                                  curLowInterval.lowerOffset(), curTopInterval.lowerOffset() - 1);
-        Interval splitHighInterval(curTopInterval.lowerLevel(), curTopInterval.upperLevel(),
-                                   curTopInterval.lowerOffset(), curTopInterval.upperOffset());
-
-        *curLowIt = splitLowInterval;
-        *curTopIt = splitHighInterval;
-
-        change = true;
-      }
-      // [a----------------b]
-      //   [c-------d]
-      // ====>>
-      // [a--c-1]
-      //        [c--d]
-      //             [d+1--b]
-      // if the lower one competely covers the higher one, we need three intervals: the lower one,
-      // the intersection and the top interval
-      else if(curLowInterval.contains(curTopInterval)) {
-        Interval splitLowInterval(curLowInterval.lowerLevel(), curTopInterval.lowerLevel(),
-                                  curLowInterval.lowerOffset(), curTopInterval.lowerOffset() - 1);
-        Interval splitMidInterval(curTopInterval.lowerLevel(), curTopInterval.upperLevel(),
-                                  curTopInterval.lowerOffset(), curTopInterval.upperOffset());
-        Interval splitHighInterval(curTopInterval.upperLevel(), curLowInterval.upperLevel(),
-                                   curTopInterval.upperOffset() + 1, curLowInterval.upperOffset());
-
-        *curLowIt = splitLowInterval;
-        *curTopIt = splitMidInterval;
-        newIntervals.insert(curTopIt, splitHighInterval);
-
-        change = true;
-      }
-      // otherwise we will generate three intervals: the intersection and the two disjoint intervals
-      // of the XOR
-      // [a---------b]
-      //   [c---------------d]
-      // ====>>
-      // [a--c-1]
-      //        [c--b]
-      //             [b+1--d]
-      else if(curLowInterval.overlaps(curTopInterval)) {
-        Interval splitLowInterval(curLowInterval.lowerLevel(), curTopInterval.lowerLevel(),
-                                  curLowInterval.lowerOffset(), curTopInterval.lowerOffset() - 1);
-        Interval splitMidInterval(curTopInterval.lowerLevel(), curLowInterval.upperLevel(),
-                                  curTopInterval.lowerOffset(), curLowInterval.upperOffset());
-        Interval splitHighInterval(curLowInterval.upperLevel(), curTopInterval.upperLevel(),
-                                   curLowInterval.upperOffset() + 1, curTopInterval.upperOffset());
-
-        *curLowIt = splitLowInterval;
-        *curTopIt = splitMidInterval;
-        newIntervals.insert(curTopIt, splitHighInterval);
-        change = true;
+  std::vector<Interval> newIntervals;
+  IntervalLevel pieceLower{0, 0};
+  int coverage = 0;
+
+  for(auto first = cuts.begin(); first != cuts.end();) {
+    // The bounds of the pieces keep the level of the interval which introduced them, preferably a
+    // lower bound for the lower bound of a piece and an upper bound for the upper bound of a piece
+    const Cut* lowerCut = nullptr;
+    const Cut* upperCut = nullptr;
+    int newCoverage = coverage;
+
+    auto last = first;
+    for(; last != cuts.end() && last->Bound == first->Bound; ++last) {
+      if(last->IsLower) {
+        newCoverage++;
+        if(!lowerCut)
+          lowerCut = &*last;
+      } else {
+        newCoverage--;
+        if(!upperCut)
+          upperCut = &*last;
       }
+    }
 
-      // if we created a new interval, the order order of the list can be false now: assume
-      // a : [0,2], b : [0,3], c : [1,5]
-      // after the first iteration, we have:
-      // a' : [0,2], b' : [3,3], c : [1,5]
-      // and now b' > c. In this case the algorithm breaks.
-      // In order to solve this, we sort the complete list once more and start from the start. This
-      // is somewhat expensive but should not be too bad since the further we go, nothing happens to
-      // the start of the array anymore.
-      if(change) {
-        std::sort(
-            newIntervals.begin(), newIntervals.end(),
-            [](Interval const& a, Interval const& b) { return a.lowerBound() < b.lowerBound(); });
-        curLowIt = newIntervals.begin();
-        curTopIt = std::next(curLowIt);
-        cnt = 0;
-        change = false;
-      }
-      // if no intervals were added, hence the only action was removing redundant intervals or
-      // having non overlapping (and non containing) intervals, we just move up the array and find
-      // the next pair of intervals to compare
-      else {
-        curLowIt = curTopIt;
-        curTopIt++;
-        cnt++;
-      }
+    if(coverage > 0) {
+      IntervalLevel pieceUpper =
+          upperCut ? upperCut->Level : IntervalLevel{lowerCut->Level.levelMark_,
+                                                     lowerCut->Level.offset_ - 1};
+      newIntervals.emplace_back(pieceLower.levelMark_, pieceUpper.levelMark_, pieceLower.offset_,
+                                pieceUpper.offset_);
+    }
+    if(newCoverage > 0) {
+      pieceLower = lowerCut ? lowerCut->Level
+                            : IntervalLevel{upperCut->Level.levelMark_,
+                                            upperCut->Level.offset_ + 1};
     }
+
+    coverage = newCoverage;
+    first = last;
   }
   return newIntervals;
 }
@@ -231,6 +231,7 @@ public:
   /// @code
   ///   vector<int>(Interval(2,3), Interval(4,5), Interval(6,7))
   /// @endcode
+  /// The partition is computed by a single sweep over the sorted bounds of the intervals.
   /// @ingroup optimizer
   ///
   static std::vector<Interval> computePartition(const std::vector<Interval>& intervals);
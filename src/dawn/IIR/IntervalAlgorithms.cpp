@@ -13,6 +13,7 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/IIR/IntervalAlgorithms.h"
+#include "dawn/IIR/IntervalSet.h"
 
 namespace dawn {
 namespace iir {
@@ -47,12 +48,9 @@ MultiInterval substract(const iir::Interval& int1, const MultiInterval& int2) {
   if(int2.empty())
     return MultiInterval{int1};
 
-  MultiInterval result = MultiInterval{int1};
-
-  for(auto it = int2.getIntervals().begin(); it != int2.getIntervals().end(); ++it) {
-    result.substract(*it);
-  }
-  return result;
+  IntervalSet result{int1};
+  result.substract(IntervalSet(int2.getIntervals()));
+  return MultiInterval(result);
 }
 
 Cache::window computeWindowOffset(LoopOrderKind loopOrder, iir::Interval const& accessInterval,
@@ -0,0 +1,206 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/IIR/IntervalSet.h"
+#include "dawn/Support/Assert.h"
+#include <algorithm>
+#include <iostream>
+
+namespace dawn {
+namespace iir {
+
+namespace {
+
+using IntervalLevel = Interval::IntervalLevel;
+
+Interval makeInterval(IntervalLevel lower, IntervalLevel upper) {
+  return Interval(lower.levelMark_, upper.levelMark_, lower.offset_, upper.offset_);
+}
+
+/// @brief The level right above (resp. below) `level`, relative to the same level mark
+/// @{
+IntervalLevel above(IntervalLevel level) { return {level.levelMark_, level.offset_ + 1}; }
+IntervalLevel below(IntervalLevel level) { return {level.levelMark_, level.offset_ - 1}; }
+/// @}
+
+bool lowerBoundLess(const Interval& a, const Interval& b) {
+  return a.lowerBound() < b.lowerBound();
+}
+
+/// @brief Merge the overlapping and adjacent intervals of a list sorted by lower bound
+std::vector<Interval> coalesce(const std::vector<Interval>& sorted) {
+  std::vector<Interval> result;
+  result.reserve(sorted.size());
+  for(const Interval& interval : sorted) {
+    if(!result.empty() && interval.lowerBound() <= result.back().upperBound() + 1) {
+      if(interval.upperBound() > result.back().upperBound())
+        result.back() = makeInterval(result.back().lowerIntervalLevel(),
+                                     interval.upperIntervalLevel());
+    } else {
+      result.push_back(interval);
+    }
+  }
+  return result;
+}
+
+} // anonymous namespace
+
+IntervalSet::IntervalSet(std::initializer_list<Interval> intervals)
+    : IntervalSet(std::vector<Interval>(intervals)) {}
+
+IntervalSet::IntervalSet(const std::vector<Interval>& intervals) {
+  std::vector<Interval> sorted(intervals);
+  std::stable_sort(sorted.begin(), sorted.end(), lowerBoundLess);
+  intervals_ = coalesce(sorted);
+}
+
+IntervalSet IntervalSet::fromCanonical(std::vector<Interval>&& intervals) {
+  IntervalSet set;
+  set.intervals_ = std::move(intervals);
+#ifndef NDEBUG
+  for(std::size_t i = 0; i < set.intervals_.size(); ++i) {
+    DAWN_ASSERT(set.intervals_[i].lowerBound() <= set.intervals_[i].upperBound());
+    DAWN_ASSERT_MSG(i == 0 ||
+                        set.intervals_[i - 1].upperBound() + 1 < set.intervals_[i].lowerBound(),
+                    "intervals are not in canonical form");
+  }
+#endif
+  return set;
+}
+
+std::vector<Interval>::iterator IntervalSet::firstEndingAtOrAbove(int bound) {
+  return std::partition_point(intervals_.begin(), intervals_.end(),
+                              [&](const Interval& I) { return I.upperBound() < bound; });
+}
+
+std::vector<Interval>::const_iterator IntervalSet::firstEndingAtOrAbove(int bound) const {
+  return std::partition_point(intervals_.begin(), intervals_.end(),
+                              [&](const Interval& I) { return I.upperBound() < bound; });
+}
+
+std::vector<Interval>::iterator IntervalSet::firstStartingAbove(int bound) {
+  return std::partition_point(intervals_.begin(), intervals_.end(),
+                              [&](const Interval& I) { return I.lowerBound() <= bound; });
+}
+
+void IntervalSet::insert(const Interval& interval) {
+  DAWN_ASSERT(interval.lowerBound() <= interval.upperBound());
+
+  // Intervals in [first, last) overlap or are adjacent to `interval`
+  auto first = firstEndingAtOrAbove(interval.lowerBound() - 1);
+  auto last = firstStartingAbove(interval.upperBound() + 1);
+
+  if(first == last) {
+    intervals_.insert(first, interval);
+    return;
+  }
+
+  IntervalLevel lower = first->lowerBound() <= interval.lowerBound()
+                            ? first->lowerIntervalLevel()
+                            : interval.lowerIntervalLevel();
+  IntervalLevel upper = std::prev(last)->upperBound() >= interval.upperBound()
+                            ? std::prev(last)->upperIntervalLevel()
+                            : interval.upperIntervalLevel();
+  *first = makeInterval(lower, upper);
+  intervals_.erase(std::next(first), last);
+}
+
+void IntervalSet::insert(const IntervalSet& other) {
+  if(other.empty())
+    return;
+  if(other.size() == 1) {
+    insert(other.intervals_.front());
+    return;
+  }
+
+  std::vector<Interval> merged;
+  merged.reserve(intervals_.size() + other.intervals_.size());
+  std::merge(intervals_.begin(), intervals_.end(), other.intervals_.begin(),
+             other.intervals_.end(), std::back_inserter(merged), lowerBoundLess);
+  intervals_ = coalesce(merged);
+}
+
+void IntervalSet::substract(const Interval& interval) {
+  // Intervals in [first, last) overlap with `interval`
+  auto first = firstEndingAtOrAbove(interval.lowerBound());
+  auto last = firstStartingAbove(interval.upperBound());
+
+  if(first == last)
+    return;
+
+  // Remainders of the first and last overlapped intervals
+  std::vector<Interval> remainders;
+  if(first->lowerBound() < interval.lowerBound())
+    remainders.push_back(
+        makeInterval(first->lowerIntervalLevel(), below(interval.lowerIntervalLevel())));
+  if(std::prev(last)->upperBound() > interval.upperBound())
+    remainders.push_back(
+        makeInterval(above(interval.upperIntervalLevel()), std::prev(last)->upperIntervalLevel()));
+
+  auto it = intervals_.erase(first, last);
+  intervals_.insert(it, remainders.begin(), remainders.end());
+}
+
+void IntervalSet::substract(const IntervalSet& other) {
+  if(other.empty() || empty())
+    return;
+  if(other.size() == 1) {
+    substract(other.intervals_.front());
+    return;
+  }
+
+  // Sweep over both lists
+  std::vector<Interval> result;
+  auto cut = other.intervals_.begin(), cutEnd = other.intervals_.end();
+  for(const Interval& interval : intervals_) {
+    IntervalLevel lower = interval.lowerIntervalLevel();
+    bool remaining = true;
+
+    while(cut != cutEnd && cut->upperBound() < lower.bound())
+      ++cut;
+
+    for(auto it = cut; it != cutEnd && it->lowerBound() <= interval.upperBound(); ++it) {
+      if(it->lowerBound() > lower.bound())
+        result.push_back(makeInterval(lower, below(it->lowerIntervalLevel())));
+      if(it->upperBound() >= interval.upperBound()) {
+        remaining = false;
+        break;
+      }
+      lower = above(it->upperIntervalLevel());
+    }
+
+    if(remaining)
+      result.push_back(makeInterval(lower, interval.upperIntervalLevel()));
+  }
+  intervals_ = std::move(result);
+}
+
+bool IntervalSet::overlaps(const Interval& interval) const {
+  auto it = firstEndingAtOrAbove(interval.lowerBound());
+  return it != intervals_.end() && it->lowerBound() <= interval.upperBound();
+}
+
+bool IntervalSet::contains(const Interval& interval) const {
+  auto it = firstEndingAtOrAbove(interval.upperBound());
+  return it != intervals_.end() && it->lowerBound() <= interval.lowerBound();
+}
+
+std::ostream& operator<<(std::ostream& os, const IntervalSet& set) {
+  for(const Interval& interval : set.getIntervals())
+    os << "[ " << interval << " ]";
+  return os;
+}
+
+} // namespace iir
+} // namespace dawn
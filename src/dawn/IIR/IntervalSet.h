@@ -0,0 +1,110 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_IIR_INTERVALSET_H
+#define DAWN_IIR_INTERVALSET_H
+
+#include "dawn/IIR/Interval.h"
+#include <initializer_list>
+#include <iosfwd>
+#include <vector>
+
+namespace dawn {
+namespace iir {
+
+/// @brief Set of vertical levels represented by a canonical list of intervals
+///
+/// The intervals are always sorted in ascending order, pairwise disjoint and non-adjacent (i.e two
+/// sets containing the same levels have the same representation). The point queries (`overlaps`,
+/// `contains`) and the location of the intervals touched by `insert` and `substract` are binary
+/// searches.
+///
+/// Bounds are compared by `level + offset`. As `sir::Interval::End` is far above any level relative
+/// to the start of the axis, bounds relative to the end of the axis are ordered after all bounds
+/// relative to the start. The bounds of the stored intervals always keep the level (and offset) of
+/// the interval which introduced them, hence a bound relative to the end of the axis stays relative
+/// to the end (e.g `{Start : End}` minus `{End-1 : End}` is `{Start : End-2}`).
+///
+/// @ingroup optimizer
+class IntervalSet {
+  std::vector<Interval> intervals_;
+
+public:
+  /// @name Constructors and Assignment
+  /// @{
+  IntervalSet() = default;
+  IntervalSet(std::initializer_list<Interval> intervals);
+
+  /// @brief Construct the union of arbitrary (possibly overlapping) `intervals`
+  explicit IntervalSet(const std::vector<Interval>& intervals);
+
+  IntervalSet(const IntervalSet&) = default;
+  IntervalSet(IntervalSet&&) = default;
+  IntervalSet& operator=(const IntervalSet&) = default;
+  IntervalSet& operator=(IntervalSet&&) = default;
+  /// @}
+
+  /// @brief Take ownership of `intervals` which are already in canonical form
+  static IntervalSet fromCanonical(std::vector<Interval>&& intervals);
+
+  /// @brief Add the levels of `interval` (resp. `other`) to the set
+  /// @{
+  void insert(const Interval& interval);
+  void insert(const IntervalSet& other);
+  /// @}
+
+  /// @brief Remove the levels of `interval` (resp. `other`) from the set
+  /// @{
+  void substract(const Interval& interval);
+  void substract(const IntervalSet& other);
+  /// @}
+
+  /// @brief Check if any level of `interval` is in the set
+  bool overlaps(const Interval& interval) const;
+
+  /// @brief Check if all levels of `interval` are in the set
+  bool contains(const Interval& interval) const;
+
+  /// @brief Check if the set is a single interval (or empty)
+  bool contiguous() const { return intervals_.size() <= 1; }
+
+  const std::vector<Interval>& getIntervals() const { return intervals_; }
+
+  /// @brief Move the intervals out of the set
+  std::vector<Interval> releaseIntervals() && { return std::move(intervals_); }
+
+  bool empty() const { return intervals_.empty(); }
+  std::size_t size() const { return intervals_.size(); }
+
+  /// @name Comparison operator
+  /// @{
+  bool operator==(const IntervalSet& other) const { return intervals_ == other.intervals_; }
+  bool operator!=(const IntervalSet& other) const { return !(*this == other); }
+  /// @}
+
+  friend std::ostream& operator<<(std::ostream& os, const IntervalSet& set);
+
+private:
+  /// @brief Iterator to the first interval whose upper bound is `>= bound`
+  std::vector<Interval>::iterator firstEndingAtOrAbove(int bound);
+  std::vector<Interval>::const_iterator firstEndingAtOrAbove(int bound) const;
+
+  /// @brief Iterator to the first interval whose lower bound is `> bound`
+  std::vector<Interval>::iterator firstStartingAbove(int bound);
+};
+
+} // namespace iir
+} // namespace dawn
+
+#endif
@@ -14,6 +14,8 @@
 
 #include "dawn/IIR/MultiInterval.h"
 #include "dawn/IIR/IntervalAlgorithms.h"
+#include "dawn/IIR/IntervalSet.h"
+#include <algorithm>
 #include <iterator>
 
 namespace dawn {
@@ -27,9 +29,35 @@ std::ostream& operator<<(std::ostream& os, const MultiInterval& multiInterval) {
   return os;
 }
 
+namespace {
+
+bool isCanonical(const std::vector<Interval>& intervals) {
+  for(std::size_t i = 1; i < intervals.size(); ++i) {
+    if(intervals[i - 1].upperBound() + 1 >= intervals[i].lowerBound())
+      return false;
+  }
+  return std::all_of(intervals.begin(), intervals.end(),
+                     [](const Interval& I) { return I.lowerBound() <= I.upperBound(); });
+}
+
+} // anonymous namespace
+
 MultiInterval::MultiInterval(std::initializer_list<Interval> const& intervals)
-    : intervals_(intervals) {}
-MultiInterval::MultiInterval(const std::vector<Interval>& intervals) : intervals_(intervals) {}
+    : intervals_(intervals), canonical_(isCanonical(intervals_)) {}
+MultiInterval::MultiInterval(const std::vector<Interval>& intervals)
+    : intervals_(intervals), canonical_(isCanonical(intervals_)) {}
+MultiInterval::MultiInterval(const IntervalSet& set) : intervals_(set.getIntervals()) {}
+
+IntervalSet MultiInterval::releaseIntervalSet() {
+  if(canonical_)
+    return IntervalSet::fromCanonical(std::move(intervals_));
+  return IntervalSet(intervals_);
+}
+
+void MultiInterval::assign(IntervalSet&& set) {
+  intervals_ = std::move(set).releaseIntervals();
+  canonical_ = true;
+}
 
 bool MultiInterval::contiguous() const {
   for(auto it = intervals_.begin(); it != intervals_.end(); it++) {
@@ -44,11 +72,19 @@ bool MultiInterval::contiguous() const {
   return true;
 }
 void MultiInterval::insert(MultiInterval const& multiInterval) {
-  for(auto const& interv : multiInterval.getIntervals())
-    insert(interv);
+  IntervalSet set = releaseIntervalSet();
+  set.insert(IntervalSet(multiInterval.getIntervals()));
+  assign(std::move(set));
 }
 
 bool MultiInterval::overlaps(const Interval& other) const {
+  if(canonical_) {
+    auto it = std::partition_point(intervals_.begin(), intervals_.end(), [&](const Interval& I) {
+      return I.upperBound() < other.lowerBound();
+    });
+    return it != intervals_.end() && it->lowerBound() <= other.upperBound();
+  }
+
   for(auto const& interv : getIntervals()) {
     if(interv.overlaps(other)) {
       return true;
@@ -73,46 +109,21 @@ void MultiInterval::insert(boost::optional<iir::Interval> const& interval) {
 }
 
 void MultiInterval::substract(iir::Interval const& interval) {
-  for(auto it = intervals_.begin(); it != intervals_.end(); ++it) {
-    if(it->overlaps(interval)) {
-      const iir::Interval int1 = *it;
-      MultiInterval multiInterval = iir::substract(int1, interval);
-
-      intervals_.erase(it);
-
-      for(auto const& intervIt : multiInterval.getIntervals()) {
-        insert(intervIt);
-      }
-      it = intervals_.begin();
-      if(it == intervals_.end())
-        break;
-    }
-  }
+  IntervalSet set = releaseIntervalSet();
+  set.substract(interval);
+  assign(std::move(set));
 }
 
 void MultiInterval::substract(MultiInterval const& multiInterval) {
-  for(auto const& interv : multiInterval.getIntervals()) {
-    substract(interv);
-  }
+  IntervalSet set = releaseIntervalSet();
+  set.substract(IntervalSet(multiInterval.getIntervals()));
+  assign(std::move(set));
 }
 
 void MultiInterval::insert(iir::Interval const& interval) {
-  intervals_.push_back(interval);
-  auto intervals = iir::Interval::computePartition(intervals_);
-  intervals_.clear();
-  std::move(intervals.begin(), intervals.end(), std::back_inserter(intervals_));
-
-  for(auto it = intervals_.begin(); it != intervals_.end(); ++it) {
-    if(std::next(it) == intervals_.end())
-      break;
-    auto& aInterval = *it;
-    auto& nextInterval = *(std::next(it));
-    if(aInterval.adjacent(nextInterval)) {
-      aInterval.merge(nextInterval);
-
-      it = std::prev(std::prev(intervals_.erase(std::next(it))));
-    }
-  }
+  IntervalSet set = releaseIntervalSet();
+  set.insert(interval);
+  assign(std::move(set));
 }
 } // namespace iir
 } // namespace dawn
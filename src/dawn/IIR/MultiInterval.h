@@ -21,14 +21,29 @@
 namespace dawn {
 namespace iir {
 
+class IntervalSet;
+
+/// @brief List of intervals
+///
+/// A multi-interval constructed from a list of intervals keeps that list (e.g the pieces of a
+/// partition). Inserting or substracting intervals brings it into the canonical form of an
+/// `IntervalSet` (sorted, disjoint and non-adjacent intervals), on which these operations are binary
+/// searches.
 class MultiInterval {
   std::vector<iir::Interval> intervals_;
 
+  /// Are the intervals in the canonical form of an `IntervalSet`?
+  bool canonical_ = true;
+
+  IntervalSet releaseIntervalSet();
+  void assign(IntervalSet&& set);
+
 public:
   /// @name Constructors and Assignment
   MultiInterval() = default;
   MultiInterval(const std::vector<Interval>& intervals);
   MultiInterval(std::initializer_list<Interval> const& intervals);
+  MultiInterval(const IntervalSet& set);
 
   void insert(iir::Interval const& interval);
   void insert(boost::optional<iir::Interval> const& interval);
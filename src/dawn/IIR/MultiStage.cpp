@@ -15,6 +15,7 @@
 #include "dawn/IIR/MultiStage.h"
 #include "dawn/IIR/Accesses.h"
 #include "dawn/IIR/DependencyGraphAccesses.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/IIR/IIR.h"
 #include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/IntervalAlgorithms.h"
@@ -31,13 +32,15 @@ namespace iir {
 MultiStage::MultiStage(StencilMetaInformation& metadata, LoopOrderKind loopOrder)
     : metadata_(metadata), loopOrder_(loopOrder), id_(UIDGenerator::getInstance()->get()) {}
 
-std::unique_ptr<MultiStage> MultiStage::clone() const {
-  auto cloneMS = std::make_unique<MultiStage>(metadata_, loopOrder_);
+std::unique_ptr<MultiStage> MultiStage::clone() const { return clone(metadata_); }
+
+std::unique_ptr<MultiStage> MultiStage::clone(StencilMetaInformation& metadata) const {
+  auto cloneMS = std::make_unique<MultiStage>(metadata, loopOrder_);
 
   cloneMS->id_ = id_;
   cloneMS->derivedInfo_ = derivedInfo_;
 
-  cloneMS->cloneChildrenFrom(*this);
+  cloneMS->cloneChildrenFrom(*this, metadata);
   return cloneMS;
 }
 
@@ -93,30 +96,63 @@ MultiStage::split(std::deque<MultiStage::SplitIndex>& splitterIndices,
   return newMultiStages;
 }
 
-std::shared_ptr<DependencyGraphAccesses>
-MultiStage::getDependencyGraphOfInterval(const Interval& interval) const {
-  auto dependencyGraph = std::make_shared<DependencyGraphAccesses>(metadata_);
-  std::for_each(children_.begin(), children_.end(), [&](const std::unique_ptr<Stage>& stagePtr) {
-    if(interval.overlaps(stagePtr->getEnclosingExtendedInterval()))
-      std::for_each(stagePtr->childrenBegin(), stagePtr->childrenEnd(),
-                    [&](const Stage::DoMethodSmartPtr_t& DoMethodPtr) {
-                      dependencyGraph->merge(DoMethodPtr->getDependencyGraph().get());
-                    });
-  });
-  return dependencyGraph;
+static thread_local DependencyGraphCacheStatistics dependencyGraphCacheStatistics;
+
+DependencyGraphCacheStatistics getThreadDependencyGraphCacheStatistics() {
+  return dependencyGraphCacheStatistics;
 }
 
-std::shared_ptr<DependencyGraphAccesses> MultiStage::getDependencyGraphOfAxis() const {
-  auto dependencyGraph = std::make_shared<DependencyGraphAccesses>(metadata_);
-  std::for_each(children_.begin(), children_.end(), [&](const std::unique_ptr<Stage>& stagePtr) {
-    std::for_each(stagePtr->childrenBegin(), stagePtr->childrenEnd(),
-                  [&](const Stage::DoMethodSmartPtr_t& DoMethodPtr) {
-                    dependencyGraph->merge(DoMethodPtr->getDependencyGraph().get());
-                  });
-  });
+std::shared_ptr<const DependencyGraphAccesses>
+MultiStage::getMemoizedDependencyGraph(DependencyGraphCacheEntry& entry,
+                                       const boost::optional<Interval>& interval) const {
+  // The graphs of the Do-Methods identify the memoized graph. The entry holds on to them, hence a
+  // graph can not be replaced by a new one allocated at the same address.
+  std::vector<std::shared_ptr<DependencyGraphAccesses>> doMethodGraphs;
+  for(const auto& stagePtr : children_)
+    if(!interval || interval->overlaps(stagePtr->getEnclosingExtendedInterval()))
+      for(const auto& doMethodPtr : stagePtr->getChildren())
+        doMethodGraphs.push_back(doMethodPtr->getDependencyGraph());
+
+  if(entry.Graph && entry.DoMethodGraphs == doMethodGraphs) {
+    dependencyGraphCacheStatistics.Hits++;
+    return entry.Graph;
+  }
+
+  // If Do-Methods were only appended (e.g a stage was inserted at the end), the new graphs are
+  // merged into a copy of the memoized graph. Merging is associative, hence the result is the same
+  // as merging all graphs from scratch.
+  std::shared_ptr<DependencyGraphAccesses> dependencyGraph;
+  std::size_t numMerged = 0;
+  if(entry.Graph && entry.DoMethodGraphs.size() < doMethodGraphs.size() &&
+     std::equal(entry.DoMethodGraphs.begin(), entry.DoMethodGraphs.end(),
+                doMethodGraphs.begin())) {
+    dependencyGraphCacheStatistics.Extensions++;
+    dependencyGraph = entry.Graph->clone();
+    numMerged = entry.DoMethodGraphs.size();
+  } else {
+    if(entry.Graph)
+      dependencyGraphCacheStatistics.Invalidations++;
+    dependencyGraphCacheStatistics.Misses++;
+    dependencyGraph = std::make_shared<DependencyGraphAccesses>(metadata_);
+  }
+
+  for(std::size_t i = numMerged; i < doMethodGraphs.size(); ++i)
+    dependencyGraph->merge(doMethodGraphs[i].get());
+
+  entry.DoMethodGraphs = std::move(doMethodGraphs);
+  entry.Graph = dependencyGraph;
   return dependencyGraph;
 }
 
+std::shared_ptr<const DependencyGraphAccesses>
+MultiStage::getDependencyGraphOfInterval(const Interval& interval) const {
+  return getMemoizedDependencyGraph(intervalDependencyGraphs_[interval], interval);
+}
+
+std::shared_ptr<const DependencyGraphAccesses> MultiStage::getDependencyGraphOfAxis() const {
+  return getMemoizedDependencyGraph(axisDependencyGraph_, boost::none);
+}
+
 iir::Cache& MultiStage::setCache(iir::Cache::CacheTypeKind type, iir::Cache::CacheIOPolicy policy,
                                  int AccessID, const Interval& interval,
                                  const Interval& enclosingAccessedInterval,
@@ -373,11 +409,29 @@ void MultiStage::DerivedInfo::clear() { fields_.clear(); }
 
 void MultiStage::clearDerivedInfo() { derivedInfo_.clear(); }
 
-const std::unordered_map<int, Field>& MultiStage::getFields() const { return derivedInfo_.fields_; }
-std::map<int, Field> MultiStage::getOrderedFields() const {
-  return support::orderMap(derivedInfo_.fields_);
+void MultiStage::renumberIDs(const IDRenumbering& renumbering) {
+  id_ = renumbering.mapUID(id_);
+
+  derivedInfo_.caches_ = renumbering.mapKeys(derivedInfo_.caches_);
+  for(auto& cachePair : derivedInfo_.caches_)
+    cachePair.second.renumberIDs(renumbering);
+  renumberFields(derivedInfo_.fields_, renumbering);
+
+  for(const auto& stage : children_)
+    stage->renumberIDs(renumbering);
+
+  // The graphs of the Do-Methods are renumbered in place, hence the memoized graphs would still be
+  // considered up to date
+  intervalDependencyGraphs_.clear();
+  axisDependencyGraph_ = DependencyGraphCacheEntry();
 }
 
+const std::unordered_map<int, Field>& MultiStage::getFields() const {
+  flushIfDirty();
+  return derivedInfo_.fields_;
+}
+std::map<int, Field> MultiStage::getOrderedFields() const { return support::orderMap(getFields()); }
+
 void MultiStage::updateFromChildren() {
   for(const auto& stagePtr : children_) {
     mergeFields(stagePtr->getFields(), derivedInfo_.fields_,
@@ -386,6 +440,7 @@ void MultiStage::updateFromChildren() {
 }
 
 const Field& MultiStage::getField(int accessID) const {
+  flushIfDirty();
   DAWN_ASSERT(derivedInfo_.fields_.count(accessID));
   return derivedInfo_.fields_.at(accessID);
 }
@@ -420,7 +475,7 @@ json::json MultiStage::jsonDump() const {
 }
 
 bool MultiStage::hasMemAccessTemporaries() const {
-  for(const auto& field : derivedInfo_.fields_) {
+  for(const auto& field : getFields()) {
     if(isMemAccessTemporary(field.first)) {
       return true;
     }
@@ -435,7 +490,7 @@ bool MultiStage::isMemAccessTemporary(const int accessID) const {
     return true;
   return (derivedInfo_.caches_.at(accessID).requiresMemMemoryAccess());
 }
-bool MultiStage::hasField(const int accessID) const { return derivedInfo_.fields_.count(accessID); }
+bool MultiStage::hasField(const int accessID) const { return getFields().count(accessID); }
 
 bool MultiStage::isEmptyOrNullStmt() const {
   for(const auto& stage : getChildren()) {
@@ -20,6 +20,7 @@
 #include "dawn/IIR/LoopOrder.h"
 #include "dawn/IIR/MultiInterval.h"
 #include "dawn/IIR/Stage.h"
+#include <cstdint>
 #include <deque>
 #include <list>
 #include <memory>
@@ -32,6 +33,7 @@ namespace iir {
 
 class Stencil;
 class DependencyGraphAccesses;
+class IDRenumbering;
 class StencilMetaInformation;
 
 namespace impl {
@@ -39,6 +41,25 @@ template <typename T>
 using StdList = std::list<T, std::allocator<T>>;
 }
 
+/// @brief Lookups of the memoized dependency graphs of the multi-stages
+/// @ingroup optimizer
+struct DependencyGraphCacheStatistics {
+  std::uint64_t Hits = 0;          ///< Memoized graph was returned
+  std::uint64_t Extensions = 0;    ///< Memoized graph was extended by appended Do-Methods
+  std::uint64_t Misses = 0;        ///< Graph was computed from scratch
+  std::uint64_t Invalidations = 0; ///< Misses which replaced an outdated memoized graph
+
+  DependencyGraphCacheStatistics operator-(const DependencyGraphCacheStatistics& other) const {
+    return DependencyGraphCacheStatistics{Hits - other.Hits, Extensions - other.Extensions,
+                                          Misses - other.Misses,
+                                          Invalidations - other.Invalidations};
+  }
+};
+
+/// @brief Get the statistics of the dependency graph lookups performed by the calling thread
+/// @ingroup optimizer
+DependencyGraphCacheStatistics getThreadDependencyGraphCacheStatistics();
+
 /// @brief A MultiStage is represented by a collection of stages and a given exectuion policy.
 ///
 /// A MultiStage usually corresponds to the outer loop (usually over k) of the loop nest. In CUDA
@@ -62,6 +83,23 @@ class MultiStage : public IIRNode<Stencil, MultiStage, Stage, impl::StdList> {
 
   DerivedInfo derivedInfo_;
 
+  /// @brief Memoized dependency graph of the multi-stage
+  struct DependencyGraphCacheEntry {
+    /// Graphs of the Do-Methods which were merged into `Graph` (in order)
+    std::vector<std::shared_ptr<DependencyGraphAccesses>> DoMethodGraphs;
+    std::shared_ptr<const DependencyGraphAccesses> Graph;
+  };
+
+  /// Memoized graphs of `getDependencyGraphOfInterval` and `getDependencyGraphOfAxis`
+  mutable std::unordered_map<Interval, DependencyGraphCacheEntry> intervalDependencyGraphs_;
+  mutable DependencyGraphCacheEntry axisDependencyGraph_;
+
+  /// @brief Get the memoized graph of `entry`, recomputing it if the graphs of the Do-Methods
+  /// (of the stages overlapping with `interval` or all stages) changed
+  std::shared_ptr<const DependencyGraphAccesses>
+  getMemoizedDependencyGraph(DependencyGraphCacheEntry& entry,
+                             const boost::optional<Interval>& interval) const;
+
 public:
   static constexpr const char* name = "MultiStage";
 
@@ -76,6 +114,9 @@ public:
 
   std::unique_ptr<MultiStage> clone() const;
 
+  /// @brief clone the multi-stage, the clone refers to the meta information `metadata`
+  std::unique_ptr<MultiStage> clone(StencilMetaInformation& metadata) const;
+
   json::json jsonDump() const;
 
   /// @brief Get the loop order
@@ -89,6 +130,9 @@ public:
   /// @brief clear the derived info
   virtual void clearDerivedInfo() override;
 
+  /// @brief Renumber the ID, the derived info and the stages (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
+
   std::vector<std::unique_ptr<DoMethod>> computeOrderedDoMethods() const;
 
   /// @brief Set the loop order
@@ -117,11 +161,19 @@ public:
 
   /// @brief Get the dependency graph of the multi-stage incorporating those stages whose extended
   /// interval overlaps with `interval`
-  std::shared_ptr<DependencyGraphAccesses>
+  ///
+  /// The graphs are memoized per interval together with the graphs of the Do-Methods they were
+  /// merged from. A memoized graph is valid as long as the same Do-Methods graphs would be merged,
+  /// i.e no overlapping stage was inserted or erased and no graph of a Do-Method was replaced (the
+  /// graphs of the Do-Methods are never modified in place). If stages were only appended, the
+  /// memoized graph is extended instead of recomputed. The returned graph is shared with the cache,
+  /// `clone` it to modify it.
+  std::shared_ptr<const DependencyGraphAccesses>
   getDependencyGraphOfInterval(const Interval& interval) const;
 
-  /// @brief Get the dependency graph of the multi-stage incorporating all stages
-  std::shared_ptr<DependencyGraphAccesses> getDependencyGraphOfAxis() const;
+  /// @brief Get the dependency graph of the multi-stage incorporating all stages (memoized, see
+  /// `getDependencyGraphOfInterval`)
+  std::shared_ptr<const DependencyGraphAccesses> getDependencyGraphOfAxis() const;
 
   /// @brief Set a cache
   iir::Cache& setCache(iir::Cache::CacheTypeKind type, iir::Cache::CacheIOPolicy policy,
@@ -182,6 +234,9 @@ public:
   std::unordered_map<int, iir::Cache>& getCaches() { return derivedInfo_.caches_; }
   const std::unordered_map<int, iir::Cache>& getCaches() const { return derivedInfo_.caches_; }
 
+  /// @brief Get the caches ordered by AccessID
+  std::map<int, iir::Cache> getOrderedCaches() const { return support::orderMap(getCaches()); }
+
   const iir::Cache& getCache(const int accessID) const;
 
   /// @brief true if it contains no stages or the stages are empty
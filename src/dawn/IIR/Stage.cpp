@@ -13,7 +13,9 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/IIR/Stage.h"
+#include "dawn/IIR/DeferredUpdate.h"
 #include "dawn/IIR/DependencyGraphAccesses.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/IIR/IIR.h"
 #include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/MultiStage.h"
@@ -68,6 +70,15 @@ std::unique_ptr<Stage> Stage::clone() const {
   return cloneStage;
 }
 
+std::unique_ptr<Stage> Stage::clone(StencilMetaInformation& metadata) const {
+  auto cloneStage = std::make_unique<Stage>(metadata, StageID_);
+
+  cloneStage->derivedInfo_ = derivedInfo_;
+
+  cloneStage->cloneChildrenFrom(*this, metadata);
+  return cloneStage;
+}
+
 DoMethod& Stage::getSingleDoMethod() {
   DAWN_ASSERT_MSG(hasSingleDoMethod(), "stage contains multiple Do-Methods");
   return *(getChildren().front());
@@ -117,10 +128,10 @@ Interval Stage::getEnclosingInterval() const {
 
 Extent Stage::getMaxVerticalExtent() const {
   Extent verticalExtent;
-  std::for_each(derivedInfo_.fields_.begin(), derivedInfo_.fields_.end(),
-                [&](const std::pair<int, Field>& pair) {
-                  verticalExtent.merge(pair.second.getExtents()[2]);
-                });
+  const auto& fields = getFields();
+  std::for_each(fields.begin(), fields.end(), [&](const std::pair<int, Field>& pair) {
+    verticalExtent.merge(pair.second.getExtents()[2]);
+  });
   return verticalExtent;
 }
 
@@ -136,6 +147,20 @@ void Stage::DerivedInfo::clear() {
 }
 
 void Stage::clearDerivedInfo() { derivedInfo_.clear(); }
+
+void Stage::renumberIDs(const IDRenumbering& renumbering) {
+  StageID_ = renumbering.mapUID(StageID_);
+
+  renumberFields(derivedInfo_.fields_, renumbering);
+  derivedInfo_.allGlobalVariables_ = renumbering.mapSet(derivedInfo_.allGlobalVariables_);
+  derivedInfo_.globalVariables_ = renumbering.mapSet(derivedInfo_.globalVariables_);
+  derivedInfo_.globalVariablesFromStencilFunctionCalls_ =
+      renumbering.mapSet(derivedInfo_.globalVariablesFromStencilFunctionCalls_);
+
+  for(const auto& doMethod : children_)
+    doMethod->renumberIDs(renumbering);
+}
+
 bool Stage::overlaps(const Stage& other) const {
   // This is a more conservative test.. if it fails we are certain nothing overlaps
   if(!getEnclosingExtendedInterval().overlaps(other.getEnclosingExtendedInterval()))
@@ -241,19 +266,23 @@ void Stage::updateGlobalVariablesInfo() {
       derivedInfo_.globalVariablesFromStencilFunctionCalls_.end());
 }
 bool Stage::hasGlobalVariables() const {
+  flushIfDirty();
   return (!derivedInfo_.globalVariables_.empty()) ||
          (!derivedInfo_.globalVariablesFromStencilFunctionCalls_.empty());
 }
 
 const std::unordered_set<int>& Stage::getGlobalVariables() const {
+  flushIfDirty();
   return derivedInfo_.globalVariables_;
 }
 
 const std::unordered_set<int>& Stage::getGlobalVariablesFromStencilFunctionCalls() const {
+  flushIfDirty();
   return derivedInfo_.globalVariablesFromStencilFunctionCalls_;
 }
 
 const std::unordered_set<int>& Stage::getAllGlobalVariables() const {
+  flushIfDirty();
   return derivedInfo_.allGlobalVariables_;
 }
 
@@ -290,6 +319,9 @@ Stage::split(std::deque<int>& splitterIndices,
 
   std::vector<std::unique_ptr<Stage>> newStages;
 
+  // The statements are moved one by one, the new stages are updated once they are complete
+  DeferredUpdateScope deferredUpdates;
+
   splitterIndices.push_back(thisDoMethod.getChildren().size() - 1);
   DoMethod::StatementAccessesIterator prevSplitterIndex = thisDoMethod.childrenBegin();
 
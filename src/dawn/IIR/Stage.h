@@ -32,6 +32,7 @@ namespace dawn {
 namespace iir {
 
 class DependencyGraphAccesses;
+class IDRenumbering;
 class MultiStage;
 
 /// @brief A Stage is represented by a collection of statements grouped into DoMethod of
@@ -88,6 +89,9 @@ public:
 
   std::unique_ptr<Stage> clone() const;
 
+  /// @brief clone the stage, the clone refers to the meta information `metadata`
+  std::unique_ptr<Stage> clone(StencilMetaInformation& metadata) const;
+
   json::json jsonDump(const StencilMetaInformation& metaData) const;
 
   /// @brief update the derived info from children
@@ -99,6 +103,9 @@ public:
   /// @brief clear the derived info
   virtual void clearDerivedInfo() override;
 
+  /// @brief Renumber the ID, the derived info and the Do-Methods (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
+
   /// @brief Check if the stage contains of a single Do-Method
   bool hasSingleDoMethod() const;
 
@@ -148,9 +155,12 @@ public:
   /// `Input`
   ///
   /// The fields are computed during `Stage::update`.
-  const std::unordered_map<int, Field>& getFields() const { return derivedInfo_.fields_; }
+  const std::unordered_map<int, Field>& getFields() const {
+    flushIfDirty();
+    return derivedInfo_.fields_;
+  }
 
-  std::map<int, Field> getOrderedFields() const { return support::orderMap(derivedInfo_.fields_); }
+  std::map<int, Field> getOrderedFields() const { return support::orderMap(getFields()); }
 
   /// @brief Update the fields and global variables
   ///
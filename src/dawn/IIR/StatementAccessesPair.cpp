@@ -16,6 +16,7 @@
 #include "dawn/IIR/ASTStringifier.h"
 #include "dawn/IIR/AccessToNameMapper.h"
 #include "dawn/IIR/Accesses.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/IIR/StencilFunctionInstantiation.h"
 #include "dawn/IIR/StencilMetaInformation.h"
 #include "dawn/Support/Printing.h"
@@ -68,16 +69,8 @@ StatementAccessesPair::StatementAccessesPair(const std::shared_ptr<iir::Stmt>& s
 std::unique_ptr<StatementAccessesPair> StatementAccessesPair::clone() const {
   auto cloneSAP = std::make_unique<StatementAccessesPair>(statement_);
 
-  if(callerAccesses_) {
-    cloneSAP->callerAccesses_ = std::make_shared<Accesses>(*callerAccesses_);
-  } else {
-    cloneSAP->callerAccesses_ = nullptr;
-  }
-  if(calleeAccesses_) {
-    cloneSAP->calleeAccesses_ = std::make_shared<Accesses>(*calleeAccesses_);
-  } else {
-    cloneSAP->calleeAccesses_ = nullptr;
-  }
+  cloneSAP->callerAccesses_ = callerAccesses_;
+  cloneSAP->calleeAccesses_ = calleeAccesses_;
   cloneSAP->blockStatements_ = blockStatements_.clone();
 
   cloneSAP->cloneChildrenFrom(*this);
@@ -91,7 +84,20 @@ void StatementAccessesPair::setStatement(const std::shared_ptr<iir::Stmt>& state
   statement_ = statement;
 }
 
-std::shared_ptr<Accesses> StatementAccessesPair::getAccesses() const { return callerAccesses_; }
+/// @brief Make `accesses` exclusively owned by the caller before it is modified
+static const std::shared_ptr<Accesses>& detach(std::shared_ptr<Accesses>& accesses) {
+  if(accesses && accesses.use_count() > 1)
+    accesses = std::make_shared<Accesses>(*accesses);
+  return accesses;
+}
+
+std::shared_ptr<const Accesses> StatementAccessesPair::getAccesses() const {
+  return callerAccesses_;
+}
+
+const std::shared_ptr<Accesses>& StatementAccessesPair::getMutableAccesses() {
+  return detach(callerAccesses_);
+}
 
 void StatementAccessesPair::setAccesses(const std::shared_ptr<Accesses>& accesses) {
   callerAccesses_ = accesses;
@@ -106,6 +112,18 @@ void StatementAccessesPair::insertBlockStatement(std::unique_ptr<StatementAccess
   blockStatements_.insert(std::move(stmt));
 }
 
+void StatementAccessesPair::renumberIDs(const IDRenumbering& renumbering) {
+  renumbering.renumberAST(statement_);
+
+  // The accesses may be shared with clones of this pair
+  for(Accesses* accesses : {callerAccesses_.get(), calleeAccesses_.get()})
+    if(accesses && renumbering.visit(accesses))
+      accesses->renumberIDs(renumbering);
+
+  for(const auto& blockStatement : blockStatements_.getBlockStatements())
+    blockStatement->renumberIDs(renumbering);
+}
+
 boost::optional<Extents> StatementAccessesPair::computeMaximumExtents(const int accessID) const {
   boost::optional<Extents> extents;
 
@@ -143,16 +161,26 @@ bool StatementAccessesPair::hasBlockStatements() const {
   return blockStatements_.hasBlockStatements();
 }
 
-std::shared_ptr<Accesses> StatementAccessesPair::getCallerAccesses() const { return getAccesses(); }
+std::shared_ptr<const Accesses> StatementAccessesPair::getCallerAccesses() const {
+  return getAccesses();
+}
+
+const std::shared_ptr<Accesses>& StatementAccessesPair::getMutableCallerAccesses() {
+  return getMutableAccesses();
+}
 
 void StatementAccessesPair::setCallerAccesses(const std::shared_ptr<Accesses>& accesses) {
   return setAccesses(accesses);
 }
 
-std::shared_ptr<Accesses> StatementAccessesPair::getCalleeAccesses() const {
+std::shared_ptr<const Accesses> StatementAccessesPair::getCalleeAccesses() const {
   return calleeAccesses_;
 }
 
+const std::shared_ptr<Accesses>& StatementAccessesPair::getMutableCalleeAccesses() {
+  return detach(calleeAccesses_);
+}
+
 void StatementAccessesPair::setCalleeAccesses(const std::shared_ptr<Accesses>& accesses) {
   calleeAccesses_ = accesses;
 }
@@ -161,7 +189,7 @@ bool StatementAccessesPair::hasCalleeAccesses() { return calleeAccesses_ != null
 
 json::json StatementAccessesPair::print(const StencilMetaInformation& metadata,
                                         const AccessToNameMapper& accessToNameMapper,
-                                        const std::unordered_map<int, Extents>& accesses) const {
+                                        const AccessMap& accesses) const {
   json::json node;
   for(const auto& accessPair : accesses) {
     json::json accessNode;
@@ -28,6 +28,7 @@ namespace dawn {
 namespace iir {
 
 class DoMethod;
+class IDRenumbering;
 class StencilMetaInformation;
 
 /// @brief Statement with corresponding Accesses
@@ -50,6 +51,9 @@ class StatementAccessesPair : public IIRNode<DoMethod, StatementAccessesPair, vo
   // accesses without the initial offset of the call
   std::shared_ptr<Accesses> calleeAccesses_;
 
+  // Both accesses are shared with the clones of this pair, the `getMutable*` accessors copy them
+  // before they are modified
+
   // If the statement is a block statement, this will contain the sub-statements of the block. Note
   // that the acceses in this case are the *accumulated* accesses of all sub-statements.
   BlockStatements blockStatements_;
@@ -64,6 +68,8 @@ public:
   StatementAccessesPair(StatementAccessesPair&&) = default;
 
   /// @brief clone the statement accesses pair, returning a smart ptr
+  ///
+  /// The statement and the accesses are shared with the clone.
   std::unique_ptr<StatementAccessesPair> clone() const;
 
   /// @brief Get/Set the statement
@@ -71,15 +77,20 @@ public:
   void setStatement(const std::shared_ptr<iir::Stmt>& statement);
 
   /// @brief Get/Set the accesses
-  std::shared_ptr<Accesses> getAccesses() const;
+  std::shared_ptr<const Accesses> getAccesses() const;
   void setAccesses(const std::shared_ptr<Accesses>& accesses);
 
+  /// @brief Get the accesses for modification, copying them first if they are shared with a clone
+  const std::shared_ptr<Accesses>& getMutableAccesses();
+
   /// @brief Get/Set the caller accesses (alias for `getAccesses`)
-  std::shared_ptr<Accesses> getCallerAccesses() const;
+  std::shared_ptr<const Accesses> getCallerAccesses() const;
+  const std::shared_ptr<Accesses>& getMutableCallerAccesses();
   void setCallerAccesses(const std::shared_ptr<Accesses>& accesses);
 
   /// @brief Get/Set the callee accesses (only set for statements inside stencil-functions)
-  std::shared_ptr<Accesses> getCalleeAccesses() const;
+  std::shared_ptr<const Accesses> getCalleeAccesses() const;
+  const std::shared_ptr<Accesses>& getMutableCalleeAccesses();
   void setCalleeAccesses(const std::shared_ptr<Accesses>& accesses);
   bool hasCalleeAccesses();
 
@@ -92,6 +103,9 @@ public:
 
   boost::optional<Extents> computeMaximumExtents(const int accessID) const;
 
+  /// @brief Renumber the statement, the accesses and the block statements (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
+
   /// @brief Convert the StatementAccessesPair of a stencil or stencil-function to string
   /// @{
   std::string toString(const StencilMetaInformation* metadata, std::size_t initialIndent = 0) const;
@@ -102,7 +116,7 @@ public:
   json::json jsonDump(const StencilMetaInformation& metadata) const;
   json::json print(const StencilMetaInformation& metadata,
                    const AccessToNameMapper& accessToNameMapper,
-                   const std::unordered_map<int, Extents>& accesses) const;
+                   const AccessMap& accesses) const;
 };
 
 } // namespace iir
@@ -14,15 +14,16 @@
 
 #include "dawn/IIR/Stencil.h"
 #include "dawn/IIR/DependencyGraphStage.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/IIR/IIR.h"
 #include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/IIR/StencilLeafIndex.h"
 #include "dawn/SIR/SIR.h"
 #include "dawn/Support/StringUtil.h"
 #include "dawn/Support/Unreachable.h"
 #include <algorithm>
 #include <iostream>
-#include <numeric>
 
 namespace dawn {
 
@@ -90,6 +91,11 @@ json::json Stencil::FieldInfo::jsonDump() const {
   return node;
 }
 
+void Stencil::FieldInfo::renumberIDs(const IDRenumbering& renumbering) {
+  Name = renumbering.mapName(Name);
+  field.renumberIDs(renumbering);
+}
+
 json::json Stencil::jsonDump() const {
   json::json node;
   node["ID"] = std::to_string(StencilID_);
@@ -108,7 +114,7 @@ json::json Stencil::jsonDump() const {
 }
 
 bool Stencil::containsRedundantComputations() const {
-  for(const auto& stage : iterateIIROver<Stage>(*this)) {
+  for(const auto& stage : iterateStencilOver<Stage>(*this)) {
     if(!stage->getExtents().isHorizontalPointwise()) {
       return true;
     }
@@ -164,10 +170,24 @@ void Stencil::DerivedInfo::clear() { fields_.clear(); }
 
 void Stencil::clearDerivedInfo() { derivedInfo_.clear(); }
 
+void Stencil::renumberIDs(const IDRenumbering& renumbering) {
+  StencilID_ = renumbering.mapUID(StencilID_);
+
+  if(derivedInfo_.stageDependencyGraph_ &&
+     renumbering.visit(derivedInfo_.stageDependencyGraph_.get()))
+    derivedInfo_.stageDependencyGraph_->renumberIDs(renumbering);
+  derivedInfo_.fields_ = renumbering.mapKeys(derivedInfo_.fields_);
+  for(auto& fieldInfoPair : derivedInfo_.fields_)
+    fieldInfoPair.second.renumberIDs(renumbering);
+
+  for(const auto& multiStage : children_)
+    multiStage->renumberIDs(renumbering);
+}
+
 std::unordered_set<Interval> Stencil::getIntervals() const {
   std::unordered_set<Interval> intervals;
 
-  for(const auto& doMethod : iterateIIROver<DoMethod>(*this)) {
+  for(const auto& doMethod : iterateStencilOver<DoMethod>(*this)) {
     intervals.insert(doMethod->getInterval());
   }
   return intervals;
@@ -181,9 +201,17 @@ std::unique_ptr<Stencil> Stencil::clone() const {
   return cloneStencil;
 }
 
+std::unique_ptr<Stencil> Stencil::clone(StencilMetaInformation& metadata) const {
+  auto cloneStencil = std::make_unique<Stencil>(metadata, stencilAttributes_, StencilID_);
+
+  cloneStencil->derivedInfo_ = derivedInfo_;
+  cloneStencil->cloneChildrenFrom(*this, metadata);
+  return cloneStencil;
+}
+
 std::vector<std::string> Stencil::getGlobalVariables() const {
   std::set<int> globalVariableAccessIDs;
-  for(const auto& stage : iterateIIROver<Stage>(*this)) {
+  for(const auto& stage : iterateStencilOver<Stage>(*this)) {
     globalVariableAccessIDs.insert(stage->getAllGlobalVariables().begin(),
                                    stage->getAllGlobalVariables().end());
   }
@@ -195,13 +223,23 @@ std::vector<std::string> Stencil::getGlobalVariables() const {
   return globalVariables;
 }
 
-int Stencil::getNumStages() const {
-  return std::accumulate(childrenBegin(), childrenEnd(), int(0),
-                         [](int numStages, const Stencil::MultiStageSmartPtr_t& MS) {
-                           return numStages + MS->getChildren().size();
-                         });
+const std::shared_ptr<const StencilLeafIndex>& Stencil::getLeafIndex() const {
+  // The descendants of a detached stencil cannot reach its epoch, an index built while the stencil
+  // was detached also depends on the epoch of the detached subtrees
+  const std::uint64_t epoch = getStructureEpoch();
+  const std::uint64_t detachedEpoch = impl::getDetachedStructureEpoch();
+  if(!leafIndex_ || leafIndexEpoch_ != epoch ||
+     (leafIndexDetached_ && leafIndexDetachedEpoch_ != detachedEpoch)) {
+    leafIndex_ = std::make_shared<StencilLeafIndex>(*this);
+    leafIndexEpoch_ = epoch;
+    leafIndexDetachedEpoch_ = detachedEpoch;
+    leafIndexDetached_ = !parentIsSet();
+  }
+  return leafIndex_;
 }
 
+int Stencil::getNumStages() const { return getLeafIndex()->getStages().size(); }
+
 void Stencil::forEachStatementAccessesPair(
     std::function<void(ArrayRef<std::unique_ptr<StatementAccessesPair>>)> func, bool updateFields) {
   forEachStatementAccessesPairImpl(func, 0, getNumStages(), updateFields);
@@ -279,7 +317,7 @@ std::unordered_map<int, Field> Stencil::computeFieldsOnTheFly() const {
 }
 
 bool Stencil::hasGlobalVariables() const {
-  for(const auto& stage : iterateIIROver<Stage>(*this)) {
+  for(const auto& stage : iterateStencilOver<Stage>(*this)) {
     if(stage->hasGlobalVariables())
       return true;
   }
@@ -333,10 +371,7 @@ const std::shared_ptr<DependencyGraphStage>& Stencil::getStageDependencyGraph()
 
 const std::unique_ptr<MultiStage>&
 Stencil::getMultiStageFromMultiStageIndex(int multiStageIdx) const {
-  DAWN_ASSERT_MSG(multiStageIdx < children_.size(), "invalid multi-stage index");
-  auto msIt = children_.begin();
-  std::advance(msIt, multiStageIdx);
-  return *msIt;
+  return getLeafIndex()->getMultiStage(multiStageIdx);
 }
 
 const std::unique_ptr<MultiStage>& Stencil::getMultiStageFromStageIndex(int stageIdx) const {
@@ -348,36 +383,13 @@ Stencil::StagePosition Stencil::getPositionFromStageIndex(int stageIdx) const {
   if(stageIdx == -1)
     return StagePosition(0, -1);
 
-  int curIdx = 0, multiStageIdx = 0;
-  for(const auto& MS : children_) {
-
-    // Is our stage in this multi-stage?
-    int numStages = MS->getChildren().size();
-    if((curIdx + numStages) <= stageIdx) {
-      curIdx += numStages;
-      multiStageIdx++;
-      continue;
-    } else {
-      int stageOffset = stageIdx - curIdx;
-      DAWN_ASSERT_MSG(stageOffset < numStages, "invalid stage index");
-      return StagePosition(multiStageIdx, stageOffset);
-    }
-  }
-  dawn_unreachable("invalid stage index");
+  ArrayRef<StencilLeafIndex::StageEntry> stages = getLeafIndex()->getStages();
+  DAWN_ASSERT_MSG(stageIdx >= 0 && stageIdx < stages.size(), "invalid stage index");
+  return stages[stageIdx].StagePos;
 }
 
 int Stencil::getStageIndexFromPosition(const Stencil::StagePosition& position) const {
-  auto curMSIt = children_.begin();
-  std::advance(curMSIt, position.MultiStageIndex);
-
-  // Count the number of stages in the multistages before our current MS
-  int numStagesInMSBeforeCurMS = std::accumulate(
-      childrenBegin(), curMSIt, int(0), [&](int numStages, const MultiStageSmartPtr_t& MS) {
-        return numStages + MS->getChildren().size();
-      });
-
-  // Add the current stage offset
-  return numStagesInMSBeforeCurMS + position.StageOffset;
+  return getLeafIndex()->getStageIndex(position);
 }
 
 const std::unique_ptr<Stage>& Stencil::getStage(const StagePosition& position) const {
@@ -396,28 +408,9 @@ const std::unique_ptr<Stage>& Stencil::getStage(const StagePosition& position) c
 }
 
 const std::unique_ptr<Stage>& Stencil::getStage(int stageIdx) const {
-  int curIdx = 0;
-  for(const auto& MS : children_) {
-
-    // Is our stage in this multi-stage?
-    int numStages = MS->getChildren().size();
-
-    if((curIdx + numStages) <= stageIdx) {
-      // No... continue
-      curIdx += numStages;
-      continue;
-    } else {
-      // Yes... advance to our stage
-      int stageOffset = stageIdx - curIdx;
-
-      DAWN_ASSERT_MSG(stageOffset < MS->getChildren().size(), "invalid stage index");
-      auto stageIt = MS->childrenBegin();
-      std::advance(stageIt, stageOffset);
-
-      return *stageIt;
-    }
-  }
-  dawn_unreachable("invalid stage index");
+  ArrayRef<StencilLeafIndex::StageEntry> stages = getLeafIndex()->getStages();
+  DAWN_ASSERT_MSG(stageIdx >= 0 && stageIdx < stages.size(), "invalid stage index");
+  return stages[stageIdx].getStage();
 }
 
 void Stencil::insertStage(const StagePosition& position, std::unique_ptr<Stage>&& stage) {
@@ -446,13 +439,13 @@ void Stencil::insertStage(const StagePosition& position, std::unique_ptr<Stage>&
 }
 
 Interval Stencil::getAxis(bool useExtendedInterval) const {
-  int numStages = getNumStages();
-  DAWN_ASSERT_MSG(numStages, "need atleast one stage");
+  ArrayRef<StencilLeafIndex::StageEntry> stages = getLeafIndex()->getStages();
+  DAWN_ASSERT_MSG(!stages.empty(), "need atleast one stage");
 
-  Interval axis = getStage(0)->getEnclosingExtendedInterval();
-  for(int stageIdx = 1; stageIdx < numStages; ++stageIdx)
-    axis.merge(useExtendedInterval ? getStage(stageIdx)->getEnclosingExtendedInterval()
-                                   : getStage(stageIdx)->getEnclosingInterval());
+  Interval axis = stages[0].getStage()->getEnclosingExtendedInterval();
+  for(const auto& stageEntry : stages.drop_front())
+    axis.merge(useExtendedInterval ? stageEntry.getStage()->getEnclosingExtendedInterval()
+                                   : stageEntry.getStage()->getEnclosingInterval());
   return axis;
 }
 
@@ -471,44 +464,22 @@ Stencil::Lifetime Stencil::getLifetime(const int AccessID) const {
   boost::optional<StatementPosition> Begin = boost::make_optional(false, StatementPosition{});
   StatementPosition End;
 
-  int multiStageIdx = 0;
-  for(const auto& multistagePtr : children_) {
+  for(const auto& stmtEntry : getLeafIndex()->getStatementAccessesPairs()) {
+    const Accesses& accesses = *stmtEntry.getStatementAccessesPair()->getAccesses();
 
-    int stageOffset = 0;
-    for(const auto& stagePtr : multistagePtr->getChildren()) {
+    auto processAccessMap = [&](const AccessMap& accessMap) {
+      if(!accessMap.count(AccessID))
+        return;
 
-      int doMethodIndex = 0;
-      for(const auto& doMethodPtr : stagePtr->getChildren()) {
-        DoMethod& doMethod = *doMethodPtr;
+      StatementPosition pos = stmtEntry.getPosition();
 
-        int statementIdx = 0;
-        for(const auto& stmtAccessPair : doMethod.getChildren()) {
-          const Accesses& accesses = *stmtAccessPair->getAccesses();
+      if(!Begin.is_initialized())
+        Begin = boost::make_optional(pos);
+      End = pos;
+    };
 
-          auto processAccessMap = [&](const std::unordered_map<int, Extents>& accessMap) {
-            if(!accessMap.count(AccessID))
-              return;
-
-            StatementPosition pos(StagePosition(multiStageIdx, stageOffset), doMethodIndex,
-                                  statementIdx);
-
-            if(!Begin.is_initialized())
-              Begin = boost::make_optional(pos);
-            End = pos;
-          };
-
-          processAccessMap(accesses.getWriteAccesses());
-          processAccessMap(accesses.getReadAccesses());
-          statementIdx++;
-        }
-
-        doMethodIndex++;
-      }
-
-      stageOffset++;
-    }
-
-    multiStageIdx++;
+    processAccessMap(accesses.getWriteAccesses());
+    processAccessMap(accesses.getReadAccesses());
   }
 
   DAWN_ASSERT(Begin.is_initialized());
@@ -517,11 +488,9 @@ Stencil::Lifetime Stencil::getLifetime(const int AccessID) const {
 }
 
 bool Stencil::isEmpty() const {
-  for(const auto& MS : getChildren())
-    for(const auto& stage : MS->getChildren())
-      for(const auto& doMethod : stage->getChildren())
-        if(!doMethod->childrenEmpty())
-          return false;
+  for(const auto& doMethod : iterateStencilOver<DoMethod>(*this))
+    if(!doMethod->childrenEmpty())
+      return false;
 
   return true;
 }
@@ -542,7 +511,7 @@ boost::optional<Interval> Stencil::getEnclosingIntervalTemporaries() const {
 }
 
 void Stencil::accept(iir::ASTVisitor& visitor) {
-  for(const auto& stmtAccessesPairPtr : iterateIIROver<StatementAccessesPair>(*this)) {
+  for(const auto& stmtAccessesPairPtr : iterateStencilOver<StatementAccessesPair>(*this)) {
     stmtAccessesPairPtr->getStatement()->accept(visitor);
   }
 }
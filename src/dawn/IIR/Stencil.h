@@ -18,6 +18,7 @@
 #include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/MultiStage.h"
 #include "dawn/SIR/SIR.h"
+#include <cstdint>
 #include <functional>
 #include <list>
 #include <memory>
@@ -29,8 +30,10 @@ namespace dawn {
 namespace iir {
 
 class DependencyGraphStage;
+class IDRenumbering;
 class StatementAccessesPair;
 class IIR;
+class StencilLeafIndex;
 class StencilMetaInformation;
 
 /// @brief A Stencil is represented by a collection of MultiStages
@@ -57,6 +60,9 @@ public:
     bool IsTemporary;
     json::json jsonDump() const;
 
+    /// @brief Renumber the field and its name (see `IDRenumbering`)
+    void renumberIDs(const IDRenumbering& renumbering);
+
     bool operator==(const FieldInfo& other) const {
       return Name == other.Name && Dimensions == other.Dimensions && field == other.field &&
              IsTemporary == other.IsTemporary;
@@ -75,6 +81,13 @@ private:
 
   DerivedInfo derivedInfo_;
 
+  /// Flat index of the leaves and the structure epochs at which it was created (the index is
+  /// rebuilt lazily whenever the structure of the stencil changed)
+  mutable std::shared_ptr<const StencilLeafIndex> leafIndex_;
+  mutable std::uint64_t leafIndexEpoch_ = 0;
+  mutable std::uint64_t leafIndexDetachedEpoch_ = 0;
+  mutable bool leafIndexDetached_ = false;
+
 public:
   static constexpr const char* name = "Stencil";
 
@@ -189,6 +202,9 @@ public:
   /// @brief clone the stencil returning a smart ptr
   std::unique_ptr<Stencil> clone() const;
 
+  /// @brief clone the stencil, the clone refers to the meta information `metadata`
+  std::unique_ptr<Stencil> clone(StencilMetaInformation& metadata) const;
+
   /// @brief return the meta information
   const StencilMetaInformation& getMetadata() const { return metadata_; }
 
@@ -202,7 +218,7 @@ public:
   bool hasGlobalVariables() const;
 
   /// @brief returns true if the accessid is used within the stencil
-  bool hasFieldAccessID(const int accessID) const { return derivedInfo_.fields_.count(accessID); }
+  bool hasFieldAccessID(const int accessID) const { return getFields().count(accessID); }
 
   /// @brief Get the enclosing interval of accesses of temporaries used in this stencil
   boost::optional<Interval> getEnclosingIntervalTemporaries() const;
@@ -223,6 +239,15 @@ public:
   const std::unique_ptr<Stage>& getStage(const StagePosition& position) const;
   /// @}
 
+  /// @brief Get the flat index of the stages, Do-Methods and StatementAccessesPairs of the stencil
+  ///
+  /// The returned index is reused until children are inserted, erased or replaced in the stencil
+  /// (see `getStructureEpoch`). The index of a stencil which is not part of an IIR tree is also
+  /// rebuilt after modifications of any other detached subtree (see
+  /// `impl::DetachedStructureEpoch`). Keep a copy of the pointer to iterate over it while modifying
+  /// the stencil.
+  const std::shared_ptr<const StencilLeafIndex>& getLeafIndex() const;
+
   /// @brief Get the unique `StencilID`
   int getStencilID() const { return StencilID_; }
 
@@ -272,6 +297,9 @@ public:
   /// @brief clear the derived info
   virtual void clearDerivedInfo() override;
 
+  /// @brief Renumber the ID, the derived info and the multi-stages (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
+
   /// @brief Compute the life-time of the fields (or variables) given as a set of `AccessID`s
   std::unordered_map<int, Lifetime> getLifetime(const std::unordered_set<int>& AccessID) const;
 
@@ -288,12 +316,13 @@ public:
   void accept(iir::ASTVisitor& visitor);
 
   /// @brief Get the pair <AccessID, field> for the fields used within the multi-stage
-  const std::unordered_map<int, FieldInfo>& getFields() const { return derivedInfo_.fields_; }
+  const std::unordered_map<int, FieldInfo>& getFields() const {
+    flushIfDirty();
+    return derivedInfo_.fields_;
+  }
 
   /// @brief Get the pair <AccessID, field> for the fields used within the multi-stage
-  std::map<int, FieldInfo> getOrderedFields() const {
-    return support::orderMap(derivedInfo_.fields_);
-  }
+  std::map<int, FieldInfo> getOrderedFields() const { return support::orderMap(getFields()); }
 
   std::unordered_map<int, Field> computeFieldsOnTheFly() const;
 
@@ -16,6 +16,7 @@
 #include "dawn/IIR/ASTStringifier.h"
 #include "dawn/IIR/AccessUtils.h"
 #include "dawn/IIR/Field.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/IIR/StencilInstantiation.h"
 #include "dawn/Support/Casting.h"
 #include "dawn/Support/Logging.h"
@@ -69,6 +70,49 @@ StencilFunctionInstantiation StencilFunctionInstantiation::clone() const {
   return stencilFun;
 }
 
+void StencilFunctionInstantiation::renumberIDs(const IDRenumbering& renumbering) {
+  // Instantiations are shared by their caller and the maps of the metadata
+  if(!renumbering.visit(this))
+    return;
+
+  renumbering.renumberAST(expr_);
+  renumbering.renumberStencilFunction(function_);
+  renumbering.renumberAST(ast_->getRoot());
+
+  for(auto& pair : ArgumentIndexToCallerAccessIDMap_)
+    pair.second = renumbering.mapUID(pair.second);
+  for(const auto& pair : ArgumentIndexToStencilFunctionInstantiationMap_)
+    pair.second->renumberIDs(renumbering);
+  CallerAccessIDToInitialOffsetMap_ = renumbering.mapKeys(CallerAccessIDToInitialOffsetMap_);
+
+  for(auto& pair : ExprToCallerAccessIDMap_) {
+    renumbering.renumberAST(pair.first);
+    pair.second = renumbering.mapUID(pair.second);
+  }
+  for(auto& pair : StmtToCallerAccessIDMap_) {
+    renumbering.renumberAST(pair.first);
+    pair.second = renumbering.mapUID(pair.second);
+  }
+
+  AccessIDToNameMap_ = renumbering.mapKeys(AccessIDToNameMap_);
+  for(auto& pair : AccessIDToNameMap_)
+    pair.second = renumbering.mapName(pair.second);
+  LiteralAccessIDToNameMap_ = renumbering.mapKeys(LiteralAccessIDToNameMap_);
+
+  for(const auto& pair : ExprToStencilFunctionInstantiationMap_) {
+    renumbering.renumberAST(pair.first);
+    pair.second->renumberIDs(renumbering);
+  }
+
+  doMethod_->renumberIDs(renumbering);
+  for(Field& field : calleeFields_)
+    field.renumberIDs(renumbering);
+  for(Field& field : callerFields_)
+    field.renumberIDs(renumbering);
+  unusedFields_ = renumbering.mapSet(unusedFields_);
+  GlobalVariableAccessIDSet_ = renumbering.mapSet(GlobalVariableAccessIDSet_);
+}
+
 Array3i StencilFunctionInstantiation::evalOffsetOfFieldAccessExpr(
     const std::shared_ptr<iir::FieldAccessExpr>& expr, bool applyInitialOffset) const {
 
@@ -34,6 +34,7 @@ namespace dawn {
 namespace iir {
 
 class StencilInstantiation;
+class IDRenumbering;
 
 inline std::string dim2str(int dim) {
   switch(dim) {
@@ -175,6 +176,10 @@ public:
 
   StencilFunctionInstantiation clone() const;
 
+  /// @brief Renumber the caller AccessIDs, the AST and the nested stencil functions (see
+  /// `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
+
   inline const std::unique_ptr<DoMethod>& getDoMethod() { return doMethod_; }
 
   std::unordered_map<int, int>& ArgumentIndexToCallerAccessIDMap() {
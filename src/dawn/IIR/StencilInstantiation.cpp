@@ -16,6 +16,7 @@
 #include "dawn/IIR/AST.h"
 #include "dawn/IIR/ASTUtil.h"
 #include "dawn/IIR/ASTVisitor.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/InstantiationHelper.h"
 #include "dawn/IIR/StatementAccessesPair.h"
@@ -63,7 +64,7 @@ std::shared_ptr<StencilInstantiation> StencilInstantiation::clone() const {
   stencilInstantiation->IIR_ =
       std::make_unique<iir::IIR>(stencilInstantiation->getIIR()->getGlobalVariableMap(),
                             stencilInstantiation->getIIR()->getStencilFunctions());
-  IIR_->clone(stencilInstantiation->IIR_);
+  IIR_->clone(stencilInstantiation->IIR_, stencilInstantiation->metadata_);
 
   return stencilInstantiation;
 }
@@ -211,6 +212,11 @@ std::string StencilInstantiation::getOriginalNameFromAccessID(int AccessID) cons
 
 bool StencilInstantiation::checkTreeConsistency() const { return IIR_->checkTreeConsistency(); }
 
+void StencilInstantiation::renumberIDs(const IDRenumbering& renumbering) {
+  metadata_.renumberIDs(renumbering);
+  IIR_->renumberIDs(renumbering);
+}
+
 void StencilInstantiation::jsonDump(std::string filename) const {
 
   std::ofstream fs(filename, std::ios::out | std::ios::trunc);
@@ -34,6 +34,8 @@ class OptimizerContext;
 
 namespace iir {
 
+class IDRenumbering;
+
 enum class TemporaryScope { TS_LocalVariable, TS_StencilTemporary };
 
 /// @brief Specific instantiation of a stencil
@@ -54,8 +56,18 @@ public:
   StencilMetaInformation& getMetaData();
   const StencilMetaInformation& getMetaData() const { return metadata_; }
 
+  /// @brief Clone the instantiation
+  ///
+  /// The statements, the accesses of the statements and the access maps of the meta information
+  /// are shared with the clone and only copied when either side modifies them. The IIR tree, the
+  /// stencil function instantiations and the control flow are copied.
   std::shared_ptr<StencilInstantiation> clone() const;
 
+  /// @brief Renumber the identifiers of the meta information and of the IIR tree
+  ///
+  /// Used to give an instantiation optimized in parallel the identifiers of the serial optimizer.
+  void renumberIDs(const IDRenumbering& renumbering);
+
   bool checkTreeConsistency() const;
 
   /// @brief Get the name of the StencilInstantiation (corresponds to the name of the SIRStencil)
@@ -0,0 +1,125 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/IIR/StencilLeafIndex.h"
+#include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/Support/Assert.h"
+
+namespace dawn {
+namespace iir {
+
+std::atomic<std::uint64_t> impl::DetachedStructureEpoch(0);
+
+void StencilLeafIndex::buildStages() const {
+  if(stagesBuilt_)
+    return;
+
+  const auto& multiStages = stencil_->getChildren();
+  multiStages_.reserve(multiStages.size());
+  firstStageIndices_.reserve(multiStages.size() + 1);
+
+  int multiStageIdx = 0;
+  for(const auto& multiStage : multiStages) {
+    multiStages_.push_back(&multiStage);
+    firstStageIndices_.push_back(stages_.size());
+
+    int stageOffset = 0;
+    for(const auto& stage : multiStage->getChildren()) {
+      StageEntry entry;
+      entry.MultiStagePtr = &multiStage;
+      entry.StagePtr = &stage;
+      entry.StageIndex = stages_.size();
+      entry.StagePos = Stencil::StagePosition(multiStageIdx, stageOffset++);
+      stages_.push_back(entry);
+    }
+    multiStageIdx++;
+  }
+  firstStageIndices_.push_back(stages_.size());
+
+  stagesBuilt_ = true;
+}
+
+void StencilLeafIndex::buildDoMethods() const {
+  if(doMethodsBuilt_)
+    return;
+
+  for(const StageEntry& stageEntry : getStages()) {
+    int doMethodIdx = 0;
+    for(const auto& doMethod : stageEntry.getStage()->getChildren()) {
+      DoMethodEntry entry;
+      static_cast<StageEntry&>(entry) = stageEntry;
+      entry.DoMethodPtr = &doMethod;
+      entry.DoMethodIndex = doMethodIdx++;
+      doMethods_.push_back(entry);
+    }
+  }
+
+  doMethodsBuilt_ = true;
+}
+
+void StencilLeafIndex::buildStatements() const {
+  if(statementsBuilt_)
+    return;
+
+  for(const DoMethodEntry& doMethodEntry : getDoMethods()) {
+    int statementIdx = 0;
+    for(const auto& stmtAccessesPair : doMethodEntry.getDoMethod()->getChildren()) {
+      StatementEntry entry;
+      static_cast<DoMethodEntry&>(entry) = doMethodEntry;
+      entry.StatementAccessesPairPtr = &stmtAccessesPair;
+      entry.StatementIndex = statementIdx++;
+      statements_.push_back(entry);
+    }
+  }
+
+  statementsBuilt_ = true;
+}
+
+ArrayRef<StencilLeafIndex::StageEntry> StencilLeafIndex::getStages() const {
+  buildStages();
+  return stages_;
+}
+
+ArrayRef<StencilLeafIndex::DoMethodEntry> StencilLeafIndex::getDoMethods() const {
+  buildDoMethods();
+  return doMethods_;
+}
+
+ArrayRef<StencilLeafIndex::StatementEntry> StencilLeafIndex::getStatementAccessesPairs() const {
+  buildStatements();
+  return statements_;
+}
+
+int StencilLeafIndex::getNumMultiStages() const {
+  buildStages();
+  return multiStages_.size();
+}
+
+const std::unique_ptr<MultiStage>& StencilLeafIndex::getMultiStage(int multiStageIdx) const {
+  buildStages();
+  DAWN_ASSERT_MSG(multiStageIdx >= 0 && multiStageIdx < multiStages_.size(),
+                  "invalid multi-stage index");
+  return *multiStages_[multiStageIdx];
+}
+
+int StencilLeafIndex::getStageIndex(const Stencil::StagePosition& position) const {
+  buildStages();
+  DAWN_ASSERT_MSG(position.MultiStageIndex >= 0 &&
+                      position.MultiStageIndex < firstStageIndices_.size(),
+                  "invalid multi-stage index");
+  return firstStageIndices_[position.MultiStageIndex] + position.StageOffset;
+}
+
+} // namespace iir
+} // namespace dawn
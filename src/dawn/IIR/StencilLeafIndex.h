@@ -0,0 +1,270 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_IIR_STENCILLEAFINDEX_H
+#define DAWN_IIR_STENCILLEAFINDEX_H
+
+#include "dawn/IIR/Stencil.h"
+#include "dawn/Support/ArrayRef.h"
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace dawn {
+namespace iir {
+
+class StatementAccessesPair;
+
+/// @brief Flat index of the Stages, Do-Methods and StatementAccessesPairs of a Stencil
+///
+/// Each table stores the nodes of one level contiguously, in the order of a depth-first traversal
+/// of the stencil, together with their ancestors and their position within the stencil. Iterating
+/// a table is thus a plain vector walk, and visitors get the parent context without walking up the
+/// parent pointers.
+///
+/// The index is obtained with `Stencil::getLeafIndex`, which rebuilds it whenever children were
+/// inserted, erased or replaced in the stencil through the IIRNode API since it was created (see
+/// `IIRNode::getStructureEpoch`). Each table is built on first access, so that e.g. stage lookups
+/// never pay for the statement table.
+///
+/// @ingroup optimizer
+class StencilLeafIndex {
+public:
+  /// @brief A Stage together with its multi-stage
+  struct StageEntry {
+    const std::unique_ptr<MultiStage>* MultiStagePtr = nullptr;
+    const std::unique_ptr<Stage>* StagePtr = nullptr;
+
+    /// Linear index of the stage within the stencil
+    int StageIndex = -1;
+
+    /// Position of the stage within the stencil
+    Stencil::StagePosition StagePos;
+
+    const std::unique_ptr<MultiStage>& getMultiStage() const { return *MultiStagePtr; }
+    const std::unique_ptr<Stage>& getStage() const { return *StagePtr; }
+    const std::unique_ptr<Stage>& getNode() const { return *StagePtr; }
+  };
+
+  /// @brief A Do-Method together with its stage and multi-stage
+  struct DoMethodEntry : StageEntry {
+    const std::unique_ptr<DoMethod>* DoMethodPtr = nullptr;
+
+    /// Index of the Do-Method inside the stage
+    int DoMethodIndex = -1;
+
+    const std::unique_ptr<DoMethod>& getDoMethod() const { return *DoMethodPtr; }
+    const std::unique_ptr<DoMethod>& getNode() const { return *DoMethodPtr; }
+  };
+
+  /// @brief A StatementAccessesPair together with its Do-Method, stage and multi-stage
+  struct StatementEntry : DoMethodEntry {
+    const std::unique_ptr<StatementAccessesPair>* StatementAccessesPairPtr = nullptr;
+
+    /// Index of the statement inside the Do-Method
+    int StatementIndex = -1;
+
+    const std::unique_ptr<StatementAccessesPair>& getStatementAccessesPair() const {
+      return *StatementAccessesPairPtr;
+    }
+    const std::unique_ptr<StatementAccessesPair>& getNode() const {
+      return *StatementAccessesPairPtr;
+    }
+
+    /// @brief Position of the statement within the stencil
+    Stencil::StatementPosition getPosition() const {
+      return Stencil::StatementPosition(StagePos, DoMethodIndex, StatementIndex);
+    }
+  };
+
+  /// @brief Entry type of the table of `Leaf` nodes
+  template <typename Leaf>
+  struct EntryOf;
+
+  /// @brief Create the (empty) index of `stencil`, the tables are built on first access
+  explicit StencilLeafIndex(const Stencil& stencil) : stencil_(&stencil) {}
+
+  StencilLeafIndex(const StencilLeafIndex&) = delete;
+  StencilLeafIndex& operator=(const StencilLeafIndex&) = delete;
+
+  /// @brief Get the indexed stencil
+  const Stencil& getStencil() const { return *stencil_; }
+
+  /// @brief Get the tables of the stages, Do-Methods and StatementAccessesPairs
+  /// @{
+  ArrayRef<StageEntry> getStages() const;
+  ArrayRef<DoMethodEntry> getDoMethods() const;
+  ArrayRef<StatementEntry> getStatementAccessesPairs() const;
+
+  template <typename Leaf>
+  ArrayRef<typename EntryOf<Leaf>::type> getEntries() const;
+  /// @}
+
+  /// @brief Get the number of multi-stages
+  int getNumMultiStages() const;
+
+  /// @brief Get the multi-stage at given multi-stage index
+  const std::unique_ptr<MultiStage>& getMultiStage(int multiStageIdx) const;
+
+  /// @brief Get the linear index of the stage at `position` (a `StageOffset` of -1 yields the index
+  /// before the first stage of the multi-stage)
+  int getStageIndex(const Stencil::StagePosition& position) const;
+
+private:
+  void buildStages() const;
+  void buildDoMethods() const;
+  void buildStatements() const;
+
+  const Stencil* stencil_;
+
+  mutable bool stagesBuilt_ = false;
+  mutable bool doMethodsBuilt_ = false;
+  mutable bool statementsBuilt_ = false;
+
+  /// Multi-stages and linear index of their first stage (with a trailing sentinel)
+  mutable std::vector<const std::unique_ptr<MultiStage>*> multiStages_;
+  mutable std::vector<int> firstStageIndices_;
+
+  mutable std::vector<StageEntry> stages_;
+  mutable std::vector<DoMethodEntry> doMethods_;
+  mutable std::vector<StatementEntry> statements_;
+};
+
+template <>
+struct StencilLeafIndex::EntryOf<Stage> {
+  using type = StageEntry;
+};
+
+template <>
+struct StencilLeafIndex::EntryOf<DoMethod> {
+  using type = DoMethodEntry;
+};
+
+template <>
+struct StencilLeafIndex::EntryOf<StatementAccessesPair> {
+  using type = StatementEntry;
+};
+
+template <>
+inline ArrayRef<StencilLeafIndex::StageEntry> StencilLeafIndex::getEntries<Stage>() const {
+  return getStages();
+}
+
+template <>
+inline ArrayRef<StencilLeafIndex::DoMethodEntry> StencilLeafIndex::getEntries<DoMethod>() const {
+  return getDoMethods();
+}
+
+template <>
+inline ArrayRef<StencilLeafIndex::StatementEntry>
+StencilLeafIndex::getEntries<StatementAccessesPair>() const {
+  return getStatementAccessesPairs();
+}
+
+/// @brief Range over the entries of a table of a `StencilLeafIndex`
+///
+/// The range shares the ownership of the index, hence the loop may modify the stencil (which
+/// replaces the index of the stencil) and continue with the remaining entries. As for the iterators of the
+/// IIR containers, the entries pointing into a modified vector of children must not be used
+/// anymore.
+template <typename Leaf>
+class StencilLeafEntryRange {
+public:
+  using Entry = typename StencilLeafIndex::EntryOf<Leaf>::type;
+  using iterator = const Entry*;
+
+  explicit StencilLeafEntryRange(std::shared_ptr<const StencilLeafIndex> index)
+      : index_(std::move(index)), entries_(index_->getEntries<Leaf>()) {}
+
+  iterator begin() const { return entries_.begin(); }
+  iterator end() const { return entries_.end(); }
+  std::size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+  const Entry& operator[](std::size_t idx) const { return entries_[idx]; }
+
+private:
+  std::shared_ptr<const StencilLeafIndex> index_;
+  ArrayRef<Entry> entries_;
+};
+
+/// @brief Range over the `Leaf` nodes of a table of a `StencilLeafIndex`, dereferencing to the
+/// smart pointer of the node (as the ranges of `iterateIIROver`)
+template <typename Leaf>
+class StencilLeafRange {
+public:
+  using Entry = typename StencilLeafIndex::EntryOf<Leaf>::type;
+
+  class iterator {
+    const Entry* entry_;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::unique_ptr<Leaf>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const std::unique_ptr<Leaf>*;
+    using reference = const std::unique_ptr<Leaf>&;
+
+    explicit iterator(const Entry* entry) : entry_(entry) {}
+
+    reference operator*() const { return entry_->getNode(); }
+    pointer operator->() const { return &entry_->getNode(); }
+
+    iterator& operator++() {
+      ++entry_;
+      return *this;
+    }
+    iterator operator++(int) {
+      iterator it(*this);
+      ++entry_;
+      return it;
+    }
+
+    bool operator==(const iterator& other) const { return entry_ == other.entry_; }
+    bool operator!=(const iterator& other) const { return entry_ != other.entry_; }
+
+    /// @brief Get the entry (with the parent context) of the current node
+    const Entry& getEntry() const { return *entry_; }
+  };
+
+  explicit StencilLeafRange(std::shared_ptr<const StencilLeafIndex> index)
+      : entries_(std::move(index)) {}
+
+  iterator begin() const { return iterator(entries_.begin()); }
+  iterator end() const { return iterator(entries_.end()); }
+  std::size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+private:
+  StencilLeafEntryRange<Leaf> entries_;
+};
+
+} // namespace iir
+
+/// @brief Iterate over the `Leaf` nodes (Stage, DoMethod or StatementAccessesPair) of `stencil`
+/// using its flat leaf index
+template <typename Leaf>
+iir::StencilLeafRange<Leaf> iterateStencilOver(const iir::Stencil& stencil) {
+  return iir::StencilLeafRange<Leaf>(stencil.getLeafIndex());
+}
+
+/// @brief Iterate over the entries of the `Leaf` nodes of `stencil`, which carry the ancestors and
+/// the position of each node
+template <typename Leaf>
+iir::StencilLeafEntryRange<Leaf> iterateStencilEntriesOver(const iir::Stencil& stencil) {
+  return iir::StencilLeafEntryRange<Leaf>(stencil.getLeafIndex());
+}
+
+} // namespace dawn
+
+#endif
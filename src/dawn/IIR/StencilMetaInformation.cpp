@@ -17,6 +17,7 @@
 #include "dawn/IIR/ASTStringifier.h"
 #include "dawn/IIR/ASTUtil.h"
 #include "dawn/IIR/ASTVisitor.h"
+#include "dawn/IIR/IDRenumbering.h"
 #include "dawn/IIR/InstantiationHelper.h"
 #include "dawn/IIR/StencilFunctionInstantiation.h"
 #include "dawn/SIR/SIR.h"
@@ -35,13 +36,9 @@ namespace iir {
 
 void StencilMetaInformation::clone(const StencilMetaInformation& origin) {
   AccessIDToNameMap_ = origin.AccessIDToNameMap_;
-  for(auto pair : origin.ExprIDToAccessIDMap_) {
-    ExprIDToAccessIDMap_.emplace(pair.first, pair.second);
-  }
-  for(auto pair : origin.StmtIDToAccessIDMap_) {
-    StmtIDToAccessIDMap_.emplace(pair.first, pair.second);
-  }
-  fieldAccessMetadata_.clone(origin.fieldAccessMetadata_);
+  ExprIDToAccessIDMap_ = origin.ExprIDToAccessIDMap_;
+  StmtIDToAccessIDMap_ = origin.StmtIDToAccessIDMap_;
+  fieldAccessMetadata_ = origin.fieldAccessMetadata_;
   for(const auto& sf : origin.stencilFunctionInstantiations_) {
     stencilFunctionInstantiations_.emplace_back(
         std::make_shared<StencilFunctionInstantiation>(sf->clone()));
@@ -68,28 +65,80 @@ void StencilMetaInformation::clone(const StencilMetaInformation& origin) {
   fileName_ = origin.fileName_;
 }
 
+void StencilMetaInformation::renumberIDs(const IDRenumbering& renumbering) {
+  FieldAccessMetadata& fieldAccessMetadata = fieldAccessMetadata_.mutate();
+  fieldAccessMetadata.LiteralAccessIDToNameMap_ =
+      renumbering.mapKeys(fieldAccessMetadata.LiteralAccessIDToNameMap_);
+  fieldAccessMetadata.FieldAccessIDSet_ = renumbering.mapSet(fieldAccessMetadata.FieldAccessIDSet_);
+  for(int& AccessID : fieldAccessMetadata.apiFieldIDs_)
+    AccessID = renumbering.mapUID(AccessID);
+  fieldAccessMetadata.TemporaryFieldAccessIDSet_ =
+      renumbering.mapSet(fieldAccessMetadata.TemporaryFieldAccessIDSet_);
+  fieldAccessMetadata.GlobalVariableAccessIDSet_ =
+      renumbering.mapSet(fieldAccessMetadata.GlobalVariableAccessIDSet_);
+  fieldAccessMetadata.variableVersions_.renumberIDs(renumbering);
+  fieldAccessMetadata.AllocatedFieldAccessIDSet_ =
+      renumbering.mapSet(fieldAccessMetadata.AllocatedFieldAccessIDSet_);
+  fieldAccessMetadata.accessIDType_ = renumbering.mapKeys(fieldAccessMetadata.accessIDType_);
+
+  DoubleSidedMap<int, std::string> accessIDToNameMap;
+  for(const auto& pair : AccessIDToNameMap_->getDirectMap())
+    accessIDToNameMap.add(renumbering.mapUID(pair.first), renumbering.mapName(pair.second));
+  AccessIDToNameMap_ = CopyOnWrite<DoubleSidedMap<int, std::string>>(std::move(accessIDToNameMap));
+
+  for(CopyOnWrite<DenseIDMap<int>>* map : {&ExprIDToAccessIDMap_, &StmtIDToAccessIDMap_}) {
+    DenseIDMap<int> renumberedMap;
+    for(const auto& pair : map->get())
+      renumberedMap.emplace(renumbering.mapUID(pair.first), renumbering.mapUID(pair.second));
+    *map = CopyOnWrite<DenseIDMap<int>>(std::move(renumberedMap));
+  }
+
+  for(const auto& stencilFun : stencilFunctionInstantiations_)
+    stencilFun->renumberIDs(renumbering);
+  for(const auto& pair : ExprToStencilFunctionInstantiationMap_) {
+    renumbering.renumberAST(pair.first);
+    pair.second->renumberIDs(renumbering);
+  }
+  for(const auto& pair : stencilFunInstantiationCandidate_) {
+    pair.first->renumberIDs(renumbering);
+    if(pair.second.callerStencilFunction_)
+      pair.second.callerStencilFunction_->renumberIDs(renumbering);
+  }
+
+  for(const auto& pair : fieldnameToBoundaryConditionMap_)
+    renumbering.renumberAST(pair.second);
+  fieldIDToInitializedDimensionsMap_ = renumbering.mapKeys(fieldIDToInitializedDimensionsMap_);
+
+  DoubleSidedMap<int, std::shared_ptr<iir::StencilCallDeclStmt>> stencilIDToStencilCallMap;
+  for(const auto& pair : StencilIDToStencilCallMap_.getDirectMap()) {
+    renumbering.renumberAST(pair.second);
+    stencilIDToStencilCallMap.add(renumbering.mapUID(pair.first), pair.second);
+  }
+  StencilIDToStencilCallMap_ = std::move(stencilIDToStencilCallMap);
+}
+
 const std::string& StencilMetaInformation::getNameFromLiteralAccessID(int AccessID) const {
   DAWN_ASSERT_MSG(isAccessType(iir::FieldAccessType::FAT_Literal, AccessID), "Invalid literal");
-  return fieldAccessMetadata_.LiteralAccessIDToNameMap_.find(AccessID)->second;
+  return fieldAccessMetadata_->LiteralAccessIDToNameMap_.find(AccessID)->second;
 }
 
 const std::string& StencilMetaInformation::getFieldNameFromAccessID(int accessID) const {
   if(accessID < 0)
     return getNameFromLiteralAccessID(accessID);
-  return AccessIDToNameMap_.directAt(accessID);
+  return AccessIDToNameMap_->directAt(accessID);
 }
 
 const std::unordered_map<std::string, int>& StencilMetaInformation::getNameToAccessIDMap() const {
-  return AccessIDToNameMap_.getReverseMap();
+  return AccessIDToNameMap_->getReverseMap();
 }
 
 /// @brief Get the AccessID-to-Name map
 const std::unordered_map<int, std::string>& StencilMetaInformation::getAccessIDToNameMap() const {
-  return AccessIDToNameMap_.getDirectMap();
+  return AccessIDToNameMap_->getDirectMap();
 }
 
 int StencilMetaInformation::getAccessIDFromName(const std::string& name) const {
-  return AccessIDToNameMap_.reverseAt(name);
+  return AccessIDToNameMap_->reverseAt(name);
 }
 
 bool StencilMetaInformation::isAccessType(FieldAccessType fType, const std::string& name) const {
@@ -222,22 +271,22 @@ StencilMetaInformation::getAccessesOfTypeImpl(FieldAccessType fieldAccessType) c
   switch(fieldAccessType) {
   case FieldAccessType::FAT_Literal:
     return FieldAccessMetadata::allConstContainerTypes(
-        fieldAccessMetadata_.LiteralAccessIDToNameMap_);
+        fieldAccessMetadata_->LiteralAccessIDToNameMap_);
   case FieldAccessType::FAT_GlobalVariable:
     return FieldAccessMetadata::allConstContainerTypes(
-        fieldAccessMetadata_.GlobalVariableAccessIDSet_);
+        fieldAccessMetadata_->GlobalVariableAccessIDSet_);
   case FieldAccessType::FAT_Field:
-    return FieldAccessMetadata::allConstContainerTypes(fieldAccessMetadata_.FieldAccessIDSet_);
+    return FieldAccessMetadata::allConstContainerTypes(fieldAccessMetadata_->FieldAccessIDSet_);
   case FieldAccessType::FAT_LocalVariable:
     dawn_unreachable("getter of local accesses ids not supported");
   case FieldAccessType::FAT_StencilTemporary:
     return FieldAccessMetadata::allConstContainerTypes(
-        fieldAccessMetadata_.TemporaryFieldAccessIDSet_);
+        fieldAccessMetadata_->TemporaryFieldAccessIDSet_);
   case FieldAccessType::FAT_InterStencilTemporary:
     return FieldAccessMetadata::allConstContainerTypes(
-        fieldAccessMetadata_.AllocatedFieldAccessIDSet_);
+        fieldAccessMetadata_->AllocatedFieldAccessIDSet_);
   case FieldAccessType::FAT_APIField:
-    return FieldAccessMetadata::allConstContainerTypes(fieldAccessMetadata_.apiFieldIDs_);
+    return FieldAccessMetadata::allConstContainerTypes(fieldAccessMetadata_->apiFieldIDs_);
   }
   return FieldAccessMetadata::allConstContainerTypes{std::set<int>{}};
 }
@@ -254,11 +303,11 @@ bool StencilMetaInformation::isAccessType(FieldAccessType fType, const int acces
            !isAccessType(FieldAccessType::FAT_GlobalVariable, accessID);
   }
   if(fType == FieldAccessType::FAT_Literal) {
-    return fieldAccessMetadata_.LiteralAccessIDToNameMap_.count(accessID) > 0;
+    return fieldAccessMetadata_->LiteralAccessIDToNameMap_.count(accessID) > 0;
   }
   // not all the accessIDs are registered
-  return (fieldAccessMetadata_.accessIDType_.count(accessID) &&
-          fieldAccessMetadata_.accessIDType_.at(accessID) == fType);
+  return (fieldAccessMetadata_->accessIDType_.count(accessID) &&
+          fieldAccessMetadata_->accessIDType_.at(accessID) == fType);
 }
 
 void StencilMetaInformation::moveRegisteredFieldTo(FieldAccessType type, int accessID) {
@@ -266,19 +315,20 @@ void StencilMetaInformation::moveRegisteredFieldTo(FieldAccessType type, int acc
   DAWN_ASSERT(type != FieldAccessType::FAT_APIField);
   DAWN_ASSERT_MSG(isFieldType(type), "non field access type can not be moved");
 
-  fieldAccessMetadata_.accessIDType_[accessID] = type;
+  FieldAccessMetadata& fieldAccessMetadata = fieldAccessMetadata_.mutate();
+  fieldAccessMetadata.accessIDType_[accessID] = type;
 
-  if(fieldAccessMetadata_.TemporaryFieldAccessIDSet_.count(accessID)) {
-    fieldAccessMetadata_.TemporaryFieldAccessIDSet_.erase(accessID);
+  if(fieldAccessMetadata.TemporaryFieldAccessIDSet_.count(accessID)) {
+    fieldAccessMetadata.TemporaryFieldAccessIDSet_.erase(accessID);
   }
-  if(fieldAccessMetadata_.AllocatedFieldAccessIDSet_.count(accessID)) {
-    fieldAccessMetadata_.AllocatedFieldAccessIDSet_.erase(accessID);
+  if(fieldAccessMetadata.AllocatedFieldAccessIDSet_.count(accessID)) {
+    fieldAccessMetadata.AllocatedFieldAccessIDSet_.erase(accessID);
   }
 
   if(type == FieldAccessType::FAT_StencilTemporary) {
-    fieldAccessMetadata_.TemporaryFieldAccessIDSet_.insert(accessID);
+    fieldAccessMetadata.TemporaryFieldAccessIDSet_.insert(accessID);
   } else if(type == FieldAccessType::FAT_InterStencilTemporary) {
-    fieldAccessMetadata_.AllocatedFieldAccessIDSet_.insert(accessID);
+    fieldAccessMetadata.AllocatedFieldAccessIDSet_.insert(accessID);
   }
 }
 
@@ -292,27 +342,28 @@ int StencilMetaInformation::insertAccessOfType(FieldAccessType type, const std::
 
 void StencilMetaInformation::insertAccessOfType(FieldAccessType type, int AccessID,
                                                 const std::string& name) {
+  FieldAccessMetadata& fieldAccessMetadata = fieldAccessMetadata_.mutate();
   if(type != FieldAccessType::FAT_Literal) {
     addAccessIDNamePair(AccessID, name);
-    fieldAccessMetadata_.accessIDType_[AccessID] = type;
+    fieldAccessMetadata.accessIDType_[AccessID] = type;
   }
 
   if(isFieldType(type)) {
-    fieldAccessMetadata_.FieldAccessIDSet_.insert(AccessID);
+    fieldAccessMetadata.FieldAccessIDSet_.insert(AccessID);
     if(type == FieldAccessType::FAT_StencilTemporary) {
-      fieldAccessMetadata_.TemporaryFieldAccessIDSet_.insert(AccessID);
+      fieldAccessMetadata.TemporaryFieldAccessIDSet_.insert(AccessID);
     } else if(type == FieldAccessType::FAT_InterStencilTemporary) {
-      fieldAccessMetadata_.AllocatedFieldAccessIDSet_.insert(AccessID);
+      fieldAccessMetadata.AllocatedFieldAccessIDSet_.insert(AccessID);
     } else if(type == FieldAccessType::FAT_APIField) {
-      fieldAccessMetadata_.apiFieldIDs_.push_back(AccessID);
+      fieldAccessMetadata.apiFieldIDs_.push_back(AccessID);
     }
   } else if(type == FieldAccessType::FAT_GlobalVariable) {
-    fieldAccessMetadata_.GlobalVariableAccessIDSet_.insert(AccessID);
+    fieldAccessMetadata.GlobalVariableAccessIDSet_.insert(AccessID);
   } else if(type == FieldAccessType::FAT_LocalVariable) {
     // local variables are not stored
   } else if(type == FieldAccessType::FAT_Literal) {
     DAWN_ASSERT(AccessID < 0);
-    fieldAccessMetadata_.LiteralAccessIDToNameMap_.emplace(AccessID, name);
+    fieldAccessMetadata.LiteralAccessIDToNameMap_.emplace(AccessID, name);
   }
 }
 
@@ -328,8 +379,8 @@ int StencilMetaInformation::addStmt(bool keepVarNames, const std::shared_ptr<Var
 
   addAccessIDNamePair(accessID, globalName);
 
-  DAWN_ASSERT(!StmtIDToAccessIDMap_.count(stmt->getID()));
-  StmtIDToAccessIDMap_.emplace(stmt->getID(), accessID);
+  DAWN_ASSERT(!StmtIDToAccessIDMap_->count(stmt->getID()));
+  StmtIDToAccessIDMap_.mutate().emplace(stmt->getID(), accessID);
 
   return accessID;
 }
@@ -347,32 +398,32 @@ Array3i StencilMetaInformation::getFieldDimensionsMask(int FieldID) const {
   return fieldIDToInitializedDimensionsMap_.find(FieldID)->second;
 }
 
-const std::unordered_map<int, int>& StencilMetaInformation::getExprIDToAccessIDMap() const {
-  return ExprIDToAccessIDMap_;
+const DenseIDMap<int>& StencilMetaInformation::getExprIDToAccessIDMap() const {
+  return *ExprIDToAccessIDMap_;
 }
-const std::unordered_map<int, int>& StencilMetaInformation::getStmtIDToAccessIDMap() const {
-  return StmtIDToAccessIDMap_;
+const DenseIDMap<int>& StencilMetaInformation::getStmtIDToAccessIDMap() const {
+  return *StmtIDToAccessIDMap_;
 }
 
 void StencilMetaInformation::insertExprToAccessID(const std::shared_ptr<Expr>& expr, int accessID) {
-  // DAWN_ASSERT(!ExprIDToAccessIDMap_.count(expr->getID()));  //this is not unique in case of
+  // DAWN_ASSERT(!ExprIDToAccessIDMap_->count(expr->getID()));  //this is not unique in case of
   // -fpass-tmp-to-function
-  ExprIDToAccessIDMap_.emplace(expr->getID(), accessID);
+  ExprIDToAccessIDMap_.mutate().emplace(expr->getID(), accessID);
 }
 
 void StencilMetaInformation::eraseExprToAccessID(std::shared_ptr<iir::Expr> expr) {
-  DAWN_ASSERT_MSG(ExprIDToAccessIDMap_.count(expr->getID()), "Field with given ID does not exist");
-  ExprIDToAccessIDMap_.erase(expr->getID());
+  DAWN_ASSERT_MSG(ExprIDToAccessIDMap_->count(expr->getID()), "Field with given ID does not exist");
+  ExprIDToAccessIDMap_.mutate().erase(expr->getID());
 }
 
 void StencilMetaInformation::eraseStmtToAccessID(std::shared_ptr<iir::Stmt> stmt) {
-  DAWN_ASSERT(StmtIDToAccessIDMap_.count(stmt->getID()));
-  StmtIDToAccessIDMap_.erase(stmt->getID());
+  DAWN_ASSERT(StmtIDToAccessIDMap_->count(stmt->getID()));
+  StmtIDToAccessIDMap_.mutate().erase(stmt->getID());
 }
 
 void StencilMetaInformation::addStmtToAccessID(const std::shared_ptr<Stmt>& stmt, int accessID) {
-  DAWN_ASSERT(!StmtIDToAccessIDMap_.count(stmt->getID()));
-  StmtIDToAccessIDMap_.emplace(stmt->getID(), accessID);
+  DAWN_ASSERT(!StmtIDToAccessIDMap_->count(stmt->getID()));
+  StmtIDToAccessIDMap_.mutate().emplace(stmt->getID(), accessID);
 }
 
 std::string StencilMetaInformation::getNameFromAccessID(int accessID) const {
@@ -384,31 +435,31 @@ std::string StencilMetaInformation::getNameFromAccessID(int accessID) const {
 }
 
 int StencilMetaInformation::getAccessIDFromExpr(const std::shared_ptr<iir::Expr>& expr) const {
-  auto it = ExprIDToAccessIDMap_.find(expr->getID());
-  DAWN_ASSERT_MSG(it != ExprIDToAccessIDMap_.end(), "Invalid Expr");
-  return it->second;
+  const int* accessID = ExprIDToAccessIDMap_->lookup(expr->getID());
+  DAWN_ASSERT_MSG(accessID, "Invalid Expr");
+  return *accessID;
 }
 
 int StencilMetaInformation::getAccessIDFromStmt(const std::shared_ptr<iir::Stmt>& stmt) const {
-  auto it = StmtIDToAccessIDMap_.find(stmt->getID());
-  DAWN_ASSERT_MSG(it != StmtIDToAccessIDMap_.end(), "Invalid Stmt");
-  return it->second;
+  const int* accessID = StmtIDToAccessIDMap_->lookup(stmt->getID());
+  DAWN_ASSERT_MSG(accessID, "Invalid Stmt");
+  return *accessID;
 }
 
 void StencilMetaInformation::setAccessIDOfStmt(const std::shared_ptr<iir::Stmt>& stmt,
                                                const int accessID) {
-  DAWN_ASSERT(StmtIDToAccessIDMap_.count(stmt->getID()));
-  StmtIDToAccessIDMap_[stmt->getID()] = accessID;
+  DAWN_ASSERT(StmtIDToAccessIDMap_->count(stmt->getID()));
+  StmtIDToAccessIDMap_.mutate()[stmt->getID()] = accessID;
 }
 
 bool StencilMetaInformation::hasStmtToAccessID(const std::shared_ptr<iir::Stmt>& stmt) const {
-  return StmtIDToAccessIDMap_.count(stmt->getID());
+  return StmtIDToAccessIDMap_->count(stmt->getID());
 }
 
 void StencilMetaInformation::setAccessIDOfExpr(const std::shared_ptr<iir::Expr>& expr,
                                                const int accessID) {
-  DAWN_ASSERT(ExprIDToAccessIDMap_.count(expr->getID()));
-  ExprIDToAccessIDMap_[expr->getID()] = accessID;
+  DAWN_ASSERT(ExprIDToAccessIDMap_->count(expr->getID()));
+  ExprIDToAccessIDMap_.mutate()[expr->getID()] = accessID;
 }
 
 const std::shared_ptr<StencilFunctionInstantiation>
@@ -421,7 +472,7 @@ StencilMetaInformation::getStencilFunctionInstantiation(
 
 void StencilMetaInformation::addAccessIDNamePair(int accessID, const std::string& name) {
   // this fails if -fkeep-varnames is used
-  AccessIDToNameMap_.add(accessID, name);
+  AccessIDToNameMap_.mutate().add(accessID, name);
 }
 
 int StencilMetaInformation::addField(FieldAccessType type, const std::string& name,
@@ -452,24 +503,25 @@ int StencilMetaInformation::addTmpField(FieldAccessType type, const std::string&
 }
 
 void StencilMetaInformation::removeAccessID(int AccessID) {
-  AccessIDToNameMap_.directEraseKey(AccessID);
+  AccessIDToNameMap_.mutate().directEraseKey(AccessID);
 
   // we can only remove field or local variables (i.e. we can not remove neither globals nor
   // literals
   DAWN_ASSERT(isAccessType(FieldAccessType::FAT_Field, AccessID) ||
               isAccessType(FieldAccessType::FAT_LocalVariable, AccessID));
 
-  fieldAccessMetadata_.FieldAccessIDSet_.erase(AccessID);
+  FieldAccessMetadata& fieldAccessMetadata = fieldAccessMetadata_.mutate();
+  fieldAccessMetadata.FieldAccessIDSet_.erase(AccessID);
   if(isAccessType(FieldAccessType::FAT_InterStencilTemporary, AccessID)) {
-    fieldAccessMetadata_.AllocatedFieldAccessIDSet_.erase(AccessID);
+    fieldAccessMetadata.AllocatedFieldAccessIDSet_.erase(AccessID);
   }
   if(isAccessType(FieldAccessType::FAT_StencilTemporary, AccessID)) {
-    fieldAccessMetadata_.TemporaryFieldAccessIDSet_.erase(AccessID);
+    fieldAccessMetadata.TemporaryFieldAccessIDSet_.erase(AccessID);
   }
   if(isAccessType(FieldAccessType::FAT_APIField, AccessID)) {
     // remote on a vector
-    auto begin = fieldAccessMetadata_.apiFieldIDs_.begin();
-    auto end = fieldAccessMetadata_.apiFieldIDs_.end();
+    auto begin = fieldAccessMetadata.apiFieldIDs_.begin();
+    auto end = fieldAccessMetadata.apiFieldIDs_.end();
     auto first = std::find(begin, end, AccessID);
     if(first != end) {
       for(auto i = first; ++i != end;) {
@@ -479,10 +531,10 @@ void StencilMetaInformation::removeAccessID(int AccessID) {
       }
     }
   }
-  fieldAccessMetadata_.accessIDType_.erase(AccessID);
+  fieldAccessMetadata.accessIDType_.erase(AccessID);
 
-  if(fieldAccessMetadata_.variableVersions_.variableHasMultipleVersions(AccessID)) {
-    auto versions = fieldAccessMetadata_.variableVersions_.getVersions(AccessID);
+  if(fieldAccessMetadata.variableVersions_.variableHasMultipleVersions(AccessID)) {
+    auto versions = fieldAccessMetadata.variableVersions_.getVersions(AccessID);
     versions->erase(std::remove_if(versions->begin(), versions->end(),
                                    [&](int AID) { return AID == AccessID; }),
                     versions->end());
@@ -495,13 +547,14 @@ StencilMetaInformation::StencilMetaInformation(const sir::GlobalVariableMap& glo
   }
 }
 
-std::shared_ptr<std::vector<int>> StencilMetaInformation::getVersionsOf(const int accessID) const {
-  return fieldAccessMetadata_.variableVersions_.getVersions(accessID);
+std::shared_ptr<const std::vector<int>>
+StencilMetaInformation::getVersionsOf(const int accessID) const {
+  return fieldAccessMetadata_->variableVersions_.getVersions(accessID);
 }
 
 json::json StencilMetaInformation::jsonDump() const {
   json::json metaDataJson;
-  metaDataJson["VariableVersions"] = fieldAccessMetadata_.variableVersions_.jsonDump();
+  metaDataJson["VariableVersions"] = fieldAccessMetadata_->variableVersions_.jsonDump();
   size_t pos = fileName_.find_last_of("\\/");
   DAWN_ASSERT(pos + 1 < fileName_.size() - 1);
   metaDataJson["filename"] = fileName_.substr(pos + 1, fileName_.size() - pos - 1);
@@ -512,7 +565,7 @@ json::json StencilMetaInformation::jsonDump() const {
   ss.str("");
 
   json::json globalAccessIDsJson;
-  for(const auto& id : fieldAccessMetadata_.GlobalVariableAccessIDSet_) {
+  for(const auto& id : fieldAccessMetadata_->GlobalVariableAccessIDSet_) {
     globalAccessIDsJson.push_back(id);
   }
   metaDataJson["GlobalAccessIDs"] = globalAccessIDsJson;
@@ -531,35 +584,35 @@ json::json StencilMetaInformation::jsonDump() const {
   metaDataJson["FieldToBC"] = bcJson;
 
   json::json accessIdToTypeJson;
-  for(const auto& p : fieldAccessMetadata_.accessIDType_) {
+  for(const auto& p : fieldAccessMetadata_->accessIDType_) {
     accessIdToTypeJson[std::to_string(p.first)] = toString(p.second);
   }
   json::json tmpAccessIDsJson;
-  for(const auto& id : fieldAccessMetadata_.TemporaryFieldAccessIDSet_) {
+  for(const auto& id : fieldAccessMetadata_->TemporaryFieldAccessIDSet_) {
     tmpAccessIDsJson.push_back(id);
   }
   metaDataJson["TemporaryAccessIDs"] = tmpAccessIDsJson;
 
   json::json apiAccessIDsJson;
-  for(const auto& id : fieldAccessMetadata_.apiFieldIDs_) {
+  for(const auto& id : fieldAccessMetadata_->apiFieldIDs_) {
     apiAccessIDsJson.push_back(id);
   }
   metaDataJson["apiAccessIDs"] = apiAccessIDsJson;
 
   json::json fieldAccessIDsJson;
-  for(const auto& id : fieldAccessMetadata_.FieldAccessIDSet_) {
+  for(const auto& id : fieldAccessMetadata_->FieldAccessIDSet_) {
     fieldAccessIDsJson.push_back(id);
   }
   metaDataJson["fieldAccessIDs"] = fieldAccessIDsJson;
 
   json::json literalAccessIDsJson;
-  for(const auto& pair : fieldAccessMetadata_.LiteralAccessIDToNameMap_) {
+  for(const auto& pair : fieldAccessMetadata_->LiteralAccessIDToNameMap_) {
     literalAccessIDsJson[std::to_string(pair.first)] = pair.second;
   }
   metaDataJson["literalAccessIDs"] = literalAccessIDsJson;
 
   json::json accessIDToNameJson;
-  for(const auto& pair : AccessIDToNameMap_.getDirectMap()) {
+  for(const auto& pair : AccessIDToNameMap_->getDirectMap()) {
     accessIDToNameJson[std::to_string(pair.first)] = pair.second;
   }
   metaDataJson["AccessIDToName"] = accessIDToNameJson;
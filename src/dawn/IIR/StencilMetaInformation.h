@@ -19,6 +19,8 @@
 #include "dawn/IIR/Extents.h"
 #include "dawn/IIR/FieldAccessMetadata.h"
 #include "dawn/SIR/SIR.h"
+#include "dawn/Support/CopyOnWrite.h"
+#include "dawn/Support/DenseIDMap.h"
 #include "dawn/Support/DoubleSidedMap.h"
 #include "dawn/Support/NonCopyable.h"
 #include "dawn/Support/RemoveIf.hpp"
@@ -37,6 +39,7 @@ class IIRSerializer;
 namespace iir {
 class StencilFunctionInstantiation;
 class Interval;
+class IDRenumbering;
 
 /// @brief Specific instantiation of a stencil
 /// @ingroup optimizer
@@ -46,8 +49,16 @@ class StencilMetaInformation : public NonCopyable {
 public:
   StencilMetaInformation(const sir::GlobalVariableMap& globalVariables);
 
+  /// @brief Make this a copy of `origin`
+  ///
+  /// The access maps and the field access metadata are shared with `origin` and only copied once
+  /// either of the two modifies them.
   void clone(const StencilMetaInformation& origin);
 
+  /// @brief Renumber the AccessIDs, the IDs of the AST nodes and the stencil IDs as well as the
+  /// names generated from them (see `IDRenumbering`)
+  void renumberIDs(const IDRenumbering& renumbering);
+
   /// @brief get the `name` associated with the `accessID` of any access type
   const std::string& getFieldNameFromAccessID(int AccessID) const;
 
@@ -58,17 +69,17 @@ public:
   bool isAccessType(FieldAccessType fType, const std::string& name) const;
 
   bool isAccessIDAVersion(const int accessID) const {
-    return fieldAccessMetadata_.variableVersions_.isAccessIDAVersion(accessID);
+    return fieldAccessMetadata_->variableVersions_.isAccessIDAVersion(accessID);
   }
 
   /// @brief Check whether the `AccessID` corresponds to a multi-versioned field
   bool isMultiVersionedField(int AccessID) const {
     return isAccessType(FieldAccessType::FAT_Field, AccessID) &&
-           fieldAccessMetadata_.variableVersions_.variableHasMultipleVersions(AccessID);
+           fieldAccessMetadata_->variableVersions_.variableHasMultipleVersions(AccessID);
   }
 
   int getOriginalVersionOfAccessID(const int accessID) const {
-    return fieldAccessMetadata_.variableVersions_.getOriginalVersionOfAccessID(accessID);
+    return fieldAccessMetadata_->variableVersions_.getOriginalVersionOfAccessID(accessID);
   }
 
   /// @brief Get the Name-to-AccessID map
@@ -130,7 +141,7 @@ public:
   int getAccessIDFromName(const std::string& name) const;
 
   bool hasNameToAccessID(const std::string& name) const {
-    return AccessIDToNameMap_.reverseHas(name);
+    return AccessIDToNameMap_->reverseHas(name);
   }
   /// @brief Get the field-AccessID set
   const std::set<int>& getFieldAccessIDSet() const;
@@ -239,20 +250,20 @@ public:
   void setFileName(const std::string& name) { fileName_ = name; }
   void setStencilLocation(const SourceLocation& location) { stencilLocation_ = location; }
 
-  const FieldAccessMetadata& getFieldAccessMetadata() const { return fieldAccessMetadata_; }
+  const FieldAccessMetadata& getFieldAccessMetadata() const { return *fieldAccessMetadata_; }
 
   void addFieldVersionIDPair(const int originalAccessID, const int versionedAccessID) {
-    fieldAccessMetadata_.variableVersions_.addIDPair(originalAccessID, versionedAccessID);
+    fieldAccessMetadata_.mutate().variableVersions_.addIDPair(originalAccessID, versionedAccessID);
   }
 
   bool variableHasMultipleVersions(const int accessID) const {
-    return fieldAccessMetadata_.variableVersions_.variableHasMultipleVersions(accessID);
+    return fieldAccessMetadata_->variableVersions_.variableHasMultipleVersions(accessID);
   }
 
-  std::shared_ptr<std::vector<int>> getVersionsOf(const int accessID) const;
+  std::shared_ptr<const std::vector<int>> getVersionsOf(const int accessID) const;
 
-  const std::unordered_map<int, int>& getExprIDToAccessIDMap() const;
-  const std::unordered_map<int, int>& getStmtIDToAccessIDMap() const;
+  const DenseIDMap<int>& getExprIDToAccessIDMap() const;
+  const DenseIDMap<int>& getStmtIDToAccessIDMap() const;
 
   const std::unordered_map<std::shared_ptr<iir::StencilFunCallExpr>,
                            std::shared_ptr<StencilFunctionInstantiation>>&
@@ -330,20 +341,25 @@ private:
   //================================================================================================
   // Stored MetaInformation
   //================================================================================================
+  //
+  // The large maps are copy-on-write: they are shared between a stencil instantiation and its
+  // clones and copied on the first modification. Read them through `->`, modify them through
+  // `mutate()`.
 
-  FieldAccessMetadata fieldAccessMetadata_;
+  CopyOnWrite<FieldAccessMetadata> fieldAccessMetadata_;
 
   /// Map of AccessIDs and to the name of the variable/field. Note that only for fields of the
   /// "main stencil" we can get the AccessID by name. This is due the fact that fields of different
   /// stencil functions can share the same name.
-  DoubleSidedMap<int, std::string> AccessIDToNameMap_;
+  CopyOnWrite<DoubleSidedMap<int, std::string>> AccessIDToNameMap_;
 
   /// Surjection of AST Nodes, Expr (FieldAccessExpr or VarAccessExpr) or Stmt (VarDeclStmt), to
   /// their AccessID. The surjection implies that multiple AST Nodes can have the same AccessID,
   /// which is the intended behaviour as we want to get the same ID back when we access the same
-  /// field for example
-  std::unordered_map<int, int> ExprIDToAccessIDMap_;
-  std::unordered_map<int, int> StmtIDToAccessIDMap_;
+  /// field for example. The maps are keyed by the ID of the node, which are drawn from few dense
+  /// ranges, hence a lookup is an array access rather than a hash map lookup.
+  CopyOnWrite<DenseIDMap<int>> ExprIDToAccessIDMap_;
+  CopyOnWrite<DenseIDMap<int>> StmtIDToAccessIDMap_;
 
   /// Referenced stencil functions in this stencil (note that nested stencil functions are not
   /// stored here but rather in the respecticve `StencilFunctionInstantiation`)
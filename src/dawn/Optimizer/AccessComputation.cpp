@@ -103,15 +103,14 @@ public:
   /// accesses list. This will also add accesses to the children of the top-level statement access
   /// pair
   void appendNewAccesses() {
-    curStatementAccessPairStack_.back()->Pair->setCallerAccesses(std::make_shared<iir::Accesses>());
-    callerAccessesList_.emplace_back(
-        curStatementAccessPairStack_.back()->Pair->getCallerAccesses());
+    auto callerAccesses = std::make_shared<iir::Accesses>();
+    curStatementAccessPairStack_.back()->Pair->setCallerAccesses(callerAccesses);
+    callerAccessesList_.emplace_back(callerAccesses);
 
     if(stencilFun_) {
-      curStatementAccessPairStack_.back()->Pair->setCalleeAccesses(
-          std::make_shared<iir::Accesses>());
-      calleeAccessesList_.emplace_back(
-          curStatementAccessPairStack_.back()->Pair->getCalleeAccesses());
+      auto calleeAccesses = std::make_shared<iir::Accesses>();
+      curStatementAccessPairStack_.back()->Pair->setCalleeAccesses(calleeAccesses);
+      calleeAccessesList_.emplace_back(calleeAccesses);
     }
 
     // Add all accesses of all parent if-cond expressions
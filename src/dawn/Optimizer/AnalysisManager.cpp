@@ -0,0 +1,148 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Optimizer/AnalysisManager.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/PassComputeStageExtents.h"
+#include "dawn/Optimizer/PassProfiler.h"
+#include "dawn/Optimizer/PassSetStageGraph.h"
+#include "dawn/Optimizer/PassSetStageName.h"
+#include "dawn/Support/Unreachable.h"
+
+namespace dawn {
+
+namespace {
+
+std::string getCounterName(AnalysisKind kind, const char* event) {
+  return std::string("analysis.") + getAnalysisName(kind) + "." + event;
+}
+
+/// @brief Recompute the derived info of all IIR nodes (bottom-up)
+void computeDerivedInfo(const std::shared_ptr<iir::StencilInstantiation>& instantiation) {
+  for(const auto& MS : iterateIIROver<iir::MultiStage>(*(instantiation->getIIR()))) {
+    MS->update(iir::NodeUpdateType::levelAndTreeAbove);
+  }
+  for(const auto& stagePtr : iterateIIROver<iir::Stage>(*(instantiation->getIIR()))) {
+    iir::Stage& stage = *stagePtr;
+    for(const auto& doMethod : stage.getChildren()) {
+      doMethod->update(iir::NodeUpdateType::level);
+    }
+    stage.update(iir::NodeUpdateType::level);
+  }
+  for(const auto& stagePtr : iterateIIROver<iir::Stage>(*(instantiation->getIIR()))) {
+    stagePtr->update(iir::NodeUpdateType::levelAndTreeAbove);
+  }
+}
+
+} // anonymous namespace
+
+const char* getAnalysisName(AnalysisKind kind) {
+  switch(kind) {
+  case AK_DerivedInfo:
+    return "DerivedInfo";
+  case AK_StageNames:
+    return "StageNames";
+  case AK_StageDependencyGraph:
+    return "StageDependencyGraph";
+  case AK_StageExtents:
+    return "StageExtents";
+  default:
+    dawn_unreachable("invalid analysis kind");
+  }
+}
+
+AnalysisManager::AnalysisManager(PassProfiler& profiler) : profiler_(profiler) {}
+
+bool AnalysisManager::isValid(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
+                              AnalysisKind kind) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = valid_.find(instantiation);
+  return it != valid_.end() && it->second.test(kind);
+}
+
+void AnalysisManager::markValid(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
+                                AnalysisKind kind) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  valid_[instantiation].set(kind);
+}
+
+void AnalysisManager::invalidate(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
+                                 const PreservedAnalyses& preserved) {
+  std::bitset<AK_NumAnalyses> invalidated;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for(auto it = valid_.begin(); it != valid_.end();)
+      it = it->first.expired() ? valid_.erase(it) : std::next(it);
+
+    auto& valid = valid_[instantiation];
+    for(int kind = 0; kind < AK_NumAnalyses; ++kind)
+      if(valid.test(kind) && !preserved.isPreserved(static_cast<AnalysisKind>(kind))) {
+        valid.reset(kind);
+        invalidated.set(kind);
+      }
+  }
+
+  for(int kind = 0; kind < AK_NumAnalyses; ++kind)
+    if(invalidated.test(kind))
+      profiler_.incrementCounter(getCounterName(static_cast<AnalysisKind>(kind), "invalidated"));
+}
+
+bool AnalysisManager::require(OptimizerContext& context,
+                              const std::shared_ptr<iir::StencilInstantiation>& instantiation,
+                              AnalysisKind kind) {
+  if(isValid(instantiation, kind)) {
+    recordReuse(kind);
+    return true;
+  }
+  return compute(context, instantiation, kind);
+}
+
+bool AnalysisManager::compute(OptimizerContext& context,
+                              const std::shared_ptr<iir::StencilInstantiation>& instantiation,
+                              AnalysisKind kind) {
+  bool success = true;
+  switch(kind) {
+  case AK_DerivedInfo:
+    computeDerivedInfo(instantiation);
+    break;
+  case AK_StageNames:
+    success = PassSetStageName(context).run(instantiation);
+    break;
+  case AK_StageDependencyGraph:
+    success = PassSetStageGraph(context).run(instantiation);
+    break;
+  case AK_StageExtents:
+    success = PassComputeStageExtents(context).run(instantiation);
+    break;
+  default:
+    dawn_unreachable("invalid analysis kind");
+  }
+
+  recordComputation(kind);
+  if(success)
+    markValid(instantiation, kind);
+  return success;
+}
+
+void AnalysisManager::recordComputation(AnalysisKind kind) {
+  profiler_.incrementCounter(getCounterName(kind, "computed"));
+}
+
+void AnalysisManager::recordReuse(AnalysisKind kind) {
+  profiler_.incrementCounter(getCounterName(kind, "reused"));
+}
+
+} // namespace dawn
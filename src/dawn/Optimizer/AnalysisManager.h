@@ -0,0 +1,140 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_OPTIMIZER_ANALYSISMANAGER_H
+#define DAWN_OPTIMIZER_ANALYSISMANAGER_H
+
+#include "dawn/Support/NonCopyable.h"
+#include <bitset>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace dawn {
+
+namespace iir {
+class StencilInstantiation;
+}
+
+class OptimizerContext;
+class PassProfiler;
+
+/// @brief Information derived from the IIR of a stencil instantiation which is managed by the
+/// `AnalysisManager`
+/// @ingroup optimizer
+enum AnalysisKind {
+  AK_DerivedInfo = 0,      ///< Derived info of the IIR nodes (fields, extents, ...), which the
+                           ///< passes update for the nodes they modify
+  AK_StageNames,           ///< Names of the stages (see `PassSetStageName`)
+  AK_StageDependencyGraph, ///< Dependency graph of the stages of each stencil
+                           ///< (see `PassSetStageGraph`)
+  AK_StageExtents,         ///< Extents of the stages (see `PassComputeStageExtents`)
+  AK_NumAnalyses
+};
+
+/// @brief Get the name of the analysis `kind`
+const char* getAnalysisName(AnalysisKind kind);
+
+/// @brief Set of analyses which are still up to date after a pass ran
+/// @ingroup optimizer
+class PreservedAnalyses {
+  std::bitset<AK_NumAnalyses> preserved_;
+
+public:
+  /// @brief No analysis is preserved (i.e the pass may change anything)
+  static PreservedAnalyses none() { return PreservedAnalyses(); }
+
+  /// @brief All analyses are preserved (i.e the pass does not modify the IIR)
+  static PreservedAnalyses all() {
+    PreservedAnalyses preserved;
+    preserved.preserved_.set();
+    return preserved;
+  }
+
+  PreservedAnalyses& preserve(AnalysisKind kind) {
+    preserved_.set(kind);
+    return *this;
+  }
+
+  PreservedAnalyses& abandon(AnalysisKind kind) {
+    preserved_.reset(kind);
+    return *this;
+  }
+
+  bool isPreserved(AnalysisKind kind) const { return preserved_.test(kind); }
+};
+
+/// @brief Keep track of the analyses which are up to date for each stencil instantiation
+///
+/// Passes declare which analyses they require, compute and preserve (see `Pass`). The
+/// `PassManager` asks the analysis manager to compute a required analysis only if it was
+/// invalidated by one of the previous passes and invalidates the analyses which are not preserved
+/// by a pass after it ran. The number of computed, reused and invalidated analyses is recorded in
+/// the counters of the `PassProfiler` (e.g `analysis.StageDependencyGraph.reused`).
+///
+/// The derived info is not recomputed on demand: the passes update it for the nodes they modify.
+/// Tracking it only avoids verifying it (`Stencil::compareDerivedInfo`, in debug builds) after
+/// passes which do not modify the IIR. It is only computed for instantiations which enter the
+/// optimizer without it (see `OptimizerContext::restoreOptimizedIIR`).
+///
+/// The instantiations are tracked by their ownership, i.e an instantiation allocated at the address
+/// of a destroyed one does not inherit its analyses. Analyses of several stencil instantiations may
+/// be handled concurrently.
+/// @ingroup optimizer
+class AnalysisManager : NonCopyable {
+  using InstantiationKey = std::weak_ptr<const iir::StencilInstantiation>;
+
+  PassProfiler& profiler_;
+  std::map<InstantiationKey, std::bitset<AK_NumAnalyses>, std::owner_less<InstantiationKey>>
+      valid_;
+  mutable std::mutex mutex_;
+
+public:
+  explicit AnalysisManager(PassProfiler& profiler);
+
+  /// @brief Check if the analysis `kind` of `instantiation` is up to date
+  bool isValid(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
+               AnalysisKind kind) const;
+
+  /// @brief Mark the analysis `kind` of `instantiation` as up to date
+  void markValid(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
+                 AnalysisKind kind);
+
+  /// @brief Invalidate all analyses of `instantiation` which are not `preserved`
+  ///
+  /// The entries of destroyed instantiations are released.
+  void invalidate(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
+                  const PreservedAnalyses& preserved);
+
+  /// @brief Make sure the analysis `kind` of `instantiation` is up to date, it is only computed if
+  /// it is not valid
+  /// @returns `true` on success, `false` otherwise
+  bool require(OptimizerContext& context,
+               const std::shared_ptr<iir::StencilInstantiation>& instantiation, AnalysisKind kind);
+
+  /// @brief (Re)compute the analysis `kind` of `instantiation`
+  /// @returns `true` on success, `false` otherwise
+  bool compute(OptimizerContext& context,
+               const std::shared_ptr<iir::StencilInstantiation>& instantiation, AnalysisKind kind);
+
+  /// @brief Record that the analysis `kind` was computed
+  void recordComputation(AnalysisKind kind);
+
+  /// @brief Record that the analysis `kind` was still up to date when it was needed
+  void recordReuse(AnalysisKind kind);
+};
+
+} // namespace dawn
+
+#endif
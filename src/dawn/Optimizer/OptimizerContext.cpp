@@ -14,6 +14,7 @@
 
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/IIR/ASTConverter.h"
+#include "dawn/IIR/DeferredUpdate.h"
 #include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/InstantiationHelper.h"
 #include "dawn/IIR/StencilInstantiation.h"
@@ -602,6 +603,10 @@ bool OptimizerContext::fillIIRFromSIR(
                       field->Name, field->fieldDimensions);
   }
 
+  // The IIR is built one statement at a time, the derived info of the nodes is computed once when
+  // the tree is complete (or when it is read)
+  iir::DeferredUpdateScope deferredUpdates;
+
   StencilDescStatementMapper stencilDeclMapper(stencilInstantiation, SIRStencil.get(),
                                                fullSIR->Stencils, *fullSIR->GlobalVariableMap,
                                                *this);
@@ -677,7 +682,9 @@ void OptimizerContext::fillIIR() {
 
   for(const auto& stencil : SIR_->Stencils) {
     DAWN_ASSERT(stencil);
-    if(!stencil->Attributes.has(sir::Attr::AK_NoCodeGen)) {
+    if(stencilInstantiationMap_.count(stencil->Name)) {
+      DAWN_LOG(INFO) << "Skipping already optimized `" << stencil->Name << "`";
+    } else if(!stencil->Attributes.has(sir::Attr::AK_NoCodeGen)) {
       stencilInstantiationMap_.insert(
           std::make_pair(stencil->Name, std::make_shared<iir::StencilInstantiation>(
                                             *getSIR()->GlobalVariableMap, iirStencilFunctions)));
@@ -696,23 +703,10 @@ bool OptimizerContext::restoreIIR(std::string const& name,
 
   stencilInstantiationMap_.insert(std::make_pair(name, stencilInstantiation));
 
-  for(const auto& MS : iterateIIROver<MultiStage>(*(stencilInstantiation->getIIR()))) {
-    MS->update(NodeUpdateType::levelAndTreeAbove);
-  }
+  // Recompute the information of the IIR nodes which is not serialized
+  passManager_.getAnalysisManager().compute(*this, stencilInstantiation, AK_DerivedInfo);
   DAWN_LOG(INFO) << "Done initializing StencilInstantiation";
 
-  // Iterate all statements (top -> bottom)
-  for(const auto& stagePtr : iterateIIROver<iir::Stage>(*(stencilInstantiation->getIIR()))) {
-    iir::Stage& stage = *stagePtr;
-    for(const auto& doMethod : stage.getChildren()) {
-      doMethod->update(iir::NodeUpdateType::level);
-    }
-    stage.update(iir::NodeUpdateType::level);
-  }
-  for(const auto& MSPtr : iterateIIROver<iir::Stage>(*(stencilInstantiation->getIIR()))) {
-    MSPtr->update(iir::NodeUpdateType::levelAndTreeAbove);
-  }
-
   // fix extents of stages since they are not stored in the iir but computed from the accesses
   // contained in the DoMethods
   checkAndPushBack<PassSetStageName>();
@@ -723,4 +717,20 @@ bool OptimizerContext::restoreIIR(std::string const& name,
   return true;
 }
 
+bool OptimizerContext::restoreOptimizedIIR(
+    std::shared_ptr<iir::StencilInstantiation> stencilInstantiation) {
+  DAWN_ASSERT(SIR_);
+  auto& metadata = stencilInstantiation->getMetaData();
+  metadata.setFileName(SIR_->Filename);
+
+  // Only recompute the information which is not serialized, the instantiation is already optimized
+  AnalysisManager& analysisManager = passManager_.getAnalysisManager();
+  for(auto kind : {AK_DerivedInfo, AK_StageNames, AK_StageExtents})
+    if(!analysisManager.compute(*this, stencilInstantiation, kind))
+      return false;
+
+  stencilInstantiationMap_[stencilInstantiation->getName()] = stencilInstantiation;
+  return true;
+}
+
 } // namespace dawn
@@ -39,6 +39,28 @@ struct HardwareConfig {
 
   /// Maximum number of fields concurrently in the texture cache
   int TexCacheMaxFields = 3;
+
+  /// Maximum number of fields a stage can keep in registers, each further field is spilled
+  int RegisterMaxFields = 24;
+
+  /// Size of a field element in bytes
+  int ElementSize = 8;
+
+  /// Size of the L1 data cache of a CPU core in bytes
+  int L1CacheSize = 32 * 1024;
+
+  /// Size of the L2 cache of a CPU core in bytes
+  int L2CacheSize = 1024 * 1024;
+
+  /// Size of a cache line in bytes
+  int CacheLineSize = 64;
+
+  /// Cost of evaluating a statement at one grid point, in bytes of global-memory traffic
+  double StatementCost = 2.0;
+
+  /// Cost of the synchronization at the end of a stage, in bytes of global-memory traffic per grid
+  /// point
+  double StageSyncCost = 4.0;
 };
 
 /// @brief Context of handling all Optimizations
@@ -112,6 +134,17 @@ public:
                       const std::shared_ptr<SIR> fullSIR);
   bool restoreIIR(std::string const& name,
                   std::shared_ptr<iir::StencilInstantiation> stencilInstantiation);
+
+  /// @brief Insert an already optimized (e.g deserialized) instantiation, replacing the one of the
+  /// same name
+  ///
+  /// In contrast to `restoreIIR`, no passes are added to the PassManager.
+  bool restoreOptimizedIIR(std::shared_ptr<iir::StencilInstantiation> stencilInstantiation);
+
+  /// @brief Build the instantiations of the stencils of the SIR
+  ///
+  /// Stencils which already have an instantiation (e.g restored with `restoreOptimizedIIR`) are
+  /// skipped.
   void fillIIR();
 
   /// @brief this function check if a pass should be pushed back into the list of passes based on
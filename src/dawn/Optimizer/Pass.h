@@ -15,6 +15,7 @@
 #ifndef DAWN_OPTIMIZER_PASS_H
 #define DAWN_OPTIMIZER_PASS_H
 
+#include "dawn/Optimizer/AnalysisManager.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -33,6 +34,8 @@ class StencilInstantiation;
 ///      on success!
 ///   2) Register your new Pass in the DAWNCompiler::compile method in DAWNCompiler.cpp at the
 ///      position you would like it run.
+///   3) Declare the analyses your Pass requires and the ones it leaves intact (see
+///      `AnalysisManager`). By default a pass is assumed to invalidate all analyses.
 ///
 /// @ingroup Optimizer
 class Pass {
@@ -43,6 +46,15 @@ protected:
   /// Name of the passes this pass depends on (empty implies no dependency)
   std::vector<std::string> dependencies_;
 
+  /// Analyses which have to be up to date before the pass is run
+  std::vector<AnalysisKind> requiredAnalyses_;
+
+  /// Analyses computed by the pass (the pass is skipped if all of them are still up to date)
+  std::vector<AnalysisKind> computedAnalyses_;
+
+  /// Analyses which are still up to date after the pass ran
+  PreservedAnalyses preservedAnalyses_;
+
   /// Optimizer that registers the passes
   OptimizerContext& context_;
 
@@ -65,6 +77,15 @@ public:
   /// @brief Get the dependencies of this pass
   std::vector<std::string> getDependencies() const { return dependencies_; }
 
+  /// @brief Get the analyses required by this pass
+  const std::vector<AnalysisKind>& getRequiredAnalyses() const { return requiredAnalyses_; }
+
+  /// @brief Get the analyses computed by this pass
+  const std::vector<AnalysisKind>& getComputedAnalyses() const { return computedAnalyses_; }
+
+  /// @brief Get the analyses preserved by this pass
+  const PreservedAnalyses& getPreservedAnalyses() const { return preservedAnalyses_; }
+
   bool isDebug() const { return isDebug_; }
 };
 
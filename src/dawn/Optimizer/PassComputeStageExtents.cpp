@@ -24,6 +24,8 @@ namespace dawn {
 PassComputeStageExtents::PassComputeStageExtents(OptimizerContext& context)
     : Pass(context, "PassComputeStageExtents", true) {
   dependencies_.push_back("PassSetStageName");
+  computedAnalyses_.push_back(AK_StageExtents);
+  preservedAnalyses_.preserve(AK_StageNames).preserve(AK_StageDependencyGraph);
 }
 
 bool PassComputeStageExtents::run(
@@ -30,7 +30,6 @@ namespace dawn {
 namespace {
 
 class ReadWriteCounter : public iir::ASTVisitorForwarding {
-  const std::shared_ptr<iir::StencilInstantiation>& instantiation_;
   const iir::StencilMetaInformation& metadata_;
   OptimizerContext& context_;
 
@@ -61,10 +60,10 @@ class ReadWriteCounter : public iir::ASTVisitorForwarding {
   std::unordered_map<int, ReadWriteAccumulator> individualReadWrites_;
 
 public:
-  ReadWriteCounter(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
-                   OptimizerContext& context, const iir::MultiStage& multiStage)
-      : instantiation_(instantiation), metadata_(instantiation->getMetaData()), context_(context),
-        numReads_(0), numWrites_(0), multiStage_(multiStage), fields_(multiStage_.getFields()) {}
+  ReadWriteCounter(const iir::StencilInstantiation& instantiation, OptimizerContext& context,
+                   const iir::MultiStage& multiStage)
+      : metadata_(instantiation.getMetaData()), context_(context), numReads_(0), numWrites_(0),
+        multiStage_(multiStage), fields_(multiStage_.getFields()) {}
 
   std::size_t getNumReads() const { return numReads_; }
   std::size_t getNumWrites() const { return numWrites_; }
@@ -284,7 +283,7 @@ computeReadWriteAccessesLowerBound(iir::StencilInstantiation* instantiation,
 std::unordered_map<int, ReadWriteAccumulator> computeReadWriteAccessesMetricPerAccessID(
     const std::shared_ptr<iir::StencilInstantiation>& instantiation, OptimizerContext& context,
     const iir::MultiStage& multiStage) {
-  ReadWriteCounter readWriteCounter(instantiation, context, multiStage);
+  ReadWriteCounter readWriteCounter(*instantiation, context, multiStage);
 
   for(const auto& statementAccessesPair : iterateIIROver<iir::StatementAccessesPair>(multiStage)) {
     statementAccessesPair->getStatement()->accept(readWriteCounter);
@@ -297,6 +296,12 @@ std::unordered_map<int, ReadWriteAccumulator> computeReadWriteAccessesMetricPerA
 std::pair<int, int>
 computeReadWriteAccessesMetric(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
                                OptimizerContext& context, const iir::MultiStage& multiStage) {
+  return computeReadWriteAccessesMetric(*instantiation, context, multiStage);
+}
+
+std::pair<int, int> computeReadWriteAccessesMetric(const iir::StencilInstantiation& instantiation,
+                                                   OptimizerContext& context,
+                                                   const iir::MultiStage& multiStage) {
   ReadWriteCounter readWriteCounter(instantiation, context, multiStage);
 
   for(const auto& statementAccessesPair : iterateIIROver<iir::StatementAccessesPair>(multiStage)) {
@@ -306,8 +311,39 @@ computeReadWriteAccessesMetric(const std::shared_ptr<iir::StencilInstantiation>&
   return std::make_pair(readWriteCounter.getNumReads(), readWriteCounter.getNumWrites());
 }
 
+/// @brief Approximate the reads and writes of the Do-Methods if they were executed in one stage
+std::pair<int, int> computeReadWriteAccessesMetric(
+    const iir::StencilInstantiation& instantiation, OptimizerContext& context,
+    const iir::MultiStage& multiStage, const std::vector<const iir::DoMethod*>& doMethods) {
+  ReadWriteCounter readWriteCounter(instantiation, context, multiStage);
+
+  for(const iir::DoMethod* doMethod : doMethods) {
+    for(const auto& statementAccessesPair : doMethod->getChildren()) {
+      statementAccessesPair->getStatement()->accept(readWriteCounter);
+    }
+  }
+
+  return std::make_pair(readWriteCounter.getNumReads(), readWriteCounter.getNumWrites());
+}
+
+/// @brief Approximate the reads and writes of all multi-stages of the stencil
+std::pair<int, int> computeReadWriteAccessesMetric(const iir::StencilInstantiation& instantiation,
+                                                   OptimizerContext& context,
+                                                   const iir::Stencil& stencil) {
+  std::pair<int, int> readAndWrite(0, 0);
+  for(const auto& multiStagePtr : stencil.getChildren()) {
+    auto multiStageReadAndWrite =
+        computeReadWriteAccessesMetric(instantiation, context, *multiStagePtr);
+    readAndWrite.first += multiStageReadAndWrite.first;
+    readAndWrite.second += multiStageReadAndWrite.second;
+  }
+  return readAndWrite;
+}
+
 PassDataLocalityMetric::PassDataLocalityMetric(OptimizerContext& context)
-    : Pass(context, "PassDataLocalityMetric") {}
+    : Pass(context, "PassDataLocalityMetric") {
+  preservedAnalyses_ = PreservedAnalyses::all();
+}
 
 bool PassDataLocalityMetric::run(
     const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
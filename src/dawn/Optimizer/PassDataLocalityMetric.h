@@ -47,6 +47,15 @@ public:
 std::pair<int, int>
 computeReadWriteAccessesMetric(const std::shared_ptr<iir::StencilInstantiation>& instantiation,
                                OptimizerContext& context, const iir::MultiStage& multiStage);
+std::pair<int, int> computeReadWriteAccessesMetric(const iir::StencilInstantiation& instantiation,
+                                                   OptimizerContext& context,
+                                                   const iir::MultiStage& multiStage);
+std::pair<int, int> computeReadWriteAccessesMetric(const iir::StencilInstantiation& instantiation,
+                                                   OptimizerContext& context,
+                                                   const iir::Stencil& stencil);
+std::pair<int, int> computeReadWriteAccessesMetric(
+    const iir::StencilInstantiation& instantiation, OptimizerContext& context,
+    const iir::MultiStage& multiStage, const std::vector<const iir::DoMethod*>& doMethods);
 std::unordered_map<int, ReadWriteAccumulator> computeReadWriteAccessesMetricPerAccessID(
     const std::shared_ptr<iir::StencilInstantiation>& instantiation, OptimizerContext& context,
     const iir::MultiStage& multiStage);
@@ -95,11 +95,11 @@ static void reportRaceCondition(const iir::Stmt& statement,
 } // anonymous namespace
 
 PassFieldVersioning::PassFieldVersioning(OptimizerContext& context)
-    : Pass(context, "PassFieldVersioning", true), numRenames_(0) {}
+    : Pass(context, "PassFieldVersioning", true) {}
 
 bool PassFieldVersioning::run(
     const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
-  numRenames_ = 0;
+  int numRenames = 0;
 
   for(const auto& stencilPtr : stencilInstantiation->getStencils()) {
     iir::Stencil& stencil = *stencilPtr;
@@ -130,7 +130,7 @@ bool PassFieldVersioning::run(
 
           // Try to resolve race-conditions by using double buffering if necessary
           auto rc = fixRaceCondition(stencilInstantiation, newGraph.get(), stencil, doMethod,
-                                     loopOrder, stageIdx, stmtIndex);
+                                     loopOrder, stageIdx, stmtIndex, numRenames);
 
           if(rc == RCKind::RK_Unresolvable) {
             // Nothing we can do ... bail out
@@ -153,7 +153,7 @@ bool PassFieldVersioning::run(
     }
   }
 
-  if(context_.getOptions().ReportPassFieldVersioning && numRenames_ == 0)
+  if(context_.getOptions().ReportPassFieldVersioning && numRenames == 0)
     std::cout << "\nPASS: " << getName() << ": " << stencilInstantiation->getName()
               << ": no rename\n";
   return true;
@@ -162,7 +162,7 @@ bool PassFieldVersioning::run(
 PassFieldVersioning::RCKind PassFieldVersioning::fixRaceCondition(
     const std::shared_ptr<iir::StencilInstantiation> instantiation,
     const iir::DependencyGraphAccesses* graph, iir::Stencil& stencil, iir::DoMethod& doMethod,
-    iir::LoopOrderKind loopOrder, int stageIdx, int index) {
+    iir::LoopOrderKind loopOrder, int stageIdx, int index, int& totalNumRenames) {
   using Vertex = iir::DependencyGraphAccesses::Vertex;
   using Edge = iir::DependencyGraphAccesses::Edge;
 
@@ -184,7 +184,7 @@ PassFieldVersioning::RCKind PassFieldVersioning::fixRaceCondition(
     for(int fromAccessID : scc) {
       std::size_t fromVertexID = graph->getVertexIDFromValue(fromAccessID);
 
-      for(const Edge& edge : *graph->getAdjacencyList()[fromVertexID]) {
+      for(const Edge& edge : graph->getAdjacencyList()[fromVertexID]) {
         if(scc.count(graph->getIDFromVertexID(edge.ToVertexID)) &&
            isHorizontalStencilOrCounterLoopOrderExtent(edge.Data, loopOrder)) {
           isStencilSCC = true;
@@ -204,7 +204,7 @@ PassFieldVersioning::RCKind PassFieldVersioning::fixRaceCondition(
     for(const auto& AccessIDVertexPair : graph->getVertices()) {
       const Vertex& vertex = AccessIDVertexPair.second;
 
-      for(const Edge& edge : *graph->getAdjacencyList()[vertex.VertexID]) {
+      for(const Edge& edge : graph->getAdjacencyList()[vertex.VertexID]) {
         if(edge.FromVertexID == edge.ToVertexID &&
            isHorizontalStencilOrCounterLoopOrderExtent(edge.Data, loopOrder)) {
           stencilSCCs->emplace_back(std::set<int>{vertex.value});
@@ -292,7 +292,7 @@ PassFieldVersioning::RCKind PassFieldVersioning::fixRaceCondition(
   if(context_.getOptions().ReportPassFieldVersioning && numRenames > 0)
     std::cout << "\n";
 
-  numRenames_ += numRenames;
+  totalNumRenames += numRenames;
   return RCKind::RK_Fixed;
 }
 
@@ -32,10 +32,6 @@ class DoMethod;
 /// @see fixRaceCondition
 /// @ingroup optimizer
 class PassFieldVersioning : public Pass {
-
-private:
-  int numRenames_;
-
 public:
   PassFieldVersioning(OptimizerContext& context);
 
@@ -78,10 +74,11 @@ public:
   /// @param loopOrder  Current loop order of the stage
   /// @param stageIdx   @b Linear index of the stage in the stencil
   /// @param stmtIdx    Index of the statement inside the stage
+  /// @param totalNumRenames  Incremented by the number of renamed fields
   RCKind fixRaceCondition(const std::shared_ptr<iir::StencilInstantiation> instantiation,
                           const iir::DependencyGraphAccesses* graph, iir::Stencil& stencil,
                           iir::DoMethod& doMethod, iir::LoopOrderKind loopOrder, int stageIdx,
-                          int stmtIdx);
+                          int stmtIdx, int& totalNumRenames);
 };
 
 } // namespace dawn
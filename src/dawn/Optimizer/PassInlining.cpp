@@ -15,6 +15,7 @@
 #include "dawn/IIR/AST.h"
 #include "dawn/IIR/ASTUtil.h"
 #include "dawn/IIR/ASTVisitor.h"
+#include "dawn/IIR/DeferredUpdate.h"
 #include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/InstantiationHelper.h"
 #include "dawn/IIR/StatementAccessesPair.h"
@@ -521,6 +522,9 @@ bool PassInlining::run(const std::shared_ptr<iir::StencilInstantiation>& stencil
 
   DetectInlineCandiates inliner(strategy_, stencilInstantiation);
 
+  // Replacing a statement would otherwise recompute the derived info of all its ancestors
+  iir::DeferredUpdateScope deferredUpdates;
+
   // Iterate all statements (top -> bottom)
   for(const auto& stagePtr : iterateIIROver<iir::Stage>(*(stencilInstantiation->getIIR()))) {
     iir::Stage& stage = *stagePtr;
@@ -13,17 +13,36 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/Optimizer/PassManager.h"
+#include "dawn/IIR/MultiStage.h"
 #include "dawn/IIR/StencilInstantiation.h"
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/Support/Logging.h"
+#include <algorithm>
 #include <vector>
 
 namespace dawn {
 
+void PassManager::recordDependencyGraphCacheStatistics(
+    const std::string& passName, const iir::DependencyGraphCacheStatistics& statistics) {
+  if(statistics.Hits == 0 && statistics.Extensions == 0 && statistics.Misses == 0)
+    return;
+
+  for(const std::string& prefix :
+      {std::string("dependency_graph_cache."), "dependency_graph_cache." + passName + "."}) {
+    profiler_.incrementCounter(prefix + "hits", statistics.Hits);
+    profiler_.incrementCounter(prefix + "extensions", statistics.Extensions);
+    profiler_.incrementCounter(prefix + "misses", statistics.Misses);
+    profiler_.incrementCounter(prefix + "invalidations", statistics.Invalidations);
+  }
+}
+
 bool PassManager::runAllPassesOnStecilInstantiation(
     OptimizerContext& context, const std::shared_ptr<iir::StencilInstantiation>& instantiation) {
   std::vector<std::string> passesRan;
 
+  // Nothing is known about the analyses of an instantiation entering the pipeline
+  analysisManager_.invalidate(instantiation, PreservedAnalyses::none());
+
   for(auto& pass : passes_) {
     for(const auto& dependency : pass->getDependencies())
       if(std::find(passesRan.begin(), passesRan.end(), dependency) == passesRan.end()) {
@@ -45,28 +64,91 @@ bool PassManager::runAllPassesOnStecilInstantiation(
 bool PassManager::runPassOnStecilInstantiation(
     OptimizerContext& context, const std::shared_ptr<iir::StencilInstantiation>& instantiation,
     Pass* pass) {
+  const auto& computedAnalyses = pass->getComputedAnalyses();
+  if(!computedAnalyses.empty() &&
+     std::all_of(computedAnalyses.begin(), computedAnalyses.end(), [&](AnalysisKind kind) {
+       return analysisManager_.isValid(instantiation, kind);
+     })) {
+    for(auto kind : computedAnalyses)
+      analysisManager_.recordReuse(kind);
+    DAWN_LOG(INFO) << "Skipping " << pass->getName() << " : analyses are up to date";
+    return true;
+  }
+
+  for(auto kind : pass->getRequiredAnalyses())
+    if(!analysisManager_.require(context, instantiation, kind)) {
+      DAWN_LOG(WARNING) << "Computing " << getAnalysisName(kind) << " for " << pass->getName()
+                        << " : FAIL";
+      return false;
+    }
+
   DAWN_LOG(INFO) << "Starting " << pass->getName() << " ...";
 
-  if(!pass->run(instantiation)) {
+  const bool profile = !context.getOptions().PassProfile.empty();
+  PassProfiler::PassRecord record;
+  AllocationStatistics allocationsBefore;
+  iir::DependencyGraphCacheStatistics graphCacheBefore;
+  if(profile) {
+    record.Pass = pass->getName();
+    record.Instantiation = instantiation->getName();
+    record.Thread = std::this_thread::get_id();
+    record.SizeBefore = PassProfiler::computeIIRSize(*instantiation);
+    allocationsBefore = getThreadAllocationStatistics();
+    graphCacheBefore = iir::getThreadDependencyGraphCacheStatistics();
+    record.Start = PassProfiler::Clock::now();
+  }
+
+  const bool success = pass->run(instantiation);
+
+  if(profile) {
+    record.End = PassProfiler::Clock::now();
+    record.Allocations = getThreadAllocationStatistics() - allocationsBefore;
+    record.SizeAfter = PassProfiler::computeIIRSize(*instantiation);
+    profiler_.addRecord(std::move(record));
+    recordDependencyGraphCacheStatistics(
+        pass->getName(), iir::getThreadDependencyGraphCacheStatistics() - graphCacheBefore);
+  }
+
+  if(!success) {
     DAWN_LOG(WARNING) << "Done with " << pass->getName() << " : FAIL";
     return false;
   }
 
   if(context.getOptions().PassVerbose) {
-    instantiation->jsonDump(pass->getName() + "_" + std::to_string(passCounter_[pass->getName()]) +
-                            "_Log.json");
+    int passCount;
+    {
+      std::lock_guard<std::mutex> lock(passCounterMutex_);
+      passCount = passCounter_[pass->getName()];
+    }
+    instantiation->jsonDump(pass->getName() + "_" + std::to_string(passCount) + "_Log.json");
   }
 
   DAWN_ASSERT_MSG(instantiation->getIIR()->checkTreeConsistency(),
                   std::string("Tree consistency check failed for pass" + pass->getName()).c_str());
 
-#ifndef NDEBUG
-  for(const auto& stencil : instantiation->getIIR()->getChildren()) {
-    DAWN_ASSERT(stencil->compareDerivedInfo());
+  const PreservedAnalyses& preserved = pass->getPreservedAnalyses();
+  analysisManager_.invalidate(instantiation, preserved);
+  for(auto kind : computedAnalyses) {
+    analysisManager_.markValid(instantiation, kind);
+    analysisManager_.recordComputation(kind);
   }
+
+  // Passes keep the derived info of the nodes they modify up to date, it only needs to be verified
+  // after passes which modify the IIR
+  if(!preserved.isPreserved(AK_DerivedInfo)) {
+#ifndef NDEBUG
+    for(const auto& stencil : instantiation->getIIR()->getChildren()) {
+      DAWN_ASSERT(stencil->compareDerivedInfo());
+    }
+    profiler_.incrementCounter("analysis.DerivedInfo.verified");
 #endif
+    analysisManager_.markValid(instantiation, AK_DerivedInfo);
+  }
 
-  passCounter_[pass->getName()]++;
+  {
+    std::lock_guard<std::mutex> lock(passCounterMutex_);
+    passCounter_[pass->getName()]++;
+  }
   DAWN_LOG(INFO) << "Done with " << pass->getName() << " : Success";
   return true;
 }
@@ -15,35 +15,50 @@
 #ifndef DAWN_OPTIMIZER_PASSMANAGER_H
 #define DAWN_OPTIMIZER_PASSMANAGER_H
 
+#include "dawn/Optimizer/AnalysisManager.h"
 #include "dawn/Optimizer/Pass.h"
+#include "dawn/Optimizer/PassProfiler.h"
 #include "dawn/Support/NonCopyable.h"
 #include "dawn/Support/STLExtras.h"
 #include <list>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace dawn {
 
 namespace iir {
 class StencilInstantiation;
-}
+struct DependencyGraphCacheStatistics;
+} // namespace iir
 
 /// @brief Handle registering and running of passes
+///
+/// The registered passes may be run on several stencil instantiations concurrently.
 class PassManager : public NonCopyable {
   std::list<std::unique_ptr<Pass>> passes_;
   std::unordered_map<std::string, int> passCounter_;
+  std::mutex passCounterMutex_;
+  PassProfiler profiler_;
+  AnalysisManager analysisManager_;
+
+  /// @brief Add the dependency graph cache lookups of a pass run to the profiler counters
+  void recordDependencyGraphCacheStatistics(const std::string& passName,
+                                            const iir::DependencyGraphCacheStatistics& statistics);
 
 public:
+  PassManager() : analysisManager_(profiler_) {}
+
   /// @brief Create a new pass at the end of the pass list
   template <class T, typename... Args>
   void pushBackPass(Args&&... args) {
-    return passes_.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
+    passes_.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
   };
 
   /// @brief Create a new pass at the start of the pass list
   template <class T, typename... Args>
   void pushFrontPass(Args&&... args) {
-    return passes_.emplace_front(std::make_unique<T>(std::forward<Args>(args)...));
+    passes_.emplace_front(std::make_unique<T>(std::forward<Args>(args)...));
   };
 
   /// @brief Run all passes on the `instantiation`
@@ -57,6 +72,14 @@ public:
                                     const std::shared_ptr<iir::StencilInstantiation>& instantiation,
                                     Pass* pass);
 
+  /// @brief Get the profiler which records the pass runs if `-profile-passes` is set
+  PassProfiler& getProfiler() { return profiler_; }
+  const PassProfiler& getProfiler() const { return profiler_; }
+
+  /// @brief Get the analysis manager which tracks the analyses invalidated by the passes
+  AnalysisManager& getAnalysisManager() { return analysisManager_; }
+  const AnalysisManager& getAnalysisManager() const { return analysisManager_; }
+
   /// @brief Get all registered passes
   std::list<std::unique_ptr<Pass>>& getPasses() { return passes_; }
   const std::list<std::unique_ptr<Pass>>& getPasses() const { return passes_; }
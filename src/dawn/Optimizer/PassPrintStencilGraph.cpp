@@ -22,6 +22,7 @@ namespace dawn {
 PassPrintStencilGraph::PassPrintStencilGraph(OptimizerContext& context)
     : Pass(context, "PassPrintStencilGraph") {
   dependencies_.push_back("PassStageSplitter");
+  preservedAnalyses_ = PreservedAnalyses::all();
 }
 
 bool PassPrintStencilGraph::run(
@@ -0,0 +1,195 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Optimizer/PassProfiler.h"
+#include "dawn/IIR/IIR.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Support/Assert.h"
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+
+namespace dawn {
+
+namespace {
+
+double toMicroseconds(PassProfiler::Clock::duration duration) {
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+void writeJson(const json::json& node, const std::string& filename) {
+  std::ofstream fs(filename, std::ios::out | std::ios::trunc);
+  DAWN_ASSERT_MSG(fs.is_open(), std::string("cannot open file '" + filename + "'").c_str());
+  fs << node.dump(2) << std::endl;
+}
+
+} // anonymous namespace
+
+json::json PassProfiler::IIRSize::jsonDump() const {
+  json::json node;
+  node["stencils"] = Stencils;
+  node["multistages"] = MultiStages;
+  node["stages"] = Stages;
+  node["do_methods"] = DoMethods;
+  node["statements"] = Statements;
+  return node;
+}
+
+PassProfiler::PassProfiler() : start_(Clock::now()) {}
+
+PassProfiler::IIRSize
+PassProfiler::computeIIRSize(const iir::StencilInstantiation& instantiation) {
+  IIRSize size;
+  for(const auto& stencil : instantiation.getIIR()->getChildren()) {
+    size.Stencils++;
+    for(const auto& multiStage : stencil->getChildren()) {
+      size.MultiStages++;
+      for(const auto& stage : multiStage->getChildren()) {
+        size.Stages++;
+        for(const auto& doMethod : stage->getChildren()) {
+          size.DoMethods++;
+          size.Statements += doMethod->getChildren().size();
+        }
+      }
+    }
+  }
+  return size;
+}
+
+void PassProfiler::addRecord(PassRecord record) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  records_.push_back(std::move(record));
+}
+
+void PassProfiler::incrementCounter(const std::string& name, std::int64_t value) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  counters_[name] += value;
+}
+
+std::int64_t PassProfiler::getCounter(const std::string& name) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = counters_.find(name);
+  return it != counters_.end() ? it->second : 0;
+}
+
+std::vector<PassProfiler::PassRecord> PassProfiler::getRecords() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return records_;
+}
+
+json::json PassProfiler::getReport() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  json::json report;
+  report["allocation_counting"] = isAllocationCountingEnabled();
+
+  struct Summary {
+    int Runs = 0;
+    double Time = 0;
+    AllocationStatistics Allocations;
+  };
+  std::vector<std::string> passOrder;
+  std::unordered_map<std::string, Summary> summaries;
+
+  json::json passesJson = json::json::array();
+  for(const PassRecord& record : records_) {
+    json::json recordJson;
+    recordJson["pass"] = record.Pass;
+    recordJson["instantiation"] = record.Instantiation;
+    recordJson["start_us"] = toMicroseconds(record.Start - start_);
+    recordJson["wall_time_us"] = toMicroseconds(record.End - record.Start);
+    recordJson["allocations"] = record.Allocations.Count;
+    recordJson["allocated_bytes"] = record.Allocations.Bytes;
+    recordJson["iir_before"] = record.SizeBefore.jsonDump();
+    recordJson["iir_after"] = record.SizeAfter.jsonDump();
+    passesJson.push_back(recordJson);
+
+    if(!summaries.count(record.Pass))
+      passOrder.push_back(record.Pass);
+    Summary& summary = summaries[record.Pass];
+    summary.Runs++;
+    summary.Time += toMicroseconds(record.End - record.Start);
+    summary.Allocations.Count += record.Allocations.Count;
+    summary.Allocations.Bytes += record.Allocations.Bytes;
+  }
+  report["passes"] = passesJson;
+
+  // Most expensive passes first (ties are kept in pipeline order)
+  std::stable_sort(passOrder.begin(), passOrder.end(),
+                   [&](const std::string& a, const std::string& b) {
+                     return summaries[a].Time > summaries[b].Time;
+                   });
+
+  json::json summaryJson = json::json::array();
+  for(const std::string& pass : passOrder) {
+    const Summary& summary = summaries[pass];
+    json::json passJson;
+    passJson["pass"] = pass;
+    passJson["runs"] = summary.Runs;
+    passJson["wall_time_us"] = summary.Time;
+    passJson["allocations"] = summary.Allocations.Count;
+    passJson["allocated_bytes"] = summary.Allocations.Bytes;
+    summaryJson.push_back(passJson);
+  }
+  report["summary"] = summaryJson;
+
+  json::json countersJson = json::json::object();
+  for(const auto& counter : counters_)
+    countersJson[counter.first] = counter.second;
+  report["counters"] = countersJson;
+
+  return report;
+}
+
+json::json PassProfiler::getChromeTrace() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Chrome expects small integer thread ids
+  std::map<std::thread::id, int> threadIDs;
+
+  json::json events = json::json::array();
+  for(const PassRecord& record : records_) {
+    auto threadIt = threadIDs.emplace(record.Thread, threadIDs.size()).first;
+
+    json::json event;
+    event["name"] = record.Pass;
+    event["cat"] = "pass";
+    event["ph"] = "X";
+    event["ts"] = toMicroseconds(record.Start - start_);
+    event["dur"] = toMicroseconds(record.End - record.Start);
+    event["pid"] = 0;
+    event["tid"] = threadIt->second;
+    event["args"]["instantiation"] = record.Instantiation;
+    event["args"]["allocations"] = record.Allocations.Count;
+    event["args"]["allocated_bytes"] = record.Allocations.Bytes;
+    event["args"]["iir_before"] = record.SizeBefore.jsonDump();
+    event["args"]["iir_after"] = record.SizeAfter.jsonDump();
+    events.push_back(event);
+  }
+
+  json::json trace;
+  trace["traceEvents"] = events;
+  trace["displayTimeUnit"] = "ms";
+  return trace;
+}
+
+void PassProfiler::writeReport(const std::string& filename) const {
+  writeJson(getReport(), filename);
+}
+
+void PassProfiler::writeChromeTrace(const std::string& filename) const {
+  writeJson(getChromeTrace(), filename);
+}
+
+} // namespace dawn
@@ -0,0 +1,111 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_OPTIMIZER_PASSPROFILER_H
+#define DAWN_OPTIMIZER_PASSPROFILER_H
+
+#include "dawn/Support/AllocationCounter.h"
+#include "dawn/Support/Json.h"
+#include "dawn/Support/NonCopyable.h"
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace dawn {
+
+namespace iir {
+class StencilInstantiation;
+}
+
+/// @brief Collects per-pass profiling information of the optimizer
+///
+/// For every run of a pass on a stencil instantiation the wall time, the heap allocations (see
+/// `AllocationCounter.h`) and the size of the IIR before and after the pass are recorded. The
+/// records can be emitted as a JSON report or as a Chrome trace (chrome://tracing).
+///
+/// Records may be added concurrently from several threads.
+/// @ingroup optimizer
+class PassProfiler : NonCopyable {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /// @brief Number of nodes in the IIR of a stencil instantiation
+  struct IIRSize {
+    int Stencils = 0;
+    int MultiStages = 0;
+    int Stages = 0;
+    int DoMethods = 0;
+    int Statements = 0;
+
+    json::json jsonDump() const;
+  };
+
+  /// @brief Profile of a single run of a pass on a stencil instantiation
+  struct PassRecord {
+    std::string Pass;
+    std::string Instantiation;
+    Clock::time_point Start;
+    Clock::time_point End;
+    AllocationStatistics Allocations;
+    IIRSize SizeBefore;
+    IIRSize SizeAfter;
+    std::thread::id Thread;
+  };
+
+private:
+  Clock::time_point start_;
+  std::vector<PassRecord> records_;
+  std::map<std::string, std::int64_t> counters_;
+  mutable std::mutex mutex_;
+
+public:
+  PassProfiler();
+
+  /// @brief Count the nodes of the IIR of `instantiation`
+  static IIRSize computeIIRSize(const iir::StencilInstantiation& instantiation);
+
+  /// @brief Add the profile of a pass run
+  void addRecord(PassRecord record);
+
+  /// @brief Add `value` to the named counter
+  void incrementCounter(const std::string& name, std::int64_t value = 1);
+
+  /// @brief Get the value of the named counter (0 if it was never incremented)
+  std::int64_t getCounter(const std::string& name) const;
+
+  /// @brief Get all records in the order they were added
+  std::vector<PassRecord> getRecords() const;
+
+  /// @brief Get the JSON report
+  ///
+  /// The report contains every record, an aggregated summary per pass (sorted by total wall time)
+  /// and the named counters.
+  json::json getReport() const;
+
+  /// @brief Get the records in the Chrome trace event format
+  json::json getChromeTrace() const;
+
+  /// @brief Write the JSON report to `filename`
+  void writeReport(const std::string& filename) const;
+
+  /// @brief Write the Chrome trace to `filename`
+  void writeChromeTrace(const std::string& filename) const;
+};
+
+} // namespace dawn
+
+#endif
@@ -16,57 +16,187 @@
 #include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/StencilInstantiation.h"
 #include "dawn/Optimizer/OptimizerContext.h"
+#include <algorithm>
+#include <cctype>
+#include <limits>
+#include <sstream>
+#include <vector>
 
 namespace dawn {
 
-PassSetBlockSize::PassSetBlockSize(OptimizerContext& context) : Pass(context, "PassSetBlockSize") {}
+namespace {
 
-bool PassSetBlockSize::run(const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
-  const auto& IIR = stencilInstantiation->getIIR();
+/// @brief Footprint of a multi-stage on a tile at one level
+struct TileFootprint {
+  /// Extents of the IJ-cached temporaries and of the other fields accessed by the multi-stage
+  /// (i.e the extents of the accesses expanded by the extents of the stages)
+  std::vector<iir::Extents> IJCachedFields;
+  std::vector<iir::Extents> Fields;
+
+  /// Number of consecutive levels of a field accessed at one level
+  int VerticalReach = 1;
+};
+
+/// @brief Size in elements of the tile `size` extended by `extents`, the partially used cache lines
+/// at the ends of the rows are accounted for by `lineElements`
+int getTileArea(const std::array<int, 2>& size, const iir::Extents& extents, int lineElements) {
+  return (size[0] + extents[0].Plus - extents[0].Minus + lineElements) *
+         (size[1] + extents[1].Plus - extents[1].Minus);
+}
 
-  std::array<unsigned int, 3> blockSize{0, 0, 0};
-  if(!context_.getOptions().block_size.empty()) {
-    std::string blockSizeStr = context_.getOptions().block_size;
-    std::istringstream idomain_size(blockSizeStr);
-    std::string arg;
-    getline(idomain_size, arg, ',');
-    unsigned int iBlockSize = std::stoi(arg);
-    getline(idomain_size, arg, ',');
-    unsigned int jBlockSize = std::stoi(arg);
-    getline(idomain_size, arg, ',');
-    unsigned int kBlockSize = std::stoi(arg);
-
-    assert(arg.empty());
-
-    blockSize = {iBlockSize, jBlockSize, kBlockSize};
-  } else {
-    bool verticalPattern = true;
-    for(const auto& stage : iterateIIROver<iir::Stage>(*IIR)) {
-      if(!stage->getExtents().isHorizontalPointwise()) {
+} // anonymous namespace
+
+PassSetBlockSize::PassSetBlockSize(OptimizerContext& context, TargetKind target)
+    : Pass(context, "PassSetBlockSize"), target_(target) {
+  preservedAnalyses_ = PreservedAnalyses::all();
+}
+
+std::array<unsigned int, 3> PassSetBlockSize::getGPUBlockSize(const iir::IIR& IIR) {
+  bool verticalPattern = true;
+  for(const auto& stage : iterateIIROver<iir::Stage>(IIR)) {
+    if(!stage->getExtents().isHorizontalPointwise()) {
+      verticalPattern = false;
+    }
+  }
+  for(const auto& stencil : IIR.getChildren()) {
+    for(const auto& fieldP : stencil->getFields()) {
+      const auto& field = fieldP.second;
+
+      auto jExtents = field.field.getExtentsRB()[1];
+      if(jExtents.Plus != 0 || jExtents.Minus != 0) {
         verticalPattern = false;
       }
     }
-    for(const auto& stencil : (*IIR).getChildren()) {
-      for(const auto& fieldP : stencil->getFields()) {
-        const auto& field = fieldP.second;
-
-        auto jExtents = field.field.getExtentsRB()[1];
-        if(jExtents.Plus != 0 || jExtents.Minus != 0) {
-          verticalPattern = false;
-        }
+  }
+
+  // recent generation of GPU architectures show good memory bandwidth with <32,1> block sizes,
+  // but if there are horizontal data dependencies, the redundant accesses across different blocks
+  // limit the performance
+  if(verticalPattern) {
+    return {32, 1, 4};
+  }
+  return {32, 4, 4};
+}
+
+std::array<unsigned int, 3> PassSetBlockSize::getCPUBlockSize(const OptimizerContext& context,
+                                                              const iir::IIR& IIR) {
+  const HardwareConfig& config = context.getHardwareConfiguration();
+  const int lineElements = std::max(1, config.CacheLineSize / config.ElementSize);
+
+  std::vector<TileFootprint> footprints;
+  for(const auto& multiStage : iterateIIROver<iir::MultiStage>(IIR)) {
+    TileFootprint footprint;
+    for(const auto& fieldPair : multiStage->getFields()) {
+      const iir::Extents& extents = fieldPair.second.getExtentsRB();
+      if(multiStage->isCached(fieldPair.first) &&
+         multiStage->getCache(fieldPair.first).getCacheType() == iir::Cache::IJ)
+        footprint.IJCachedFields.push_back(extents);
+      else
+        footprint.Fields.push_back(extents);
+      footprint.VerticalReach =
+          std::max(footprint.VerticalReach, extents[2].Plus - extents[2].Minus + 1);
+    }
+    footprints.push_back(std::move(footprint));
+  }
+
+  // Cost of the tiles fitting into the caches, the tiles are a multiple of a cache line (and hence
+  // of the vector width) in i
+  std::vector<std::pair<std::array<int, 2>, double>> tileCosts;
+  for(int sizeI = lineElements; sizeI <= 32 * lineElements; sizeI *= 2) {
+    for(int sizeJ = 1; sizeJ <= 64; sizeJ *= 2) {
+      const std::array<int, 2> size{sizeI, sizeJ};
+
+      // Elements transferred per grid point, i.e the points of the tile plus its halo which is
+      // computed redundantly
+      bool fits = true;
+      double cost = 0.0;
+      for(const auto& footprint : footprints) {
+        int ijCachedArea = 0, area = 0;
+        for(const auto& extents : footprint.IJCachedFields)
+          ijCachedArea += getTileArea(size, extents, lineElements);
+        for(const auto& extents : footprint.Fields)
+          area += getTileArea(size, extents, lineElements);
+
+        fits &= ijCachedArea * config.ElementSize <= config.L1CacheSize &&
+                (ijCachedArea + area * footprint.VerticalReach) * config.ElementSize <=
+                    config.L2CacheSize;
+        cost += double(ijCachedArea + area) / (sizeI * sizeJ);
       }
+      if(fits)
+        tileCosts.emplace_back(size, cost);
     }
+  }
+
+  // Larger tiles only pay off if they reduce the traffic noticeably, among the tiles within 5% of
+  // the lowest cost the smallest one (i.e the one giving the most parallelism) with the longest
+  // rows is selected
+  std::array<int, 2> bestSize{lineElements, 1};
+  if(!tileCosts.empty()) {
+    double minCost = std::numeric_limits<double>::max();
+    for(const auto& tileCost : tileCosts)
+      minCost = std::min(minCost, tileCost.second);
 
-    // recent generation of GPU architectures show good memory bandwidth with <32,1> block sizes,
-    // but if there are horizontal data dependencies, the redundant accesses across different blocks
-    // limit the performance
-    if(verticalPattern) {
-      blockSize = {32, 1, 4};
-    } else {
-      blockSize = {32, 4, 4};
+    int bestArea = std::numeric_limits<int>::max();
+    for(const auto& tileCost : tileCosts) {
+      const std::array<int, 2>& size = tileCost.first;
+      const int area = size[0] * size[1];
+      if(tileCost.second <= 1.05 * minCost &&
+         (area < bestArea || (area == bestArea && size[0] > bestSize[0]))) {
+        bestSize = size;
+        bestArea = area;
+      }
     }
   }
 
+  // The levels of a block in k of all the fields fit into the L2 cache
+  int levelSize = 0;
+  for(const auto& footprint : footprints) {
+    int area = 0;
+    for(const auto& extents : footprint.IJCachedFields)
+      area += getTileArea(bestSize, extents, lineElements);
+    for(const auto& extents : footprint.Fields)
+      area += getTileArea(bestSize, extents, lineElements);
+    levelSize = std::max(levelSize, area * config.ElementSize);
+  }
+  int sizeK = 1;
+  while(sizeK < 64 && 2 * sizeK * levelSize <= config.L2CacheSize)
+    sizeK *= 2;
+
+  return {static_cast<unsigned int>(bestSize[0]), static_cast<unsigned int>(bestSize[1]),
+          static_cast<unsigned int>(sizeK)};
+}
+
+bool PassSetBlockSize::parseBlockSize(const std::string& str, std::array<unsigned int, 3>& blockSize) {
+  std::istringstream ss(str);
+  std::string component;
+  int dim = 0;
+  while(std::getline(ss, component, ',')) {
+    if(dim == 3 || component.empty() ||
+       !std::all_of(component.begin(), component.end(), [](char c) { return std::isdigit(c); }))
+      return false;
+    // Larger blocks do not make sense, this also rules out overflows
+    if(component.size() > 6 || std::stoul(component) == 0)
+      return false;
+    blockSize[dim++] = static_cast<unsigned int>(std::stoul(component));
+  }
+  return dim == 3 && str.back() != ',';
+}
+
+std::array<unsigned int, 3> PassSetBlockSize::computeBlockSize(const OptimizerContext& context,
+                                                               TargetKind target,
+                                                               const iir::IIR& IIR) {
+  // An invalid `block_size` option is reported by the compiler driver before optimizing
+  std::array<unsigned int, 3> blockSize;
+  if(!context.getOptions().block_size.empty() &&
+     parseBlockSize(context.getOptions().block_size, blockSize))
+    return blockSize;
+  return target == TK_CPU ? getCPUBlockSize(context, IIR) : getGPUBlockSize(IIR);
+}
+
+bool PassSetBlockSize::run(const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
+  const auto& IIR = stencilInstantiation->getIIR();
+
+  const std::array<unsigned int, 3> blockSize = computeBlockSize(context_, target_, *IIR);
   IIR->setBlockSize(blockSize);
 
   if(context_.getOptions().ReportPassSetBlockSize) {
@@ -16,22 +16,64 @@
 #define DAWN_OPTIMIZER_PASSSETBLOCKSIZE_H
 
 #include "dawn/Optimizer/Pass.h"
+#include <array>
+#include <string>
 
 namespace dawn {
+namespace iir {
+class IIR;
+}
 
 /// @brief This Pass computes and assign the block size of each IIR
 ///
-/// This Pass depends on `PassSetBlockSize`.
+/// This Pass depends on `PassSetCaches` and `PassComputeStageExtents`.
+///
+/// Unless a block size is given with the `block_size` option, it is chosen for the target:
+///
+///   - GPUs use fixed blocks of <32,1> or <32,4> threads, depending on whether the stencils have
+///     horizontal data dependencies.
+///   - CPUs execute all the stages of a multi-stage on a tile of the horizontal plane before
+///     proceeding to the next tile (see `cxxopt::CXXOptCodeGen`). The tile size is chosen from a
+///     cache model of the working set of a tile at one level (see `HardwareConfig`): the
+///     IJ-cached temporaries have to fit into the L1 cache, all the fields accessed by a
+///     multi-stage into the L2 cache. Among the fitting tiles, the one transferring the fewest cache
+///     lines per grid point (i.e with the least redundant halo) is selected.
 ///
 /// @ingroup optimizer
 ///
 /// This pass is not necessary to create legal code and is hence not in the debug-group
 class PassSetBlockSize : public Pass {
 public:
-  PassSetBlockSize(OptimizerContext& context);
+  /// @brief Kind of the target the block size is chosen for
+  enum TargetKind {
+    TK_GPU, ///< Blocks of threads of a GPU
+    TK_CPU  ///< Tiles computed by a CPU core
+  };
+
+  PassSetBlockSize(OptimizerContext& context, TargetKind target);
 
   /// @brief Pass implementation
   bool run(const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) override;
+
+  /// @brief Compute the block size of `IIR` for `target`, i.e the `block_size` option if given and
+  /// the heuristic of the target otherwise
+  ///
+  /// The result depends on the stage extents and, for CPUs, on the IJ-caches of the IIR. Passes
+  /// running before `PassSetCaches` (e.g `PassStageMerger`) hence only get an estimate for CPUs.
+  static std::array<unsigned int, 3>
+  computeBlockSize(const OptimizerContext& context, TargetKind target, const iir::IIR& IIR);
+
+  /// @brief Parse a block size given as `<i>,<j>,<k>` (e.g `32,4,4`)
+  ///
+  /// @returns `false` if `str` does not consist of exactly three positive integers
+  static bool parseBlockSize(const std::string& str, std::array<unsigned int, 3>& blockSize);
+
+private:
+  TargetKind target_;
+
+  static std::array<unsigned int, 3> getGPUBlockSize(const iir::IIR& IIR);
+  static std::array<unsigned int, 3> getCPUBlockSize(const OptimizerContext& context,
+                                                     const iir::IIR& IIR);
 };
 
 } // namespace dawn
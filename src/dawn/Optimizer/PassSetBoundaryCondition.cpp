@@ -21,6 +21,7 @@
 #include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/Stencil.h"
 #include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/IIR/StencilLeafIndex.h"
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/Support/Assert.h"
 #include "dawn/Support/Logging.h"
@@ -185,24 +186,27 @@ bool PassSetBoundaryCondition::run(
     StencilIDsVisited_.emplace(stencilID);
   }
 
+  // A map of all the stencils that a given field already applied its boundary conditons to
+  std::unordered_map<std::string, std::vector<int>> StencilBCsApplied;
+
   auto calculateHaloExtents = [&](std::string fieldname) {
     iir::Extents fullExtent{0, 0, 0, 0, 0, 0};
     // Did we already apply a BoundaryCondition for this field?
     // This is the first time we apply a BC to this field, we traverse all stencils that were
     // applied before
     std::unordered_set<int> stencilIDsToVisit(StencilIDsVisited_);
-    if(StencilBCsApplied_.count(fieldname) != 0) {
-      for(int traveresedID : StencilBCsApplied_[fieldname]) {
+    if(StencilBCsApplied.count(fieldname) != 0) {
+      for(int traveresedID : StencilBCsApplied[fieldname]) {
         stencilIDsToVisit.erase(traveresedID);
       }
     }
     for(const auto& stencil : stencilInstantiation->getStencils()) {
       if(stencilIDsToVisit.count(stencil->getStencilID())) {
         fullExtent.merge(analyzeStencilExtents(stencil, metadata.getAccessIDFromName(fieldname)));
-        if(StencilBCsApplied_.count(fieldname) == 0) {
-          StencilBCsApplied_.emplace(fieldname, std::vector<int>{stencil->getStencilID()});
+        if(StencilBCsApplied.count(fieldname) == 0) {
+          StencilBCsApplied.emplace(fieldname, std::vector<int>{stencil->getStencilID()});
         } else {
-          StencilBCsApplied_[fieldname].push_back(stencil->getStencilID());
+          StencilBCsApplied[fieldname].push_back(stencil->getStencilID());
         }
       }
     }
@@ -219,6 +223,8 @@ bool PassSetBoundaryCondition::run(
     }
   };
 
+  std::vector<int> boundaryConditionInserted;
+
   // Loop through all the StmtAccessPair in the stencil forward
   for(const auto& stencilPtr : stencilInstantiation->getStencils()) {
     iir::Stencil& stencil = *stencilPtr;
@@ -226,9 +232,9 @@ bool PassSetBoundaryCondition::run(
     std::unordered_map<int, iir::Extents> stencilDirtyFields;
     stencilDirtyFields.clear();
 
-    for(const auto& stmtAccess : iterateIIROver<iir::StatementAccessesPair>(stencil)) {
+    for(const auto& stmtAccess : iterateStencilOver<iir::StatementAccessesPair>(stencil)) {
 
-      iir::Accesses& acesses = *(stmtAccess->getAccesses());
+      const iir::Accesses& acesses = *(stmtAccess->getAccesses());
       const auto& allReadAccesses = acesses.getReadAccesses();
       const auto& allWriteAccesses = acesses.getWriteAccesses();
 
@@ -302,7 +308,7 @@ bool PassSetBoundaryCondition::run(
         // The boundary condition is applied, the field is clean again
         dirtyFields.erase(originalID);
         // we add it to a vector for output
-        boundaryConditionInserted_.push_back(originalID);
+        boundaryConditionInserted.push_back(originalID);
       }
       // Any write-access requires a halo update once is is read off-center therefore we set
       // the fields to modified
@@ -326,10 +332,10 @@ bool PassSetBoundaryCondition::run(
   // Output
   if(context_.getOptions().ReportBoundaryConditions) {
     std::cout << "\nPASS: " << getName() << ": " << stencilInstantiation->getName() << " :";
-    if(boundaryConditionInserted_.size() == 0) {
+    if(boundaryConditionInserted.size() == 0) {
       std::cout << " No boundary conditions applied\n";
     }
-    for(const auto& ID : boundaryConditionInserted_) {
+    for(const auto& ID : boundaryConditionInserted) {
       std::cout << " Boundary Condition for field '"
                 << stencilInstantiation->getOriginalNameFromAccessID(ID) << "' inserted"
                 << std::endl;
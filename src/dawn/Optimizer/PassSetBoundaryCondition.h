@@ -45,12 +45,6 @@ public:
 
   /// @brief Pass implementation
   bool run(const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) override;
-
-private:
-  std::vector<int> boundaryConditionInserted_;
-
-  /// A map of all the stencils that a given field already applied its boundary conditons to
-  std::unordered_map<std::string, std::vector<int>> StencilBCsApplied_;
 };
 
 } // namespace dawn
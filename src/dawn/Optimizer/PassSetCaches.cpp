@@ -148,7 +148,11 @@ CacheCandidate computeCacheCandidateForMS(iir::Field const& field, bool isTempor
 
 } // anonymous namespace
 
-PassSetCaches::PassSetCaches(OptimizerContext& context) : Pass(context, "PassSetCaches") {}
+PassSetCaches::PassSetCaches(OptimizerContext& context) : Pass(context, "PassSetCaches") {
+  preservedAnalyses_.preserve(AK_StageNames)
+      .preserve(AK_StageDependencyGraph)
+      .preserve(AK_StageExtents);
+}
 
 bool PassSetCaches::run(const std::shared_ptr<iir::StencilInstantiation>& instantiation) {
   const auto& metadata = instantiation->getMetaData();
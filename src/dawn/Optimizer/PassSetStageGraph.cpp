@@ -58,7 +58,8 @@ static bool depends(const iir::Stage& fromStage, const iir::Stage& toStage) {
 
 PassSetStageGraph::PassSetStageGraph(OptimizerContext& context)
     : Pass(context, "PassSetStageGraph") {
-  dependencies_.push_back("PassSetStageName");
+  computedAnalyses_.push_back(AK_StageDependencyGraph);
+  preservedAnalyses_ = PreservedAnalyses::all();
 }
 
 bool PassSetStageGraph::run(
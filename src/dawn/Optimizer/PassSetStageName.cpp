@@ -19,7 +19,10 @@
 namespace dawn {
 
 PassSetStageName::PassSetStageName(OptimizerContext& context)
-    : Pass(context, "PassSetStageName", true) {}
+    : Pass(context, "PassSetStageName", true) {
+  computedAnalyses_.push_back(AK_StageNames);
+  preservedAnalyses_ = PreservedAnalyses::all();
+}
 
 bool PassSetStageName::run(const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
   stencilInstantiation->getIIR()->getStageIDToNameMap().clear();
@@ -71,7 +71,11 @@ bool PassSetSyncStage::requiresSync(const iir::Stage& stage,
   return false;
 }
 
-PassSetSyncStage::PassSetSyncStage(OptimizerContext& context) : Pass(context, "PassSetSyncStage") {}
+PassSetSyncStage::PassSetSyncStage(OptimizerContext& context) : Pass(context, "PassSetSyncStage") {
+  preservedAnalyses_.preserve(AK_StageNames)
+      .preserve(AK_StageDependencyGraph)
+      .preserve(AK_StageExtents);
+}
 
 bool PassSetSyncStage::run(const std::shared_ptr<iir::StencilInstantiation>& instantiation) {
   for(const auto& doMethod : iterateIIROver<iir::DoMethod>(*(instantiation->getIIR()))) {
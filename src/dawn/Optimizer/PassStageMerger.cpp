@@ -18,12 +18,20 @@
 #include "dawn/IIR/StencilInstantiation.h"
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/Optimizer/ReadBeforeWriteConflict.h"
+#include "dawn/Optimizer/StageMergeCostModel.h"
 #include "dawn/Support/FileUtil.h"
+#include <iostream>
+#include <memory>
 
 namespace dawn {
 
-PassStageMerger::PassStageMerger(OptimizerContext& context) : Pass(context, "PassStageMerger") {
-  dependencies_.push_back("PassSetStageGraph");
+PassStageMerger::PassStageMerger(OptimizerContext& context, PassSetBlockSize::TargetKind target)
+    : Pass(context, "PassStageMerger"), target_(target) {
+  requiredAnalyses_.push_back(AK_StageDependencyGraph);
+
+  // The block size of the GPU heuristic depends on the extents of the stages
+  if(context.getOptions().MergeStagesCostModel)
+    requiredAnalyses_.push_back(AK_StageExtents);
 }
 
 bool PassStageMerger::run(const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) {
@@ -60,6 +68,35 @@ bool PassStageMerger::run(const std::shared_ptr<iir::StencilInstantiation>& sten
     if(!MergeStagesOfStencil && !MergeDoMethodsOfStencil)
       continue;
 
+    std::unique_ptr<StageMergeCostModel> costModel;
+    if(context_.getOptions().MergeStagesCostModel)
+      costModel = std::make_unique<StageMergeCostModel>(
+          *stencilInstantiation, context_, stencil,
+          PassSetBlockSize::computeBlockSize(context_, target_, *stencilInstantiation->getIIR()));
+
+    // With the cost model, only merge if the estimated cost of the merged stage is lower than the
+    // one of the separate stages
+    auto isProfitable = [&](const iir::MultiStage& multiStage, const iir::Stage& candidateStage,
+                            const iir::Stage& curStage, const iir::DoMethod& curDoMethod) {
+      if(!costModel)
+        return true;
+
+      StageCost separateCost =
+          costModel->getCostOfSeparateStages(multiStage, candidateStage, curStage, curDoMethod);
+      StageCost mergedCost =
+          costModel->getCostOfMergedStage(multiStage, candidateStage, curStage, curDoMethod);
+      bool profitable = mergedCost.getScore() < separateCost.getScore();
+
+      if(context_.getOptions().ReportPassStageMerger)
+        std::cout << "\nPASS: " << getName() << ": " << stencilInstantiation->getName()
+                  << ": stage " << curStage.getStageID() << " " << curDoMethod.getInterval()
+                  << " into stage " << candidateStage.getStageID() << ": "
+                  << (profitable ? "accepted" : "rejected")
+                  << ": separate: " << separateCost.toString()
+                  << ", merged: " << mergedCost.toString() << std::endl;
+      return profitable;
+    };
+
     // Note that the underyling assumption is that stages in the same multi-stage are guaranteed to
     // have no counter loop-oorder vertical dependencies. We can thus treat each multi-stage in
     // isolation!
@@ -126,7 +163,10 @@ bool PassStageMerger::run(const std::shared_ptr<iir::StencilInstantiation>& sten
                 if(newDepGraph->isDAG() &&
                    !hasHorizontalReadBeforeWriteConflict(newDepGraph.get())) {
 
-                  if(MergeStagesOfStencil) {
+                  if(MergeStagesOfStencil &&
+                     isProfitable(multiStage, candidateStage, curStage, curDoMethod)) {
+                    if(costModel)
+                      costModel->merged(candidateStage, curStage);
                     candidateStage.appendDoMethod(*curDoMethodIt, *candidateDoMethodIt,
                                                   newDepGraph);
                     for(auto& doMethod : candidateStage.getChildren()) {
@@ -143,7 +183,10 @@ bool PassStageMerger::run(const std::shared_ptr<iir::StencilInstantiation>& sten
               }
             } else {
               // Interval does not exists in `candidateStage`, just insert our DoMethod
-              if(MergeDoMethodsOfStencil && MergeDoMethodsOfStage) {
+              if(MergeDoMethodsOfStencil && MergeDoMethodsOfStage &&
+                 isProfitable(multiStage, candidateStage, curStage, curDoMethod)) {
+                if(costModel)
+                  costModel->merged(candidateStage, curStage);
                 candidateStage.addDoMethod(*curDoMethodIt);
                 // CARTO
                 for(auto& doMethod : candidateStage.getChildren()) {
@@ -16,6 +16,7 @@
 #define DAWN_OPTIMIZER_PASSSTAGEMERGER_H
 
 #include "dawn/Optimizer/Pass.h"
+#include "dawn/Optimizer/PassSetBlockSize.h"
 
 namespace dawn {
 
@@ -25,7 +26,18 @@ namespace dawn {
 /// Merging stages is beneficial as it reduces synchronization among the threads (e.g in CUDA a
 /// stage is followed by a `__syncthreads()`).
 ///
-/// This Pass depends on `PassSetStageGraph`.
+/// Merging can however grow the extents of the stage (i.e redundant computations in the halo) and
+/// the number of fields a stage has to keep in registers or shared memory. With
+/// `-merge-stages-cost-model`, a merge is hence only performed if it lowers the cost estimated by
+/// `StageMergeCostModel` and `-report-pass-stage-merger` reports the accepted and rejected merges
+/// with their costs. Otherwise every legal merge is performed.
+///
+/// The redundant computations depend on the block size, which is computed with
+/// `PassSetBlockSize::computeBlockSize` for the `target` from the current stage extents. For GPUs
+/// this is the block size `PassSetBlockSize` will assign. For CPUs the IJ-caches are not set yet
+/// and the tile may thus differ from the final one, unless it is given with `-block-size`.
+///
+/// This Pass depends on `PassSetStageGraph` (and `PassComputeStageExtents` with the cost model).
 ///
 /// @note This pass renders the stage graphs invalid. Run `PassSetStageGraph` to compute them again.
 ///
@@ -34,10 +46,13 @@ namespace dawn {
 /// This pass is not necessary to create legal code and is hence not in the debug-group
 class PassStageMerger : public Pass {
 public:
-  PassStageMerger(OptimizerContext& context);
+  PassStageMerger(OptimizerContext& context, PassSetBlockSize::TargetKind target);
 
   /// @brief Pass implementation
   bool run(const std::shared_ptr<iir::StencilInstantiation>& stencilInstantiation) override;
+
+private:
+  PassSetBlockSize::TargetKind target_;
 };
 
 } // namespace dawn
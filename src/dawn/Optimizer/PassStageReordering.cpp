@@ -26,7 +26,10 @@ namespace dawn {
 PassStageReordering::PassStageReordering(OptimizerContext& context,
                                          ReorderStrategy::ReorderStrategyKind strategy)
     : Pass(context, "PassStageReordering"), strategy_(strategy) {
-  dependencies_.push_back("PassSetStageGraph");
+  requiredAnalyses_.push_back(AK_StageDependencyGraph);
+  // The reordered stencils keep the stage dependency graph (the dependencies between the stages
+  // do not change), the stage names however depend on the position of the stages
+  preservedAnalyses_.preserve(AK_StageDependencyGraph);
 }
 
 bool PassStageReordering::run(
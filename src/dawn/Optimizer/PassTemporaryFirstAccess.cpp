@@ -14,9 +14,9 @@
 
 #include "dawn/Optimizer/PassTemporaryFirstAccess.h"
 #include "dawn/IIR/ASTVisitor.h"
-#include "dawn/IIR/IIRNodeIterator.h"
 #include "dawn/IIR/StatementAccessesPair.h"
 #include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/IIR/StencilLeafIndex.h"
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/Support/IndexRange.h"
 #include <algorithm>
@@ -85,7 +85,8 @@ bool PassTemporaryFirstAccess::run(
     // {AccesID : (isFirstAccessWrite, Stmt)}
     std::unordered_map<int, std::pair<bool, std::shared_ptr<iir::Stmt>>> accessMap;
 
-    for(const auto& stmtAccessesPair : iterateIIROver<iir::StatementAccessesPair>(*stencilPtr)) {
+    for(const auto& stmtAccessesPair :
+        iterateStencilOver<iir::StatementAccessesPair>(*stencilPtr)) {
       const auto& accesses = stmtAccessesPair->getAccesses();
       const auto& astStatement = stmtAccessesPair->getStatement();
 
@@ -19,6 +19,7 @@
 #include "dawn/IIR/StatementAccessesPair.h"
 #include "dawn/IIR/Stencil.h"
 #include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/IIR/StencilLeafIndex.h"
 #include "dawn/Optimizer/OptimizerContext.h"
 #include "dawn/Optimizer/TemporaryHandling.h"
 #include <iostream>
@@ -98,7 +99,8 @@ PassTemporaryType::PassTemporaryType(OptimizerContext& context)
 bool PassTemporaryType::run(const std::shared_ptr<iir::StencilInstantiation>& instantiation) {
   const auto& metadata = instantiation->getMetaData();
 
-  report_.clear();
+  // Collection of reports with tmp promotion/demotion
+  std::vector<Report> reports;
   std::unordered_map<int, Temporary> temporaries;
   std::unordered_set<int> AccessIDs;
 
@@ -111,8 +113,8 @@ bool PassTemporaryType::run(const std::shared_ptr<iir::StencilInstantiation>& in
 
     // Loop over all accesses
     for(const auto& statementAccessesPair :
-        iterateIIROver<iir::StatementAccessesPair>(*stencilPtr)) {
-      auto processAccessMap = [&](const std::unordered_map<int, iir::Extents>& accessMap) {
+        iterateStencilOver<iir::StatementAccessesPair>(*stencilPtr)) {
+      auto processAccessMap = [&](const iir::AccessMap& accessMap) {
         for(const auto& AccessIDExtentPair : accessMap) {
           int AccessID = AccessIDExtentPair.first;
           const iir::Extents& extent = AccessIDExtentPair.second;
@@ -174,7 +176,7 @@ bool PassTemporaryType::run(const std::shared_ptr<iir::StencilInstantiation>& in
           if(context_.getOptions().ReportPassTemporaryType)
             report("promote");
 
-          report_.push_back(Report{accessID, TmpActionMod::promote});
+          reports.push_back(Report{accessID, TmpActionMod::promote});
           promoteLocalVariableToTemporaryField(instantiation.get(), stencilPtr.get(), accessID,
                                                temporary.lifetime_, temporary.type_);
         }
@@ -189,7 +191,7 @@ bool PassTemporaryType::run(const std::shared_ptr<iir::StencilInstantiation>& in
           if(context_.getOptions().ReportPassTemporaryType)
             report("demote");
 
-          report_.push_back(Report{accessID, TmpActionMod::demote});
+          reports.push_back(Report{accessID, TmpActionMod::demote});
           demoteTemporaryFieldToLocalVariable(instantiation.get(), stencilPtr.get(), accessID,
                                               temporary.lifetime_);
         }
@@ -197,7 +199,7 @@ bool PassTemporaryType::run(const std::shared_ptr<iir::StencilInstantiation>& in
     }
     fixTemporariesSpanningMultipleStencils(instantiation.get(), instantiation->getStencils());
 
-    if(!report_.empty()) {
+    if(!reports.empty()) {
       for(const auto& ms : iterateIIROver<iir::MultiStage>(*stencilPtr)) {
         ms->update(iir::NodeUpdateType::levelAndTreeAbove);
       }
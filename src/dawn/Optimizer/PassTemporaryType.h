@@ -73,8 +73,6 @@ public:
     TmpActionMod tmpMod_;
   };
 
-  // collection of reports with tmp promotion/demotion
-  std::vector<Report> report_;
   PassTemporaryType(OptimizerContext& context);
 
   /// @brief Pass implementation
@@ -67,18 +67,27 @@ public:
 };
 
 /// @brief Remap all accesses from `oldAccessID` to `newAccessID` in the `accessesMap`
-static void renameAccessesMaps(std::unordered_map<int, iir::Extents>& accessesMap, int oldAccessID,
-                               int newAccessID) {
-  for(auto it = accessesMap.begin(); it != accessesMap.end();) {
-    if(it->first == oldAccessID) {
-      accessesMap.emplace(newAccessID, it->second);
-      it = accessesMap.erase(it);
-    } else {
-      ++it;
-    }
+static void renameAccessesMaps(iir::AccessMap& accessesMap, int oldAccessID, int newAccessID) {
+  auto it = accessesMap.find(oldAccessID);
+  if(it != accessesMap.end()) {
+    iir::Extents extents = it->second;
+    accessesMap.erase(it);
+    accessesMap.emplace(newAccessID, extents);
   }
 }
 
+/// @brief Remap all accesses from `oldAccessID` to `newAccessID` in the caller (or callee) accesses
+/// of `pair`. The accesses are only copied (if they are shared with a clone) if they contain
+/// `oldAccessID`.
+static void renameAccesses(iir::StatementAccessesPair& pair, bool callee, int oldAccessID,
+                           int newAccessID) {
+  if(!(callee ? pair.getCalleeAccesses() : pair.getCallerAccesses())->hasAccess(oldAccessID))
+    return;
+  const auto& accesses = callee ? pair.getMutableCalleeAccesses() : pair.getMutableCallerAccesses();
+  renameAccessesMaps(accesses->getReadAccesses(), oldAccessID, newAccessID);
+  renameAccessesMaps(accesses->getWriteAccesses(), oldAccessID, newAccessID);
+}
+
 } // anonymous namespace
 
 void renameAccessIDInStmts(
@@ -110,26 +119,16 @@ void renameAccessIDInExpr(iir::StencilInstantiation* instantiation, int oldAcces
 void renameAccessIDInAccesses(
     const iir::StencilMetaInformation* metadata, int oldAccessID, int newAccessID,
     ArrayRef<std::unique_ptr<iir::StatementAccessesPair>> statementAccessesPairs) {
-  for(auto& statementAccessesPair : statementAccessesPairs) {
-    renameAccessesMaps(statementAccessesPair->getAccesses()->getReadAccesses(), oldAccessID,
-                       newAccessID);
-    renameAccessesMaps(statementAccessesPair->getAccesses()->getWriteAccesses(), oldAccessID,
-                       newAccessID);
-  }
+  for(auto& statementAccessesPair : statementAccessesPairs)
+    renameAccesses(*statementAccessesPair, false, oldAccessID, newAccessID);
 }
 
 void renameAccessIDInAccesses(
     iir::StencilFunctionInstantiation* instantiation, int oldAccessID, int newAccessID,
     ArrayRef<std::unique_ptr<iir::StatementAccessesPair>> statementAccessesPairs) {
   for(auto& statementAccessesPair : statementAccessesPairs) {
-    renameAccessesMaps(statementAccessesPair->getCallerAccesses()->getReadAccesses(), oldAccessID,
-                       newAccessID);
-    renameAccessesMaps(statementAccessesPair->getCallerAccesses()->getWriteAccesses(), oldAccessID,
-                       newAccessID);
-    renameAccessesMaps(statementAccessesPair->getCalleeAccesses()->getReadAccesses(), oldAccessID,
-                       newAccessID);
-    renameAccessesMaps(statementAccessesPair->getCalleeAccesses()->getWriteAccesses(), oldAccessID,
-                       newAccessID);
+    renameAccesses(*statementAccessesPair, false, oldAccessID, newAccessID);
+    renameAccesses(*statementAccessesPair, true, oldAccessID, newAccessID);
   }
 }
 
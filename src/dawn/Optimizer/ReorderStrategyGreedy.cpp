@@ -26,15 +26,13 @@
 
 namespace dawn {
 
-/// @brief Check if we can merge the stage into the multi-stage, possibly changing the loop order.
-/// @returns the the enew dependency graphs of the multi-stage (or NULL) and the new loop order
-template <typename ReturnType =
-              std::pair<std::shared_ptr<iir::DependencyGraphAccesses>, iir::LoopOrderKind>>
-ReturnType isMergable(const iir::Stage& stage, iir::LoopOrderKind stageLoopOrder,
-                      const iir::MultiStage& multiStage) {
+std::pair<std::shared_ptr<iir::DependencyGraphAccesses>, iir::LoopOrderKind>
+isMergable(const iir::Stage& stage, iir::LoopOrderKind stageLoopOrder,
+           const iir::MultiStage& multiStage) {
+  using ReturnType = std::pair<std::shared_ptr<iir::DependencyGraphAccesses>, iir::LoopOrderKind>;
   iir::LoopOrderKind multiStageLoopOrder = multiStage.getLoopOrder();
   auto multiStageDependencyGraph =
-      multiStage.getDependencyGraphOfInterval(stage.getEnclosingExtendedInterval());
+      multiStage.getDependencyGraphOfInterval(stage.getEnclosingExtendedInterval())->clone();
 
   // Merge stage into dependency graph
   const iir::DoMethod& doMethod = stage.getSingleDoMethod();
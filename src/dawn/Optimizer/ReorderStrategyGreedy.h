@@ -15,13 +15,25 @@
 #ifndef DAWN_OPTIMIZER_REORDERSTRATEGYGREEDY_H
 #define DAWN_OPTIMIZER_REORDERSTRATEGYGREEDY_H
 
+#include "dawn/IIR/LoopOrder.h"
 #include "dawn/Optimizer/ReorderStrategy.h"
+#include <utility>
 
 namespace dawn {
 
 namespace iir {
 class StencilInstantiation;
-}
+class DependencyGraphAccesses;
+class MultiStage;
+class Stage;
+} // namespace iir
+
+/// @brief Check if we can merge the stage into the multi-stage, possibly changing the loop order.
+/// @returns the the new dependency graph of the multi-stage (or NULL) and the new loop order
+std::pair<std::shared_ptr<iir::DependencyGraphAccesses>, iir::LoopOrderKind>
+isMergable(const iir::Stage& stage, iir::LoopOrderKind stageLoopOrder,
+           const iir::MultiStage& multiStage);
+
 /// @brief Reordering strategy which tries to move each stage upwards as far as possible under the
 /// sole constraint that the extent of any field does not exeed the maximum halo points
 /// @ingroup optimizer
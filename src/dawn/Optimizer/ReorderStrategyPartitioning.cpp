@@ -14,17 +14,266 @@
 
 #include "dawn/Optimizer/ReorderStrategyPartitioning.h"
 #include "dawn/IIR/DependencyGraphAccesses.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/MultiStage.h"
+#include "dawn/IIR/Stencil.h"
 #include "dawn/IIR/StencilInstantiation.h"
 #include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/PassDataLocalityMetric.h"
+#include "dawn/Optimizer/ReorderStrategyGreedy.h"
+#include "dawn/Support/Format.h"
+#include <iostream>
+#include <limits>
+#include <unordered_map>
+#include <vector>
 
 namespace dawn {
 
+namespace {
+
+/// @brief Stages in a legal execution order, each with the loop order of the multi-stage it
+/// comes from
+struct StageSequence {
+  std::vector<const iir::Stage*> Stages;
+  std::vector<iir::LoopOrderKind> LoopOrders;
+
+  void push_back(const iir::Stage* stage, iir::LoopOrderKind loopOrder) {
+    Stages.push_back(stage);
+    LoopOrders.push_back(loopOrder);
+  }
+  int size() const { return Stages.size(); }
+};
+
+/// @brief Legal multi-stage made of a contiguous range of stages
+struct Segment {
+  iir::LoopOrderKind LoopOrder;
+  int Traffic;
+};
+
+/// @brief Cost of the best partition of the first stages into multi-stages
+struct PartitionCost {
+  int Traffic = std::numeric_limits<int>::max();
+  int NumMultiStages = 0;
+  int LastSegmentBegin = -1;
+
+  bool isBetterThan(const PartitionCost& other) const {
+    return Traffic < other.Traffic ||
+           (Traffic == other.Traffic && NumMultiStages < other.NumMultiStages);
+  }
+};
+
+/// @brief Partition of a stage sequence into multi-stages
+struct Partition {
+  PartitionCost Cost;
+  std::vector<int> SegmentBegins; ///< First stage of each multi-stage (followed by the end)
+  std::vector<iir::LoopOrderKind> LoopOrders;
+};
+
+/// @brief Estimate the global-memory traffic of the multi-stage made of the stages
+/// `[first, last]`, i.e every field it accesses is loaded and/or stored once
+///
+/// Temporaries which are only accessed by these stages and have no vertical extent can be kept in
+/// an IJ-cache (see `PassSetCaches`) and do not produce any traffic. Hence every temporary whose
+/// accesses are cut by a multi-stage boundary adds to the traffic, this is what we minimize.
+int estimateTraffic(const iir::StencilMetaInformation& metadata,
+                    const iir::MultiStage& multiStage,
+                    const std::unordered_map<int, std::pair<int, int>>& temporaryStageRanges,
+                    int first, int last) {
+  int traffic = 0;
+  for(const auto& AccessIDFieldPair : multiStage.getFields()) {
+    int AccessID = AccessIDFieldPair.first;
+    const iir::Field& field = AccessIDFieldPair.second;
+
+    if(metadata.isAccessType(iir::FieldAccessType::FAT_StencilTemporary, AccessID) &&
+       field.getExtents().isVerticalPointwise()) {
+      const auto& stageRange = temporaryStageRanges.at(AccessID);
+      if(first <= stageRange.first && stageRange.second <= last)
+        continue;
+    }
+
+    switch(field.getIntend()) {
+    case iir::Field::IK_Output:
+    case iir::Field::IK_Input:
+      traffic += 1;
+      break;
+    case iir::Field::IK_InputOutput:
+      traffic += 2;
+      break;
+    }
+  }
+  return traffic;
+}
+
+/// @brief Print the data locality metric of the partitioned and the greedy stencil
+void reportDataLocality(iir::StencilInstantiation* instantiation, OptimizerContext& context,
+                        const iir::Stencil& partitionedStencil, const iir::Stencil& greedyStencil) {
+  auto partitioned = computeReadWriteAccessesMetric(*instantiation, context, partitionedStencil);
+  auto greedy = computeReadWriteAccessesMetric(*instantiation, context, greedyStencil);
+
+  std::cout << "S-cut partitioning - " << instantiation->getName() << " - Stencil "
+            << partitionedStencil.getStencilID() << ":\n";
+  std::cout << format("  %-22s %15s %15s\n", "", "greedy", "scut");
+  std::cout << format("  %-22s %15i %15i\n", "MultiStages", greedyStencil.getChildren().size(),
+                      partitionedStencil.getChildren().size());
+  std::cout << format("  %-22s %15i %15i\n", "Reads", greedy.first, partitioned.first);
+  std::cout << format("  %-22s %15i %15i\n", "Writes", greedy.second, partitioned.second);
+}
+
+/// @brief Cut the stage sequence into multi-stages such that the estimated traffic is minimal
+/// @returns false if a stage exceeds the maximum number of halo points on its own
+bool partitionStages(iir::StencilInstantiation* instantiation, OptimizerContext& context,
+                     const StageSequence& sequence, Partition& partition) {
+  auto& metadata = instantiation->getMetaData();
+  const int maxBoundaryExtent = context.getOptions().MaxHaloPoints;
+  const int numStages = sequence.size();
+
+  // First and last stage accessing each temporary
+  std::unordered_map<int, std::pair<int, int>> temporaryStageRanges;
+  for(int stageIdx = 0; stageIdx < numStages; ++stageIdx) {
+    for(const auto& AccessIDFieldPair : sequence.Stages[stageIdx]->getFields()) {
+      int AccessID = AccessIDFieldPair.first;
+      if(metadata.isAccessType(iir::FieldAccessType::FAT_StencilTemporary, AccessID))
+        temporaryStageRanges.emplace(AccessID, std::make_pair(stageIdx, stageIdx))
+            .first->second.second = stageIdx;
+    }
+  }
+
+  // Compute all legal multi-stages: `segments[first][i]` is the multi-stage made of the stages
+  // `[first, first + i]`. Stages are appended in the same way as the greedy strategy does, hence a
+  // multi-stage stays legal w.r.t the loop order and the maximum halo points. Once a stage can not
+  // be appended, longer multi-stages starting at `first` are not considered either.
+  std::vector<std::vector<Segment>> segments(numStages);
+  for(int first = 0; first < numStages; ++first) {
+    iir::MultiStage multiStage(metadata, iir::LoopOrderKind::LK_Parallel);
+
+    for(int last = first; last < numStages; ++last) {
+      const iir::Stage& stage = *sequence.Stages[last];
+      const iir::LoopOrderKind stageLoopOrder = sequence.LoopOrders[last];
+      if(!loopOrdersAreCompatible(stageLoopOrder, multiStage.getLoopOrder()))
+        break;
+
+      auto dependencyGraphLoopOrderPair = isMergable(stage, stageLoopOrder, multiStage);
+      auto multiStageDependencyGraph = dependencyGraphLoopOrderPair.first;
+      DAWN_ASSERT_MSG(multiStageDependencyGraph || last != first,
+                      "stage can not be put into an empty multi-stage (this probably means the "
+                      "stage graph contains cycles - i.e is not a DAG!)");
+
+      if(!multiStageDependencyGraph)
+        break;
+
+      if(multiStageDependencyGraph->exceedsMaxBoundaryPoints(maxBoundaryExtent)) {
+        if(last != first)
+          break;
+
+        // The stage exceeds the maximum allowed boundary extents on its own... nothing we can do
+        DiagnosticsBuilder diag(DiagnosticsKind::Error, SourceLocation());
+        diag << "stencil '" << instantiation->getName()
+             << "' exceeds maximum number of allowed halo lines (" << maxBoundaryExtent << ")";
+        context.getDiagnostics().report(diag);
+        return false;
+      }
+
+      multiStage.setLoopOrder(dependencyGraphLoopOrderPair.second);
+      multiStage.insertChild(stage.clone());
+      segments[first].push_back(
+          Segment{multiStage.getLoopOrder(),
+                  estimateTraffic(metadata, multiStage, temporaryStageRanges, first, last)});
+    }
+  }
+
+  // Find the cuts minimizing the total traffic (and then the number of multi-stages) by dynamic
+  // programming over the prefixes of the stages: `costs[end]` is the cost of the best partition of
+  // the stages `[0, end)`.
+  std::vector<PartitionCost> costs(numStages + 1);
+  costs[0].Traffic = 0;
+  for(int first = 0; first < numStages; ++first) {
+    const PartitionCost& prefix = costs[first];
+    for(int i = 0; i < static_cast<int>(segments[first].size()); ++i) {
+      PartitionCost candidate;
+      candidate.Traffic = prefix.Traffic + segments[first][i].Traffic;
+      candidate.NumMultiStages = prefix.NumMultiStages + 1;
+      candidate.LastSegmentBegin = first;
+
+      if(candidate.isBetterThan(costs[first + i + 1]))
+        costs[first + i + 1] = candidate;
+    }
+  }
+
+  partition.Cost = costs[numStages];
+  partition.SegmentBegins.assign(1, numStages);
+  partition.LoopOrders.clear();
+  for(int end = numStages; end > 0; end = costs[end].LastSegmentBegin) {
+    const int first = costs[end].LastSegmentBegin;
+    partition.SegmentBegins.insert(partition.SegmentBegins.begin(), first);
+    partition.LoopOrders.insert(partition.LoopOrders.begin(),
+                                segments[first][end - first - 1].LoopOrder);
+  }
+  return true;
+}
+
+} // anonymous namespace
+
 std::unique_ptr<iir::Stencil>
 ReoderStrategyPartitioning::reorder(iir::StencilInstantiation* instantiation,
                                     const std::unique_ptr<iir::Stencil>& stencilPtr,
                                     OptimizerContext& context) {
-  DAWN_ASSERT("ReoderStrategyPartitioning is not yet implemented");
-  return nullptr;
+  iir::Stencil& stencil = *stencilPtr;
+  auto& metadata = instantiation->getMetaData();
+
+  // The current order of the stages is a topological order of the stage dependency graph. Each
+  // stage keeps the loop order of the multi-stage it comes from.
+  StageSequence sequence;
+  std::unordered_map<int, int> stageIDToIndex;
+  for(const auto& multiStagePtr : stencil.getChildren()) {
+    for(const auto& stagePtr : multiStagePtr->getChildren()) {
+      stageIDToIndex.emplace(stagePtr->getStageID(), sequence.size());
+      sequence.push_back(stagePtr.get(), multiStagePtr->getLoopOrder());
+    }
+  }
+
+  Partition partition;
+  if(!partitionStages(instantiation, context, sequence, partition))
+    return nullptr;
+
+  // The greedy strategy moves the stages upwards along the stage dependency graph, which yields
+  // another topological order. We cut both orders and keep the cheaper partition.
+  auto greedyStencil = ReoderStrategyGreedy().reorder(instantiation, stencilPtr, context);
+  if(!greedyStencil)
+    return nullptr;
+
+  StageSequence greedySequence;
+  for(const auto& stagePtr : iterateIIROver<iir::Stage>(*greedyStencil)) {
+    const int stageIdx = stageIDToIndex.at(stagePtr->getStageID());
+    greedySequence.push_back(sequence.Stages[stageIdx], sequence.LoopOrders[stageIdx]);
+  }
+
+  Partition greedyOrderPartition;
+  if(!partitionStages(instantiation, context, greedySequence, greedyOrderPartition))
+    return nullptr;
+
+  if(greedyOrderPartition.Cost.isBetterThan(partition.Cost)) {
+    sequence = std::move(greedySequence);
+    partition = std::move(greedyOrderPartition);
+  }
+
+  std::unique_ptr<iir::Stencil> newStencil = std::make_unique<iir::Stencil>(
+      metadata, stencil.getStencilAttributes(), stencilPtr->getStencilID());
+  newStencil->setStageDependencyGraph(stencil.getStageDependencyGraph());
+
+  for(std::size_t segmentIdx = 0; segmentIdx < partition.LoopOrders.size(); ++segmentIdx) {
+    newStencil->insertChild(
+        std::make_unique<iir::MultiStage>(metadata, partition.LoopOrders[segmentIdx]));
+
+    const auto& multiStagePtr = newStencil->getChildren().back();
+    for(int stageIdx = partition.SegmentBegins[segmentIdx];
+        stageIdx < partition.SegmentBegins[segmentIdx + 1]; ++stageIdx)
+      multiStagePtr->insertChild(sequence.Stages[stageIdx]->clone());
+  }
+
+  if(context.getOptions().ReportDataLocalityMetric)
+    reportDataLocality(instantiation, context, *newStencil, *greedyStencil);
+
+  return newStencil;
 }
 
 } // namespace dawn
@@ -21,6 +21,12 @@ namespace dawn {
 
 /// @brief Reordering strategy which uses S-cut graph partitioning to reorder the stages and
 /// statements
+///
+/// The stages are laid out in a topological order of the stage dependency graph, which is cut into
+/// multi-stages such that the estimated global-memory traffic is minimal. Every field shared by
+/// stages on both sides of a cut has to be stored and loaded again, while temporaries used within
+/// a single multi-stage can be cached. Only cuts respecting the loop order legality and the
+/// maximum number of halo points are considered.
 /// @ingroup optimizer
 class ReoderStrategyPartitioning : public ReorderStrategy {
 public:
@@ -0,0 +1,181 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Optimizer/StageMergeCostModel.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/PassDataLocalityMetric.h"
+#include "dawn/Support/Format.h"
+#include <algorithm>
+#include <unordered_set>
+
+namespace dawn {
+
+namespace {
+
+/// @brief Width of the extent in the given horizontal dimension
+int getWidth(const iir::Extents& extent, int dim) {
+  return std::max(0, extent[dim].Plus) - std::min(0, extent[dim].Minus);
+}
+
+/// @brief Add the Do-Methods of the stage to `doMethods`
+void appendDoMethods(const iir::Stage& stage, std::vector<const iir::DoMethod*>& doMethods) {
+  for(const auto& doMethodPtr : stage.getChildren())
+    doMethods.push_back(doMethodPtr.get());
+}
+
+} // anonymous namespace
+
+StageCost& StageCost::operator+=(const StageCost& other) {
+  BytesMoved += other.BytesMoved;
+  RedundantComputation += other.RedundantComputation;
+  ResourcePressure += other.ResourcePressure;
+  Synchronization += other.Synchronization;
+  return *this;
+}
+
+std::string StageCost::toString() const {
+  return format("%.2f (bytes %.2f, redundant %.2f, pressure %.2f, sync %.2f)", getScore(),
+                BytesMoved, RedundantComputation, ResourcePressure, Synchronization);
+}
+
+StageMergeCostModel::StageMergeCostModel(const iir::StencilInstantiation& instantiation,
+                                         OptimizerContext& context, const iir::Stencil& stencil,
+                                         const std::array<unsigned int, 3>& blockSize)
+    : instantiation_(instantiation), context_(context), blockSize_(blockSize) {
+  const int numStages = stencil.getNumStages();
+  for(int i = 0; i < numStages; ++i)
+    stageExtents_.emplace(stencil.getStage(i)->getStageID(), iir::Extents(0, 0, 0, 0, 0, 0));
+
+  // Propagate the read extents of the fields backwards to the stages computing them (the same way
+  // `PassComputeStageExtents` does)
+  for(int i = numStages - 1; i >= 0; --i) {
+    const iir::Stage& fromStage = *stencil.getStage(i);
+    const iir::Extents& fromStageExtent = stageExtents_.at(fromStage.getStageID());
+
+    for(const auto& fromFieldPair : fromStage.getFields()) {
+      const iir::Field& fromField = fromFieldPair.second;
+      iir::Extents fieldExtent = fromField.getExtents();
+      fieldExtent.expand(fromStageExtent);
+
+      for(int j = i - 1; j >= 0; --j) {
+        const iir::Stage& toStage = *stencil.getStage(j);
+        auto it = toStage.getFields().find(fromField.getAccessID());
+        if(it == toStage.getFields().end() || it->second.getIntend() == iir::Field::IK_Input)
+          continue;
+
+        iir::Extents& toStageExtent = stageExtents_.at(toStage.getStageID());
+        toStageExtent.merge(fieldExtent);
+        toStageExtent[2] = iir::Extent{0, 0};
+      }
+    }
+  }
+}
+
+StageCost StageMergeCostModel::getCost(const iir::MultiStage& multiStage,
+                                       const std::vector<const iir::DoMethod*>& doMethods,
+                                       const iir::Extents& extent) const {
+  const HardwareConfig& config = context_.getHardwareConfiguration();
+  StageCost cost;
+
+  // Do-Methods of the same interval are executed one after the other at each grid point, values
+  // computed by one of them can be reused by the next. Do-Methods of different intervals are
+  // executed at different k-levels.
+  std::vector<bool> counted(doMethods.size(), false);
+  for(std::size_t i = 0; i < doMethods.size(); ++i) {
+    if(counted[i])
+      continue;
+
+    std::vector<const iir::DoMethod*> sameInterval;
+    for(std::size_t j = i; j < doMethods.size(); ++j) {
+      if(!counted[j] && doMethods[j]->getInterval() == doMethods[i]->getInterval()) {
+        sameInterval.push_back(doMethods[j]);
+        counted[j] = true;
+      }
+    }
+
+    auto readAndWrite =
+        computeReadWriteAccessesMetric(instantiation_, context_, multiStage, sameInterval);
+    cost.BytesMoved += config.ElementSize * (readAndWrite.first + readAndWrite.second);
+  }
+
+  // Every statement is also evaluated in the halo of the stage. We relate the halo to the interior
+  // of a block.
+  const double interior = double(blockSize_[0]) * blockSize_[1];
+  const double withHalo =
+      double(blockSize_[0] + getWidth(extent, 0)) * (blockSize_[1] + getWidth(extent, 1));
+
+  int numStatements = 0;
+  std::unordered_set<int> fields, sharedMemoryFields;
+  for(const iir::DoMethod* doMethod : doMethods) {
+    numStatements += doMethod->getChildren().size();
+
+    for(const auto& AccessIDFieldPair : doMethod->getFields()) {
+      int AccessID = AccessIDFieldPair.first;
+      fields.insert(AccessID);
+
+      // Temporaries accessed with horizontal offsets are candidates for IJ-caches
+      if(instantiation_.getMetaData().isAccessType(iir::FieldAccessType::FAT_StencilTemporary,
+                                                   AccessID) &&
+         !AccessIDFieldPair.second.getExtents().isHorizontalPointwise())
+        sharedMemoryFields.insert(AccessID);
+    }
+  }
+  cost.RedundantComputation =
+      config.StatementCost * numStatements * (withHalo - interior) / interior;
+
+  // Fields which do not fit into the registers (or shared memory) are stored and loaded once more
+  const int spilledFields = std::max(0, int(fields.size()) - config.RegisterMaxFields) +
+                            std::max(0, int(sharedMemoryFields.size()) - config.SMemMaxFields);
+  cost.ResourcePressure = 2.0 * config.ElementSize * spilledFields;
+
+  cost.Synchronization = config.StageSyncCost;
+  return cost;
+}
+
+StageCost StageMergeCostModel::getCostOfSeparateStages(const iir::MultiStage& multiStage,
+                                                       const iir::Stage& stage,
+                                                       const iir::Stage& otherStage,
+                                                       const iir::DoMethod& doMethod) const {
+  std::vector<const iir::DoMethod*> doMethods;
+  appendDoMethods(stage, doMethods);
+
+  StageCost cost = getCost(multiStage, doMethods, getExtent(stage));
+  cost += getCost(multiStage, {&doMethod}, getExtent(otherStage));
+  return cost;
+}
+
+StageCost StageMergeCostModel::getCostOfMergedStage(const iir::MultiStage& multiStage,
+                                                    const iir::Stage& stage,
+                                                    const iir::Stage& otherStage,
+                                                    const iir::DoMethod& doMethod) const {
+  std::vector<const iir::DoMethod*> doMethods;
+  appendDoMethods(stage, doMethods);
+  doMethods.push_back(&doMethod);
+
+  iir::Extents extent = getExtent(stage);
+  extent.merge(getExtent(otherStage));
+  return getCost(multiStage, doMethods, extent);
+}
+
+void StageMergeCostModel::merged(const iir::Stage& stage, const iir::Stage& otherStage) {
+  iir::Extents extent = getExtent(otherStage);
+  stageExtents_.at(stage.getStageID()).merge(extent);
+}
+
+const iir::Extents& StageMergeCostModel::getExtent(const iir::Stage& stage) const {
+  return stageExtents_.at(stage.getStageID());
+}
+
+} // namespace dawn
@@ -0,0 +1,102 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_OPTIMIZER_STAGEMERGECOSTMODEL_H
+#define DAWN_OPTIMIZER_STAGEMERGECOSTMODEL_H
+
+#include "dawn/IIR/Extents.h"
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace dawn {
+
+class OptimizerContext;
+
+namespace iir {
+class DoMethod;
+class MultiStage;
+class Stage;
+class Stencil;
+class StencilInstantiation;
+} // namespace iir
+
+/// @brief Estimated cost of executing Do-Methods in one stage, per grid point in bytes of
+/// global-memory traffic
+/// @ingroup optimizer
+struct StageCost {
+  double BytesMoved = 0;           ///< Reads and writes (see `PassDataLocalityMetric`)
+  double RedundantComputation = 0; ///< Statements evaluated in the halo of the stage
+  double ResourcePressure = 0;     ///< Fields spilled from registers and shared memory
+  double Synchronization = 0;      ///< Synchronization at the end of the stage
+
+  double getScore() const {
+    return BytesMoved + RedundantComputation + ResourcePressure + Synchronization;
+  }
+
+  StageCost& operator+=(const StageCost& other);
+
+  std::string toString() const;
+};
+
+/// @brief Profitability model of merging Do-Methods into stages (see `PassStageMerger`)
+///
+/// The extent of a stage is the horizontal region it has to be computed on such that later stages
+/// can read its outputs. A merged stage is computed on the union of the extents of the merged
+/// stages, i.e merging may introduce redundant computations in the halo. On the other hand merging
+/// saves a synchronization and values computed in the same stage can be kept in registers.
+///
+/// @ingroup optimizer
+class StageMergeCostModel {
+  const iir::StencilInstantiation& instantiation_;
+  OptimizerContext& context_;
+
+  /// Block size the stencil is expected to be executed with
+  std::array<unsigned int, 3> blockSize_;
+
+  /// Horizontal extent of each stage (by StageID)
+  std::unordered_map<int, iir::Extents> stageExtents_;
+
+public:
+  /// @brief Compute the extents of the stages of `stencil`, which will be executed with blocks of
+  /// `blockSize` (see `PassSetBlockSize::computeBlockSize`)
+  StageMergeCostModel(const iir::StencilInstantiation& instantiation, OptimizerContext& context,
+                      const iir::Stencil& stencil, const std::array<unsigned int, 3>& blockSize);
+
+  /// @brief Cost of executing the `doMethods` in one stage computed on `extent`
+  StageCost getCost(const iir::MultiStage& multiStage,
+                    const std::vector<const iir::DoMethod*>& doMethods,
+                    const iir::Extents& extent) const;
+
+  /// @brief Cost of the Do-Methods of `stage` and the separate `doMethod` of another stage
+  StageCost getCostOfSeparateStages(const iir::MultiStage& multiStage, const iir::Stage& stage,
+                                    const iir::Stage& otherStage,
+                                    const iir::DoMethod& doMethod) const;
+
+  /// @brief Cost of `stage` after merging the `doMethod` of `otherStage` into it
+  StageCost getCostOfMergedStage(const iir::MultiStage& multiStage, const iir::Stage& stage,
+                                 const iir::Stage& otherStage,
+                                 const iir::DoMethod& doMethod) const;
+
+  /// @brief Record that a Do-Method of `otherStage` was merged into `stage`
+  void merged(const iir::Stage& stage, const iir::Stage& otherStage);
+
+  /// @brief Get the horizontal extent of the stage
+  const iir::Extents& getExtent(const iir::Stage& stage) const;
+};
+
+} // namespace dawn
+
+#endif
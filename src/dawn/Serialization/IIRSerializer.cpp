@@ -35,7 +35,7 @@ static proto::iir::Extents makeProtoExtents(dawn::iir::Extents const& extents) {
   return protoExtents;
 }
 static void setAccesses(proto::iir::Accesses* protoAccesses,
-                        const std::shared_ptr<iir::Accesses>& accesses) {
+                        const std::shared_ptr<const iir::Accesses>& accesses) {
   auto protoReadAccesses = protoAccesses->mutable_readaccess();
   for(auto IDExtentsPair : accesses->getReadAccesses())
     protoReadAccesses->insert({IDExtentsPair.first, makeProtoExtents(IDExtentsPair.second)});
@@ -209,45 +209,46 @@ void IIRSerializer::serializeMetaData(proto::iir::StencilInstantiation& target,
   }
   // Filling Field: repeated ExprIDPair ExprToAccessID = 2;
   auto& protoExprIDtoAccessID = *protoMetaData->mutable_expridtoaccessid();
-  for(const auto& exprIDToAccessIDPair : metaData.ExprIDToAccessIDMap_) {
+  for(const auto& exprIDToAccessIDPair : *metaData.ExprIDToAccessIDMap_) {
     protoExprIDtoAccessID.insert({exprIDToAccessIDPair.first, exprIDToAccessIDPair.second});
   }
   // Filling Field: repeated StmtIDPair StmtToAccessID = 3;
   auto& protoStmtIDtoAccessID = *protoMetaData->mutable_stmtidtoaccessid();
-  for(const auto& stmtIDToAccessIDPair : metaData.StmtIDToAccessIDMap_) {
+  for(const auto& stmtIDToAccessIDPair : *metaData.StmtIDToAccessIDMap_) {
     protoStmtIDtoAccessID.insert({stmtIDToAccessIDPair.first, stmtIDToAccessIDPair.second});
   }
   // Filling Field: repeated AccessIDType = 4;
   auto& protoAccessIDType = *protoMetaData->mutable_accessidtotype();
-  for(const auto& accessIDTypePair : metaData.fieldAccessMetadata_.accessIDType_) {
+  for(const auto& accessIDTypePair : metaData.fieldAccessMetadata_->accessIDType_) {
     protoAccessIDType.insert({accessIDTypePair.first, (int)accessIDTypePair.second});
   }
   // Filling Field: map<int32, string> LiteralIDToName = 5;
   auto& protoLiteralIDToNameMap = *protoMetaData->mutable_literalidtoname();
-  for(const auto& literalIDtoNamePair : metaData.fieldAccessMetadata_.LiteralAccessIDToNameMap_) {
+  for(const auto& literalIDtoNamePair :
+      metaData.fieldAccessMetadata_->LiteralAccessIDToNameMap_) {
     protoLiteralIDToNameMap.insert({literalIDtoNamePair.first, literalIDtoNamePair.second});
   }
   // Filling Field: repeated int32 FieldAccessIDs = 6;
-  for(int fieldAccessID : metaData.fieldAccessMetadata_.FieldAccessIDSet_) {
+  for(int fieldAccessID : metaData.fieldAccessMetadata_->FieldAccessIDSet_) {
     protoMetaData->add_fieldaccessids(fieldAccessID);
   }
   // Filling Field: repeated int32 APIFieldIDs = 7;
-  for(int apifieldID : metaData.fieldAccessMetadata_.apiFieldIDs_) {
+  for(int apifieldID : metaData.fieldAccessMetadata_->apiFieldIDs_) {
     protoMetaData->add_apifieldids(apifieldID);
   }
   // Filling Field: repeated int32 TemporaryFieldIDs = 8;
-  for(int temporaryFieldID : metaData.fieldAccessMetadata_.TemporaryFieldAccessIDSet_) {
+  for(int temporaryFieldID : metaData.fieldAccessMetadata_->TemporaryFieldAccessIDSet_) {
     protoMetaData->add_temporaryfieldids(temporaryFieldID);
   }
   // Filling Field: repeated int32 GlobalVariableIDs = 9;
-  for(int globalVariableID : metaData.fieldAccessMetadata_.GlobalVariableAccessIDSet_) {
+  for(int globalVariableID : metaData.fieldAccessMetadata_->GlobalVariableAccessIDSet_) {
     protoMetaData->add_globalvariableids(globalVariableID);
   }
 
   // Filling Field: VariableVersions versionedFields = 10;
   auto protoVariableVersions = protoMetaData->mutable_versionedfields();
   auto& protoVariableVersionMap = *protoVariableVersions->mutable_variableversionmap();
-  auto variableVersions = metaData.fieldAccessMetadata_.variableVersions_;
+  const auto& variableVersions = metaData.fieldAccessMetadata_->variableVersions_;
   for(const auto& IDtoVectorOfVersionsPair : variableVersions.getvariableVersionsMap()) {
     proto::iir::AllVersionedFields protoFieldVersions;
     for(int id : *(IDtoVectorOfVersionsPair.second)) {
@@ -292,7 +293,7 @@ void IIRSerializer::serializeMetaData(proto::iir::StencilInstantiation& target,
         {boundaryCallToExtent.first->getID(), makeProtoExtents(boundaryCallToExtent.second)});
 
   // Filling Field: dawn.proto.statements.SourceLocation stencilLocation = 15;
-  for(auto allocatedFieldID : metaData.fieldAccessMetadata_.AllocatedFieldAccessIDSet_) {
+  for(auto allocatedFieldID : metaData.fieldAccessMetadata_->AllocatedFieldAccessIDSet_) {
     protoMetaData->add_allocatedfieldids(allocatedFieldID);
   }
 
@@ -518,36 +519,38 @@ void IIRSerializer::deserializeMetaData(std::shared_ptr<iir::StencilInstantiatio
     metadata.addAccessIDNamePair(IDtoName.first, IDtoName.second);
   }
 
+  auto& exprIDToAccessIDMap = metadata.ExprIDToAccessIDMap_.mutate();
   for(auto exprIDToAccessID : protoMetaData.expridtoaccessid()) {
-    metadata.ExprIDToAccessIDMap_[exprIDToAccessID.first] = exprIDToAccessID.second;
+    exprIDToAccessIDMap[exprIDToAccessID.first] = exprIDToAccessID.second;
   }
+  auto& stmtIDToAccessIDMap = metadata.StmtIDToAccessIDMap_.mutate();
   for(auto stmtIDToAccessID : protoMetaData.stmtidtoaccessid()) {
-    metadata.StmtIDToAccessIDMap_[stmtIDToAccessID.first] = stmtIDToAccessID.second;
+    stmtIDToAccessIDMap[stmtIDToAccessID.first] = stmtIDToAccessID.second;
   }
 
+  auto& fieldAccessMetadata = metadata.fieldAccessMetadata_.mutate();
   for(auto accessIDTypePair : protoMetaData.accessidtotype()) {
-    metadata.fieldAccessMetadata_.accessIDType_.emplace(
-        accessIDTypePair.first, (iir::FieldAccessType)accessIDTypePair.second);
+    fieldAccessMetadata.accessIDType_.emplace(accessIDTypePair.first,
+                                              (iir::FieldAccessType)accessIDTypePair.second);
   }
 
   for(auto literalIDToName : protoMetaData.literalidtoname()) {
-    metadata.fieldAccessMetadata_.LiteralAccessIDToNameMap_[literalIDToName.first] =
-        literalIDToName.second;
+    fieldAccessMetadata.LiteralAccessIDToNameMap_[literalIDToName.first] = literalIDToName.second;
   }
   for(auto fieldaccessID : protoMetaData.fieldaccessids()) {
-    metadata.fieldAccessMetadata_.FieldAccessIDSet_.insert(fieldaccessID);
+    fieldAccessMetadata.FieldAccessIDSet_.insert(fieldaccessID);
   }
   for(auto ApiFieldID : protoMetaData.apifieldids()) {
-    metadata.fieldAccessMetadata_.apiFieldIDs_.push_back(ApiFieldID);
+    fieldAccessMetadata.apiFieldIDs_.push_back(ApiFieldID);
   }
   for(auto temporaryFieldID : protoMetaData.temporaryfieldids()) {
-    metadata.fieldAccessMetadata_.TemporaryFieldAccessIDSet_.insert(temporaryFieldID);
+    fieldAccessMetadata.TemporaryFieldAccessIDSet_.insert(temporaryFieldID);
   }
   for(auto globalVariableID : protoMetaData.globalvariableids()) {
-    metadata.fieldAccessMetadata_.GlobalVariableAccessIDSet_.insert(globalVariableID);
+    fieldAccessMetadata.GlobalVariableAccessIDSet_.insert(globalVariableID);
   }
   for(auto allocatedFieldID : protoMetaData.allocatedfieldids()) {
-    metadata.fieldAccessMetadata_.AllocatedFieldAccessIDSet_.insert(allocatedFieldID);
+    fieldAccessMetadata.AllocatedFieldAccessIDSet_.insert(allocatedFieldID);
   }
 
   for(auto variableVersionMap : protoMetaData.versionedfields().variableversionmap()) {
@@ -25,6 +25,7 @@
 #include <fstream>
 #include <google/protobuf/util/json_util.h>
 #include <list>
+#include <mutex>
 #include <stack>
 #include <tuple>
 
@@ -33,6 +34,9 @@ namespace dawn {
 namespace {
 
 /// @brief Singleton logger of Protobuf
+///
+/// SIRs may be deserialized from several threads at once (see `dawnCompileBatch`), hence the
+/// logging stack is guarded by a mutex.
 class ProtobufLogger : public NonCopyable {
 public:
   using LogMessage = std::tuple<google::protobuf::LogLevel, std::string, int, std::string>;
@@ -61,25 +65,30 @@ public:
   }
 
   /// @brief Push a `message` to the logging stack
-  void push(LogMessage message) { logStack_.emplace_back(std::move(message)); }
+  void push(LogMessage message) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    logStack_.emplace_back(std::move(message));
+  }
 
   /// @brief Get a dump of all error messages (in the order of occurence) and reset the internal
   /// logging stack
   std::string getErrorMessagesAndReset() {
+    std::lock_guard<std::mutex> lock(mutex_);
     std::string str = "Protobuf errors (most recent call last):\n\n";
     for(const LogMessage& msg : logStack_)
       if(std::get<0>(msg) >= google::protobuf::LOGLEVEL_ERROR)
-        str += dawn::format("%s:%i: %s\n\n");
+        str += dawn::format("%s:%i: %s\n\n", std::get<1>(msg), std::get<2>(msg), std::get<3>(msg));
     logStack_.clear();
     return str;
   }
 
   /// @brief Initialize and register the Logger
   static void init() {
-    if(instance_)
-      return;
-    instance_ = new ProtobufLogger();
-    google::protobuf::SetLogHandler(ProtobufLogger::LogHandler);
+    static std::once_flag initialized;
+    std::call_once(initialized, [] {
+      instance_ = new ProtobufLogger();
+      google::protobuf::SetLogHandler(ProtobufLogger::LogHandler);
+    });
   }
 
   /// @brief Get the singleton instance of the logger
@@ -87,6 +96,7 @@ public:
 
 private:
   std::list<LogMessage> logStack_;
+  std::mutex mutex_;
 
   static ProtobufLogger* instance_;
 };
@@ -692,4 +702,12 @@ std::shared_ptr<SIR> SIRSerializer::deserializeFromString(const std::string& str
   return deserializeImpl(str, kind);
 }
 
+std::shared_ptr<SIR> SIRSerializer::copy(const SIR* sir) {
+  auto copiedSIR = deserializeImpl(serializeImpl(sir, SK_Byte), SK_Byte);
+  DAWN_ASSERT(copiedSIR->Stencils.size() == sir->Stencils.size());
+  for(std::size_t i = 0; i < sir->Stencils.size(); ++i)
+    copiedSIR->Stencils[i]->Attributes = sir->Stencils[i]->Attributes;
+  return copiedSIR;
+}
+
 } // namespace dawn
@@ -66,6 +66,12 @@ public:
   /// @param kind   The kind of serialization to use when writing to the string (Json or Byte)
   /// @returns JSON formatted strong of `sir`
   static std::string serializeToString(const SIR* sir, SerializationKind kind = SK_Json);
+
+  /// @brief Deep copy of `sir` by a round trip through the byte serialization
+  ///
+  /// The stencil attributes, which are not part of the serialized SIR, are copied as well.
+  /// @returns newly allocated SIR
+  static std::shared_ptr<SIR> copy(const SIR* sir);
 };
 
 } // namespace dawn
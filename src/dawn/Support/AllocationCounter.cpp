@@ -0,0 +1,79 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Support/AllocationCounter.h"
+#include "dawn/Support/Config.h"
+#include <cstdlib>
+#include <new>
+
+namespace dawn {
+
+namespace {
+thread_local std::uint64_t threadAllocationCount = 0;
+thread_local std::uint64_t threadAllocationBytes = 0;
+} // anonymous namespace
+
+bool isAllocationCountingEnabled() {
+#ifdef DAWN_PROFILE_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+}
+
+AllocationStatistics getThreadAllocationStatistics() {
+  return AllocationStatistics{threadAllocationCount, threadAllocationBytes};
+}
+
+#ifdef DAWN_PROFILE_ALLOCATIONS
+
+namespace {
+
+void* countedAllocate(std::size_t size) noexcept {
+  ++threadAllocationCount;
+  threadAllocationBytes += size;
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+void* countedAllocateOrThrow(std::size_t size) {
+  if(void* ptr = countedAllocate(size))
+    return ptr;
+  throw std::bad_alloc();
+}
+
+} // anonymous namespace
+
+#endif
+
+} // namespace dawn
+
+#ifdef DAWN_PROFILE_ALLOCATIONS
+
+void* operator new(std::size_t size) { return dawn::countedAllocateOrThrow(size); }
+void* operator new[](std::size_t size) { return dawn::countedAllocateOrThrow(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return dawn::countedAllocate(size);
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return dawn::countedAllocate(size);
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { std::free(ptr); }
+
+#endif
@@ -0,0 +1,48 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_SUPPORT_ALLOCATIONCOUNTER_H
+#define DAWN_SUPPORT_ALLOCATIONCOUNTER_H
+
+#include <cstdint>
+
+namespace dawn {
+
+/// @brief Number of heap allocations and allocated bytes
+/// @ingroup support
+struct AllocationStatistics {
+  std::uint64_t Count = 0;
+  std::uint64_t Bytes = 0;
+
+  AllocationStatistics operator-(const AllocationStatistics& other) const {
+    return AllocationStatistics{Count - other.Count, Bytes - other.Bytes};
+  }
+};
+
+/// @brief Check if heap allocations are counted
+///
+/// Counting requires Dawn to be configured with `DAWN_PROFILE_ALLOCATIONS`, in which case the
+/// global `operator new` is replaced by a counting version.
+/// @ingroup support
+bool isAllocationCountingEnabled();
+
+/// @brief Get the number of allocations performed by the calling thread so far
+///
+/// The statistics are always zero if allocation counting is disabled.
+/// @ingroup support
+AllocationStatistics getThreadAllocationStatistics();
+
+} // namespace dawn
+
+#endif
@@ -24,6 +24,9 @@
 // Define if this is a Linux platform
 #cmakedefine DAWN_ON_LINUX ${DAWN_ON_LINUX}
 
+// Define if allocations should be counted (see dawn/Support/AllocationCounter.h)
+#cmakedefine DAWN_PROFILE_ALLOCATIONS ${DAWN_PROFILE_ALLOCATIONS}
+
 // Major version of DAWN
 #define DAWN_VERSION_MAJOR ${DAWN_VERSION_MAJOR}
 
@@ -0,0 +1,75 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_SUPPORT_COPYONWRITE_H
+#define DAWN_SUPPORT_COPYONWRITE_H
+
+#include "dawn/Support/Assert.h"
+#include <memory>
+#include <utility>
+
+namespace dawn {
+
+/// @brief Value of type `T` which is shared between copies until one of them is modified
+///
+/// Copying a `CopyOnWrite` is cheap as only a reference to the value is copied. Read access is
+/// provided by `get()`, `operator*` and `operator->` which are all `const`. Write access has to be
+/// requested explicitly with `mutate()`, which first copies the value (with the copy constructor
+/// of `T`) if it is currently shared with another `CopyOnWrite`. Hence a modification never
+/// becomes visible to any of the copies.
+///
+/// References obtained from `get()` stay valid until the next call to `mutate()` on the same
+/// object. The class is not thread-safe: copies sharing a value may only be modified
+/// concurrently if every thread owns its copy.
+///
+/// @ingroup support
+template <class T>
+class CopyOnWrite {
+  std::shared_ptr<T> value_;
+
+public:
+  CopyOnWrite() : value_(std::make_shared<T>()) {}
+  explicit CopyOnWrite(T value) : value_(std::make_shared<T>(std::move(value))) {}
+
+  CopyOnWrite(const CopyOnWrite&) = default;
+  CopyOnWrite(CopyOnWrite&&) = default;
+  CopyOnWrite& operator=(const CopyOnWrite&) = default;
+  CopyOnWrite& operator=(CopyOnWrite&&) = default;
+
+  /// @brief Read access to the (possibly shared) value
+  const T& get() const {
+    DAWN_ASSERT(value_);
+    return *value_;
+  }
+  const T& operator*() const { return get(); }
+  const T* operator->() const { return &get(); }
+
+  /// @brief Write access to the value, copying it first if it is shared
+  T& mutate() {
+    DAWN_ASSERT(value_);
+    if(value_.use_count() > 1)
+      value_ = std::make_shared<T>(*value_);
+    return *value_;
+  }
+
+  /// @brief Check if the value is currently shared with another `CopyOnWrite`
+  bool isShared() const { return value_.use_count() > 1; }
+
+  /// @brief Check if `this` and `other` share the same value
+  bool sharesWith(const CopyOnWrite& other) const { return value_ == other.value_; }
+};
+
+} // namespace dawn
+
+#endif
@@ -0,0 +1,213 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_SUPPORT_DENSEIDMAP_H
+#define DAWN_SUPPORT_DENSEIDMAP_H
+
+#include "dawn/Support/Assert.h"
+#include "dawn/Support/FlatMap.h"
+#include <bitset>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+namespace dawn {
+
+/// @brief Map from integer IDs (e.g the IDs of AST nodes) to values, stored in flat arrays
+///
+/// The IDs of the nodes of a stencil instantiation are drawn from a few contiguous ranges of the
+/// `UIDGenerator`. The map therefore stores the values in pages of consecutive IDs and a lookup is
+/// a binary search over the (few) pages followed by an array access, instead of hashing. Negative
+/// IDs are supported. Iteration order is deterministic but not ascending.
+///
+/// @ingroup support
+template <class T>
+class DenseIDMap {
+  static constexpr unsigned PageBits = 8;
+  static constexpr unsigned PageSize = 1u << PageBits;
+
+  struct Page {
+    T Values[PageSize];
+    std::bitset<PageSize> Present;
+  };
+
+  FlatMap<std::uint32_t, std::unique_ptr<Page>> pages_;
+  std::size_t size_ = 0;
+
+  /// @brief Map the ID to a non-negative index such that IDs of small magnitude stay dense
+  static std::uint32_t toIndex(int id) {
+    return (static_cast<std::uint32_t>(id) << 1) ^ static_cast<std::uint32_t>(id >> 31);
+  }
+  static int toID(std::uint32_t index) {
+    return static_cast<int>((index >> 1) ^ (~(index & 1) + 1));
+  }
+
+  const Page* findPage(std::uint32_t index) const {
+    auto it = pages_.find(index >> PageBits);
+    return it != pages_.end() ? it->second.get() : nullptr;
+  }
+  Page* findPage(std::uint32_t index) {
+    auto it = pages_.find(index >> PageBits);
+    return it != pages_.end() ? it->second.get() : nullptr;
+  }
+  Page& getOrCreatePage(std::uint32_t index) {
+    auto& page = pages_[index >> PageBits];
+    if(!page)
+      page = std::make_unique<Page>();
+    return *page;
+  }
+
+public:
+  /// @brief Forward iterator over the `(ID, value)` pairs
+  class const_iterator {
+    friend class DenseIDMap;
+    using PageIterator = typename FlatMap<std::uint32_t, std::unique_ptr<Page>>::const_iterator;
+
+    PageIterator page_, end_;
+    unsigned offset_;
+
+    const_iterator(PageIterator page, PageIterator end, unsigned offset)
+        : page_(page), end_(end), offset_(offset) {
+      skipEmpty();
+    }
+
+    void skipEmpty() {
+      while(page_ != end_) {
+        while(offset_ < PageSize && !page_->second->Present[offset_])
+          ++offset_;
+        if(offset_ < PageSize)
+          return;
+        ++page_;
+        offset_ = 0;
+      }
+    }
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = std::pair<int, T>;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = value_type;
+
+    value_type operator*() const {
+      return value_type(toID((page_->first << PageBits) | offset_), page_->second->Values[offset_]);
+    }
+
+    const_iterator& operator++() {
+      ++offset_;
+      skipEmpty();
+      return *this;
+    }
+
+    bool operator==(const const_iterator& other) const {
+      return page_ == other.page_ && (page_ == end_ || offset_ == other.offset_);
+    }
+    bool operator!=(const const_iterator& other) const { return !(*this == other); }
+  };
+
+  DenseIDMap() = default;
+  DenseIDMap(DenseIDMap&&) = default;
+  DenseIDMap& operator=(DenseIDMap&&) = default;
+
+  DenseIDMap(const DenseIDMap& other) { *this = other; }
+  DenseIDMap& operator=(const DenseIDMap& other) {
+    if(this == &other)
+      return *this;
+    pages_.clear();
+    for(const auto& page : other.pages_)
+      pages_.emplace(page.first, std::make_unique<Page>(*page.second));
+    size_ = other.size_;
+    return *this;
+  }
+
+  const_iterator begin() const { return const_iterator(pages_.begin(), pages_.end(), 0); }
+  const_iterator end() const { return const_iterator(pages_.end(), pages_.end(), 0); }
+
+  std::size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+
+  void clear() {
+    pages_.clear();
+    size_ = 0;
+  }
+
+  std::size_t count(int id) const { return lookup(id) != nullptr; }
+
+  /// @brief Get a pointer to the value of `id` or `nullptr` if there is none
+  const T* lookup(int id) const {
+    const std::uint32_t index = toIndex(id);
+    const Page* page = findPage(index);
+    const unsigned offset = index & (PageSize - 1);
+    return page && page->Present[offset] ? &page->Values[offset] : nullptr;
+  }
+
+  const T& at(int id) const {
+    const T* value = lookup(id);
+    DAWN_ASSERT_MSG(value, "invalid ID");
+    return *value;
+  }
+
+  /// @brief Insert the value if `id` is not yet present, returns true if the value was inserted
+  bool emplace(int id, const T& value) {
+    const std::uint32_t index = toIndex(id);
+    Page& page = getOrCreatePage(index);
+    const unsigned offset = index & (PageSize - 1);
+    if(page.Present[offset])
+      return false;
+    page.Present[offset] = true;
+    page.Values[offset] = value;
+    size_++;
+    return true;
+  }
+
+  T& operator[](int id) {
+    const std::uint32_t index = toIndex(id);
+    Page& page = getOrCreatePage(index);
+    const unsigned offset = index & (PageSize - 1);
+    if(!page.Present[offset]) {
+      page.Present[offset] = true;
+      page.Values[offset] = T();
+      size_++;
+    }
+    return page.Values[offset];
+  }
+
+  std::size_t erase(int id) {
+    const std::uint32_t index = toIndex(id);
+    Page* page = findPage(index);
+    const unsigned offset = index & (PageSize - 1);
+    if(!page || !page->Present[offset])
+      return 0;
+    page->Present[offset] = false;
+    size_--;
+    return 1;
+  }
+
+  bool operator==(const DenseIDMap& other) const {
+    if(size_ != other.size_)
+      return false;
+    for(const auto& pair : *this) {
+      const T* value = other.lookup(pair.first);
+      if(!value || !(*value == pair.second))
+        return false;
+    }
+    return true;
+  }
+  bool operator!=(const DenseIDMap& other) const { return !(*this == other); }
+};
+
+} // namespace dawn
+
+#endif
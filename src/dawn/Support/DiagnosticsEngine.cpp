@@ -16,12 +16,19 @@
 
 namespace dawn {
 
-void DiagnosticsEngine::report(const DiagnosticsMessage& diag) { queue_.push_back(diag); }
+void DiagnosticsEngine::report(const DiagnosticsMessage& diag) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  queue_.push_back(diag);
+}
 
-void DiagnosticsEngine::report(DiagnosticsMessage&& diag) { queue_.push_back(std::move(diag)); }
+void DiagnosticsEngine::report(DiagnosticsMessage&& diag) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  queue_.push_back(std::move(diag));
+}
 
 void DiagnosticsEngine::report(const DiagnosticsBuilder& diagBuilder) {
-  report(diagBuilder.getMessage(filename_));
+  std::lock_guard<std::mutex> lock(mutex_);
+  queue_.push_back(diagBuilder.getMessage(filename_));
 }
 
 } // namespace dawn
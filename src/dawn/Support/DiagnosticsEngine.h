@@ -18,27 +18,42 @@
 #include "dawn/Support/DiagnosticsMessage.h"
 #include "dawn/Support/DiagnosticsQueue.h"
 #include "dawn/Support/NonCopyable.h"
+#include <mutex>
 
 namespace dawn {
 
 /// @brief Concrete class used to report problems and issues
+///
+/// Diagnostics may be reported concurrently from several threads (e.g while optimizing multiple
+/// stencil instantiations in parallel).
+///
 /// @ingroup compiler
 class DiagnosticsEngine : NonCopyable {
   std::string filename_;
   DiagnosticsQueue queue_;
+  mutable std::mutex mutex_;
 
 public:
   /// @brief Clear the diagnostic queue
-  void clear() { queue_.clear(); }
+  void clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.clear();
+  }
 
   /// @brief Check if there are any diagnostics
   bool hasDiags() const { return hasErrors() || hasWarnings(); }
 
   /// @brief Check if there are any warnings
-  bool hasWarnings() const { return queue_.hasWarnings(); }
+  bool hasWarnings() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.hasWarnings();
+  }
 
   /// @brief Check if there are any errors
-  bool hasErrors() const { return queue_.hasErrors(); }
+  bool hasErrors() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.hasErrors();
+  }
 
   /// @brief Get the diagnostics queue
   const DiagnosticsQueue& getQueue() const { return queue_; }
@@ -49,7 +64,10 @@ public:
   void report(DiagnosticsMessage&& diag);
 
   /// @brief Set the name of the file currently being processed
-  void setFilename(const std::string& filename) { filename_ = filename; }
+  void setFilename(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    filename_ = filename;
+  }
 };
 
 } // namespace dawn
@@ -0,0 +1,134 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_SUPPORT_FLATMAP_H
+#define DAWN_SUPPORT_FLATMAP_H
+
+#include "dawn/Support/Assert.h"
+#include <algorithm>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace dawn {
+
+/// @brief Associative container storing its elements in a vector sorted by key
+///
+/// Intended for small maps (e.g the accesses of a statement) where a lookup via binary search in
+/// contiguous memory beats hashing and the per-element allocations of `std::unordered_map`.
+/// Iteration is in ascending key order. Inserting or erasing invalidates all iterators. The key of
+/// an element must not be modified through an iterator.
+///
+/// @ingroup support
+template <class Key, class T>
+class FlatMap {
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<Key, T>;
+  using size_type = std::size_t;
+  using iterator = typename std::vector<value_type>::iterator;
+  using const_iterator = typename std::vector<value_type>::const_iterator;
+
+private:
+  std::vector<value_type> data_;
+
+  struct KeyCompare {
+    bool operator()(const value_type& value, const Key& key) const { return value.first < key; }
+  };
+
+  iterator lowerBound(const Key& key) {
+    return std::lower_bound(data_.begin(), data_.end(), key, KeyCompare());
+  }
+  const_iterator lowerBound(const Key& key) const {
+    return std::lower_bound(data_.begin(), data_.end(), key, KeyCompare());
+  }
+
+public:
+  FlatMap() = default;
+  FlatMap(std::initializer_list<value_type> values) {
+    for(const auto& value : values)
+      insert(value);
+  }
+
+  iterator begin() { return data_.begin(); }
+  iterator end() { return data_.end(); }
+  const_iterator begin() const { return data_.begin(); }
+  const_iterator end() const { return data_.end(); }
+
+  bool empty() const { return data_.empty(); }
+  size_type size() const { return data_.size(); }
+  void clear() { data_.clear(); }
+  void reserve(size_type size) { data_.reserve(size); }
+
+  iterator find(const Key& key) {
+    auto it = lowerBound(key);
+    return it != data_.end() && it->first == key ? it : data_.end();
+  }
+  const_iterator find(const Key& key) const {
+    auto it = lowerBound(key);
+    return it != data_.end() && it->first == key ? it : data_.end();
+  }
+
+  size_type count(const Key& key) const { return find(key) != end(); }
+
+  T& at(const Key& key) {
+    auto it = find(key);
+    if(it == end())
+      throw std::out_of_range("FlatMap::at");
+    return it->second;
+  }
+  const T& at(const Key& key) const {
+    auto it = find(key);
+    if(it == end())
+      throw std::out_of_range("FlatMap::at");
+    return it->second;
+  }
+
+  /// @brief Insert the element if the key is not yet present (like `std::map::emplace`)
+  template <class... Args>
+  std::pair<iterator, bool> emplace(const Key& key, Args&&... args) {
+    auto it = lowerBound(key);
+    if(it != data_.end() && it->first == key)
+      return std::make_pair(it, false);
+    return std::make_pair(
+        data_.emplace(it, std::piecewise_construct, std::forward_as_tuple(key),
+                      std::forward_as_tuple(std::forward<Args>(args)...)),
+        true);
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace(value.first, value.second);
+  }
+
+  T& operator[](const Key& key) { return emplace(key).first->second; }
+
+  iterator erase(const_iterator it) { return data_.erase(it); }
+  size_type erase(const Key& key) {
+    auto it = find(key);
+    if(it == end())
+      return 0;
+    data_.erase(it);
+    return 1;
+  }
+
+  bool operator==(const FlatMap& other) const { return data_ == other.data_; }
+  bool operator!=(const FlatMap& other) const { return data_ != other.data_; }
+};
+
+} // namespace dawn
+
+#endif
@@ -13,7 +13,56 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/Support/IndexGenerator.h"
+
 namespace dawn {
-std::unique_ptr<IndexGenerator> IndexGenerator::instance;
+
+namespace {
+thread_local IndexGenerator::Scope* currentScope = nullptr;
+} // anonymous namespace
+
+IndexGenerator::Scope::Scope(long unsigned int base, long unsigned int size)
+    : next_(base), end_(base + size), parent_(currentScope) {
+  currentScope = this;
+}
+
+IndexGenerator::Scope::~Scope() { currentScope = parent_; }
+
+long unsigned int IndexGenerator::Scope::getIndex() {
+  DAWN_ASSERT_MSG(next_ < end_, "IndexGenerator::Scope: reserved range of indices exhausted");
+  return next_++;
+}
+
+IndexGenerator& IndexGenerator::Instance() {
+  static IndexGenerator* instance = new IndexGenerator;
+  return *instance;
+}
+
+long unsigned int IndexGenerator::getIndex() {
+  if(currentScope)
+    return currentScope->getIndex();
+  DAWN_ASSERT(idx_.load() < std::numeric_limits<long unsigned int>::max());
+  return idx_++;
+}
+
+long unsigned int IndexGenerator::peek() const {
+  if(currentScope)
+    return currentScope->next_;
+  return idx_.load();
+}
+
+long unsigned int IndexGenerator::getNumAvailable() const {
+  if(currentScope)
+    return currentScope->end_ - currentScope->next_;
+  return std::numeric_limits<long unsigned int>::max() - idx_.load();
+}
+
+void IndexGenerator::set(long unsigned int idx) {
+  if(currentScope) {
+    DAWN_ASSERT_MSG(idx <= currentScope->end_, "IndexGenerator::Scope: index out of range");
+    currentScope->next_ = idx;
+  } else {
+    idx_.store(idx);
+  }
+}
 
 } // namespace dawn
@@ -16,35 +16,60 @@
 #define DAWN_SUPPORT_INDEXGENERATOR_H
 
 #include "dawn/Support/Assert.h"
+#include "dawn/Support/NonCopyable.h"
+#include <atomic>
 #include <limits>
-#include <memory>
 
 namespace dawn {
 
+/// @brief Thread-safe generator of unique indices (starting from @b 0)
+///
+/// Like `UIDGenerator`, a thread can open an `IndexGenerator::Scope` to draw its indices from a
+/// private, pre-reserved range.
 class IndexGenerator {
 private:
   IndexGenerator(const IndexGenerator&) = delete;
   IndexGenerator& operator=(const IndexGenerator&) = delete;
 
-  static std::unique_ptr<IndexGenerator> instance;
-
-  long unsigned int idx_ = 0;
+  std::atomic<long unsigned int> idx_{0};
 
 private:
   IndexGenerator() = default;
 
 public:
-  static IndexGenerator& Instance() {
-    if(!instance)
-      instance.reset(new IndexGenerator);
+  /// @brief Reserve the indices `[base, base + size)` for the current thread
+  class Scope : NonCopyable {
+    long unsigned int next_;
+    long unsigned int end_;
+    Scope* parent_;
+
+    friend class IndexGenerator;
+
+  public:
+    Scope(long unsigned int base, long unsigned int size);
+    ~Scope();
+
+    /// @brief Get the next index of the range
+    long unsigned int getIndex();
+
+    /// @brief Get the first index which has not been handed out yet
+    long unsigned int getNext() const { return next_; }
+  };
+
+  static IndexGenerator& Instance();
+
+  long unsigned int getIndex();
+
+  /// @brief Get the index which will be returned by the next call to `getIndex` (from the active
+  /// `Scope` of the thread, if any)
+  long unsigned int peek() const;
 
-    return *(instance.get());
-  }
+  /// @brief Get the number of indices which can still be handed out by `getIndex` (from the active
+  /// `Scope` of the thread, if any)
+  long unsigned int getNumAvailable() const;
 
-  long unsigned int getIndex() {
-    DAWN_ASSERT(idx_ < std::numeric_limits<long unsigned int>::max());
-    return idx_++;
-  }
+  /// @brief Continue numbering at `idx` (in the active `Scope` of the thread, if any)
+  void set(long unsigned int idx);
 };
 
 } // namespace dawn
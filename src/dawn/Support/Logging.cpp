@@ -17,6 +17,16 @@
 
 namespace dawn {
 
+namespace {
+
+/// @brief Stream of the message currently being assembled by this thread
+std::stringstream& getThreadLocalStream() {
+  thread_local std::stringstream ss;
+  return ss;
+}
+
+} // anonymous namespace
+
 internal::LoggerProxy::LoggerProxy(LoggingLevel level, std::stringstream& ss, const char* file,
                                    int line)
     : level_(level), ss_(ss), file_(file), line_(line) {}
@@ -27,41 +37,42 @@ internal::LoggerProxy::~LoggerProxy() {
   ss_.get().clear();
 }
 
-Logger* Logger::instance_ = nullptr;
-
 Logger::Logger() : logger_(nullptr) {}
 
-void Logger::registerLogger(LoggerInterface* logger) { logger_ = logger; }
+void Logger::registerLogger(LoggerInterface* logger) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  logger_ = logger;
+}
 
 LoggerInterface* Logger::getLogger() { return logger_; }
 
 internal::LoggerProxy Logger::logInfo(const char* file, int line) {
-  return internal::LoggerProxy(LoggingLevel::Info, ss_, file, line);
+  return internal::LoggerProxy(LoggingLevel::Info, getThreadLocalStream(), file, line);
 }
 
 internal::LoggerProxy Logger::logWarning(const char* file, int line) {
-  return internal::LoggerProxy(LoggingLevel::Warning, ss_, file, line);
+  return internal::LoggerProxy(LoggingLevel::Warning, getThreadLocalStream(), file, line);
 }
 
 internal::LoggerProxy Logger::logError(const char* file, int line) {
-  return internal::LoggerProxy(LoggingLevel::Error, ss_, file, line);
+  return internal::LoggerProxy(LoggingLevel::Error, getThreadLocalStream(), file, line);
 }
 
 internal::LoggerProxy Logger::logFatal(const char* file, int line) {
-  return internal::LoggerProxy(LoggingLevel::Fatal, ss_, file, line);
+  return internal::LoggerProxy(LoggingLevel::Fatal, getThreadLocalStream(), file, line);
 }
 
 void Logger::log(LoggingLevel level, const std::string& message, const char* file, int line) {
+  std::lock_guard<std::mutex> lock(mutex_);
   if(logger_ != nullptr) {
     logger_->log(level, message, file, line);
   }
 }
 
 Logger& Logger::getSingleton() {
-  if(instance_ == nullptr) {
-    instance_ = new Logger;
-  }
-  return *instance_;
+  // Initialization of function-local statics is thread-safe
+  static Logger* instance = new Logger;
+  return *instance;
 }
 
 } // namespace dawn
@@ -16,6 +16,7 @@
 #define DAWN_SUPPORT_LOGGING_H
 
 #include <functional>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -92,11 +93,13 @@ public:
 ///   }
 /// @endcode
 ///
+/// Logging is thread-safe: each thread assembles its messages in its own stream and the calls to
+/// the registered Logger are serialized.
+///
 /// @ingroup support
 class Logger {
-  static Logger* instance_;
   LoggerInterface* logger_;
-  std::stringstream ss_;
+  std::mutex mutex_;
 
 public:
   /// @brief Initialize Logger object
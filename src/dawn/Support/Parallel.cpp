@@ -0,0 +1,73 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Support/Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace dawn {
+
+int getNumWorkerThreads(int numThreads) {
+  if(numThreads > 0)
+    return numThreads;
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void parallelFor(std::size_t numTasks, int numThreads,
+                 const std::function<void(std::size_t)>& task) {
+  const std::size_t numWorkers =
+      std::min(numTasks, static_cast<std::size_t>(getNumWorkerThreads(numThreads)));
+
+  if(numWorkers <= 1) {
+    for(std::size_t i = 0; i < numTasks; ++i)
+      task(i);
+    return;
+  }
+
+  std::atomic<std::size_t> nextTask(0);
+  std::atomic<bool> failed(false);
+  std::exception_ptr exception;
+  std::mutex exceptionMutex;
+
+  auto worker = [&]() {
+    for(std::size_t i = nextTask++; i < numTasks && !failed; i = nextTask++) {
+      try {
+        task(i);
+      } catch(...) {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if(!exception)
+          exception = std::current_exception();
+        failed = true;
+      }
+    }
+  };
+
+  // The calling thread participates as one of the workers
+  std::vector<std::thread> threads;
+  for(std::size_t i = 1; i < numWorkers; ++i)
+    threads.emplace_back(worker);
+  worker();
+
+  for(auto& thread : threads)
+    thread.join();
+
+  if(exception)
+    std::rethrow_exception(exception);
+}
+
+} // namespace dawn
@@ -0,0 +1,40 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_SUPPORT_PARALLEL_H
+#define DAWN_SUPPORT_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace dawn {
+
+/// @brief Get the number of worker threads to use if `numThreads` were requested
+///
+/// A request of `numThreads <= 0` is resolved to the number of hardware threads.
+/// @ingroup support
+int getNumWorkerThreads(int numThreads);
+
+/// @brief Invoke `task(i)` for every `i` in `[0, numTasks)` using up to `numThreads` threads
+///
+/// The tasks are handed out in increasing order of their index. If a task throws, the remaining
+/// tasks are skipped and the first exception is rethrown on the calling thread once all workers
+/// have finished. With a single worker (or a single task) everything runs on the calling thread.
+/// @ingroup support
+void parallelFor(std::size_t numTasks, int numThreads,
+                 const std::function<void(std::size_t)>& task);
+
+} // namespace dawn
+
+#endif
@@ -0,0 +1,62 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_SUPPORT_SHA256_H
+#define DAWN_SUPPORT_SHA256_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace dawn {
+
+/// @brief Incremental SHA-256 message digest
+///
+/// Used to compute stable, content-addressed keys (e.g for the compilation cache).
+///
+/// @code
+///   SHA256 sha;
+///   sha.update("foo");
+///   sha.update("bar");
+///   std::string digest = sha.hexDigest(); // == SHA256::hash("foobar")
+/// @endcode
+///
+/// @ingroup support
+class SHA256 {
+  std::array<std::uint32_t, 8> state_;
+  std::array<unsigned char, 64> buffer_;
+  std::uint64_t length_;
+  std::size_t bufferSize_;
+
+  void processBlock(const unsigned char* block);
+
+public:
+  SHA256();
+
+  /// @brief Append `size` bytes of `data` to the message
+  void update(const void* data, std::size_t size);
+  void update(const std::string& data) { update(data.data(), data.size()); }
+
+  /// @brief Finish the computation and return the digest as lowercase hex string
+  ///
+  /// The object must not be updated afterwards.
+  std::string hexDigest();
+
+  /// @brief Compute the digest of `data` as lowercase hex string
+  static std::string hash(const std::string& data);
+};
+
+} // namespace dawn
+
+#endif
@@ -13,18 +13,58 @@
 //===------------------------------------------------------------------------------------------===//
 
 #include "dawn/Support/UIDGenerator.h"
+#include "dawn/Support/Assert.h"
+#include <limits>
 
 namespace dawn {
 
-/* Null, because instance will be initialized on demand. */
-UIDGenerator* UIDGenerator::instance_ = 0;
+namespace {
+thread_local UIDGenerator::Scope* currentScope = nullptr;
+} // anonymous namespace
+
+UIDGenerator::Scope::Scope(int base, int size)
+    : next_(base), end_(base + size), parent_(currentScope) {
+  currentScope = this;
+}
+
+UIDGenerator::Scope::~Scope() { currentScope = parent_; }
+
+int UIDGenerator::Scope::get() {
+  DAWN_ASSERT_MSG(next_ < end_, "UIDGenerator::Scope: reserved range of identifiers exhausted");
+  return next_++;
+}
 
 UIDGenerator* UIDGenerator::getInstance() {
-  if(instance_ == 0) {
-    instance_ = new UIDGenerator();
-  }
+  // Initialization of function-local statics is thread-safe
+  static UIDGenerator* instance = new UIDGenerator();
+  return instance;
+}
 
-  return instance_;
+int UIDGenerator::get() {
+  if(currentScope)
+    return currentScope->get();
+  return counter_++;
+}
+
+int UIDGenerator::peek() const {
+  if(currentScope)
+    return currentScope->next_;
+  return counter_.load();
+}
+
+int UIDGenerator::getNumAvailable() const {
+  if(currentScope)
+    return currentScope->end_ - currentScope->next_;
+  return std::numeric_limits<int>::max() - counter_.load();
+}
+
+void UIDGenerator::set(int counter) {
+  if(currentScope) {
+    DAWN_ASSERT_MSG(counter <= currentScope->end_, "UIDGenerator::Scope: counter out of range");
+    currentScope->next_ = counter;
+  } else {
+    counter_.store(counter);
+  }
 }
 
 } // namespace dawn
@@ -16,22 +16,59 @@
 #define DAWN_SUPPORT_UIDGENERATOR
 
 #include "dawn/Support/NonCopyable.h"
+#include <atomic>
 
 namespace dawn {
 
 /// @brief Unique identifier generator (starting from @b 1)
+///
+/// The generator is safe to use from several threads. To obtain identifiers which do not depend on
+/// the scheduling of the threads, a thread can open a `UIDGenerator::Scope` which redirects all
+/// requests of that thread to a private, pre-reserved range of identifiers.
+///
 /// @ingroup support
 class UIDGenerator : NonCopyable {
-  int counter_;
-  static UIDGenerator* instance_;
+  std::atomic<int> counter_;
 
   UIDGenerator() : counter_(1) {}
 
 public:
+  /// @brief Reserve the identifiers `[base, base + size)` for the current thread
+  ///
+  /// Scopes are nestable; the innermost scope of a thread is the active one.
+  class Scope : NonCopyable {
+    int next_;
+    int end_;
+    Scope* parent_;
+
+    friend class UIDGenerator;
+
+  public:
+    Scope(int base, int size);
+    ~Scope();
+
+    /// @brief Get the next identifier of the range
+    int get();
+
+    /// @brief Get the first identifier which has not been handed out yet
+    int getNext() const { return next_; }
+  };
+
   static UIDGenerator* getInstance();
 
   /// @brief Get a unique *strictly* positive identifer
-  int get() { return (counter_++); }
+  int get();
+
+  /// @brief Get the identifier which will be returned by the next call to `get` (from the active
+  /// `Scope` of the thread, if any)
+  int peek() const;
+
+  /// @brief Get the number of identifiers which can still be handed out by `get` (from the active
+  /// `Scope` of the thread, if any)
+  int getNumAvailable() const;
+
+  /// @brief Continue numbering at `counter` (in the active `Scope` of the thread, if any)
+  void set(int counter);
 
   void reset() { counter_ = 0; }
 };
@@ -0,0 +1,170 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Support/UnixSocket.h"
+#include "dawn/Support/Format.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Writing to a socket closed by the peer must not raise SIGPIPE (on macOS `SO_NOSIGPIPE` is set on
+// the socket instead)
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+namespace dawn {
+
+namespace {
+
+void disableSigPipe(int fd) {
+#ifdef SO_NOSIGPIPE
+  int value = 1;
+  ::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &value, sizeof(value));
+#else
+  (void)fd;
+#endif
+}
+
+sockaddr_un makeAddress(const std::string& path) {
+  sockaddr_un address;
+  std::memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if(path.size() >= sizeof(address.sun_path))
+    throw std::runtime_error(dawn::format("socket path '%s' is too long", path));
+  std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+  return address;
+}
+
+std::runtime_error makeError(const std::string& what, const std::string& path) {
+  return std::runtime_error(dawn::format("%s '%s': %s", what, path, std::strerror(errno)));
+}
+
+} // anonymous namespace
+
+UnixSocket::UnixSocket(UnixSocket&& other) noexcept : fd_(other.fd_) { other.fd_ = -1; }
+
+UnixSocket& UnixSocket::operator=(UnixSocket&& other) noexcept {
+  if(this != &other) {
+    close();
+    fd_ = other.fd_;
+    other.fd_ = -1;
+  }
+  return *this;
+}
+
+UnixSocket::~UnixSocket() { close(); }
+
+UnixSocket UnixSocket::listen(const std::string& path, int backlog) {
+  sockaddr_un address = makeAddress(path);
+
+  UnixSocket socket(::socket(AF_UNIX, SOCK_STREAM, 0));
+  if(!socket.isValid())
+    throw makeError("cannot create socket", path);
+
+  // Replace a stale socket left behind by a server which did not shut down cleanly, but never the
+  // socket of a running server
+  struct stat status;
+  if(::lstat(path.c_str(), &status) == 0 && S_ISSOCK(status.st_mode)) {
+    UnixSocket probe(::socket(AF_UNIX, SOCK_STREAM, 0));
+    if(probe.isValid() &&
+       ::connect(probe.fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0)
+      throw std::runtime_error(dawn::format("socket '%s' is in use by another server", path));
+    ::unlink(path.c_str());
+  }
+
+  if(::bind(socket.fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    throw makeError("cannot bind socket", path);
+  if(::listen(socket.fd_, backlog) != 0)
+    throw makeError("cannot listen on socket", path);
+  return socket;
+}
+
+UnixSocket UnixSocket::connect(const std::string& path) {
+  sockaddr_un address = makeAddress(path);
+
+  UnixSocket socket(::socket(AF_UNIX, SOCK_STREAM, 0));
+  if(!socket.isValid())
+    throw makeError("cannot create socket", path);
+
+  if(::connect(socket.fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+    throw makeError("cannot connect to socket", path);
+  disableSigPipe(socket.fd_);
+  return socket;
+}
+
+UnixSocket UnixSocket::accept() const {
+  int fd;
+  do {
+    fd = ::accept(fd_, nullptr, nullptr);
+  } while(fd < 0 && errno == EINTR);
+  if(fd >= 0)
+    disableSigPipe(fd);
+  return UnixSocket(fd);
+}
+
+bool UnixSocket::sendAll(const void* data, std::size_t size) const {
+  const char* ptr = static_cast<const char*>(data);
+  while(size > 0) {
+    ssize_t sent = ::send(fd_, ptr, size, MSG_NOSIGNAL);
+    if(sent < 0 && errno == EINTR)
+      continue;
+    if(sent <= 0)
+      return false;
+    ptr += sent;
+    size -= sent;
+  }
+  return true;
+}
+
+bool UnixSocket::receiveAll(void* data, std::size_t size) const {
+  char* ptr = static_cast<char*>(data);
+  while(size > 0) {
+    ssize_t received = ::recv(fd_, ptr, size, 0);
+    if(received < 0 && errno == EINTR)
+      continue;
+    if(received <= 0)
+      return false;
+    ptr += received;
+    size -= received;
+  }
+  return true;
+}
+
+void UnixSocket::shutdown() const {
+  if(isValid())
+    ::shutdown(fd_, SHUT_RDWR);
+}
+
+void UnixSocket::setTimeout(int seconds) const {
+  timeval timeout;
+  timeout.tv_sec = seconds;
+  timeout.tv_usec = 0;
+  ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  ::setsockopt(fd_, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+}
+
+void UnixSocket::close() {
+  if(isValid()) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+}
+
+} // namespace dawn
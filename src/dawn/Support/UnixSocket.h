@@ -0,0 +1,79 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_SUPPORT_UNIXSOCKET_H
+#define DAWN_SUPPORT_UNIXSOCKET_H
+
+#include "dawn/Support/NonCopyable.h"
+#include <cstddef>
+#include <string>
+
+namespace dawn {
+
+/// @brief Stream socket in the Unix domain (i.e a local socket identified by a path)
+///
+/// The socket is closed on destruction. Errors while setting up a socket are reported by throwing
+/// `std::runtime_error`, errors while transferring data by returning `false`.
+///
+/// @ingroup support
+class UnixSocket : NonCopyable {
+  int fd_;
+
+public:
+  /// @brief Create an invalid socket
+  UnixSocket() : fd_(-1) {}
+
+  /// @brief Take ownership of the socket file descriptor `fd`
+  explicit UnixSocket(int fd) : fd_(fd) {}
+
+  UnixSocket(UnixSocket&& other) noexcept;
+  UnixSocket& operator=(UnixSocket&& other) noexcept;
+  ~UnixSocket();
+
+  /// @brief Create a socket listening at `path`
+  ///
+  /// A stale socket at `path` (i.e one nobody listens at anymore) is replaced.
+  /// @throws std::runtime_error  Another process listens at `path` or the socket cannot be created
+  static UnixSocket listen(const std::string& path, int backlog = 128);
+
+  /// @brief Connect to the socket listening at `path`
+  static UnixSocket connect(const std::string& path);
+
+  /// @brief Wait for a connection of a client (returns an invalid socket on failure)
+  UnixSocket accept() const;
+
+  /// @brief Send `size` bytes of `data`
+  bool sendAll(const void* data, std::size_t size) const;
+
+  /// @brief Receive exactly `size` bytes into `data`
+  bool receiveAll(void* data, std::size_t size) const;
+
+  /// @brief Abort all blocking operations on the socket (e.g `accept`)
+  ///
+  /// This function is async-signal-safe.
+  void shutdown() const;
+
+  /// @brief Set the timeout of sending and receiving data
+  void setTimeout(int seconds) const;
+
+  /// @brief Close the socket
+  void close();
+
+  /// @brief Check if the socket is valid
+  bool isValid() const { return fd_ >= 0; }
+};
+
+} // namespace dawn
+
+#endif
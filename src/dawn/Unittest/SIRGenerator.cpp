@@ -0,0 +1,153 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Unittest/SIRGenerator.h"
+#include "dawn/SIR/AST.h"
+#include "dawn/SIR/ASTExpr.h"
+#include "dawn/SIR/ASTStmt.h"
+#include "dawn/SIR/SIR.h"
+#include <algorithm>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace dawn {
+
+namespace {
+
+class SIRGenerator {
+  const SIRGeneratorParameters& params_;
+  std::mt19937 rng_;
+
+  int random(int lower, int upper) {
+    return std::uniform_int_distribution<int>(lower, upper)(rng_);
+  }
+
+  static std::string getFieldName(int idx) { return "field_" + std::to_string(idx); }
+  static std::string getStencilFunctionName(int depth) { return "fun_" + std::to_string(depth); }
+
+  std::shared_ptr<sir::Expr> makeFieldAccess(const std::string& name) {
+    return std::make_shared<sir::FieldAccessExpr>(
+        name, Array3i{{random(-params_.OffsetRadius, params_.OffsetRadius),
+                       random(-params_.OffsetRadius, params_.OffsetRadius), 0}});
+  }
+
+  std::shared_ptr<sir::Expr> makeStencilFunctionCall(int depth,
+                                                     std::shared_ptr<sir::Expr> argument) {
+    auto call = std::make_shared<sir::StencilFunCallExpr>(getStencilFunctionName(depth));
+    call->getArguments().push_back(argument);
+    return call;
+  }
+
+  /// @brief fun_d(data) = data[+r] - data[-r] (+ fun_{d-1}(data))
+  std::shared_ptr<sir::StencilFunction> makeStencilFunction(int depth) {
+    auto stencilFunction = std::make_shared<sir::StencilFunction>();
+    stencilFunction->Name = getStencilFunctionName(depth);
+    stencilFunction->Args.push_back(std::make_shared<sir::Field>("data"));
+
+    std::shared_ptr<sir::Expr> expr = std::make_shared<sir::BinaryOperator>(
+        makeFieldAccess("data"), "-", makeFieldAccess("data"));
+    if(depth > 1)
+      expr = std::make_shared<sir::BinaryOperator>(
+          expr, "+",
+          makeStencilFunctionCall(depth - 1, std::make_shared<sir::FieldAccessExpr>("data")));
+
+    stencilFunction->Asts.push_back(std::make_shared<sir::AST>(sir::makeBlockStmt(
+        std::vector<std::shared_ptr<sir::Stmt>>{sir::makeReturnStmt(expr)})));
+    return stencilFunction;
+  }
+
+  std::shared_ptr<sir::Stmt> makeStatement(int lhsField) {
+    const int numFields = std::max(params_.NumFields, 2);
+
+    // Read a few fields different from the written one
+    auto readField = [&]() {
+      int idx = random(0, numFields - 2);
+      return getFieldName(idx >= lhsField ? idx + 1 : idx);
+    };
+
+    std::shared_ptr<sir::Expr> rhs = makeFieldAccess(readField());
+    for(int i = 0; i < 2; ++i)
+      rhs = std::make_shared<sir::BinaryOperator>(rhs, i % 2 ? "*" : "+",
+                                                  makeFieldAccess(readField()));
+
+    if(params_.StencilFunctionDepth > 0)
+      rhs = std::make_shared<sir::BinaryOperator>(
+          rhs, "+",
+          makeStencilFunctionCall(params_.StencilFunctionDepth,
+                                  std::make_shared<sir::FieldAccessExpr>(readField())));
+
+    rhs = std::make_shared<sir::BinaryOperator>(
+        rhs, "*", std::make_shared<sir::LiteralAccessExpr>("0.5", BuiltinTypeID::Float));
+
+    return sir::makeExprStmt(std::make_shared<sir::AssignmentExpr>(
+        std::make_shared<sir::FieldAccessExpr>(getFieldName(lhsField)), rhs));
+  }
+
+  std::shared_ptr<sir::Stencil> makeStencil(int idx) {
+    const int numFields = std::max(params_.NumFields, 2);
+
+    auto stencil = std::make_shared<sir::Stencil>();
+    stencil->Name = "stencil_" + std::to_string(idx);
+    for(int i = 0; i < numFields; ++i)
+      stencil->Fields.push_back(std::make_shared<sir::Field>(getFieldName(i)));
+
+    std::vector<std::shared_ptr<sir::Stmt>> regions;
+    int statementIdx = 0;
+    for(int r = 0; r < params_.NumVerticalRegions; ++r) {
+      std::vector<std::shared_ptr<sir::Stmt>> statements;
+      for(int s = 0; s < params_.NumStatements; ++s, ++statementIdx)
+        statements.push_back(makeStatement(1 + statementIdx % (numFields - 1)));
+
+      auto verticalRegion = std::make_shared<sir::VerticalRegion>(
+          std::make_shared<sir::AST>(sir::makeBlockStmt(statements)),
+          std::make_shared<sir::Interval>(sir::Interval::Start, sir::Interval::End),
+          r % 2 ? sir::VerticalRegion::LK_Backward : sir::VerticalRegion::LK_Forward);
+      regions.push_back(sir::makeVerticalRegionDeclStmt(verticalRegion));
+    }
+
+    stencil->StencilDescAst = std::make_shared<sir::AST>(sir::makeBlockStmt(regions));
+    return stencil;
+  }
+
+public:
+  SIRGenerator(const SIRGeneratorParameters& params) : params_(params), rng_(params.Seed) {}
+
+  std::shared_ptr<SIR> generate() {
+    auto sir = std::make_shared<SIR>();
+    sir->Filename = "synthetic_" + params_.toString() + ".cpp";
+
+    for(int depth = 1; depth <= params_.StencilFunctionDepth; ++depth)
+      sir->StencilFunctions.push_back(makeStencilFunction(depth));
+
+    for(int i = 0; i < params_.NumStencils; ++i)
+      sir->Stencils.push_back(makeStencil(i));
+    return sir;
+  }
+};
+
+} // anonymous namespace
+
+std::string SIRGeneratorParameters::toString() const {
+  std::ostringstream ss;
+  ss << "s" << NumStencils << "_r" << NumVerticalRegions << "_st" << NumStatements << "_f"
+     << NumFields << "_d" << StencilFunctionDepth << "_o" << OffsetRadius;
+  return ss.str();
+}
+
+std::shared_ptr<SIR> generateSIR(const SIRGeneratorParameters& parameters) {
+  return SIRGenerator(parameters).generate();
+}
+
+} // namespace dawn
@@ -0,0 +1,50 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#ifndef DAWN_UNITTEST_SIRGENERATOR_H
+#define DAWN_UNITTEST_SIRGENERATOR_H
+
+#include <memory>
+#include <string>
+
+namespace dawn {
+
+struct SIR;
+
+/// @brief Shape of a synthetic SIR (see `generateSIR`)
+struct SIRGeneratorParameters {
+  int NumStencils = 1;            ///< Number of stencils
+  int NumVerticalRegions = 1;     ///< Vertical regions per stencil
+  int NumStatements = 4;          ///< Statements per vertical region
+  int NumFields = 4;              ///< Fields per stencil (at least 2)
+  int StencilFunctionDepth = 0;   ///< Nesting depth of the stencil function called by every
+                                  ///< statement (0 = no stencil functions)
+  int OffsetRadius = 1;           ///< Maximum horizontal offset of the field accesses
+  unsigned Seed = 0;              ///< Seed of the pseudo-random choices
+
+  /// @brief Short textual description (e.g for benchmark reports)
+  std::string toString() const;
+};
+
+/// @brief Generate a synthetic, valid SIR of the given shape
+///
+/// Every statement assigns a sum of (offset) reads of other fields of the stencil to one of its
+/// fields, the first field is only read. Vertical regions alternate between forward and backward
+/// loop order. The result only depends on the parameters, i.e the same parameters always give the
+/// same SIR.
+std::shared_ptr<SIR> generateSIR(const SIRGeneratorParameters& parameters);
+
+} // namespace dawn
+
+#endif
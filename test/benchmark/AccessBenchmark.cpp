@@ -0,0 +1,233 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+// Access lookup microbenchmark
+//
+// Optimizes a large synthetic SIR and measures the lookups which sit on the hot paths of the
+// access computation, the dependency graphs and the code generators: the AccessID of every field
+// and variable access (`StencilMetaInformation::getAccessIDFromExpr`) and the merge of the
+// accesses of all statements (`iir::Accesses`). Each is compared against the same operation on
+// a `std::unordered_map`. Additionally the construction of the dependency graph of every
+// multi-stage is timed. Times are in milliseconds, the minimum over the repetitions is reported.
+//
+//   DawnAccessBenchmark --stencils=16 --statements=16 --fields=16 --repetitions=5
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/ASTExpr.h"
+#include "dawn/IIR/ASTVisitor.h"
+#include "dawn/IIR/Accesses.h"
+#include "dawn/IIR/DependencyGraphAccesses.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Unittest/SIRGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// @brief Minimum time (in milliseconds) of `repetitions` runs of `function`
+template <class FunctionType>
+double time(int repetitions, FunctionType&& function) {
+  double best = std::numeric_limits<double>::max();
+  for(int i = 0; i < repetitions; ++i) {
+    auto start = Clock::now();
+    function();
+    best = std::min(best,
+                    std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+  }
+  return best;
+}
+
+/// @brief Collect the expressions which have an AccessID
+class AccessExprCollector : public iir::ASTVisitorForwarding {
+  std::vector<std::shared_ptr<iir::Expr>>& exprs_;
+
+public:
+  AccessExprCollector(std::vector<std::shared_ptr<iir::Expr>>& exprs) : exprs_(exprs) {}
+
+  void visit(const std::shared_ptr<iir::FieldAccessExpr>& expr) override {
+    exprs_.push_back(expr);
+    iir::ASTVisitorForwarding::visit(expr);
+  }
+  void visit(const std::shared_ptr<iir::VarAccessExpr>& expr) override {
+    exprs_.push_back(expr);
+    iir::ASTVisitorForwarding::visit(expr);
+  }
+};
+
+void printMetric(const std::string& name, double value) {
+  std::cout << std::left << std::setw(36) << name << std::right << std::setw(12) << std::fixed
+            << std::setprecision(3) << value << "\n";
+}
+
+bool parseArguments(int argc, char* argv[], SIRGeneratorParameters& parameters, int& repetitions,
+                    int& lookups) {
+  for(int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto pos = arg.find('=');
+    if(arg.compare(0, 2, "--") != 0 || pos == std::string::npos)
+      return false;
+
+    std::string name = arg.substr(2, pos - 2);
+    int value = std::stoi(arg.substr(pos + 1));
+    if(name == "stencils")
+      parameters.NumStencils = value;
+    else if(name == "regions")
+      parameters.NumVerticalRegions = value;
+    else if(name == "statements")
+      parameters.NumStatements = value;
+    else if(name == "fields")
+      parameters.NumFields = value;
+    else if(name == "repetitions")
+      repetitions = std::max(1, value);
+    else if(name == "lookups")
+      lookups = std::max(1, value);
+    else
+      return false;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  SIRGeneratorParameters parameters;
+  parameters.NumStencils = 16;
+  parameters.NumStatements = 16;
+  parameters.NumFields = 16;
+  int repetitions = 5;
+  int lookups = 100;
+
+  try {
+    if(!parseArguments(argc, argv, parameters, repetitions, lookups))
+      throw std::invalid_argument(argv[0]);
+  } catch(std::exception&) {
+    std::cout << "usage: " << argv[0]
+              << " [--stencils=N --regions=N --statements=N --fields=N --repetitions=N "
+                 "--lookups=N]\n";
+    return 1;
+  }
+
+  Options compileOptions;
+  DawnCompiler compiler(&compileOptions);
+  auto optimizer = compiler.runOptimizer(generateSIR(parameters));
+  if(!optimizer || compiler.getDiagnostics().hasErrors()) {
+    std::cerr << "error: optimizer failed on " << parameters.toString() << std::endl;
+    return 1;
+  }
+
+  double exprLookup = 0, exprLookupHashed = 0, merge = 0, mergeHashed = 0, graphs = 0;
+  std::size_t numExprs = 0, numStatements = 0;
+  volatile int sink = 0;
+
+  for(const auto& instantiationPair : optimizer->getStencilInstantiationMap()) {
+    const auto& instantiation = instantiationPair.second;
+    const auto& metadata = instantiation->getMetaData();
+
+    std::vector<std::shared_ptr<iir::Expr>> exprs;
+    std::vector<std::shared_ptr<const iir::Accesses>> accesses;
+    AccessExprCollector collector(exprs);
+    for(const auto& stmtAccessesPair :
+        iterateIIROver<iir::StatementAccessesPair>(*instantiation->getIIR())) {
+      stmtAccessesPair->getStatement()->accept(collector);
+      accesses.push_back(stmtAccessesPair->getAccesses());
+    }
+    numExprs += exprs.size();
+    numStatements += accesses.size();
+
+    // AccessID of every expression
+    std::unordered_map<int, int> hashedExprIDToAccessID;
+    for(auto pair : metadata.getExprIDToAccessIDMap())
+      hashedExprIDToAccessID.emplace(pair.first, pair.second);
+
+    exprLookup += time(repetitions, [&] {
+      int sum = 0;
+      for(int i = 0; i < lookups; ++i)
+        for(const auto& expr : exprs)
+          sum += metadata.getAccessIDFromExpr(expr);
+      sink = sum;
+    });
+    exprLookupHashed += time(repetitions, [&] {
+      int sum = 0;
+      for(int i = 0; i < lookups; ++i)
+        for(const auto& expr : exprs)
+          sum += hashedExprIDToAccessID.find(expr->getID())->second;
+      sink = sum;
+    });
+
+    // Merge of the accesses of all statements
+    merge += time(repetitions, [&] {
+      for(int i = 0; i < lookups; ++i) {
+        iir::Accesses merged;
+        for(const auto& access : accesses) {
+          for(const auto& pair : access->getReadAccesses())
+            merged.mergeReadExtent(pair.first, pair.second);
+          for(const auto& pair : access->getWriteAccesses())
+            merged.mergeWriteExtent(pair.first, pair.second);
+        }
+        sink = merged.getReadAccesses().size();
+      }
+    });
+    mergeHashed += time(repetitions, [&] {
+      for(int i = 0; i < lookups; ++i) {
+        std::unordered_map<int, iir::Extents> reads, writes;
+        for(const auto& access : accesses) {
+          for(const auto& pair : access->getReadAccesses()) {
+            auto it = reads.find(pair.first);
+            if(it != reads.end())
+              it->second.merge(pair.second);
+            else
+              reads.emplace(pair.first, pair.second);
+          }
+          for(const auto& pair : access->getWriteAccesses()) {
+            auto it = writes.find(pair.first);
+            if(it != writes.end())
+              it->second.merge(pair.second);
+            else
+              writes.emplace(pair.first, pair.second);
+          }
+        }
+        sink = reads.size();
+      }
+    });
+
+    // Dependency graph of every multi-stage
+    graphs += time(repetitions, [&] {
+      for(const auto& multiStage : iterateIIROver<iir::MultiStage>(*instantiation->getIIR()))
+        sink = multiStage->getDependencyGraphOfAxis()->getNumVertices();
+    });
+  }
+
+  std::cout << parameters.toString() << ": " << numStatements << " statements, " << numExprs
+            << " accesses, " << lookups << " lookups each\n\n";
+  printMetric("expr_to_access_id", exprLookup);
+  printMetric("expr_to_access_id/unordered_map", exprLookupHashed);
+  printMetric("accesses_merge", merge);
+  printMetric("accesses_merge/unordered_map", mergeHashed);
+  printMetric("dependency_graphs", graphs);
+  return 0;
+}
@@ -0,0 +1,166 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+// StencilInstantiation cloning benchmark
+//
+// Optimizes a large synthetic SIR and clones every stencil instantiation `--clones` times, keeping
+// all clones alive, as a search-based optimizer evaluating many candidate IIRs would. Reports the
+// time (in milliseconds, minimum over the repetitions) and the number and volume of the heap
+// allocations of the clones. A second scenario renames one field in every clone, which forces the
+// shared metadata and accesses to be copied. Allocation numbers require Dawn to be configured with
+// `DAWN_PROFILE_ALLOCATIONS`.
+//
+//   DawnCloneBenchmark --stencils=16 --statements=16 --fields=16 --clones=100 --repetitions=3
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/Renaming.h"
+#include "dawn/Support/AllocationCounter.h"
+#include "dawn/Unittest/SIRGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// @brief Time (in milliseconds) and allocations of the fastest of `repetitions` runs of `function`
+struct Measurement {
+  double Milliseconds = std::numeric_limits<double>::max();
+  AllocationStatistics Allocations;
+};
+
+template <class FunctionType>
+Measurement measure(int repetitions, FunctionType&& function) {
+  Measurement best;
+  for(int i = 0; i < repetitions; ++i) {
+    auto allocationsBefore = getThreadAllocationStatistics();
+    auto start = Clock::now();
+    function();
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    if(ms < best.Milliseconds) {
+      best.Milliseconds = ms;
+      best.Allocations = getThreadAllocationStatistics() - allocationsBefore;
+    }
+  }
+  return best;
+}
+
+void printMetric(const std::string& name, const Measurement& m) {
+  std::cout << std::left << std::setw(28) << name << std::right << std::setw(12) << std::fixed
+            << std::setprecision(3) << m.Milliseconds << " ms" << std::setw(12)
+            << m.Allocations.Count << " allocs" << std::setw(12) << std::setprecision(2)
+            << m.Allocations.Bytes / (1024.0 * 1024.0) << " MB\n";
+}
+
+bool parseArguments(int argc, char* argv[], SIRGeneratorParameters& parameters, int& repetitions,
+                    int& clones) {
+  for(int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto pos = arg.find('=');
+    if(arg.compare(0, 2, "--") != 0 || pos == std::string::npos)
+      return false;
+    std::string name = arg.substr(2, pos - 2);
+    int value = std::stoi(arg.substr(pos + 1));
+    if(name == "stencils")
+      parameters.NumStencils = value;
+    else if(name == "regions")
+      parameters.NumVerticalRegions = value;
+    else if(name == "statements")
+      parameters.NumStatements = value;
+    else if(name == "fields")
+      parameters.NumFields = value;
+    else if(name == "repetitions")
+      repetitions = std::max(1, value);
+    else if(name == "clones")
+      clones = std::max(1, value);
+    else
+      return false;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  SIRGeneratorParameters parameters;
+  parameters.NumStencils = 16;
+  parameters.NumStatements = 16;
+  parameters.NumFields = 16;
+  int repetitions = 3;
+  int clones = 100;
+
+  try {
+    if(!parseArguments(argc, argv, parameters, repetitions, clones))
+      throw std::invalid_argument(argv[0]);
+  } catch(std::exception&) {
+    std::cout << "usage: " << argv[0]
+              << " [--stencils=N --regions=N --statements=N --fields=N --clones=N "
+                 "--repetitions=N]\n";
+    return 1;
+  }
+
+  Options compileOptions;
+  DawnCompiler compiler(&compileOptions);
+  auto optimizer = compiler.runOptimizer(generateSIR(parameters));
+  if(!optimizer || compiler.getDiagnostics().hasErrors()) {
+    std::cerr << "error: optimizer failed on " << parameters.toString() << std::endl;
+    return 1;
+  }
+
+  std::vector<std::shared_ptr<iir::StencilInstantiation>> instantiations;
+  for(const auto& instantiationPair : optimizer->getStencilInstantiationMap())
+    instantiations.push_back(instantiationPair.second);
+
+  std::vector<std::shared_ptr<iir::StencilInstantiation>> candidates;
+  candidates.reserve(instantiations.size() * clones);
+
+  // Clone only
+  Measurement clone = measure(repetitions, [&] {
+    for(const auto& instantiation : instantiations)
+      for(int i = 0; i < clones; ++i)
+        candidates.push_back(instantiation->clone());
+  });
+  candidates.clear();
+
+  // Clone and rename the first field of every clone
+  Measurement cloneAndRename = measure(repetitions, [&] {
+    for(const auto& instantiation : instantiations) {
+      const auto& metadata = instantiation->getMetaData();
+      int accessID = *metadata.getAccessesOfType<iir::FieldAccessType::FAT_APIField>().begin();
+      for(int i = 0; i < clones; ++i) {
+        auto candidate = instantiation->clone();
+        renameAccessIDInStencil(candidate->getStencils().front().get(), accessID,
+                                candidate->nextUID());
+        candidates.push_back(std::move(candidate));
+      }
+    }
+  });
+  candidates.clear();
+
+  std::cout << parameters.toString() << ": " << instantiations.size() << " instantiations, "
+            << clones << " clones each\n\n";
+  printMetric("clone", clone);
+  printMetric("clone_and_rename", cloneAndRename);
+  return 0;
+}
@@ -0,0 +1,370 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+// Compiler throughput benchmark
+//
+// Generates synthetic SIRs (see `dawn/Unittest/SIRGenerator.h`) and measures the time spent in
+// the front end (SIR to IIR), in every optimizer pass, in the code generators and in the IIR
+// serialization. All times are in milliseconds and the minimum over the repetitions is reported.
+//
+//   DawnCompilerBenchmark --statements=16 --scale=stencils --values=1,2,4,8 --output=out.json
+//   DawnCompilerBenchmark --baseline=out.json --threshold=10
+//
+// With `--baseline` the exit code is non-zero if any metric got slower by more than `threshold`
+// percent compared to the baseline results.
+
+#include "dawn/CodeGen/CXXNaive/CXXNaiveCodeGen.h"
+#include "dawn/CodeGen/GridTools/GTCodeGen.h"
+#include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/IIRSerializer.h"
+#include "dawn/Support/Json.h"
+#include "dawn/Unittest/SIRGenerator.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// @brief Metric name to time in milliseconds
+using Metrics = std::map<std::string, double>;
+
+/// @brief Metrics faster than this are too noisy to be compared against a baseline
+constexpr double MinComparedTime = 1.0;
+
+struct BenchmarkOptions {
+  SIRGeneratorParameters Parameters;
+  int Repetitions = 3;
+  int OptimizerJobs = 1;
+  int CodeGenJobs = 1;
+  std::string Scale;
+  std::vector<int> Values;
+  std::string Output;
+  std::string Baseline;
+  double Threshold = 10.0;
+};
+
+double milliseconds(Clock::duration duration) {
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+template <class FunctionType>
+double time(FunctionType&& function) {
+  auto start = Clock::now();
+  function();
+  return milliseconds(Clock::now() - start);
+}
+
+/// @brief Scratch file of the pass profile, unique per process so that concurrent benchmark runs
+/// do not overwrite each other's profile
+std::string getProfileFilename() {
+  const char* tmpdir = std::getenv("TMPDIR");
+  return std::string(tmpdir ? tmpdir : "/tmp") + "/dawn-benchmark-profile." +
+         std::to_string(::getpid()) + ".json";
+}
+
+/// @brief Time of the conversion of the SIR to the (unoptimized) IIR
+void measureFrontend(const std::shared_ptr<SIR>& sir, Metrics& metrics) {
+  DiagnosticsEngine diagnostics;
+  OptimizerContext context(diagnostics, OptimizerContext::OptimizerContextOptions{}, sir);
+  metrics["frontend"] = time([&] { context.fillIIR(); });
+}
+
+/// @brief Time of every optimizer pass (summed over the stencil instantiations) and of the code
+/// generators
+void measureOptimizerAndCodeGen(const std::shared_ptr<SIR>& sir, const BenchmarkOptions& options,
+                                Metrics& metrics) {
+  Options compileOptions;
+  compileOptions.PassProfile = getProfileFilename();
+  compileOptions.OptimizerJobs = options.OptimizerJobs;
+  DawnCompiler compiler(&compileOptions);
+
+  std::unique_ptr<OptimizerContext> optimizer;
+  metrics["optimizer"] = time([&] { optimizer = compiler.runOptimizer(sir); });
+  std::remove(compileOptions.PassProfile.c_str());
+  std::remove((compileOptions.PassProfile + ".trace.json").c_str());
+  if(!optimizer || compiler.getDiagnostics().hasErrors())
+    throw std::runtime_error("optimizer failed on " + options.Parameters.toString());
+
+  for(const auto& record : optimizer->getPassManager().getProfiler().getRecords())
+    metrics["pass/" + record.Pass] += milliseconds(record.End - record.Start);
+
+  auto& stencilInstantiationMap = optimizer->getStencilInstantiationMap();
+  std::map<std::string, std::unique_ptr<codegen::CodeGen>> codeGens;
+  codeGens["gridtools"] = std::make_unique<codegen::gt::GTCodeGen>(
+      stencilInstantiationMap, compiler.getDiagnostics(), compileOptions.UseParallelEP,
+      compileOptions.MaxHaloPoints);
+  codeGens["c++-naive"] = std::make_unique<codegen::cxxnaive::CXXNaiveCodeGen>(
+      stencilInstantiationMap, compiler.getDiagnostics(), compileOptions.MaxHaloPoints);
+
+  for(auto& codeGen : codeGens) {
+    codeGen.second->setNumThreads(options.CodeGenJobs);
+    metrics["codegen/" + codeGen.first] = time([&] { codeGen.second->generateCode(); });
+  }
+}
+
+/// @brief Time of serializing the optimized IIR and of reading it back
+///
+/// The serializer does not support stencil functions, hence the SIR is optimized separately with
+/// all stencil functions inlined.
+void measureSerialization(const std::shared_ptr<SIR>& sir, Metrics& metrics) {
+  Options compileOptions;
+  compileOptions.InlineSF = true;
+  DawnCompiler compiler(&compileOptions);
+  auto optimizer = compiler.runOptimizer(sir);
+  if(!optimizer || compiler.getDiagnostics().hasErrors())
+    throw std::runtime_error("optimizer failed");
+
+  OptimizerContext context(compiler.getDiagnostics(), OptimizerContext::OptimizerContextOptions{},
+                           std::make_shared<SIR>());
+
+  for(auto kind : {IIRSerializer::SK_Json, IIRSerializer::SK_Byte}) {
+    const std::string name = kind == IIRSerializer::SK_Json ? "json" : "byte";
+    std::vector<std::string> serialized;
+    metrics["serialize/" + name] = time([&] {
+      for(const auto& instantiationPair : optimizer->getStencilInstantiationMap())
+        serialized.push_back(IIRSerializer::serializeToString(instantiationPair.second, kind));
+    });
+    metrics["deserialize/" + name] = time([&] {
+      for(const auto& str : serialized)
+        IIRSerializer::deserializeFromString(str, &context, kind);
+    });
+  }
+}
+
+Metrics runBenchmark(const BenchmarkOptions& options) {
+  Metrics best;
+  for(int repetition = 0; repetition < options.Repetitions; ++repetition) {
+    auto sir = generateSIR(options.Parameters);
+
+    Metrics metrics;
+    measureFrontend(sir, metrics);
+    measureOptimizerAndCodeGen(sir, options, metrics);
+    measureSerialization(sir, metrics);
+
+    for(const auto& metric : metrics) {
+      auto it = best.find(metric.first);
+      if(it == best.end())
+        best.insert(metric);
+      else
+        it->second = std::min(it->second, metric.second);
+    }
+  }
+  return best;
+}
+
+void printTable(const std::vector<std::pair<std::string, Metrics>>& results) {
+  std::size_t width = 0;
+  for(const auto& metric : results.front().second)
+    width = std::max(width, metric.first.size());
+
+  std::cout << std::left << std::setw(width + 2) << "metric [ms]";
+  for(const auto& result : results)
+    std::cout << std::right << std::setw(std::max<std::size_t>(result.first.size(), 10) + 2)
+              << result.first;
+  std::cout << "\n";
+
+  for(const auto& metric : results.front().second) {
+    std::cout << std::left << std::setw(width + 2) << metric.first;
+    for(const auto& result : results) {
+      auto it = result.second.find(metric.first);
+      std::cout << std::right << std::setw(std::max<std::size_t>(result.first.size(), 10) + 2)
+                << std::fixed << std::setprecision(2)
+                << (it != result.second.end() ? it->second : 0.0);
+    }
+    std::cout << "\n";
+  }
+}
+
+json::json toJson(const std::vector<std::pair<std::string, Metrics>>& results) {
+  json::json node;
+  for(const auto& result : results)
+    for(const auto& metric : result.second)
+      node[result.first][metric.first] = metric.second;
+  return node;
+}
+
+/// @brief Compare against the baseline, returns the number of regressions
+int compareToBaseline(const std::vector<std::pair<std::string, Metrics>>& results,
+                      const BenchmarkOptions& options) {
+  std::ifstream file(options.Baseline);
+  if(!file.is_open())
+    throw std::runtime_error("cannot open baseline: " + options.Baseline);
+  json::json baseline;
+  file >> baseline;
+
+  int regressions = 0;
+  for(const auto& result : results) {
+    if(!baseline.count(result.first))
+      continue;
+    const json::json& baselineMetrics = baseline[result.first];
+
+    for(const auto& metric : result.second) {
+      if(!baselineMetrics.count(metric.first))
+        continue;
+      double reference = baselineMetrics[metric.first].get<double>();
+      if(std::max(reference, metric.second) < MinComparedTime)
+        continue;
+
+      double change = 100.0 * (metric.second - reference) / std::max(reference, 1e-9);
+      if(change > options.Threshold) {
+        std::cout << "regression: " << result.first << " " << metric.first << " " << std::fixed
+                  << std::setprecision(2) << reference << " ms -> " << metric.second << " ms (+"
+                  << std::setprecision(1) << change << "%)\n";
+        regressions++;
+      }
+    }
+  }
+  return regressions;
+}
+
+int* getScaledParameter(SIRGeneratorParameters& parameters, const std::string& name) {
+  if(name == "stencils")
+    return &parameters.NumStencils;
+  if(name == "regions")
+    return &parameters.NumVerticalRegions;
+  if(name == "statements")
+    return &parameters.NumStatements;
+  if(name == "fields")
+    return &parameters.NumFields;
+  if(name == "depth")
+    return &parameters.StencilFunctionDepth;
+  if(name == "radius")
+    return &parameters.OffsetRadius;
+  return nullptr;
+}
+
+void printUsage(const char* program) {
+  std::cout
+      << "usage: " << program << " [options]\n\n"
+      << "SIR shape:\n"
+      << "  --stencils=N --regions=N --statements=N --fields=N --depth=N --radius=N --seed=N\n\n"
+      << "Benchmark:\n"
+      << "  --repetitions=N       Report the minimum of N runs (default 3)\n"
+      << "  --optimizer-jobs=N    Threads of the optimizer (default 1)\n"
+      << "  --codegen-jobs=N      Threads of the code generators (default 1)\n"
+      << "  --scale=PARAM         Sweep the SIR shape parameter PARAM (e.g `statements`) ...\n"
+      << "  --values=A,B,...      ... over these values\n"
+      << "  --output=FILE         Write the results as JSON to FILE\n"
+      << "  --baseline=FILE       Compare to the results in FILE\n"
+      << "  --threshold=PERCENT   Allowed slow down compared to the baseline (default 10)\n";
+}
+
+bool parseArguments(int argc, char* argv[], BenchmarkOptions& options) {
+  for(int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto pos = arg.find('=');
+    if(arg.compare(0, 2, "--") != 0 || pos == std::string::npos)
+      return false;
+
+    std::string name = arg.substr(2, pos - 2);
+    std::string value = arg.substr(pos + 1);
+
+    if(int* parameter = getScaledParameter(options.Parameters, name))
+      *parameter = std::stoi(value);
+    else if(name == "seed")
+      options.Parameters.Seed = std::stoul(value);
+    else if(name == "repetitions")
+      options.Repetitions = std::max(1, std::stoi(value));
+    else if(name == "optimizer-jobs")
+      options.OptimizerJobs = std::stoi(value);
+    else if(name == "codegen-jobs")
+      options.CodeGenJobs = std::stoi(value);
+    else if(name == "scale")
+      options.Scale = value;
+    else if(name == "values") {
+      std::istringstream ss(value);
+      for(std::string item; std::getline(ss, item, ',');)
+        options.Values.push_back(std::stoi(item));
+    } else if(name == "output")
+      options.Output = value;
+    else if(name == "baseline")
+      options.Baseline = value;
+    else if(name == "threshold")
+      options.Threshold = std::stod(value);
+    else
+      return false;
+  }
+
+  if(!options.Scale.empty() &&
+     (options.Values.empty() || !getScaledParameter(options.Parameters, options.Scale)))
+    return false;
+  return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  BenchmarkOptions options;
+  try {
+    if(!parseArguments(argc, argv, options)) {
+      printUsage(argv[0]);
+      return 1;
+    }
+  } catch(std::exception&) {
+    printUsage(argv[0]);
+    return 1;
+  }
+
+  try {
+    std::vector<std::pair<std::string, Metrics>> results;
+    if(options.Scale.empty()) {
+      results.emplace_back(options.Parameters.toString(), runBenchmark(options));
+    } else {
+      for(int value : options.Values) {
+        BenchmarkOptions scaledOptions = options;
+        *getScaledParameter(scaledOptions.Parameters, options.Scale) = value;
+        results.emplace_back(scaledOptions.Parameters.toString(), runBenchmark(scaledOptions));
+      }
+    }
+
+    printTable(results);
+
+    if(!options.Output.empty()) {
+      std::ofstream file(options.Output);
+      file << toJson(results).dump(2) << std::endl;
+    }
+
+    if(!options.Baseline.empty()) {
+      int regressions = compareToBaseline(results, options);
+      if(regressions != 0) {
+        std::cout << regressions << " metric(s) regressed by more than " << options.Threshold
+                  << "%\n";
+        return 1;
+      }
+    }
+  } catch(std::exception& e) {
+    std::cerr << "error: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,296 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+// Interval algebra microbenchmark
+//
+// Compares the sorted-vector interval engine (`iir::IntervalSet` and the sweep-line
+// `Interval::computePartition`) against the previous implementation, which is kept here as a
+// reference: the partition was computed by repeatedly splitting neighbouring pairs and re-sorting,
+// and every insert into a `MultiInterval` recomputed the partition of all its intervals. The
+// intervals are random, with bounds relative to the start and to the end of the axis. Times are in
+// milliseconds, the minimum over the repetitions is reported.
+//
+//   DawnIntervalBenchmark --intervals=64 --repetitions=5
+
+#include "dawn/IIR/Interval.h"
+#include "dawn/IIR/IntervalAlgorithms.h"
+#include "dawn/IIR/IntervalSet.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dawn;
+using iir::Interval;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// @brief Minimum time (in milliseconds) of `repetitions` runs of `function`
+template <class FunctionType>
+double time(int repetitions, FunctionType&& function) {
+  double best = std::numeric_limits<double>::max();
+  for(int i = 0; i < repetitions; ++i) {
+    auto start = Clock::now();
+    function();
+    best = std::min(best,
+                    std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+  }
+  return best;
+}
+
+/// @brief Previous implementation of `Interval::computePartition`
+std::vector<Interval> legacyComputePartition(std::vector<Interval> const& intervals) {
+  std::vector<Interval> newIntervals(intervals);
+
+  std::sort(newIntervals.begin(), newIntervals.end(),
+            [](Interval const& a, Interval const& b) { return a.lowerBound() < b.lowerBound(); });
+
+  if(newIntervals.size() > 1) {
+    bool change = false;
+    for(auto curLowIt = newIntervals.begin(), curTopIt = std::next(newIntervals.begin());
+        curTopIt != newIntervals.end();) {
+      const Interval& curLowInterval = *curLowIt;
+      const Interval& curTopInterval = *curTopIt;
+
+      if(curLowInterval == curTopInterval) {
+        curTopIt = newIntervals.erase(curTopIt);
+        continue;
+      } else if(curLowInterval.contains(curTopInterval) &&
+                (curLowInterval.lowerBound() == curTopInterval.lowerBound())) {
+        Interval splitHighInterval(curLowInterval.lowerLevel(), curTopInterval.upperLevel(),
+                                   curLowInterval.lowerOffset(), curTopInterval.upperOffset());
+        Interval splitLowInterval(curTopInterval.upperLevel(), curLowInterval.upperLevel(),
+                                  curTopInterval.upperOffset() + 1, curLowInterval.upperOffset());
+
+        *curLowIt = splitLowInterval;
+        *curTopIt = splitHighInterval;
+
+        change = true;
+      } else if(curTopInterval.contains(curLowInterval)) {
+        Interval splitLowInterval(curLowInterval.lowerLevel(), curLowInterval.upperLevel(),
+                                  curLowInterval.lowerOffset(), curLowInterval.upperOffset());
+        Interval splitHighInterval(curLowInterval.upperLevel(), curTopInterval.upperLevel(),
+                                   curLowInterval.upperOffset() + 1, curTopInterval.upperOffset());
+
+        *curLowIt = splitLowInterval;
+        *curTopIt = splitHighInterval;
+
+        change = true;
+      } else if(curLowInterval.contains(curTopInterval) &&
+                (curLowInterval.upperBound() == curTopInterval.upperBound())) {
+        Interval splitLowInterval(curLowInterval.lowerLevel(), curTopInterval.lowerLevel(),
+                                  curLowInterval.lowerOffset(), curTopInterval.lowerOffset() - 1);
+        Interval splitHighInterval(curTopInterval.lowerLevel(), curTopInterval.upperLevel(),
+                                   curTopInterval.lowerOffset(), curTopInterval.upperOffset());
+
+        *curLowIt = splitLowInterval;
+        *curTopIt = splitHighInterval;
+
+        change = true;
+      } else if(curLowInterval.contains(curTopInterval)) {
+        Interval splitLowInterval(curLowInterval.lowerLevel(), curTopInterval.lowerLevel(),
+                                  curLowInterval.lowerOffset(), curTopInterval.lowerOffset() - 1);
+        Interval splitMidInterval(curTopInterval.lowerLevel(), curTopInterval.upperLevel(),
+                                  curTopInterval.lowerOffset(), curTopInterval.upperOffset());
+        Interval splitHighInterval(curTopInterval.upperLevel(), curLowInterval.upperLevel(),
+                                   curTopInterval.upperOffset() + 1, curLowInterval.upperOffset());
+
+        *curLowIt = splitLowInterval;
+        *curTopIt = splitMidInterval;
+        newIntervals.insert(curTopIt, splitHighInterval);
+
+        change = true;
+      } else if(curLowInterval.overlaps(curTopInterval)) {
+        Interval splitLowInterval(curLowInterval.lowerLevel(), curTopInterval.lowerLevel(),
+                                  curLowInterval.lowerOffset(), curTopInterval.lowerOffset() - 1);
+        Interval splitMidInterval(curTopInterval.lowerLevel(), curLowInterval.upperLevel(),
+                                  curTopInterval.lowerOffset(), curLowInterval.upperOffset());
+        Interval splitHighInterval(curLowInterval.upperLevel(), curTopInterval.upperLevel(),
+                                   curLowInterval.upperOffset() + 1, curTopInterval.upperOffset());
+
+        *curLowIt = splitLowInterval;
+        *curTopIt = splitMidInterval;
+        newIntervals.insert(curTopIt, splitHighInterval);
+        change = true;
+      }
+
+      if(change) {
+        std::sort(
+            newIntervals.begin(), newIntervals.end(),
+            [](Interval const& a, Interval const& b) { return a.lowerBound() < b.lowerBound(); });
+        curLowIt = newIntervals.begin();
+        curTopIt = std::next(curLowIt);
+        change = false;
+      } else {
+        curLowIt = curTopIt;
+        curTopIt++;
+      }
+    }
+  }
+  return newIntervals;
+}
+
+/// @brief Previous implementation of `MultiInterval::insert`
+void legacyInsert(std::vector<Interval>& intervals, const Interval& interval) {
+  intervals.push_back(interval);
+  intervals = legacyComputePartition(intervals);
+
+  for(auto it = intervals.begin(); it != intervals.end(); ++it) {
+    if(std::next(it) == intervals.end())
+      break;
+    auto& aInterval = *it;
+    auto& nextInterval = *(std::next(it));
+    if(aInterval.adjacent(nextInterval)) {
+      aInterval.merge(nextInterval);
+      it = std::prev(std::prev(intervals.erase(std::next(it))));
+    }
+  }
+}
+
+/// @brief Previous implementation of `MultiInterval::substract`
+void legacySubstract(std::vector<Interval>& intervals, const Interval& interval) {
+  for(auto it = intervals.begin(); it != intervals.end(); ++it) {
+    if(it->overlaps(interval)) {
+      const Interval int1 = *it;
+      iir::MultiInterval multiInterval = iir::substract(int1, interval);
+      intervals.erase(it);
+      for(auto const& intervIt : multiInterval.getIntervals())
+        legacyInsert(intervals, intervIt);
+      it = intervals.begin();
+      if(it == intervals.end())
+        break;
+    }
+  }
+}
+
+std::vector<Interval> randomIntervals(int n, int numLevels, std::mt19937& gen) {
+  auto randomLevel = [&]() -> Interval::IntervalLevel {
+    if(std::uniform_int_distribution<int>(0, 3)(gen) == 0)
+      return {sir::Interval::End, std::uniform_int_distribution<int>(-3, 0)(gen)};
+    return {std::uniform_int_distribution<int>(0, numLevels)(gen),
+            std::uniform_int_distribution<int>(-1, 1)(gen)};
+  };
+
+  std::vector<Interval> intervals;
+  while(static_cast<int>(intervals.size()) < n) {
+    Interval::IntervalLevel a = randomLevel(), b = randomLevel();
+    if(a.bound() > b.bound())
+      std::swap(a, b);
+    if(a.bound() >= 0)
+      intervals.emplace_back(a.levelMark_, b.levelMark_, a.offset_, b.offset_);
+  }
+  return intervals;
+}
+
+void printMetric(const std::string& name, double value) {
+  std::cout << std::left << std::setw(36) << name << std::right << std::setw(12) << std::fixed
+            << std::setprecision(3) << value << "\n";
+}
+
+bool parseArguments(int argc, char* argv[], int& numIntervals, int& repetitions) {
+  for(int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto pos = arg.find('=');
+    if(arg.compare(0, 2, "--") != 0 || pos == std::string::npos)
+      return false;
+
+    std::string name = arg.substr(2, pos - 2);
+    int value = std::stoi(arg.substr(pos + 1));
+    if(name == "intervals")
+      numIntervals = std::max(1, value);
+    else if(name == "repetitions")
+      repetitions = std::max(1, value);
+    else
+      return false;
+  }
+  return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+  int numIntervals = 64;
+  int repetitions = 5;
+
+  try {
+    if(!parseArguments(argc, argv, numIntervals, repetitions))
+      throw std::invalid_argument(argv[0]);
+  } catch(std::exception&) {
+    std::cout << "usage: " << argv[0] << " [--intervals=N --repetitions=N]\n";
+    return 1;
+  }
+
+  std::mt19937 gen(42);
+  std::vector<Interval> intervals = randomIntervals(numIntervals, 4 * numIntervals, gen);
+  std::vector<Interval> cuts;
+  for(int i = 0; i < numIntervals; ++i) {
+    int level = std::uniform_int_distribution<int>(0, 4 * numIntervals)(gen);
+    cuts.emplace_back(level, level + 1);
+  }
+  volatile std::size_t sink = 0;
+
+  // Partition of all the intervals
+  double partitionLegacy =
+      time(repetitions, [&] { sink = legacyComputePartition(intervals).size(); });
+  double partition =
+      time(repetitions, [&] { sink = Interval::computePartition(intervals).size(); });
+
+  // Union built one interval at a time, then short cuts are removed one at a time
+  std::vector<Interval> legacyResult;
+  double insertLegacy = time(repetitions, [&] {
+    legacyResult.clear();
+    for(const Interval& interval : intervals)
+      legacyInsert(legacyResult, interval);
+  });
+  double substractLegacy = time(repetitions, [&] {
+    std::vector<Interval> result = legacyResult;
+    for(const Interval& interval : cuts)
+      legacySubstract(result, interval);
+    sink = result.size();
+  });
+
+  iir::IntervalSet set;
+  double insert = time(repetitions, [&] {
+    set = iir::IntervalSet();
+    for(const Interval& interval : intervals)
+      set.insert(interval);
+  });
+  double substract = time(repetitions, [&] {
+    iir::IntervalSet result = set;
+    for(const Interval& interval : cuts)
+      result.substract(interval);
+    sink = result.size();
+  });
+
+  if(iir::IntervalSet(legacyResult) != set) {
+    std::cerr << "error: the union differs from the reference implementation" << std::endl;
+    return 1;
+  }
+
+  std::cout << "intervals: " << numIntervals << ", repetitions: " << repetitions << "\n";
+  printMetric("partition (legacy) [ms]", partitionLegacy);
+  printMetric("partition (sweep-line) [ms]", partition);
+  printMetric("insert (legacy) [ms]", insertLegacy);
+  printMetric("insert (IntervalSet) [ms]", insert);
+  printMetric("substract (legacy) [ms]", substractLegacy);
+  printMetric("substract (IntervalSet) [ms]", substract);
+  return 0;
+}
@@ -0,0 +1,201 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn-c/Compiler.h"
+#include "dawn-c/TranslationUnit.h"
+#include "dawn/Compiler/CompileServer.h"
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Serialization/SIRSerializer.h"
+#include "dawn/Support/IndexGenerator.h"
+#include "dawn/Support/UIDGenerator.h"
+#include "dawn/Unittest/SIRGenerator.h"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <climits>
+#include <thread>
+#include <unistd.h>
+
+namespace {
+
+class CompileServerTest : public ::testing::Test {
+protected:
+  std::string socketPath_;
+  std::unique_ptr<dawn::CompileServer> server_;
+  std::thread thread_;
+
+  void SetUp() override {
+    socketPath_ = "/tmp/dawn-compile-server-test-" + std::to_string(::getpid()) + ".sock";
+    server_ = std::make_unique<dawn::CompileServer>(socketPath_, 2);
+    thread_ = std::thread([this] { server_->run(); });
+  }
+
+  void TearDown() override {
+    dawn::server::shutdown(socketPath_);
+    thread_.join();
+    server_.reset();
+  }
+
+  static std::string generateSerializedSIR(int numStatements) {
+    dawn::SIRGeneratorParameters parameters;
+    parameters.NumStatements = numStatements;
+    auto sir = dawn::generateSIR(parameters);
+    return dawn::SIRSerializer::serializeToString(sir.get(), dawn::SIRSerializer::SK_Byte);
+  }
+};
+
+TEST_F(CompileServerTest, MatchesInProcessCompilation) {
+  dawn::Options options;
+  options.Backend = "c++-naive";
+
+  for(int numStatements : {2, 5}) {
+    std::string SIR = generateSerializedSIR(numStatements);
+    auto result = dawn::server::compile(socketPath_, SIR, options);
+    ASSERT_NE(result.TranslationUnit, nullptr) << result.Error;
+    EXPECT_TRUE(result.Error.empty());
+
+    // The server numbers the identifiers like a freshly started compiler
+    dawn::UIDGenerator::Scope uidScope(1, INT_MAX - 1);
+    dawn::IndexGenerator::Scope indexScope(0, ULONG_MAX);
+    dawn::DawnCompiler compiler(&options);
+    auto TU = compiler.compile(
+        dawn::SIRSerializer::deserializeFromString(SIR, dawn::SIRSerializer::SK_Byte));
+    ASSERT_NE(TU, nullptr);
+
+    EXPECT_EQ(result.TranslationUnit->getStencils(), TU->getStencils());
+    EXPECT_EQ(result.TranslationUnit->getGlobals(), TU->getGlobals());
+    EXPECT_EQ(result.TranslationUnit->getPPDefines(), TU->getPPDefines());
+  }
+
+  auto statistics = dawn::server::getStatistics(socketPath_);
+  EXPECT_EQ(statistics.at("requests").get<int>(), 2);
+  EXPECT_EQ(statistics.at("failed_compilations").get<int>(), 0);
+  EXPECT_EQ(statistics.at("workers").get<int>(), 2);
+}
+
+TEST_F(CompileServerTest, ReportsErrors) {
+  auto result = dawn::server::compile(socketPath_, "not a serialized SIR", dawn::Options());
+  EXPECT_EQ(result.TranslationUnit, nullptr);
+  EXPECT_NE(result.Error.find("cannot deserialize SIR"), std::string::npos) << result.Error;
+
+  EXPECT_EQ(server_->getStatistics().FailedCompilations, 1);
+}
+
+TEST_F(CompileServerTest, IgnoresLocalFileOptions) {
+  const std::string profilePath =
+      "/tmp/dawn-compile-server-test-" + std::to_string(::getpid()) + ".profile.json";
+  dawn::Options options;
+  options.Backend = "c++-naive";
+  options.OutputFile = "/tmp/dawn-compile-server-test.cpp";
+  options.SerializeIIR = true;
+  options.PassProfile = profilePath;
+
+  auto result = dawn::server::compile(socketPath_, generateSerializedSIR(2), options);
+  ASSERT_NE(result.TranslationUnit, nullptr) << result.Error;
+  EXPECT_NE(::access(profilePath.c_str(), F_OK), 0);
+
+  std::vector<std::string> warnings;
+  for(const auto& diag : result.Diagnostics)
+    if(diag.getDiagKind() == dawn::DiagnosticsKind::Warning &&
+       diag.getMessage().find("compile server") != std::string::npos)
+      warnings.push_back(diag.getMessage());
+  EXPECT_EQ(warnings, (std::vector<std::string>{
+                          "option '-write-iir' is ignored by the compile server",
+                          "option '-profile-passes' is ignored by the compile server"}));
+}
+
+TEST_F(CompileServerTest, BoundsQueue) {
+  const std::string socketPath = socketPath_ + ".bounded";
+  dawn::CompileServer server(socketPath, 1, 1);
+  EXPECT_EQ(server.getQueueCapacity(), 1u);
+  std::thread thread([&] { server.run(); });
+
+  dawn::Options options;
+  options.Backend = "c++-naive";
+  const std::string SIR = generateSerializedSIR(3);
+  std::vector<std::thread> clients;
+  std::atomic<int> numCompiled(0);
+  for(int i = 0; i < 4; ++i)
+    clients.emplace_back([&] {
+      numCompiled += dawn::server::compile(socketPath, SIR, options).TranslationUnit != nullptr;
+    });
+  for(auto& client : clients)
+    client.join();
+
+  EXPECT_EQ(numCompiled, 4);
+  EXPECT_LE(server.getStatistics().MaxQueueDepth, 1u);
+
+  dawn::server::shutdown(socketPath);
+  thread.join();
+}
+
+TEST_F(CompileServerTest, SurvivesBogusMessages) {
+  {
+    // Header announcing a payload far beyond the limit
+    dawn::UnixSocket socket = dawn::UnixSocket::connect(socketPath_);
+    const std::uint32_t kind = dawn::server::MK_Compile;
+    const std::uint64_t size = ~std::uint64_t(0);
+    ASSERT_TRUE(socket.sendAll(&kind, sizeof(kind)));
+    ASSERT_TRUE(socket.sendAll(&size, sizeof(size)));
+
+    dawn::server::Message response;
+    ASSERT_EQ(dawn::server::receiveMessage(socket, response), dawn::server::RS_Received);
+    EXPECT_EQ(response.Kind, dawn::server::MK_Error);
+  }
+  {
+    dawn::UnixSocket socket = dawn::UnixSocket::connect(socketPath_);
+    ASSERT_TRUE(dawn::server::sendMessage(socket, dawn::server::Message{
+                                                      dawn::server::MessageKind(42), ""}));
+    dawn::server::Message response;
+    ASSERT_EQ(dawn::server::receiveMessage(socket, response), dawn::server::RS_Received);
+    EXPECT_EQ(response.Kind, dawn::server::MK_Error);
+  }
+
+  auto statistics = dawn::server::getStatistics(socketPath_);
+  EXPECT_EQ(statistics.at("workers").get<int>(), 2);
+}
+
+TEST_F(CompileServerTest, DoesNotStealSocketOfRunningServer) {
+  EXPECT_THROW(dawn::CompileServer(socketPath_, 1), std::runtime_error);
+  EXPECT_EQ(dawn::server::getStatistics(socketPath_).at("workers").get<int>(), 2);
+}
+
+TEST_F(CompileServerTest, DawnCompileUsesServer) {
+  std::string SIR = generateSerializedSIR(3);
+
+  dawnSetCompileServer(socketPath_.c_str());
+  dawnTranslationUnit_t* TU = dawnCompile(SIR.data(), SIR.size(), nullptr);
+  ASSERT_NE(TU, nullptr);
+  char* stencil = dawnTranslationUnitGetStencil(TU, "stencil_0");
+  EXPECT_NE(stencil, nullptr);
+  std::free(stencil);
+  dawnTranslationUnitDestroy(TU);
+
+  char* statistics = dawnCompileServerGetStatistics(socketPath_.c_str());
+  ASSERT_NE(statistics, nullptr);
+  EXPECT_EQ(dawn::json::json::parse(statistics).at("requests").get<int>(), 1);
+  std::free(statistics);
+
+  // Fall back to in-process compilation if the server cannot be reached
+  dawnSetCompileServer("/nonexistent/dawn.sock");
+  TU = dawnCompile(SIR.data(), SIR.size(), nullptr);
+  EXPECT_NE(TU, nullptr);
+  dawnTranslationUnitDestroy(TU);
+  EXPECT_EQ(dawnCompileServerGetStatistics("/nonexistent/dawn.sock"), nullptr);
+
+  dawnSetCompileServer(nullptr);
+  EXPECT_EQ(server_->getStatistics().Requests, 1);
+}
+
+} // anonymous namespace
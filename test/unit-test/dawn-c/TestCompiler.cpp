@@ -21,11 +21,14 @@
 #include "dawn/SIR/SIR.h"
 #include "dawn/Serialization/SIRSerializer.h"
 #include "dawn/Support/DiagnosticsEngine.h"
+#include "dawn/Support/UIDGenerator.h"
 #include "dawn/Unittest/IIRBuilder.h"
+#include "dawn/Unittest/SIRGenerator.h"
 #include <gtest/gtest.h>
 
 #include <cstring>
 #include <fstream>
+#include <regex>
 
 namespace {
 
@@ -50,6 +53,95 @@ TEST(CompilerTest, CompileEmptySIR) {
   freeCharArray(ppDefines, size);
   dawnTranslationUnitDestroy(TU);
 }
+/// @brief Byte-serialized synthetic SIRs of different shapes
+static std::vector<std::string> generateSerializedSIRs(int numSIRs) {
+  std::vector<std::string> SIRs;
+  for(int i = 0; i < numSIRs; ++i) {
+    dawn::SIRGeneratorParameters parameters;
+    parameters.NumStencils = 1 + i % 2;
+    parameters.NumStatements = 2 + i;
+    parameters.Seed = i;
+    auto sir = dawn::generateSIR(parameters);
+    SIRs.push_back(dawn::SIRSerializer::serializeToString(sir.get(), dawn::SIRSerializer::SK_Byte));
+  }
+  return SIRs;
+}
+
+static std::vector<std::string> compileBatch(const std::vector<std::string>& SIRs, int numThreads) {
+  std::vector<const char*> data;
+  std::vector<size_t> sizes;
+  for(const auto& sir : SIRs) {
+    data.push_back(sir.data());
+    sizes.push_back(sir.size());
+  }
+
+  dawnCompileResult_t* results =
+      dawnCompileBatch(data.data(), sizes.data(), SIRs.size(), nullptr, numThreads);
+
+  std::vector<std::string> code;
+  for(std::size_t i = 0; i < SIRs.size(); ++i) {
+    if(results[i].ErrorMessage) {
+      EXPECT_EQ(results[i].TranslationUnit, nullptr);
+      code.push_back(results[i].ErrorMessage);
+      continue;
+    }
+    EXPECT_NE(results[i].TranslationUnit, nullptr);
+    char* stencil = dawnTranslationUnitGetStencil(results[i].TranslationUnit, "stencil_0");
+    EXPECT_NE(stencil, nullptr);
+    code.push_back(stencil ? stencil : "");
+    std::free(stencil);
+  }
+
+  dawnCompileResultsDestroy(results, SIRs.size());
+  return code;
+}
+
+TEST(CompilerTest, CompileBatch) {
+  auto SIRs = generateSerializedSIRs(6);
+  auto serialCode = compileBatch(SIRs, 1);
+  auto parallelCode = compileBatch(SIRs, 3);
+
+  ASSERT_EQ(serialCode.size(), SIRs.size());
+  for(std::size_t i = 0; i < SIRs.size(); ++i)
+    EXPECT_NE(serialCode[i].find("stencil_0"), std::string::npos) << serialCode[i];
+
+  // Apart from the identifiers (which continue across the calls), the result does not depend on
+  // the number of threads
+  auto stripNumbers = [](const std::string& code) {
+    return std::regex_replace(code, std::regex("[0-9]+"), "#");
+  };
+  for(std::size_t i = 0; i < SIRs.size(); ++i)
+    EXPECT_EQ(stripNumbers(serialCode[i]), stripNumbers(parallelCode[i]));
+
+  dawn::UIDGenerator::getInstance()->reset();
+  auto repeatedCode = compileBatch(SIRs, 2);
+  dawn::UIDGenerator::getInstance()->reset();
+  EXPECT_EQ(repeatedCode, compileBatch(SIRs, 3));
+}
+
+TEST(CompilerTest, CompileBatchKeepsIdentifiersForLaterCompilations) {
+  auto SIRs = generateSerializedSIRs(2);
+  dawn::UIDGenerator::getInstance()->reset();
+  const int numAvailable = dawn::UIDGenerator::getInstance()->getNumAvailable();
+
+  // Each SIR of a batch reserves at most 2^24 identifiers
+  compileBatch(SIRs, 2);
+  EXPECT_GT(dawn::UIDGenerator::getInstance()->getNumAvailable(), numAvailable - (2 << 24));
+  compileBatch(SIRs, 2);
+  EXPECT_GT(dawn::UIDGenerator::getInstance()->getNumAvailable(), numAvailable - (4 << 24));
+}
+
+TEST(CompilerTest, CompileBatchReportsErrorsPerSIR) {
+  auto SIRs = generateSerializedSIRs(2);
+  SIRs.insert(SIRs.begin() + 1, "not a serialized SIR");
+
+  auto code = compileBatch(SIRs, 2);
+  ASSERT_EQ(code.size(), 3);
+  EXPECT_NE(code[0].find("stencil_0"), std::string::npos);
+  EXPECT_NE(code[1].find("cannot deserialize SIR"), std::string::npos) << code[1];
+  EXPECT_NE(code[2].find("stencil_0"), std::string::npos);
+}
+
 template <typename CG>
 void dump(std::ostream& os, dawn::codegen::stencilInstantiationContext& ctx) {
   dawn::DiagnosticsEngine diagnostics;
@@ -0,0 +1,178 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/IIR/DeferredUpdate.h"
+#include "dawn/IIR/IIRNode.h"
+#include <gtest/gtest.h>
+#include <memory>
+
+using namespace dawn;
+
+namespace {
+
+class Mid;
+class Leaf;
+
+/// Root of the test tree, the derived info is the sum of the values of all the leaves
+class Root : public iir::IIRNode<void, Root, Mid> {
+public:
+  int sum_ = 0;
+  int numUpdates_ = 0;
+
+  int getSum() const {
+    flushIfDirty();
+    return sum_;
+  }
+
+  void updateFromChildren() override;
+  void clearDerivedInfo() override { sum_ = 0; }
+};
+
+class Mid : public iir::IIRNode<Root, Mid, Leaf> {
+public:
+  int sum_ = 0;
+  int numUpdates_ = 0;
+  int numLevelUpdates_ = 0;
+
+  int getSum() const {
+    flushIfDirty();
+    return sum_;
+  }
+
+  void updateFromChildren() override;
+  void updateLevel() override { numLevelUpdates_++; }
+  void clearDerivedInfo() override { sum_ = 0; }
+};
+
+class Leaf : public iir::IIRNode<Mid, Leaf, void> {
+public:
+  Leaf(int value) : value_(value) {}
+  int value_;
+};
+
+void Mid::updateFromChildren() {
+  numUpdates_++;
+  sum_ = 0;
+  for(const auto& leaf : children_)
+    sum_ += leaf->value_;
+}
+
+void Root::updateFromChildren() {
+  numUpdates_++;
+  sum_ = 0;
+  for(const auto& mid : children_)
+    sum_ += mid->getSum();
+}
+
+class DeferredUpdate : public ::testing::Test {
+protected:
+  std::unique_ptr<Root> root_;
+
+  void SetUp() override {
+    root_ = std::make_unique<Root>();
+    root_->insertChild(std::make_unique<Mid>(), root_);
+    root_->insertChild(std::make_unique<Mid>(), root_);
+    root_->numUpdates_ = 0;
+  }
+
+  Mid& getMid(int i) { return *root_->getChildren()[i]; }
+};
+
+TEST_F(DeferredUpdate, EagerWithoutScope) {
+  EXPECT_FALSE(iir::DeferredUpdateScope::isActive());
+  for(int i = 1; i <= 4; ++i)
+    getMid(0).insertChild(std::make_unique<Leaf>(i));
+
+  EXPECT_EQ(getMid(0).numUpdates_, 4);
+  EXPECT_EQ(root_->numUpdates_, 4);
+  EXPECT_FALSE(root_->isDirty());
+  EXPECT_EQ(root_->getSum(), 10);
+}
+
+TEST_F(DeferredUpdate, BatchEdit) {
+  {
+    iir::DeferredUpdateScope scope;
+    EXPECT_TRUE(iir::DeferredUpdateScope::isActive());
+
+    for(int i = 1; i <= 4; ++i) {
+      getMid(0).insertChild(std::make_unique<Leaf>(i));
+      getMid(1).insertChild(std::make_unique<Leaf>(10 * i));
+    }
+
+    EXPECT_EQ(getMid(0).numUpdates_, 0);
+    EXPECT_EQ(root_->numUpdates_, 0);
+    EXPECT_TRUE(getMid(0).isDirty());
+    EXPECT_TRUE(root_->isDirty());
+  }
+
+  // Each node is recomputed once when the scope closes
+  EXPECT_FALSE(iir::DeferredUpdateScope::isActive());
+  EXPECT_FALSE(root_->isDirty());
+  EXPECT_EQ(getMid(0).numUpdates_, 1);
+  EXPECT_EQ(getMid(1).numUpdates_, 1);
+  EXPECT_EQ(root_->numUpdates_, 1);
+  EXPECT_EQ(getMid(0).sum_, 10);
+  EXPECT_EQ(getMid(1).sum_, 100);
+  EXPECT_EQ(root_->sum_, 110);
+}
+
+TEST_F(DeferredUpdate, RecomputeOnRead) {
+  iir::DeferredUpdateScope scope;
+
+  getMid(0).insertChild(std::make_unique<Leaf>(3));
+  EXPECT_EQ(root_->getSum(), 3);
+  EXPECT_FALSE(root_->isDirty());
+
+  // Updates are deferred again after the read
+  getMid(1).insertChild(std::make_unique<Leaf>(4));
+  EXPECT_TRUE(root_->isDirty());
+  EXPECT_EQ(root_->getSum(), 7);
+  EXPECT_EQ(root_->numUpdates_, 2);
+}
+
+TEST_F(DeferredUpdate, NestedScopes) {
+  {
+    iir::DeferredUpdateScope outer;
+    {
+      iir::DeferredUpdateScope inner;
+      getMid(0).insertChild(std::make_unique<Leaf>(1));
+    }
+    // Only the outermost scope applies the updates
+    EXPECT_TRUE(root_->isDirty());
+    getMid(0).insertChild(std::make_unique<Leaf>(2));
+  }
+  EXPECT_EQ(root_->numUpdates_, 1);
+  EXPECT_EQ(root_->sum_, 3);
+}
+
+TEST_F(DeferredUpdate, UpdateLevelAndErase) {
+  for(int i = 1; i <= 3; ++i)
+    getMid(1).insertChild(std::make_unique<Leaf>(i));
+
+  {
+    iir::DeferredUpdateScope scope;
+    getMid(1).update(iir::NodeUpdateType::levelAndTreeAbove);
+    getMid(1).update(iir::NodeUpdateType::levelAndTreeAbove);
+    EXPECT_EQ(getMid(1).numLevelUpdates_, 0);
+
+    // A dirty node which is destroyed within the scope is dropped from the pending updates
+    getMid(0).insertChild(std::make_unique<Leaf>(7));
+    root_->childrenErase(root_->childrenBegin());
+  }
+  EXPECT_EQ(getMid(0).numLevelUpdates_, 1);
+  EXPECT_EQ(getMid(0).sum_, 6);
+  EXPECT_EQ(root_->sum_, 6);
+}
+
+} // anonymous namespace
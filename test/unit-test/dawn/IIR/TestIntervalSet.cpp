@@ -0,0 +1,232 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/IIR/IntervalSet.h"
+#include "dawn/IIR/Interval.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <set>
+
+using namespace dawn;
+using namespace iir;
+
+namespace {
+
+/// Reference model of a set of levels
+using LevelSet = std::set<int>;
+
+/// Order preserving compression of the bounds (relative to the start or to the end of the axis) of
+/// the random intervals, which keeps the model small
+int compress(int bound) {
+  return bound < sir::Interval::End / 2 ? bound : bound - sir::Interval::End + 100;
+}
+
+LevelSet toLevels(const Interval& interval) {
+  LevelSet levels;
+  for(int level = compress(interval.lowerBound()); level <= compress(interval.upperBound());
+      ++level)
+    levels.insert(level);
+  return levels;
+}
+
+LevelSet toLevels(const std::vector<Interval>& intervals) {
+  LevelSet levels;
+  for(const Interval& interval : intervals) {
+    LevelSet l = toLevels(interval);
+    levels.insert(l.begin(), l.end());
+  }
+  return levels;
+}
+
+bool isCanonical(const std::vector<Interval>& intervals) {
+  for(std::size_t i = 0; i < intervals.size(); ++i) {
+    if(intervals[i].lowerBound() > intervals[i].upperBound())
+      return false;
+    if(i > 0 && intervals[i - 1].upperBound() + 1 >= intervals[i].lowerBound())
+      return false;
+  }
+  return true;
+}
+
+/// Random intervals with bounds relative to the start and to the end of the axis
+class RandomIntervals {
+  std::mt19937 gen_;
+
+  Interval::IntervalLevel randomLevel() {
+    if(std::uniform_int_distribution<int>(0, 3)(gen_) == 0)
+      return {sir::Interval::End, std::uniform_int_distribution<int>(-8, 2)(gen_)};
+    return {std::uniform_int_distribution<int>(0, 12)(gen_),
+            std::uniform_int_distribution<int>(0, 3)(gen_)};
+  }
+
+public:
+  RandomIntervals(unsigned seed) : gen_(seed) {}
+
+  Interval operator()() {
+    Interval::IntervalLevel a = randomLevel(), b = randomLevel();
+    if(a.bound() > b.bound())
+      std::swap(a, b);
+    return Interval(a.levelMark_, b.levelMark_, a.offset_, b.offset_);
+  }
+
+  std::vector<Interval> operator()(int n) {
+    std::vector<Interval> intervals;
+    for(int i = 0; i < n; ++i)
+      intervals.push_back((*this)());
+    return intervals;
+  }
+
+  bool coin() { return std::uniform_int_distribution<int>(0, 1)(gen_); }
+};
+
+TEST(IntervalSet, Canonical) {
+  IntervalSet set{Interval{7, 9}, Interval{0, 5}, Interval{6, 6}, Interval{12, 14},
+                  Interval{13, 20}};
+  EXPECT_EQ(set, (IntervalSet{Interval{0, 9}, Interval{12, 20}}));
+  EXPECT_EQ(set.size(), 2);
+
+  set.substract(Interval{3, 13});
+  EXPECT_EQ(set, (IntervalSet{Interval{0, 2}, Interval{14, 20}}));
+
+  set.insert(Interval{3, 13});
+  EXPECT_EQ(set, (IntervalSet{Interval{0, 20}}));
+  EXPECT_TRUE(set.contiguous());
+}
+
+TEST(IntervalSet, EndRelativeBounds) {
+  IntervalSet set{Interval{sir::Interval::Start, sir::Interval::End}};
+  set.substract(Interval{sir::Interval::End, sir::Interval::End, -1, 0});
+
+  ASSERT_EQ(set.size(), 1);
+  const Interval& interval = set.getIntervals().front();
+  EXPECT_EQ(interval.lowerLevel(), sir::Interval::Start);
+  EXPECT_EQ(interval.upperLevel(), sir::Interval::End);
+  EXPECT_EQ(interval.upperOffset(), -2);
+
+  set.substract(Interval{sir::Interval::Start, sir::Interval::Start, 0, 1});
+  EXPECT_EQ(set.getIntervals().front().lowerLevel(), sir::Interval::Start);
+  EXPECT_EQ(set.getIntervals().front().lowerOffset(), 2);
+
+  EXPECT_TRUE(set.overlaps(Interval{sir::Interval::End, sir::Interval::End, -2, 0}));
+  EXPECT_FALSE(set.overlaps(Interval{sir::Interval::End, sir::Interval::End, -1, 0}));
+  EXPECT_TRUE(set.contains(Interval{5, sir::Interval::End, 0, -3}));
+}
+
+TEST(IntervalSet, PropertyInsertSubstract) {
+  RandomIntervals random(42);
+
+  for(int trial = 0; trial < 200; ++trial) {
+    IntervalSet set;
+    LevelSet model;
+
+    for(int op = 0; op < 20; ++op) {
+      Interval interval = random();
+      LevelSet levels = toLevels(interval);
+      if(random.coin()) {
+        set.insert(interval);
+        model.insert(levels.begin(), levels.end());
+      } else {
+        set.substract(interval);
+        for(int level : levels)
+          model.erase(level);
+      }
+
+      ASSERT_TRUE(isCanonical(set.getIntervals())) << set;
+      ASSERT_EQ(toLevels(set.getIntervals()), model) << set;
+
+      Interval query = random();
+      LevelSet queryLevels = toLevels(query);
+      bool overlaps = false, contains = true;
+      for(int level : queryLevels) {
+        overlaps |= model.count(level) != 0;
+        contains &= model.count(level) != 0;
+      }
+      ASSERT_EQ(set.overlaps(query), overlaps) << set << " " << query;
+      ASSERT_EQ(set.contains(query), contains) << set << " " << query;
+    }
+  }
+}
+
+TEST(IntervalSet, PropertySetOperations) {
+  RandomIntervals random(7);
+
+  for(int trial = 0; trial < 200; ++trial) {
+    std::vector<Interval> a = random(6), b = random(6);
+    LevelSet levelsA = toLevels(a), levelsB = toLevels(b);
+
+    IntervalSet setA(a), setB(b);
+    ASSERT_TRUE(isCanonical(setA.getIntervals()));
+    ASSERT_EQ(toLevels(setA.getIntervals()), levelsA);
+
+    IntervalSet unionSet = setA;
+    unionSet.insert(setB);
+    LevelSet unionLevels = levelsA;
+    unionLevels.insert(levelsB.begin(), levelsB.end());
+    ASSERT_TRUE(isCanonical(unionSet.getIntervals()));
+    ASSERT_EQ(toLevels(unionSet.getIntervals()), unionLevels);
+
+    IntervalSet difference = setA;
+    difference.substract(setB);
+    LevelSet differenceLevels;
+    for(int level : levelsA)
+      if(!levelsB.count(level))
+        differenceLevels.insert(level);
+    ASSERT_TRUE(isCanonical(difference.getIntervals()));
+    ASSERT_EQ(toLevels(difference.getIntervals()), differenceLevels);
+
+    // The canonical form is unique
+    IntervalSet incremental;
+    for(const Interval& interval : a)
+      incremental.insert(interval);
+    ASSERT_EQ(incremental, setA);
+  }
+}
+
+TEST(IntervalSet, PropertyPartition) {
+  RandomIntervals random(1234);
+
+  for(int trial = 0; trial < 300; ++trial) {
+    std::vector<Interval> intervals = random(1 + trial % 8);
+    std::vector<Interval> partition = Interval::computePartition(intervals);
+
+    // The pieces are sorted, disjoint and cover exactly the levels of the intervals
+    for(std::size_t i = 0; i < partition.size(); ++i) {
+      ASSERT_LE(partition[i].lowerBound(), partition[i].upperBound());
+      if(i > 0) {
+        ASSERT_LT(partition[i - 1].upperBound(), partition[i].lowerBound());
+      }
+    }
+    ASSERT_EQ(toLevels(partition), toLevels(intervals));
+
+    // Each piece is either inside or outside of each interval, and two adjacent pieces are not in
+    // the same intervals (i.e the partition is minimal)
+    auto membership = [&](const Interval& piece) {
+      std::vector<bool> inside;
+      for(const Interval& interval : intervals) {
+        if(interval.overlaps(piece)) {
+          EXPECT_TRUE(interval.contains(piece)) << interval << " " << piece;
+        }
+        inside.push_back(interval.overlaps(piece));
+      }
+      return inside;
+    };
+    for(std::size_t i = 1; i < partition.size(); ++i) {
+      if(partition[i - 1].adjacent(partition[i])) {
+        ASSERT_NE(membership(partition[i - 1]), membership(partition[i]));
+      }
+    }
+  }
+}
+
+} // anonymous namespace
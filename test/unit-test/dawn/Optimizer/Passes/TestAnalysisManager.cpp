@@ -0,0 +1,150 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/AnalysisManager.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/PassProfiler.h"
+#include "dawn/Optimizer/PassSetBlockSize.h"
+#include "dawn/Optimizer/PassSetStageGraph.h"
+#include "dawn/Optimizer/PassStageMerger.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Unittest/SIRGenerator.h"
+#include <gtest/gtest.h>
+
+using namespace dawn;
+
+namespace {
+
+std::int64_t getCounter(const OptimizerContext& optimizer, const std::string& name) {
+  return optimizer.getPassManager().getProfiler().getCounter(name);
+}
+
+TEST(AnalysisManager, PreservedAnalyses) {
+  EXPECT_FALSE(PreservedAnalyses::none().isPreserved(AK_StageNames));
+  EXPECT_TRUE(PreservedAnalyses::all().isPreserved(AK_StageNames));
+
+  PreservedAnalyses preserved = PreservedAnalyses::all();
+  preserved.abandon(AK_StageNames);
+  EXPECT_FALSE(preserved.isPreserved(AK_StageNames));
+  EXPECT_TRUE(preserved.isPreserved(AK_StageDependencyGraph));
+
+  preserved = PreservedAnalyses::none();
+  preserved.preserve(AK_StageExtents);
+  EXPECT_TRUE(preserved.isPreserved(AK_StageExtents));
+  EXPECT_FALSE(preserved.isPreserved(AK_DerivedInfo));
+}
+
+TEST(AnalysisManager, ComputesRequiredAnalysesOnlyOnce) {
+  Options options;
+  DawnCompiler compiler(&options);
+  OptimizerContext optimizer(compiler.getDiagnostics(), OptimizerContext::OptimizerContextOptions{},
+                             generateSIR(SIRGeneratorParameters{}));
+  optimizer.fillIIR();
+
+  // The second PassSetStageGraph is skipped as PassSetBlockSize does not modify the IIR, the
+  // stage merger reuses the graph
+  PassManager& passManager = optimizer.getPassManager();
+  passManager.pushBackPass<PassSetStageGraph>(optimizer);
+  passManager.pushBackPass<PassSetBlockSize>(optimizer, PassSetBlockSize::TK_GPU);
+  passManager.pushBackPass<PassSetStageGraph>(optimizer);
+  passManager.pushBackPass<PassStageMerger>(optimizer, PassSetBlockSize::TK_GPU);
+
+  auto instantiation = optimizer.getStencilInstantiationMap().begin()->second;
+  ASSERT_TRUE(passManager.runAllPassesOnStecilInstantiation(optimizer, instantiation));
+
+  EXPECT_EQ(getCounter(optimizer, "analysis.StageDependencyGraph.computed"), 1);
+  EXPECT_EQ(getCounter(optimizer, "analysis.StageDependencyGraph.reused"), 2);
+  EXPECT_EQ(getCounter(optimizer, "analysis.StageDependencyGraph.invalidated"), 1);
+  EXPECT_FALSE(passManager.getAnalysisManager().isValid(instantiation,
+                                                        AK_StageDependencyGraph));
+}
+
+TEST(AnalysisManager, ComputesMissingAnalysesOnDemand) {
+  Options options;
+  DawnCompiler compiler(&options);
+  OptimizerContext optimizer(compiler.getDiagnostics(), OptimizerContext::OptimizerContextOptions{},
+                             generateSIR(SIRGeneratorParameters{}));
+  optimizer.fillIIR();
+
+  // The stage merger requires the stage dependency graph which is not computed by any pass
+  PassManager& passManager = optimizer.getPassManager();
+  passManager.pushBackPass<PassStageMerger>(optimizer, PassSetBlockSize::TK_GPU);
+
+  auto instantiation = optimizer.getStencilInstantiationMap().begin()->second;
+  ASSERT_TRUE(passManager.runAllPassesOnStecilInstantiation(optimizer, instantiation));
+  EXPECT_EQ(getCounter(optimizer, "analysis.StageDependencyGraph.computed"), 1);
+  EXPECT_TRUE(instantiation->getStencils().front()->getStageDependencyGraph() != nullptr);
+}
+
+TEST(AnalysisManager, StageMergeCostModelSeesStageExtents) {
+  Options options;
+  options.MergeStages = true;
+  options.MergeStagesCostModel = true;
+  DawnCompiler compiler(&options);
+  OptimizerContext::OptimizerContextOptions optimizerOptions;
+  optimizerOptions.MergeStages = true;
+  optimizerOptions.MergeStagesCostModel = true;
+  OptimizerContext optimizer(compiler.getDiagnostics(), optimizerOptions,
+                             generateSIR(SIRGeneratorParameters{}));
+  optimizer.fillIIR();
+
+  // The block size the cost model is given has to be the one `PassSetBlockSize` assigns at the
+  // end of the pipeline, which depends on the stage extents
+  PassManager& passManager = optimizer.getPassManager();
+  passManager.pushBackPass<PassStageMerger>(optimizer, PassSetBlockSize::TK_GPU);
+
+  auto instantiation = optimizer.getStencilInstantiationMap().begin()->second;
+  ASSERT_TRUE(passManager.runAllPassesOnStecilInstantiation(optimizer, instantiation));
+  EXPECT_EQ(getCounter(optimizer, "analysis.StageExtents.computed"), 1);
+
+  auto optimized = compiler.runOptimizer(generateSIR(SIRGeneratorParameters{}));
+  ASSERT_TRUE(optimized != nullptr);
+  EXPECT_EQ(PassSetBlockSize::computeBlockSize(optimizer, PassSetBlockSize::TK_GPU,
+                                               *instantiation->getIIR()),
+            optimized->getStencilInstantiationMap().begin()->second->getIIR()->getBlockSize());
+}
+
+TEST(AnalysisManager, OptimizerSkipsRedundantWork) {
+  SIRGeneratorParameters shape;
+  shape.NumStencils = 2;
+  shape.NumVerticalRegions = 2;
+
+  Options options;
+  DawnCompiler compiler(&options);
+  auto optimizer = compiler.runOptimizer(generateSIR(shape));
+  ASSERT_TRUE(optimizer != nullptr);
+
+  // The stage merger reuses the graph of the stage reordering
+  EXPECT_EQ(getCounter(*optimizer, "analysis.StageDependencyGraph.computed"), 2);
+  EXPECT_EQ(getCounter(*optimizer, "analysis.StageDependencyGraph.reused"), 2 * 2);
+}
+
+TEST(AnalysisManager, NewInstantiationsDoNotInheritAnalyses) {
+  PassProfiler profiler;
+  AnalysisManager analysisManager(profiler);
+
+  auto instantiation = std::make_shared<iir::StencilInstantiation>();
+  analysisManager.markValid(instantiation, AK_StageNames);
+  EXPECT_TRUE(analysisManager.isValid(instantiation, AK_StageNames));
+
+  // The new instantiation is likely allocated at the address of the destroyed one
+  instantiation.reset();
+  auto newInstantiation = std::make_shared<iir::StencilInstantiation>();
+  EXPECT_FALSE(analysisManager.isValid(newInstantiation, AK_StageNames));
+}
+
+} // anonymous namespace
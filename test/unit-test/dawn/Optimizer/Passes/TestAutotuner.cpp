@@ -0,0 +1,290 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Compiler/Autotuner.h"
+#include "dawn/Compiler/BenchmarkHarness.h"
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/Compiler/TuningDatabase.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/SIRSerializer.h"
+#include "test/unit-test/dawn/Optimizer/TestEnvironment.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <regex>
+#include <set>
+#include <streambuf>
+
+using namespace dawn;
+namespace fs = std::filesystem;
+
+namespace {
+
+std::shared_ptr<SIR> loadSIR(const std::string& sirFilename) {
+  std::string filename = TestEnvironment::path_ + "/" + sirFilename;
+  std::ifstream file(filename);
+  DAWN_ASSERT_MSG((file.good()), std::string("File " + filename + " does not exists").c_str());
+
+  std::string jsonstr((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  return SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
+}
+
+/// @brief Code of the translation unit with the stencil IDs (which are global) removed
+std::string toString(const codegen::TranslationUnit& translationUnit) {
+  std::string str = translationUnit.getGlobals();
+  for(const auto& stencil : translationUnit.getStencils())
+    str += stencil.first + "\n" + stencil.second;
+  return std::regex_replace(str, std::regex("stencil_[0-9]+"), "stencil");
+}
+
+/// @brief Separable cost with its minimum at `b=2`, `c=1`, `a` is only slightly better at 1
+double fakeCost(const TuningConfiguration& configuration) {
+  double cost = 10.0;
+  cost -= *configuration.get("a") == "1" ? 1.0 : 0.0;
+  cost -= *configuration.get("b") == "2" ? 3.0 : (*configuration.get("b") == "1" ? 1.0 : 0.0);
+  cost -= *configuration.get("c") == "1" ? 2.0 : 0.0;
+  return cost;
+}
+
+std::vector<TuningParameter> getFakeSpace() {
+  return {{"a", {"0", "1"}}, {"b", {"0", "1", "2"}}, {"c", {"0", "1"}}};
+}
+
+TEST(Autotuner, ExhaustiveSearchFindsTheMinimum) {
+  Autotuner tuner(getFakeSpace(), fakeCost);
+  EXPECT_EQ(tuner.getNumConfigurations(), 12);
+
+  auto result = tuner.run(Autotuner::SK_Exhaustive, 0);
+  EXPECT_EQ(result.History.size(), 12);
+  EXPECT_EQ(result.BestTime, 4.0);
+  EXPECT_EQ(*result.Best.get("a"), "1");
+  EXPECT_EQ(*result.Best.get("b"), "2");
+  EXPECT_EQ(*result.Best.get("c"), "1");
+}
+
+TEST(Autotuner, GreedySearchNeedsFewerEvaluations) {
+  Autotuner tuner(getFakeSpace(), fakeCost);
+  auto result = tuner.run(Autotuner::SK_Greedy, 0);
+  EXPECT_EQ(result.BestTime, 4.0);
+  EXPECT_LT(result.History.size(), 12);
+}
+
+TEST(Autotuner, RandomSearchRespectsTheBudget) {
+  std::set<std::string> evaluated;
+  Autotuner tuner(getFakeSpace(), [&](const TuningConfiguration& configuration) {
+    EXPECT_TRUE(evaluated.insert(configuration.jsonDump().dump()).second);
+    return fakeCost(configuration);
+  });
+
+  auto result = tuner.run(Autotuner::SK_Random, 5, 42);
+  EXPECT_EQ(result.History.size(), 5);
+  EXPECT_EQ(evaluated.size(), 5);
+  EXPECT_GE(result.BestTime, 4.0);
+}
+
+TEST(Autotuner, FailedConfigurationsAreNeverBest) {
+  Autotuner tuner(getFakeSpace(), [](const TuningConfiguration& configuration) {
+    return *configuration.get("c") == "1" ? -1.0 : fakeCost(configuration);
+  });
+  auto result = tuner.run(Autotuner::SK_Exhaustive, 0);
+  EXPECT_EQ(result.BestTime, 6.0);
+  EXPECT_EQ(*result.Best.get("c"), "0");
+}
+
+TEST(Autotuner, DefaultSpaceOnlyCoversBenchmarkedBackends) {
+  auto hasParameter = [](const std::string& backend, const std::string& name) {
+    auto space = Autotuner::getDefaultSpace(backend);
+    return std::any_of(space.begin(), space.end(),
+                       [&](const TuningParameter& parameter) { return parameter.Name == name; });
+  };
+  EXPECT_TRUE(hasParameter("c++-opt", "block_size"));
+  EXPECT_TRUE(hasParameter("c++-opt", "SIMDWidth"));
+  EXPECT_FALSE(hasParameter("c++-naive", "block_size"));
+  EXPECT_FALSE(hasParameter("cuda", "block_size"));
+}
+
+class TuningDatabaseTest : public ::testing::Test {
+protected:
+  std::string dbFile_;
+
+  void SetUp() override {
+    const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+    dbFile_ =
+        (fs::temp_directory_path() / ("dawn-tuning-" + std::string(info->name()) + ".json"))
+            .string();
+    fs::remove(dbFile_);
+  }
+
+  void TearDown() override { fs::remove(dbFile_); }
+};
+
+TEST_F(TuningDatabaseTest, ConfigurationAppliesToOptions) {
+  TuningConfiguration configuration;
+  configuration.set("ReorderStrategy", "scut");
+  configuration.set("MergeStages", "true");
+  configuration.set("MaxFieldsPerStencil", "20");
+
+  Options options;
+  ASSERT_TRUE(configuration.apply(options));
+  EXPECT_EQ(options.ReorderStrategy, "scut");
+  EXPECT_TRUE(options.MergeStages);
+  EXPECT_EQ(options.MaxFieldsPerStencil, 20);
+  EXPECT_EQ(TuningConfiguration::fromOptions(
+                options, {"MaxFieldsPerStencil", "MergeStages", "ReorderStrategy"}),
+            configuration);
+  EXPECT_EQ(configuration.toString(), "-max-fields=20 -merge-stages=true -reorder=scut");
+
+  configuration.set("MaxFieldsPerStencil", "many");
+  EXPECT_FALSE(configuration.apply(options));
+  EXPECT_FALSE(TuningConfiguration::isOption("NoSuchOption"));
+}
+
+TEST_F(TuningDatabaseTest, KeepsTheFastestEntryAcrossSaves) {
+  TuningConfiguration slow, fast;
+  slow.set("MergeStages", "false");
+  fast.set("MergeStages", "true");
+
+  {
+    TuningDatabase database(dbFile_);
+    EXPECT_EQ(database.size(), 0);
+    EXPECT_TRUE(database.insert("key", {"stencil", slow, 2.0}));
+    EXPECT_TRUE(database.insert("key", {"stencil", fast, 1.0}));
+    EXPECT_FALSE(database.insert("key", {"stencil", slow, 1.5}));
+    ASSERT_TRUE(database.save());
+  }
+
+  TuningDatabase database(dbFile_);
+  ASSERT_EQ(database.size(), 1);
+  ASSERT_TRUE(database.lookup("key") != nullptr);
+  EXPECT_EQ(database.lookup("key")->Configuration, fast);
+  EXPECT_EQ(database.lookup("key")->Time, 1.0);
+  EXPECT_TRUE(database.lookup("other") == nullptr);
+}
+
+TEST_F(TuningDatabaseTest, KeyIgnoresTunedOptions) {
+  auto sir = loadSIR("compute_extent_test_stencil_01.sir");
+
+  Options options;
+  options.Backend = "c++-naive";
+  const std::string key = TuningDatabase::computeKey(*sir, "compute_extent_test_stencil", options);
+
+  options.ReorderStrategy = "scut";
+  options.MergeStages = true;
+  EXPECT_EQ(TuningDatabase::computeKey(*sir, "compute_extent_test_stencil", options), key);
+
+  options.OptimizerJobs = 4;
+  options.CodeGenJobs = 4;
+  EXPECT_EQ(TuningDatabase::computeKey(*sir, "compute_extent_test_stencil", options), key);
+
+  options.Backend = "gridtools";
+  EXPECT_NE(TuningDatabase::computeKey(*sir, "compute_extent_test_stencil", options), key);
+}
+
+TEST_F(TuningDatabaseTest, CompilerUsesTheTunedConfiguration) {
+  auto sir = loadSIR("compute_extent_test_stencil_01.sir");
+
+  Options options;
+  options.Backend = "c++-naive";
+
+  TuningConfiguration configuration;
+  configuration.set("ReorderStrategy", "none");
+  configuration.set("MergeStages", "true");
+  {
+    TuningDatabase database(dbFile_);
+    database.insert(TuningDatabase::computeKey(*sir, "compute_extent_test_stencil", options),
+                    {"compute_extent_test_stencil", configuration, 1.0});
+    ASSERT_TRUE(database.save());
+  }
+
+  Options tunedOptions = options;
+  ASSERT_TRUE(configuration.apply(tunedOptions));
+  auto expected = DawnCompiler(&tunedOptions).compile(sir);
+  ASSERT_TRUE(expected != nullptr);
+
+  options.TuningDB = dbFile_;
+  DawnCompiler compiler(&options);
+  auto translationUnit = compiler.compile(sir);
+  ASSERT_TRUE(translationUnit != nullptr);
+  EXPECT_EQ(toString(*translationUnit), toString(*expected));
+  EXPECT_EQ(compiler.getOptions().ReorderStrategy, "greedy");
+  EXPECT_EQ(compiler.getTuningDatabase()->size(), 1);
+}
+
+TEST_F(TuningDatabaseTest, StencilsWithDifferentConfigurationsShareOneTranslationUnit) {
+  auto sir = loadSIR("compute_extent_test_stencil_01.sir");
+  auto other = loadSIR("test_field_access_interval_01.sir");
+  const std::string tunedStencil = "tuned_stencil";
+  other->Stencils.front()->Name = tunedStencil;
+  sir->Stencils.push_back(other->Stencils.front());
+
+  Options options;
+  options.Backend = "c++-naive";
+
+  TuningConfiguration configuration;
+  configuration.set("ReorderStrategy", "none");
+  {
+    TuningDatabase database(dbFile_);
+    database.insert(TuningDatabase::computeKey(*sir, tunedStencil, options),
+                    {tunedStencil, configuration, 1.0});
+    ASSERT_TRUE(database.save());
+  }
+  auto untuned = DawnCompiler(&options).compile(sir);
+  ASSERT_TRUE(untuned != nullptr);
+
+  // Every configuration compiles its own copy of the SIR
+  const std::string sirString = SIRSerializer::serializeToString(sir.get());
+
+  options.TuningDB = dbFile_;
+  DawnCompiler compiler(&options);
+  auto translationUnit = compiler.compile(sir);
+  ASSERT_TRUE(translationUnit != nullptr);
+  EXPECT_EQ(SIRSerializer::serializeToString(sir.get()), sirString);
+  EXPECT_FALSE(compiler.getDiagnostics().hasDiags());
+  EXPECT_EQ(translationUnit->getStencils().size(), 2);
+  EXPECT_EQ(translationUnit->getPPDefines(), untuned->getPPDefines());
+  EXPECT_EQ(translationUnit->getGlobals(), untuned->getGlobals());
+}
+
+TEST_F(TuningDatabaseTest, HarnessEmbedsTheGeneratedStencil) {
+  auto sir = loadSIR("compute_extent_test_stencil_01.sir");
+
+  Options options;
+  options.Backend = "c++-naive";
+  auto translationUnit = DawnCompiler(&options).compile(sir);
+  ASSERT_TRUE(translationUnit != nullptr);
+
+  BenchmarkHarness harness(sir, "compute_extent_test_stencil", options,
+                           BenchmarkHarness::Settings());
+  std::string source = harness.generateSource(*translationUnit);
+  EXPECT_NE(source.find("dawn_generated::cxxnaive::compute_extent_test_stencil "
+                        "dawn_benchmark_stencil(dawn_benchmark_dom"),
+            std::string::npos);
+  EXPECT_NE(source.find("dawn-benchmark-time"), std::string::npos);
+
+  // `u` is read, `out` and `lap` are read and written
+  EXPECT_NE(source.find("const std::size_t dawn_benchmark_transfers = 5;"), std::string::npos);
+  EXPECT_NE(source.find("dawn-benchmark-bandwidth"), std::string::npos);
+  EXPECT_NE(source.find("dawn-benchmark-stream"), std::string::npos);
+
+  options.Backend = "cuda";
+  EXPECT_TRUE(BenchmarkHarness(sir, "compute_extent_test_stencil", options,
+                               BenchmarkHarness::Settings())
+                  .generateSource(*translationUnit)
+                  .empty());
+}
+
+} // anonymous namespace
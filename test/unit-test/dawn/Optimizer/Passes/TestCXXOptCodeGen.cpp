@@ -0,0 +1,178 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/Optimizer/PassSetBlockSize.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/SIRSerializer.h"
+#include "test/unit-test/dawn/Optimizer/TestEnvironment.h"
+#include <array>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <streambuf>
+
+using namespace dawn;
+
+namespace {
+
+class CXXOptCodeGenTest : public ::testing::Test {
+protected:
+  std::string generate(const std::string& sirFilename, int simdWidth = 0,
+                       const std::string& blockSize = "16,8,2") {
+    std::string filename = TestEnvironment::path_ + "/" + sirFilename;
+    std::ifstream file(filename);
+    DAWN_ASSERT_MSG((file.good()), std::string("File " + filename + " does not exists").c_str());
+
+    std::string jsonstr((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    auto sir = SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
+
+    Options options;
+    options.Backend = "c++-opt";
+    options.block_size = blockSize;
+    options.SIMDWidth = simdWidth;
+    DawnCompiler compiler(&options);
+    auto translationUnit = compiler.compile(sir);
+    if(!translationUnit)
+      return "";
+
+    std::string code;
+    for(const auto& stencil : translationUnit->getStencils())
+      code += stencil.second;
+    return code;
+  }
+};
+
+TEST_F(CXXOptCodeGenTest, ParallelMultiStageIsSplitInK) {
+  std::string code = generate("compute_extent_test_stencil_01.sir");
+  ASSERT_FALSE(code.empty());
+
+  EXPECT_NE(code.find("namespace cxxopt"), std::string::npos);
+  EXPECT_NE(code.find("#pragma omp parallel"), std::string::npos);
+  EXPECT_NE(code.find("#pragma omp for collapse(3)"), std::string::npos);
+  EXPECT_NE(code.find("const int numBlocksI = (iMax - iMin + 16) / 16"), std::string::npos);
+  EXPECT_NE(code.find("kBlock * 2 + 2 - 1"), std::string::npos);
+
+  // The first stage computes the extended block required by the second one
+  EXPECT_NE(code.find("for(int i = iStart+-1; i <= iEnd+1; ++i)"), std::string::npos);
+}
+
+TEST_F(CXXOptCodeGenTest, TemporariesAreAllocatedPerBlock) {
+  std::string code = generate("compute_extent_test_stencil_02.sir");
+  ASSERT_FALSE(code.empty());
+
+  EXPECT_EQ(code.find("m_lap"), std::string::npos);
+  EXPECT_NE(code.find("lap_offsets[0] = 1 - iStart"), std::string::npos);
+
+  // The IJ-cached temporaries only hold the level which is computed
+  EXPECT_EQ(code.find("block_meta_data("), std::string::npos);
+  EXPECT_NE(code.find("tmp_meta_data_t block_ij_meta_data(16 + 2, 8 + 2, 1)"), std::string::npos);
+  EXPECT_NE(code.find("tmp_storage_t block_lap(block_ij_meta_data)"), std::string::npos);
+  EXPECT_NE(code.find("lap(i+0+lap_offsets[0],j+0+lap_offsets[1],0)"), std::string::npos);
+}
+
+TEST_F(CXXOptCodeGenTest, TileSizeIsChosenFromCacheModel) {
+  // The IJ-cached temporaries of a tile fit into the L1 cache
+  std::string code = generate("compute_extent_test_stencil_02.sir", 8, "");
+  ASSERT_FALSE(code.empty());
+  EXPECT_NE(code.find("const int numBlocksI = (iMax - iMin + 128) / 128"), std::string::npos);
+  EXPECT_NE(code.find("const int numBlocksJ = (jMax - jMin + 8) / 8"), std::string::npos);
+  EXPECT_NE(code.find("constexpr int blockStrideJ = 136"), std::string::npos);
+
+  // Without horizontal dependencies, there is no halo to amortize in j
+  code = generate("test_compute_ordered_do_methods.sir", 8, "");
+  ASSERT_FALSE(code.empty());
+  EXPECT_NE(code.find("const int numBlocksI = (iMax - iMin + 128) / 128"), std::string::npos);
+  EXPECT_NE(code.find("const int numBlocksJ = (jMax - jMin + 1) / 1"), std::string::npos);
+}
+
+TEST_F(CXXOptCodeGenTest, VerticalMultiStageIsOnlySplitHorizontally) {
+  std::string code = generate("test_compute_ordered_do_methods.sir");
+  ASSERT_FALSE(code.empty());
+
+  EXPECT_NE(code.find("#pragma omp for collapse(2)"), std::string::npos);
+  EXPECT_EQ(code.find("kBlock"), std::string::npos);
+}
+
+TEST_F(CXXOptCodeGenTest, InnermostLoopsAreVectorized) {
+  std::string code = generate("compute_extent_test_stencil_01.sir", 4);
+  ASSERT_FALSE(code.empty());
+
+  EXPECT_NE(code.find("const bool unitStrideI = u_si == 1 && out_si == 1 && lap_si == 1"),
+            std::string::npos);
+  EXPECT_NE(code.find("#pragma omp simd\n"), std::string::npos);
+  EXPECT_NE(code.find("for(int iVec = iFirst; iVec < iPeel; iVec += 4)"), std::string::npos);
+
+  // Remainder loop
+  EXPECT_NE(code.find("for(int i = iPeel; i <= iLast; ++i)"), std::string::npos);
+  EXPECT_NE(code.find("out_ptr[(i+0) + (j+0)*out_sj + (k+0)*out_sk] = "), std::string::npos);
+  EXPECT_NE(code.find("out_ptr[(i+0)*out_si + (j+0)*out_sj + (k+0)*out_sk] = "),
+            std::string::npos);
+}
+
+TEST_F(CXXOptCodeGenTest, BranchesAreLoweredToSelects) {
+  std::string code = generate("compute_extent_test_stencil_02.sir", 8);
+  ASSERT_FALSE(code.empty());
+
+  EXPECT_EQ(code.find("if(("), std::string::npos);
+  EXPECT_NE(code.find("const bool __mask_0 = "), std::string::npos);
+  EXPECT_NE(code.find("flx_ptr[(i+0-blockOriginI) + (j+0-blockOriginJ)*blockStrideJ] = "
+                      "simd_select((!__mask_0), "),
+            std::string::npos);
+
+  // Padded and aligned block temporaries
+  EXPECT_NE(code.find("constexpr int blockStrideJ = 24"), std::string::npos);
+  EXPECT_NE(code.find("lap_ptr = simd_align(block_lap.data())"), std::string::npos);
+}
+
+TEST_F(CXXOptCodeGenTest, VerticalMultiStagesUseKCaches) {
+  std::string code = generate("test_compute_read_access_interval_03.sir", 8);
+  ASSERT_FALSE(code.empty());
+
+  // The columns are swept in batches of the vector width
+  EXPECT_NE(code.find("for(int iVec = iStart; iVec <= iEnd; iVec += 8)"), std::string::npos);
+  EXPECT_NE(code.find("float_type tmp_kcache[2][8];"), std::string::npos);
+
+  // Fill, computation on the cache, flush and slide
+  EXPECT_NE(code.find("tmp_kcache[0][i - iVec] = tmp_ptr[(i+0) + (j+0)*tmp_sj + (k+-1)*tmp_sk];"),
+            std::string::npos);
+  EXPECT_NE(code.find("b_ptr[(i+0) + (j+0)*b_sj + (k+0)*b_sk] = tmp_kcache[0][i - iVec];"),
+            std::string::npos);
+  EXPECT_NE(code.find("tmp_ptr[(i+0) + (j+0)*tmp_sj + (k+-1)*tmp_sk] = tmp_kcache[0][i - iVec];"),
+            std::string::npos);
+  EXPECT_NE(code.find("tmp_kcache[0][i - iVec] = tmp_kcache[1][i - iVec];"), std::string::npos);
+
+  EXPECT_EQ(generate("test_compute_read_access_interval_03.sir").find("_kcache"),
+            std::string::npos);
+}
+
+TEST_F(CXXOptCodeGenTest, MalformedBlockSizeIsReported) {
+  std::array<unsigned int, 3> blockSize;
+  EXPECT_TRUE(PassSetBlockSize::parseBlockSize("16,8,2", blockSize));
+  EXPECT_EQ(blockSize, (std::array<unsigned int, 3>{16, 8, 2}));
+
+  for(const std::string str : {"16,8", "16,8,2,1", "16,8,", "16,,2", "16,x,2", "16,-8,2", "0,8,2",
+                               "16,8,99999999999"})
+    EXPECT_FALSE(PassSetBlockSize::parseBlockSize(str, blockSize)) << str;
+
+  Options options;
+  options.Backend = "c++-opt";
+  options.block_size = "16,8";
+  DawnCompiler compiler(&options);
+  EXPECT_EQ(compiler.compile(std::make_shared<SIR>()), nullptr);
+  EXPECT_TRUE(compiler.getDiagnostics().hasErrors());
+}
+
+} // anonymous namespace
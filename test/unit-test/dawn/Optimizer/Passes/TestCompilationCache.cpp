@@ -0,0 +1,179 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Compiler/CompilationCache.h"
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/SIRSerializer.h"
+#include "test/unit-test/dawn/Optimizer/TestEnvironment.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <streambuf>
+
+using namespace dawn;
+namespace fs = std::filesystem;
+
+namespace {
+
+class CompilationCacheTest : public ::testing::Test {
+protected:
+  std::string cacheDir_;
+
+  void SetUp() override {
+    const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+    cacheDir_ = (fs::temp_directory_path() / ("dawn-cache-" + std::string(info->name()))).string();
+    fs::remove_all(cacheDir_);
+  }
+
+  void TearDown() override { fs::remove_all(cacheDir_); }
+
+  std::shared_ptr<SIR> loadSIR(const std::string& sirFilename) {
+    std::string filename = TestEnvironment::path_ + "/" + sirFilename;
+    std::ifstream file(filename);
+    DAWN_ASSERT_MSG((file.good()), std::string("File " + filename + " does not exists").c_str());
+
+    std::string jsonstr((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
+  }
+
+  static std::string toString(const codegen::TranslationUnit& translationUnit) {
+    std::ostringstream ss;
+    for(const auto& define : translationUnit.getPPDefines())
+      ss << define << "\n";
+    ss << translationUnit.getGlobals();
+    for(const auto& stencil : translationUnit.getStencils())
+      ss << stencil.first << "\n" << stencil.second;
+    return ss.str();
+  }
+};
+
+TEST_F(CompilationCacheTest, SecondCompilationIsServedFromCache) {
+  Options options;
+  options.Backend = "c++-naive";
+  options.CacheDir = cacheDir_;
+
+  DawnCompiler compiler(&options);
+  auto first = compiler.compile(loadSIR("compute_extent_test_stencil_01.sir"));
+  ASSERT_TRUE(first != nullptr);
+  EXPECT_EQ(compiler.getCompilationCache()->getStatistics().Misses, 1);
+  EXPECT_EQ(compiler.getCompilationCache()->getStatistics().Stores, 1);
+
+  // Loading the SIR again assigns new statement IDs which must not change the key
+  auto second = compiler.compile(loadSIR("compute_extent_test_stencil_01.sir"));
+  ASSERT_TRUE(second != nullptr);
+  EXPECT_EQ(compiler.getCompilationCache()->getStatistics().Hits, 1);
+  EXPECT_EQ(toString(*first), toString(*second));
+  EXPECT_EQ(first->getFilename(), second->getFilename());
+
+  // A new compiler shares the on-disk entries
+  DawnCompiler otherCompiler(&options);
+  auto third = otherCompiler.compile(loadSIR("compute_extent_test_stencil_01.sir"));
+  ASSERT_TRUE(third != nullptr);
+  EXPECT_EQ(otherCompiler.getCompilationCache()->getStatistics().Hits, 1);
+  EXPECT_EQ(toString(*first), toString(*third));
+}
+
+TEST_F(CompilationCacheTest, KeyDependsOnSIRAndOptions) {
+  auto sir = loadSIR("compute_extent_test_stencil_01.sir");
+
+  Options options;
+  options.Backend = "c++-naive";
+  const std::string key = CompilationCache::computeKey(*sir, options);
+  EXPECT_EQ(key.size(), 64);
+
+  options.CacheDir = cacheDir_;
+  options.CacheMaxSize = 1;
+  EXPECT_EQ(CompilationCache::computeKey(*sir, options), key);
+
+  options.OptimizerJobs = 4;
+  EXPECT_NE(CompilationCache::computeKey(*sir, options), key);
+
+  options.OptimizerJobs = 1;
+  options.IncrementalDir = cacheDir_;
+  EXPECT_NE(CompilationCache::computeKey(*sir, options), key);
+
+  options.IncrementalDir.clear();
+  options.Backend = "gridtools";
+  EXPECT_NE(CompilationCache::computeKey(*sir, options), key);
+
+  options.Backend = "c++-naive";
+  EXPECT_NE(CompilationCache::computeKey(*loadSIR("compute_extent_test_stencil_02.sir"), options),
+            key);
+}
+
+TEST_F(CompilationCacheTest, EvictsLeastRecentlyUsedEntries) {
+  codegen::TranslationUnit translationUnit("file.cpp", {"#define FOO"},
+                                           {{"stencil", std::string(1000, 'x')}}, "");
+
+  CompilationCache sizingCache(cacheDir_, 0);
+  ASSERT_TRUE(sizingCache.store("a", translationUnit));
+  const auto entrySize = fs::file_size(fs::path(cacheDir_) / "a.tu");
+  fs::last_write_time(fs::path(cacheDir_) / "a.tu",
+                      fs::file_time_type::clock::now() - std::chrono::hours(1));
+
+  // Only a single entry fits into the cache
+  CompilationCache cache(cacheDir_, entrySize + entrySize / 2);
+  ASSERT_TRUE(cache.store("b", translationUnit));
+  EXPECT_EQ(cache.getStatistics().Evictions, 1);
+
+  EXPECT_TRUE(cache.lookup("b") != nullptr);
+  EXPECT_TRUE(cache.lookup("a") == nullptr);
+  EXPECT_EQ(cache.getStatistics().Hits, 1);
+  EXPECT_EQ(cache.getStatistics().Misses, 1);
+}
+
+TEST_F(CompilationCacheTest, DiagnosticsAreReportedFromCache) {
+  Options options;
+  options.Backend = "c++-naive";
+  options.CacheDir = cacheDir_;
+
+  // The optimizer modifies the SIR it compiles, hence the key is computed first
+  auto sir = loadSIR("compute_extent_test_stencil_01.sir");
+  const std::string key = CompilationCache::computeKey(*sir, options);
+
+  DawnCompiler compiler(&options);
+  auto first = compiler.compile(sir);
+  ASSERT_TRUE(first != nullptr);
+
+  // Replace the entry by one of a compilation which emitted a warning
+  const DiagnosticsMessage warning(DiagnosticsKind::Warning, SourceLocation(3, 7), "file.sir",
+                                   "unused field `tmp`");
+  CompilationCache cache(cacheDir_, 0);
+  ASSERT_TRUE(cache.store(key, *first, {warning}));
+
+  auto second = compiler.compile(loadSIR("compute_extent_test_stencil_01.sir"));
+  ASSERT_TRUE(second != nullptr);
+  EXPECT_EQ(compiler.getCompilationCache()->getStatistics().Hits, 1);
+  ASSERT_EQ(compiler.getDiagnostics().getQueue().queue().size(), 1);
+
+  const DiagnosticsMessage& diag = *compiler.getDiagnostics().getQueue().queue().front();
+  EXPECT_EQ(diag.getDiagKind(), DiagnosticsKind::Warning);
+  EXPECT_EQ(diag.getSourceLocation(), SourceLocation(3, 7));
+  EXPECT_EQ(diag.getFilename(), "file.sir");
+  EXPECT_EQ(diag.getMessage(), "unused field `tmp`");
+}
+
+TEST_F(CompilationCacheTest, IgnoresCorruptEntries) {
+  CompilationCache cache(cacheDir_, 0);
+  std::ofstream(fs::path(cacheDir_) / "broken.tu") << "{\"key\": \"bro";
+  EXPECT_TRUE(cache.lookup("broken") == nullptr);
+  EXPECT_EQ(cache.getStatistics().Misses, 1);
+}
+
+} // anonymous namespace
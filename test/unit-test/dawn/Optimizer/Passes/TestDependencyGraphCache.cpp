@@ -0,0 +1,112 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/DependencyGraphAccesses.h"
+#include "dawn/IIR/MultiStage.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Unittest/SIRGenerator.h"
+#include <cstdio>
+#include <gtest/gtest.h>
+
+using namespace dawn;
+
+namespace {
+
+class DependencyGraphCache : public ::testing::Test {
+protected:
+  Options options_;
+  std::unique_ptr<DawnCompiler> compiler_;
+  std::unique_ptr<OptimizerContext> optimizer_;
+
+  void SetUp() override {
+    compiler_ = std::make_unique<DawnCompiler>(&options_);
+    optimizer_ = compiler_->runOptimizer(generateSIR(SIRGeneratorParameters{}));
+    ASSERT_TRUE(optimizer_ != nullptr);
+  }
+
+  iir::MultiStage& getMultiStage() {
+    auto instantiation = optimizer_->getStencilInstantiationMap().begin()->second;
+    return *instantiation->getStencils().front()->getChildren().front();
+  }
+};
+
+TEST_F(DependencyGraphCache, ReturnsMemoizedGraph) {
+  iir::MultiStage& multiStage = getMultiStage();
+  const iir::Interval interval = multiStage.getEnclosingInterval();
+
+  auto graph = multiStage.getDependencyGraphOfInterval(interval);
+  auto axisGraph = multiStage.getDependencyGraphOfAxis();
+
+  auto before = iir::getThreadDependencyGraphCacheStatistics();
+  EXPECT_EQ(multiStage.getDependencyGraphOfInterval(interval), graph);
+  EXPECT_EQ(multiStage.getDependencyGraphOfAxis(), axisGraph);
+
+  auto statistics = iir::getThreadDependencyGraphCacheStatistics() - before;
+  EXPECT_EQ(statistics.Hits, 2);
+  EXPECT_EQ(statistics.Misses, 0);
+  EXPECT_FALSE(graph->empty());
+}
+
+TEST_F(DependencyGraphCache, UpdatedAfterInsertingAndErasingChildren) {
+  iir::MultiStage& multiStage = getMultiStage();
+  auto graph = multiStage.getDependencyGraphOfAxis();
+
+  // Appending a stage extends the memoized graph
+  auto before = iir::getThreadDependencyGraphCacheStatistics();
+  multiStage.insertChild(multiStage.getChildren().front()->clone());
+  auto extendedGraph = multiStage.getDependencyGraphOfAxis();
+  EXPECT_NE(extendedGraph, graph);
+  EXPECT_EQ(extendedGraph->toString(), graph->toString());
+  EXPECT_EQ((iir::getThreadDependencyGraphCacheStatistics() - before).Extensions, 1);
+
+  // Erasing it recomputes the graph
+  before = iir::getThreadDependencyGraphCacheStatistics();
+  multiStage.childrenErase(std::prev(multiStage.childrenEnd()));
+  auto newGraph = multiStage.getDependencyGraphOfAxis();
+  EXPECT_NE(newGraph, extendedGraph);
+  EXPECT_EQ(newGraph->toString(), graph->toString());
+  EXPECT_EQ((iir::getThreadDependencyGraphCacheStatistics() - before).Invalidations, 1);
+}
+
+TEST_F(DependencyGraphCache, RecomputedIfDoMethodGraphIsReplaced) {
+  iir::MultiStage& multiStage = getMultiStage();
+  auto graph = multiStage.getDependencyGraphOfAxis();
+
+  // Replacing the graph of a Do-Method does not notify the multi-stage
+  iir::DoMethod& doMethod = *multiStage.getChildren().front()->getChildren().front();
+  doMethod.setDependencyGraph(doMethod.getDependencyGraph()->clone());
+  EXPECT_NE(multiStage.getDependencyGraphOfAxis(), graph);
+}
+
+TEST(DependencyGraphCacheProfile, CountersInPassProfile) {
+  Options options;
+  options.PassProfile = "dependency_graph_cache_profile.json";
+  DawnCompiler compiler(&options);
+  auto optimizer = compiler.runOptimizer(generateSIR(SIRGeneratorParameters{}));
+  ASSERT_TRUE(optimizer != nullptr);
+  std::remove(options.PassProfile.c_str());
+  std::remove((options.PassProfile + ".trace.json").c_str());
+
+  const PassProfiler& profiler = optimizer->getPassManager().getProfiler();
+  EXPECT_GT(profiler.getCounter("dependency_graph_cache.misses"), 0);
+  EXPECT_EQ(profiler.getCounter("dependency_graph_cache.misses"),
+            profiler.getCounter("dependency_graph_cache.PassTemporaryMerger.misses") +
+                profiler.getCounter("dependency_graph_cache.PassMultiStageSplitter.misses") +
+                profiler.getCounter("dependency_graph_cache.PassStageReordering.misses"));
+}
+
+} // anonymous namespace
@@ -0,0 +1,209 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Fingerprint.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/SIRSerializer.h"
+#include "test/unit-test/dawn/Optimizer/TestEnvironment.h"
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <map>
+#include <regex>
+#include <streambuf>
+
+using namespace dawn;
+namespace fs = std::filesystem;
+
+namespace {
+
+class IncrementalCompilationTest : public ::testing::Test {
+protected:
+  std::string directory_;
+
+  void SetUp() override {
+    const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+    directory_ =
+        (fs::temp_directory_path() / ("dawn-incremental-" + std::string(info->name()))).string();
+    fs::remove_all(directory_);
+  }
+
+  void TearDown() override { fs::remove_all(directory_); }
+
+  /// @brief Combine the stencils of several SIR files into a single SIR
+  static std::shared_ptr<SIR> loadCombinedSIR(const std::vector<std::string>& sirFilenames) {
+    auto combined = std::make_shared<SIR>();
+    combined->GlobalVariableMap = std::make_shared<sir::GlobalVariableMap>();
+
+    for(std::size_t i = 0; i < sirFilenames.size(); ++i) {
+      std::string filename = TestEnvironment::path_ + "/" + sirFilenames[i];
+      std::ifstream file(filename);
+      DAWN_ASSERT_MSG((file.good()), std::string("File " + filename + " does not exists").c_str());
+
+      std::string jsonstr((std::istreambuf_iterator<char>(file)),
+                          std::istreambuf_iterator<char>());
+      std::shared_ptr<SIR> sir =
+          SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
+
+      combined->Filename = sir->Filename;
+      for(const auto& stencil : sir->Stencils) {
+        stencil->Name = "stencil_" + std::to_string(i);
+        combined->Stencils.push_back(stencil);
+      }
+      for(const auto& stencilFunction : sir->StencilFunctions)
+        combined->StencilFunctions.push_back(stencilFunction);
+    }
+    return combined;
+  }
+
+  using StencilCodeMap = std::map<std::string, std::string>;
+
+  StencilCodeMap compile(const std::shared_ptr<SIR>& sir, const std::string& directory,
+                         IncrementalCompilation::Statistics& statistics) {
+    Options options;
+    options.Backend = "c++-naive";
+    options.IncrementalDir = directory;
+    DawnCompiler compiler(&options);
+
+    auto translationUnit = compiler.compile(sir);
+    EXPECT_FALSE(compiler.getDiagnostics().hasErrors());
+    statistics = compiler.getIncrementalCompilation()
+                     ? compiler.getIncrementalCompilation()->getStatistics()
+                     : IncrementalCompilation::Statistics();
+    return translationUnit ? translationUnit->getStencils() : StencilCodeMap{};
+  }
+
+  /// @brief Remove the identifiers drawn from the UIDGenerator (e.g in the names of the stencils)
+  static std::string stripNumbers(const std::string& code) {
+    return std::regex_replace(code, std::regex("[0-9]+"), "#");
+  }
+};
+
+const std::vector<std::string> sirFiles = {
+    "compute_extent_test_stencil_01.sir", "compute_extent_test_stencil_02.sir",
+    "compute_extent_test_stencil_04.sir", "test_field_access_interval_01.sir"};
+
+TEST_F(IncrementalCompilationTest, UnchangedStencilsAreReused) {
+  IncrementalCompilation::Statistics statistics;
+
+  const StencilCodeMap first = compile(loadCombinedSIR(sirFiles), directory_, statistics);
+  ASSERT_EQ(first.size(), sirFiles.size());
+  EXPECT_EQ(statistics.Reused, 0);
+  EXPECT_EQ(statistics.Stored, sirFiles.size());
+
+  const StencilCodeMap second = compile(loadCombinedSIR(sirFiles), directory_, statistics);
+  EXPECT_EQ(statistics.Reused, sirFiles.size());
+  EXPECT_EQ(statistics.Stored, 0);
+  EXPECT_EQ(first, second);
+}
+
+TEST_F(IncrementalCompilationTest, OnlyChangedStencilsAreOptimized) {
+  IncrementalCompilation::Statistics statistics;
+  const StencilCodeMap first = compile(loadCombinedSIR(sirFiles), directory_, statistics);
+
+  // Replace the body of the last stencil
+  std::vector<std::string> changedSirFiles = sirFiles;
+  changedSirFiles.back() = "test_field_access_interval_02.sir";
+
+  const StencilCodeMap incremental =
+      compile(loadCombinedSIR(changedSirFiles), directory_, statistics);
+  EXPECT_EQ(statistics.Reused, sirFiles.size() - 1);
+  EXPECT_EQ(statistics.Stored, 1);
+
+  const StencilCodeMap fromScratch =
+      compile(loadCombinedSIR(changedSirFiles), directory_ + "-scratch", statistics);
+  fs::remove_all(directory_ + "-scratch");
+  EXPECT_EQ(statistics.Reused, 0);
+
+  // The reused stencils are identical to the ones of the first compilation, the changed one
+  // matches a compilation from scratch
+  ASSERT_EQ(incremental.size(), sirFiles.size());
+  for(std::size_t i = 0; i < sirFiles.size() - 1; ++i) {
+    const std::string name = "stencil_" + std::to_string(i);
+    EXPECT_EQ(incremental.at(name), first.at(name));
+  }
+  const std::string changed = "stencil_" + std::to_string(sirFiles.size() - 1);
+  EXPECT_NE(stripNumbers(incremental.at(changed)), stripNumbers(first.at(changed)));
+  EXPECT_EQ(stripNumbers(incremental.at(changed)), stripNumbers(fromScratch.at(changed)));
+}
+
+TEST_F(IncrementalCompilationTest, StencilsCallingStencilFunctionsAreNotStored) {
+  IncrementalCompilation::Statistics statistics;
+
+  // `stencil_0` calls stencil functions, which the IIR serializer does not support
+  const std::vector<std::string> sirFilesWithFunctions = {"compute_extent_test_stencil_03.sir",
+                                                          "compute_extent_test_stencil_01.sir"};
+  const StencilCodeMap regular = compile(loadCombinedSIR(sirFilesWithFunctions), "", statistics);
+
+  const StencilCodeMap first =
+      compile(loadCombinedSIR(sirFilesWithFunctions), directory_, statistics);
+  EXPECT_EQ(statistics.Stored, 1);
+
+  const StencilCodeMap second =
+      compile(loadCombinedSIR(sirFilesWithFunctions), directory_, statistics);
+  EXPECT_EQ(statistics.Reused, 1);
+  EXPECT_EQ(statistics.Stored, 0);
+
+  // The optimizer runs the same passes as without incremental compilation
+  ASSERT_EQ(regular.size(), sirFilesWithFunctions.size());
+  for(const auto& stencil : regular) {
+    EXPECT_EQ(stripNumbers(first.at(stencil.first)), stripNumbers(stencil.second));
+    EXPECT_EQ(stripNumbers(second.at(stencil.first)), stripNumbers(stencil.second));
+  }
+}
+
+TEST_F(IncrementalCompilationTest, StencilsOfTheSameNameDoNotEvictEachOther) {
+  IncrementalCompilation::Statistics statistics;
+
+  // Both SIRs contain a different `stencil_0`, e.g two files of a build sharing the directory
+  const std::vector<std::string> otherSirFiles = {"test_field_access_interval_02.sir"};
+  const std::vector<std::string> sirFile = {sirFiles.front()};
+
+  const StencilCodeMap first = compile(loadCombinedSIR(sirFile), directory_, statistics);
+  const StencilCodeMap other = compile(loadCombinedSIR(otherSirFiles), directory_, statistics);
+  EXPECT_EQ(statistics.Stored, 1);
+
+  EXPECT_EQ(compile(loadCombinedSIR(sirFile), directory_, statistics), first);
+  EXPECT_EQ(statistics.Reused, 1);
+  EXPECT_EQ(compile(loadCombinedSIR(otherSirFiles), directory_, statistics), other);
+  EXPECT_EQ(statistics.Reused, 1);
+
+  // Each entry is a single file, no temporary files are left behind
+  std::size_t numFiles = 0;
+  for(const auto& entry : fs::directory_iterator(directory_)) {
+    EXPECT_EQ(entry.path().extension(), ".iir") << entry.path();
+    numFiles++;
+  }
+  EXPECT_EQ(numFiles, 2);
+}
+
+TEST_F(IncrementalCompilationTest, FingerprintOnlyDependsOnReferencedParts) {
+  Options options;
+  auto sir = loadCombinedSIR(sirFiles);
+  std::vector<std::string> changedSirFiles = sirFiles;
+  changedSirFiles.back() = "test_field_access_interval_02.sir";
+  auto changedSir = loadCombinedSIR(changedSirFiles);
+
+  EXPECT_EQ(computeStencilFingerprint(*sir, "stencil_0", options),
+            computeStencilFingerprint(*changedSir, "stencil_0", options));
+  EXPECT_NE(computeStencilFingerprint(*sir, "stencil_3", options),
+            computeStencilFingerprint(*changedSir, "stencil_3", options));
+  EXPECT_NE(computeStencilFingerprint(*sir, "stencil_0", options),
+            computeStencilFingerprint(*sir, "stencil_1", options));
+}
+
+} // anonymous namespace
@@ -0,0 +1,144 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/CodeGen/TranslationUnit.h"
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/SIRSerializer.h"
+#include "dawn/Support/UIDGenerator.h"
+#include "test/unit-test/dawn/Optimizer/TestEnvironment.h"
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <streambuf>
+
+using namespace dawn;
+
+namespace {
+
+/// @brief Combine the stencils of several SIR files into a single SIR
+std::shared_ptr<SIR> loadCombinedSIR(const std::vector<std::string>& sirFilenames) {
+  auto combined = std::make_shared<SIR>();
+  combined->GlobalVariableMap = std::make_shared<sir::GlobalVariableMap>();
+
+  for(std::size_t i = 0; i < sirFilenames.size(); ++i) {
+    std::string filename = TestEnvironment::path_ + "/" + sirFilenames[i];
+    std::ifstream file(filename);
+    DAWN_ASSERT_MSG((file.good()), std::string("File " + filename + " does not exists").c_str());
+
+    std::string jsonstr((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::shared_ptr<SIR> sir =
+        SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
+
+    combined->Filename = sir->Filename;
+    for(const auto& stencil : sir->Stencils) {
+      stencil->Name += "_" + std::to_string(i);
+      combined->Stencils.push_back(stencil);
+    }
+    for(const auto& stencilFunction : sir->StencilFunctions)
+      combined->StencilFunctions.push_back(stencilFunction);
+  }
+  return combined;
+}
+
+std::string compileSIR(const std::vector<std::string>& sirFilenames, Options options) {
+  UIDGenerator::getInstance()->reset();
+  std::shared_ptr<SIR> sir = loadCombinedSIR(sirFilenames);
+
+  DawnCompiler compiler(&options);
+
+  auto translationUnit = compiler.compile(sir);
+  EXPECT_FALSE(compiler.getDiagnostics().hasErrors());
+  if(!translationUnit)
+    return "";
+
+  std::ostringstream ss;
+  for(const auto& define : translationUnit->getPPDefines())
+    ss << define << "\n";
+  ss << translationUnit->getGlobals();
+  for(const auto& stencil : translationUnit->getStencils())
+    ss << stencil.first << "\n" << stencil.second;
+  return ss.str();
+}
+
+std::string compile(int optimizerJobs, int codeGenJobs = 1,
+                    const std::string& backend = "c++-naive") {
+  Options options;
+  options.Backend = backend;
+  options.OptimizerJobs = optimizerJobs;
+  options.CodeGenJobs = codeGenJobs;
+  return compileSIR(
+      {"compute_extent_test_stencil_01.sir", "compute_extent_test_stencil_02.sir",
+       "compute_extent_test_stencil_03.sir", "compute_extent_test_stencil_04.sir",
+       "compute_extent_test_stencil_05.sir", "test_field_access_interval_01.sir",
+       "test_field_access_interval_02.sir", "test_field_access_interval_03.sir"},
+      options);
+}
+
+TEST(ParallelOptimizer, SingleJobMatchesSerialOptimizer) {
+  // Output of the serial optimizer, before stencil instantiations could be optimized in parallel
+  std::ifstream file(TestEnvironment::path_ + "/parallel_optimizer_serial_output.txt");
+  ASSERT_TRUE(file.good());
+  const std::string reference((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+
+  EXPECT_EQ(compile(1), reference);
+}
+
+TEST(ParallelOptimizer, OutputIsIndependentOfNumberOfJobs) {
+  const std::string serial = compile(1);
+  ASSERT_FALSE(serial.empty());
+
+  EXPECT_EQ(compile(2), serial);
+  EXPECT_EQ(compile(4), serial);
+  EXPECT_EQ(compile(0), serial);
+}
+
+TEST(ParallelOptimizer, GeneratedNamesAreIndependentOfNumberOfJobs) {
+  // The stencil functions computing temporaries on the fly are named after the AccessID of the
+  // temporary and the merged temporaries after the AccessID of the first one
+  for(const std::string backend : {"c++-naive", "gridtools", "c++-opt"}) {
+    Options options;
+    options.Backend = backend;
+    options.PassTmpToFunction = true;
+    options.MergeStages = true;
+    options.MergeTemporaries = true;
+
+    options.OptimizerJobs = 1;
+    const std::string serial = compileSIR(
+        {"test_field_access_interval_05.sir", "compute_extent_test_stencil_03.sir"}, options);
+    ASSERT_FALSE(serial.empty()) << backend;
+
+    options.OptimizerJobs = 4;
+    EXPECT_EQ(compileSIR({"test_field_access_interval_05.sir", "compute_extent_test_stencil_03.sir"},
+                         options),
+              serial)
+        << backend;
+  }
+}
+
+TEST(ParallelOptimizer, CodeGenIsIndependentOfNumberOfJobs) {
+  for(const std::string backend : {"c++-naive", "gridtools"}) {
+    for(int optimizerJobs : {1, 4}) {
+      const std::string serial = compile(optimizerJobs, 1, backend);
+      ASSERT_FALSE(serial.empty()) << backend;
+
+      EXPECT_EQ(compile(optimizerJobs, 4, backend), serial) << backend;
+      EXPECT_EQ(compile(optimizerJobs, 0, backend), serial) << backend;
+    }
+  }
+}
+
+} // anonymous namespace
@@ -0,0 +1,87 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Serialization/SIRSerializer.h"
+#include "dawn/Support/AllocationCounter.h"
+#include "dawn/Support/Json.h"
+#include "test/unit-test/dawn/Optimizer/TestEnvironment.h"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <streambuf>
+
+using namespace dawn;
+
+namespace {
+
+json::json readJson(const std::string& filename) {
+  std::ifstream file(filename);
+  DAWN_ASSERT_MSG((file.good()), std::string("File " + filename + " does not exists").c_str());
+  json::json node;
+  file >> node;
+  return node;
+}
+
+TEST(PassProfiler, ReportAndTrace) {
+  std::string filename = TestEnvironment::path_ + "/compute_extent_test_stencil_01.sir";
+  std::ifstream file(filename);
+  DAWN_ASSERT_MSG((file.good()), std::string("File " + filename + " does not exists").c_str());
+  std::string jsonstr((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  std::shared_ptr<SIR> sir = SIRSerializer::deserializeFromString(jsonstr, SIRSerializer::SK_Json);
+
+  const std::string profileFile = "pass_profile_test.json";
+  Options options;
+  options.PassProfile = profileFile;
+  DawnCompiler compiler(&options);
+
+  auto optimizer = compiler.runOptimizer(sir);
+  ASSERT_NE(optimizer, nullptr);
+  const std::size_t numPasses = optimizer->getPassManager().getPasses().size();
+
+  json::json report = readJson(profileFile);
+  ASSERT_EQ(report["passes"].size(), numPasses);
+  for(const auto& record : report["passes"]) {
+    EXPECT_EQ(record["instantiation"], "compute_extent_test_stencil");
+    EXPECT_GE(record["wall_time_us"].get<double>(), 0.0);
+    EXPECT_GE(record["iir_after"]["stencils"].get<int>(), 1);
+    EXPECT_GE(record["iir_after"]["statements"].get<int>(), 1);
+  }
+  EXPECT_FALSE(report["summary"].empty());
+
+  if(isAllocationCountingEnabled()) {
+    std::uint64_t allocations = 0;
+    for(const auto& record : report["passes"])
+      allocations += record["allocations"].get<std::uint64_t>();
+    EXPECT_GT(allocations, 0);
+  }
+
+  // The multi-stage splitter never removes multi-stages
+  for(const auto& record : report["passes"])
+    if(record["pass"] == "PassMultiStageSplitter")
+      EXPECT_GE(record["iir_after"]["multistages"].get<int>(),
+                record["iir_before"]["multistages"].get<int>());
+
+  json::json trace = readJson(profileFile + ".trace.json");
+  EXPECT_EQ(trace["traceEvents"].size(), numPasses);
+  for(const auto& event : trace["traceEvents"])
+    EXPECT_EQ(event["ph"], "X");
+
+  std::remove(profileFile.c_str());
+  std::remove((profileFile + ".trace.json").c_str());
+}
+
+} // anonymous namespace
@@ -0,0 +1,117 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/PassDataLocalityMetric.h"
+#include "dawn/Optimizer/ReorderStrategyGreedy.h"
+#include "dawn/Optimizer/ReorderStrategyPartitioning.h"
+#include "dawn/Unittest/SIRGenerator.h"
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+class ReorderStrategyPartitioningTest : public ::testing::Test {
+protected:
+  Options options_;
+  std::unique_ptr<DawnCompiler> compiler_;
+  std::unique_ptr<OptimizerContext> optimizer_;
+
+  void SetUp() override {
+    SIRGeneratorParameters parameters;
+    parameters.NumVerticalRegions = 4;
+    parameters.NumStatements = 6;
+    parameters.NumFields = 6;
+
+    // Keep the stages as they come out of the splitters, the strategies are applied by the tests
+    options_.ReorderStrategy = "none";
+    compiler_ = std::make_unique<DawnCompiler>(&options_);
+    optimizer_ = compiler_->runOptimizer(generateSIR(parameters));
+    ASSERT_TRUE(optimizer_ != nullptr);
+  }
+
+  std::shared_ptr<iir::StencilInstantiation> getInstantiation() {
+    return optimizer_->getStencilInstantiationMap().begin()->second;
+  }
+};
+
+std::vector<int> getStageIDs(const iir::Stencil& stencil) {
+  std::vector<int> stageIDs;
+  for(const auto& stage : iterateIIROver<iir::Stage>(stencil))
+    stageIDs.push_back(stage->getStageID());
+  return stageIDs;
+}
+
+int getTraffic(const iir::StencilInstantiation& instantiation, OptimizerContext& context,
+               const iir::Stencil& stencil) {
+  auto readAndWrite = computeReadWriteAccessesMetric(instantiation, context, stencil);
+  return readAndWrite.first + readAndWrite.second;
+}
+
+TEST_F(ReorderStrategyPartitioningTest, KeepsAllStages) {
+  auto instantiation = getInstantiation();
+  const auto& stencilPtr = instantiation->getStencils().front();
+
+  auto newStencil =
+      ReoderStrategyPartitioning().reorder(instantiation.get(), stencilPtr, *optimizer_);
+  ASSERT_TRUE(newStencil != nullptr);
+  EXPECT_FALSE(compiler_->getDiagnostics().hasErrors());
+
+  auto stageIDs = getStageIDs(*stencilPtr);
+  auto newStageIDs = getStageIDs(*newStencil);
+  std::sort(stageIDs.begin(), stageIDs.end());
+  std::sort(newStageIDs.begin(), newStageIDs.end());
+  EXPECT_EQ(newStageIDs, stageIDs);
+
+  for(const auto& multiStage : newStencil->getChildren())
+    EXPECT_FALSE(multiStage->childrenEmpty());
+}
+
+TEST_F(ReorderStrategyPartitioningTest, TrafficDoesNotExceedGreedy) {
+  auto instantiation = getInstantiation();
+  const auto& stencilPtr = instantiation->getStencils().front();
+
+  auto greedyStencil =
+      ReoderStrategyGreedy().reorder(instantiation.get(), stencilPtr, *optimizer_);
+  auto newStencil =
+      ReoderStrategyPartitioning().reorder(instantiation.get(), stencilPtr, *optimizer_);
+  ASSERT_TRUE(greedyStencil != nullptr);
+  ASSERT_TRUE(newStencil != nullptr);
+
+  EXPECT_LE(getTraffic(*instantiation, *optimizer_, *newStencil),
+            getTraffic(*instantiation, *optimizer_, *greedyStencil));
+}
+
+TEST(ReorderStrategyPartitioning, RunsInTheOptimizer) {
+  SIRGeneratorParameters parameters;
+  parameters.NumStencils = 2;
+  parameters.NumVerticalRegions = 3;
+  parameters.StencilFunctionDepth = 1;
+
+  Options options;
+  options.ReorderStrategy = "scut";
+  DawnCompiler compiler(&options);
+  auto optimizer = compiler.runOptimizer(generateSIR(parameters));
+  ASSERT_TRUE(optimizer != nullptr);
+  EXPECT_FALSE(compiler.getDiagnostics().hasErrors());
+}
+
+} // anonymous namespace
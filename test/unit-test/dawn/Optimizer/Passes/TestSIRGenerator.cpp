@@ -0,0 +1,64 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Fingerprint.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/SIR/SIR.h"
+#include "dawn/Unittest/SIRGenerator.h"
+#include <gtest/gtest.h>
+
+using namespace dawn;
+
+namespace {
+
+TEST(SIRGenerator, GeneratedSIRCompiles) {
+  std::vector<SIRGeneratorParameters> shapes(4);
+  shapes[1].NumStencils = 3;
+  shapes[1].NumVerticalRegions = 3;
+  shapes[2].NumStatements = 12;
+  shapes[2].NumFields = 8;
+  shapes[2].OffsetRadius = 3;
+  shapes[3].StencilFunctionDepth = 3;
+
+  for(const auto& shape : shapes) {
+    for(const std::string backend : {"c++-naive", "c++-opt", "gridtools"}) {
+      Options options;
+      options.Backend = backend;
+      DawnCompiler compiler(&options);
+
+      auto sir = generateSIR(shape);
+      ASSERT_EQ(sir->Stencils.size(), shape.NumStencils);
+      EXPECT_TRUE(compiler.compile(sir) != nullptr) << shape.toString() << " " << backend;
+      EXPECT_FALSE(compiler.getDiagnostics().hasErrors()) << shape.toString() << " " << backend;
+    }
+  }
+}
+
+TEST(SIRGenerator, IsDeterministic) {
+  SIRGeneratorParameters shape;
+  shape.NumVerticalRegions = 2;
+  shape.StencilFunctionDepth = 2;
+
+  Options options;
+  EXPECT_EQ(computeSIRFingerprint(*generateSIR(shape), options),
+            computeSIRFingerprint(*generateSIR(shape), options));
+
+  SIRGeneratorParameters otherSeed = shape;
+  otherSeed.Seed = 1;
+  EXPECT_NE(computeSIRFingerprint(*generateSIR(shape), options),
+            computeSIRFingerprint(*generateSIR(otherSeed), options));
+}
+
+} // anonymous namespace
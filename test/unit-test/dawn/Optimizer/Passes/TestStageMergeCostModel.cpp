@@ -0,0 +1,113 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/PassSetBlockSize.h"
+#include "dawn/Optimizer/StageMergeCostModel.h"
+#include "dawn/Unittest/SIRGenerator.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+class StageMergeCostModelTest : public ::testing::Test {
+protected:
+  Options options_;
+  std::unique_ptr<DawnCompiler> compiler_;
+  std::unique_ptr<OptimizerContext> optimizer_;
+
+  void SetUp() override {
+    SIRGeneratorParameters parameters;
+    parameters.NumStatements = 6;
+    compiler_ = std::make_unique<DawnCompiler>(&options_);
+    optimizer_ = compiler_->runOptimizer(generateSIR(parameters));
+    ASSERT_TRUE(optimizer_ != nullptr);
+  }
+
+  std::shared_ptr<iir::StencilInstantiation> getInstantiation() {
+    return optimizer_->getStencilInstantiationMap().begin()->second;
+  }
+};
+
+std::vector<const iir::DoMethod*> getDoMethods(const iir::Stage& stage) {
+  std::vector<const iir::DoMethod*> doMethods;
+  for(const auto& doMethod : stage.getChildren())
+    doMethods.push_back(doMethod.get());
+  return doMethods;
+}
+
+TEST_F(StageMergeCostModelTest, RedundantComputationGrowsWithExtent) {
+  auto instantiation = getInstantiation();
+  const iir::Stencil& stencil = *instantiation->getStencils().front();
+  const iir::MultiStage& multiStage = *stencil.getChildren().front();
+  const iir::Stage& stage = *multiStage.getChildren().front();
+
+  StageMergeCostModel costModel(*instantiation, *optimizer_, stencil, {32, 4, 4});
+  StageCost pointwise =
+      costModel.getCost(multiStage, getDoMethods(stage), iir::Extents(0, 0, 0, 0, 0, 0));
+  StageCost halo =
+      costModel.getCost(multiStage, getDoMethods(stage), iir::Extents(-1, 1, -1, 1, 0, 0));
+
+  EXPECT_EQ(pointwise.RedundantComputation, 0);
+  EXPECT_GT(halo.RedundantComputation, 0);
+  EXPECT_EQ(halo.BytesMoved, pointwise.BytesMoved);
+  EXPECT_GT(pointwise.BytesMoved, 0);
+  EXPECT_GT(halo.getScore(), pointwise.getScore());
+}
+
+TEST_F(StageMergeCostModelTest, FieldsBeyondRegistersAreSpilled) {
+  auto instantiation = getInstantiation();
+  const iir::Stencil& stencil = *instantiation->getStencils().front();
+  const iir::MultiStage& multiStage = *stencil.getChildren().front();
+  const iir::Stage& stage = *multiStage.getChildren().front();
+
+  StageMergeCostModel costModel(*instantiation, *optimizer_, stencil, {32, 4, 4});
+  const iir::Extents& extent = costModel.getExtent(stage);
+  EXPECT_EQ(costModel.getCost(multiStage, getDoMethods(stage), extent).ResourcePressure, 0);
+
+  optimizer_->getHardwareConfiguration().RegisterMaxFields = 0;
+  EXPECT_EQ(costModel.getCost(multiStage, getDoMethods(stage), extent).ResourcePressure,
+            2.0 * optimizer_->getHardwareConfiguration().ElementSize * stage.getFields().size());
+}
+
+TEST_F(StageMergeCostModelTest, BlockSizeDecidesMerge) {
+  auto instantiation = getInstantiation();
+  const iir::Stencil& stencil = *instantiation->getStencils().front();
+  const iir::MultiStage& multiStage = *stencil.getChildren().front();
+  const iir::Stage& stage = *multiStage.getChildren().front();
+  const iir::Stage& otherStage = *multiStage.getChildren().back();
+  const iir::DoMethod& doMethod = *otherStage.getChildren().front();
+
+  // The halo added by merging a stage with a smaller extent only pays off on large blocks
+  auto isProfitable = [&](const std::array<unsigned int, 3>& blockSize) {
+    StageMergeCostModel costModel(*instantiation, *optimizer_, stencil, blockSize);
+    return costModel.getCostOfMergedStage(multiStage, stage, otherStage, doMethod).getScore() <
+           costModel.getCostOfSeparateStages(multiStage, stage, otherStage, doMethod).getScore();
+  };
+  EXPECT_FALSE(isProfitable({4, 4, 4}));
+  EXPECT_TRUE(isProfitable({256, 256, 4}));
+
+  // The merger anticipates the block size given with `-block-size`
+  optimizer_->getOptions().block_size = "256,256,4";
+  EXPECT_EQ(PassSetBlockSize::computeBlockSize(*optimizer_, PassSetBlockSize::TK_GPU,
+                                               *instantiation->getIIR()),
+            (std::array<unsigned int, 3>{256, 256, 4}));
+}
+
+} // anonymous namespace
@@ -0,0 +1,109 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/Accesses.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Optimizer/Renaming.h"
+#include "dawn/Unittest/SIRGenerator.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+class StencilInstantiationClone : public ::testing::Test {
+protected:
+  Options options_;
+  std::unique_ptr<DawnCompiler> compiler_;
+  std::unique_ptr<OptimizerContext> optimizer_;
+
+  void SetUp() override {
+    SIRGeneratorParameters parameters;
+    parameters.NumStencils = 1;
+    parameters.NumVerticalRegions = 2;
+    parameters.NumStatements = 6;
+    compiler_ = std::make_unique<DawnCompiler>(&options_);
+    optimizer_ = compiler_->runOptimizer(generateSIR(parameters));
+    ASSERT_TRUE(optimizer_ != nullptr);
+  }
+
+  std::shared_ptr<iir::StencilInstantiation> getInstantiation() {
+    return optimizer_->getStencilInstantiationMap().begin()->second;
+  }
+};
+
+std::vector<const iir::StatementAccessesPair*> getStatementAccessesPairs(const iir::IIR& iir) {
+  std::vector<const iir::StatementAccessesPair*> pairs;
+  for(const auto& pair : iterateIIROver<iir::StatementAccessesPair>(iir))
+    pairs.push_back(pair.get());
+  return pairs;
+}
+
+TEST_F(StencilInstantiationClone, RefersToItsOwnMetadata) {
+  auto instantiation = getInstantiation();
+  auto clone = instantiation->clone();
+
+  ASSERT_EQ(clone->getStencils().size(), instantiation->getStencils().size());
+  for(const auto& stencil : clone->getStencils()) {
+    EXPECT_EQ(&stencil->getMetadata(), &clone->getMetaData());
+    for(const auto& multiStage : stencil->getChildren())
+      EXPECT_EQ(&multiStage->getMetadata(), &clone->getMetaData());
+  }
+  EXPECT_EQ(clone->getIIR()->getFields().size(), instantiation->getIIR()->getFields().size());
+}
+
+TEST_F(StencilInstantiationClone, SharesAccessesUntilModified) {
+  auto instantiation = getInstantiation();
+  auto clone = instantiation->clone();
+
+  auto pairs = getStatementAccessesPairs(*instantiation->getIIR());
+  auto clonePairs = getStatementAccessesPairs(*clone->getIIR());
+  ASSERT_EQ(pairs.size(), clonePairs.size());
+  ASSERT_FALSE(pairs.empty());
+  for(std::size_t i = 0; i < pairs.size(); ++i) {
+    EXPECT_NE(pairs[i], clonePairs[i]);
+    EXPECT_EQ(pairs[i]->getStatement(), clonePairs[i]->getStatement());
+    EXPECT_EQ(pairs[i]->getAccesses(), clonePairs[i]->getAccesses());
+  }
+
+  // Rename a written field in the clone
+  int oldAccessID = pairs.front()->getAccesses()->getWriteAccesses().begin()->first;
+  int newAccessID = clone->nextUID();
+  const auto& exprIDToAccessID = instantiation->getMetaData().getExprIDToAccessIDMap();
+  auto exprIDToAccessIDBefore = exprIDToAccessID;
+  for(const auto& stencil : clone->getStencils())
+    renameAccessIDInStencil(stencil.get(), oldAccessID, newAccessID);
+
+  for(std::size_t i = 0; i < pairs.size(); ++i) {
+    const auto& accesses = pairs[i]->getAccesses();
+    EXPECT_FALSE(accesses->hasAccess(newAccessID));
+    if(accesses->hasAccess(oldAccessID)) {
+      EXPECT_NE(accesses, clonePairs[i]->getAccesses());
+      EXPECT_FALSE(clonePairs[i]->getAccesses()->hasAccess(oldAccessID));
+      EXPECT_TRUE(clonePairs[i]->getAccesses()->hasAccess(newAccessID));
+    } else {
+      EXPECT_EQ(accesses, clonePairs[i]->getAccesses());
+    }
+  }
+  EXPECT_TRUE(instantiation->getMetaData().getExprIDToAccessIDMap() == exprIDToAccessIDBefore);
+  EXPECT_FALSE(clone->getMetaData().getExprIDToAccessIDMap() == exprIDToAccessIDBefore);
+}
+
+} // anonymous namespace
@@ -0,0 +1,162 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Compiler/DawnCompiler.h"
+#include "dawn/Compiler/Options.h"
+#include "dawn/IIR/IIRNodeIterator.h"
+#include "dawn/IIR/StatementAccessesPair.h"
+#include "dawn/IIR/StencilInstantiation.h"
+#include "dawn/IIR/StencilLeafIndex.h"
+#include "dawn/Optimizer/OptimizerContext.h"
+#include "dawn/Unittest/SIRGenerator.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+using namespace dawn;
+
+namespace {
+
+class StencilLeafIndex : public ::testing::Test {
+protected:
+  Options options_;
+  std::unique_ptr<DawnCompiler> compiler_;
+  std::unique_ptr<OptimizerContext> optimizer_;
+
+  void SetUp() override {
+    SIRGeneratorParameters parameters;
+    parameters.NumStencils = 2;
+    parameters.NumVerticalRegions = 2;
+    parameters.NumStatements = 6;
+    compiler_ = std::make_unique<DawnCompiler>(&options_);
+    optimizer_ = compiler_->runOptimizer(generateSIR(parameters));
+    ASSERT_TRUE(optimizer_ != nullptr);
+  }
+
+  const std::vector<std::unique_ptr<iir::Stencil>>& getStencils() {
+    return optimizer_->getStencilInstantiationMap().begin()->second->getStencils();
+  }
+};
+
+template <typename Leaf, typename Range>
+std::vector<const Leaf*> collect(Range&& range) {
+  std::vector<const Leaf*> nodes;
+  for(const auto& node : range)
+    nodes.push_back(node.get());
+  return nodes;
+}
+
+TEST_F(StencilLeafIndex, MatchesRecursiveIteration) {
+  for(const auto& stencil : getStencils()) {
+    EXPECT_EQ(collect<iir::Stage>(iterateStencilOver<iir::Stage>(*stencil)),
+              collect<iir::Stage>(iterateIIROver<iir::Stage>(*stencil)));
+    EXPECT_EQ(collect<iir::DoMethod>(iterateStencilOver<iir::DoMethod>(*stencil)),
+              collect<iir::DoMethod>(iterateIIROver<iir::DoMethod>(*stencil)));
+    EXPECT_EQ(collect<iir::StatementAccessesPair>(
+                  iterateStencilOver<iir::StatementAccessesPair>(*stencil)),
+              collect<iir::StatementAccessesPair>(
+                  iterateIIROver<iir::StatementAccessesPair>(*stencil)));
+  }
+}
+
+TEST_F(StencilLeafIndex, EntriesCarryParentContext) {
+  for(const auto& stencil : getStencils()) {
+    int stageIdx = 0;
+    for(const auto& entry : iterateStencilEntriesOver<iir::Stage>(*stencil)) {
+      EXPECT_EQ(entry.StageIndex, stageIdx);
+      EXPECT_EQ(entry.getStage().get(), stencil->getStage(entry.StagePos).get());
+      EXPECT_EQ(stencil->getStageIndexFromPosition(entry.StagePos), stageIdx);
+      EXPECT_EQ(entry.getMultiStage().get(),
+                stencil->getMultiStageFromMultiStageIndex(entry.StagePos.MultiStageIndex).get());
+      stageIdx++;
+    }
+    EXPECT_EQ(stencil->getNumStages(), stageIdx);
+
+    for(const auto& entry : iterateStencilEntriesOver<iir::StatementAccessesPair>(*stencil)) {
+      const auto& doMethod = entry.getDoMethod();
+      EXPECT_EQ(doMethod->getChild(entry.StatementIndex).get(),
+                entry.getStatementAccessesPair().get());
+      EXPECT_EQ(entry.getStage()->getChild(entry.DoMethodIndex).get(), doMethod.get());
+      EXPECT_EQ(stencil->getStage(entry.StageIndex).get(), entry.getStage().get());
+      EXPECT_EQ(&entry.getStage()->getParent(), &entry.getMultiStage());
+    }
+  }
+}
+
+TEST_F(StencilLeafIndex, RebuiltAfterStructuralModifications) {
+  iir::Stencil& stencil = *getStencils().front();
+  auto index = stencil.getLeafIndex();
+  EXPECT_EQ(stencil.getLeafIndex(), index);
+
+  // Modifying the statements does not change the structure
+  stencil.updateFields();
+  EXPECT_EQ(stencil.getLeafIndex(), index);
+
+  // Inserting a statement deep in the tree invalidates the index
+  const int numStatements = index->getStatementAccessesPairs().size();
+  iir::DoMethod& doMethod = *stencil.getStage(0)->getChildren().front();
+  doMethod.insertChild(doMethod.getChildren().front()->clone());
+  ASSERT_NE(stencil.getLeafIndex(), index);
+  EXPECT_EQ(stencil.getLeafIndex()->getStatementAccessesPairs().size(), numStatements + 1);
+
+  // The old index still describes the tree before the modification
+  EXPECT_EQ(index->getStatementAccessesPairs().size(), numStatements);
+
+  index = stencil.getLeafIndex();
+  doMethod.childrenErase(std::prev(doMethod.childrenEnd()));
+  EXPECT_NE(stencil.getLeafIndex(), index);
+  EXPECT_EQ(stencil.getLeafIndex()->getStatementAccessesPairs().size(), numStatements);
+
+  // Inserting a stage shifts the positions of the following stages
+  const int numStages = stencil.getNumStages();
+  const iir::Stage* lastStage = stencil.getStage(numStages - 1).get();
+  stencil.insertStage(iir::Stencil::StagePosition(0, -1), stencil.getStage(0)->clone());
+  EXPECT_EQ(stencil.getNumStages(), numStages + 1);
+  EXPECT_EQ(stencil.getStage(numStages).get(), lastStage);
+}
+
+TEST_F(StencilLeafIndex, OnlyInvalidatedByModificationsOfTheStencil) {
+  // Stencil of another instantiation, e.g one optimized concurrently
+  const auto& instantiations = optimizer_->getStencilInstantiationMap();
+  ASSERT_EQ(instantiations.size(), 2);
+  iir::Stencil& stencil = *getStencils().front();
+  iir::Stencil& other = *std::next(instantiations.begin())->second->getStencils().front();
+  auto index = stencil.getLeafIndex();
+
+  iir::DoMethod& otherDoMethod = *other.getStage(0)->getChildren().front();
+  otherDoMethod.insertChild(otherDoMethod.getChildren().front()->clone());
+  EXPECT_EQ(stencil.getLeafIndex(), index);
+
+  // The descendants of a detached stencil cannot notify it
+  std::unique_ptr<iir::Stencil> detached = stencil.clone();
+  const int numStatements = detached->getLeafIndex()->getStatementAccessesPairs().size();
+  iir::DoMethod& doMethod = *detached->getStage(0)->getChildren().front();
+  doMethod.insertChild(doMethod.getChildren().front()->clone());
+  EXPECT_EQ(detached->getLeafIndex()->getStatementAccessesPairs().size(), numStatements + 1);
+  EXPECT_EQ(stencil.getLeafIndex(), index);
+}
+
+TEST_F(StencilLeafIndex, RangeOutlivesModification) {
+  iir::Stencil& stencil = *getStencils().front();
+  const int numStages = stencil.getNumStages();
+
+  int numVisited = 0;
+  for(const auto& stage : iterateStencilOver<iir::Stage>(stencil)) {
+    if(numVisited++ == 0)
+      stencil.insertStage(iir::Stencil::StagePosition(0, -1), stage->clone());
+  }
+  EXPECT_EQ(numVisited, numStages);
+  EXPECT_EQ(stencil.getNumStages(), numStages + 1);
+}
+
+} // anonymous namespace
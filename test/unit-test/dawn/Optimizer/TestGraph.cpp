@@ -150,4 +150,52 @@ TEST(GraphTest, computeIDsWithCycle) {
   EXPECT_TRUE((std::equal(ids.begin(), ids.end(), ref.begin())));
 }
 
+TEST(GraphTest, DiamondIsNotACycle) {
+  TestGraph graph;
+
+  graph.insertEdge(0, 1);
+  graph.insertEdge(0, 2);
+  graph.insertEdge(1, 3);
+  graph.insertEdge(2, 3);
+  graph.insertEdge(3, 4);
+
+  EXPECT_TRUE(graph.computeIDsWithCycles().empty());
+}
+
+TEST(GraphTest, Reachability) {
+  TestGraph graph;
+
+  graph.insertEdge(0, 1);
+  graph.insertEdge(1, 2);
+  graph.insertEdge(3, 2);
+
+  EXPECT_TRUE(graph.isReachable(0, 2));
+  EXPECT_TRUE(graph.isReachable(3, 2));
+  EXPECT_FALSE(graph.isReachable(2, 0));
+  EXPECT_FALSE(graph.isReachable(0, 3));
+  EXPECT_FALSE(graph.isReachable(0, 0));
+
+  // Inserting an edge invalidates the cached reachability
+  graph.insertEdge(2, 0);
+  EXPECT_TRUE(graph.isReachable(2, 0));
+  EXPECT_TRUE(graph.isReachable(3, 1));
+  EXPECT_TRUE(graph.hasCycleDependency(0));
+  EXPECT_FALSE(graph.hasCycleDependency(3));
+}
+
+TEST(GraphTest, Merge) {
+  TestGraph graph1, graph2;
+
+  graph1.insertEdge(0, 1);
+  graph2.insertEdge(2, 1);
+  graph2.insertEdge(1, 0);
+
+  graph1.merge(&graph2);
+  EXPECT_EQ(graph1.getNumVertices(), 3);
+  EXPECT_EQ(graph1.edgesOf(0).size(), 1);
+  EXPECT_EQ(graph1.getValueFromVertexID(graph1.getVertexIDFromValue(2)), 2);
+  EXPECT_TRUE(graph1.isReachable(2, 0));
+  EXPECT_EQ(graph1.computeIDsWithCycles(), (std::set<int>{0, 1}));
+}
+
 } // anonymous namespace
@@ -0,0 +1,48 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Support/CopyOnWrite.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace dawn {
+
+TEST(CopyOnWrite, CopiesShareTheValue) {
+  CopyOnWrite<std::vector<int>> a(std::vector<int>{1, 2, 3});
+  EXPECT_FALSE(a.isShared());
+
+  CopyOnWrite<std::vector<int>> b = a;
+  EXPECT_TRUE(a.sharesWith(b));
+  EXPECT_TRUE(a.isShared());
+  EXPECT_EQ(&a.get(), &b.get());
+  EXPECT_EQ(b->size(), 3);
+}
+
+TEST(CopyOnWrite, MutateDetaches) {
+  CopyOnWrite<std::vector<int>> a(std::vector<int>{1, 2, 3});
+  CopyOnWrite<std::vector<int>> b = a;
+
+  b.mutate().push_back(4);
+  EXPECT_FALSE(a.sharesWith(b));
+  EXPECT_FALSE(a.isShared());
+  EXPECT_EQ(*a, (std::vector<int>{1, 2, 3}));
+  EXPECT_EQ(*b, (std::vector<int>{1, 2, 3, 4}));
+
+  // An unshared value is modified in place
+  const std::vector<int>* value = &b.get();
+  b.mutate().push_back(5);
+  EXPECT_EQ(&b.get(), value);
+}
+
+} // namespace dawn
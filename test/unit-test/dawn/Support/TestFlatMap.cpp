@@ -0,0 +1,108 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Support/DenseIDMap.h"
+#include "dawn/Support/FlatMap.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace dawn {
+
+TEST(FlatMap, IsSortedByKey) {
+  FlatMap<int, std::string> map;
+  map.emplace(3, "c");
+  map.emplace(-1, "a");
+  map.emplace(2, "b");
+
+  std::vector<int> keys;
+  for(const auto& pair : map)
+    keys.push_back(pair.first);
+  EXPECT_EQ(keys, (std::vector<int>{-1, 2, 3}));
+}
+
+TEST(FlatMap, EmplaceDoesNotOverwrite) {
+  FlatMap<int, int> map;
+  EXPECT_TRUE(map.emplace(1, 10).second);
+  EXPECT_FALSE(map.emplace(1, 20).second);
+  EXPECT_EQ(map.at(1), 10);
+
+  map[1] = 20;
+  EXPECT_EQ(map.at(1), 20);
+  EXPECT_THROW(map.at(2), std::out_of_range);
+}
+
+TEST(FlatMap, Erase) {
+  FlatMap<int, int> map;
+  for(int i = 0; i < 10; ++i)
+    map[i] = i * i;
+
+  EXPECT_EQ(map.erase(4), 1);
+  EXPECT_EQ(map.erase(4), 0);
+  map.erase(map.find(0));
+
+  EXPECT_EQ(map.size(), 8);
+  EXPECT_EQ(map.count(0), 0);
+  EXPECT_EQ(map.count(4), 0);
+  EXPECT_EQ(map.find(5)->second, 25);
+}
+
+TEST(DenseIDMap, BehavesLikeMap) {
+  DenseIDMap<int> map;
+  std::map<int, int> reference;
+
+  // IDs are spread over several pages, including negative ones
+  for(int id : {0, 1, 255, 256, 1000, 100000, -1, -300, 42}) {
+    EXPECT_TRUE(map.emplace(id, id * 2));
+    reference.emplace(id, id * 2);
+  }
+  EXPECT_FALSE(map.emplace(42, 0));
+  EXPECT_EQ(map.size(), reference.size());
+
+  for(const auto& pair : reference) {
+    ASSERT_TRUE(map.lookup(pair.first));
+    EXPECT_EQ(*map.lookup(pair.first), pair.second);
+  }
+  EXPECT_EQ(map.lookup(2), nullptr);
+  EXPECT_EQ(map.count(2), 0);
+
+  std::map<int, int> visited;
+  for(auto pair : map)
+    visited.emplace(pair.first, pair.second);
+  EXPECT_EQ(visited, reference);
+}
+
+TEST(DenseIDMap, EraseAndCompare) {
+  DenseIDMap<int> a, b;
+  for(int id = 0; id < 600; ++id)
+    a[id] = id;
+  b = a;
+  EXPECT_EQ(a, b);
+
+  EXPECT_EQ(a.erase(300), 1);
+  EXPECT_EQ(a.erase(300), 0);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(a.size(), 599);
+
+  b.erase(300);
+  EXPECT_EQ(a, b);
+
+  a.clear();
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(a.begin() == a.end());
+}
+
+} // namespace dawn
@@ -0,0 +1,68 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Support/Parallel.h"
+#include "dawn/Support/UIDGenerator.h"
+#include <atomic>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+namespace dawn {
+
+TEST(Parallel, VisitsEveryTaskOnce) {
+  std::vector<std::atomic<int>> visits(100);
+  for(auto& v : visits)
+    v = 0;
+
+  parallelFor(visits.size(), 4, [&](std::size_t i) { visits[i]++; });
+
+  for(const auto& v : visits)
+    EXPECT_EQ(v.load(), 1);
+}
+
+TEST(Parallel, NoTasks) {
+  int calls = 0;
+  parallelFor(0, 4, [&](std::size_t) { ++calls; });
+  EXPECT_EQ(calls, 0);
+}
+
+TEST(Parallel, RethrowsException) {
+  EXPECT_THROW(parallelFor(10, 3,
+                           [](std::size_t i) {
+                             if(i == 5)
+                               throw std::runtime_error("task failed");
+                           }),
+               std::runtime_error);
+}
+
+TEST(Parallel, UIDGeneratorScopesAreIndependentOfScheduling) {
+  const int base = UIDGenerator::getInstance()->peek();
+  std::vector<std::vector<int>> ids(8);
+
+  parallelFor(ids.size(), 4, [&](std::size_t i) {
+    UIDGenerator::Scope scope(base + static_cast<int>(i) * 100, 100);
+    for(int n = 0; n < 10; ++n)
+      ids[i].push_back(UIDGenerator::getInstance()->get());
+  });
+
+  for(std::size_t i = 0; i < ids.size(); ++i)
+    for(int n = 0; n < 10; ++n)
+      EXPECT_EQ(ids[i][n], base + static_cast<int>(i) * 100 + n);
+
+  // Outside of a scope the global counter is used and was left untouched
+  EXPECT_EQ(UIDGenerator::getInstance()->get(), base);
+}
+
+} // namespace dawn
@@ -0,0 +1,43 @@
+//===--------------------------------------------------------------------------------*- C++ -*-===//
+//                          _
+//                         | |
+//                       __| | __ ___      ___ ___
+//                      / _` |/ _` \ \ /\ / / '_  |
+//                     | (_| | (_| |\ V  V /| | | |
+//                      \__,_|\__,_| \_/\_/ |_| |_| - Compiler Toolchain
+//
+//
+//  This file is distributed under the MIT License (MIT).
+//  See LICENSE.txt for details.
+//
+//===------------------------------------------------------------------------------------------===//
+
+#include "dawn/Support/SHA256.h"
+#include <gtest/gtest.h>
+#include <string>
+
+using namespace dawn;
+
+namespace {
+
+TEST(SHA256, KnownDigests) {
+  EXPECT_EQ(SHA256::hash(""), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+  EXPECT_EQ(SHA256::hash("abc"),
+            "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+  EXPECT_EQ(SHA256::hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"),
+            "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+  EXPECT_EQ(SHA256::hash(std::string(1000000, 'a')),
+            "cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+}
+
+TEST(SHA256, IncrementalUpdate) {
+  const std::string message(200, 'x');
+  for(std::size_t split : {0, 1, 63, 64, 65, 128, 200}) {
+    SHA256 sha;
+    sha.update(message.substr(0, split));
+    sha.update(message.substr(split));
+    EXPECT_EQ(sha.hexDigest(), SHA256::hash(message));
+  }
+}
+
+} // anonymous namespace